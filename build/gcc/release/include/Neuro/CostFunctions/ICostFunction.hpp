@@ -0,0 +1,81 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_ICOST_FUNCTION_HPP
+#define ANNT_ICOST_FUNCTION_HPP
+
+#include <vector>
+
+#include "../../Types/Types.hpp"
+#include "../../Tools/XParallel.hpp"
+
+namespace ANNT { namespace Neuro { namespace Training {
+
+// Cost functions' interface for calculating cost and gradient
+// for a specified output/target pair
+class ICostFunction
+{
+public:
+    virtual ~ICostFunction( ) { }
+
+    // Calculates cost value of the specified output vector
+    virtual float_t Cost( const fvector_t& output, const fvector_t& target ) const = 0;
+
+    // Calculates gradient for the specified output/target pair
+    virtual fvector_t Gradient( const fvector_t& output, const fvector_t& target ) const = 0;
+
+    // Calculates cost value and gradient for the specified output/target pair, the gradient is written
+    // into the provided vector of the output's size. Default implementation is based on the above methods;
+    // cost functions override it to avoid allocation of a temporary vector.
+    virtual float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const
+    {
+        grad = Gradient( output, target );
+
+        return Cost( output, target );
+    }
+
+    // Calculates cost values and gradients for a batch of output/target pairs - gradients are written into the
+    // provided vectors and cost values into the provided array; returns total cost of the batch
+    float_t BatchCostGradient( const std::vector<fvector_t*>& outputs,
+                               const std::vector<fvector_t*>& targets,
+                               const std::vector<fvector_t*>& grads,
+                               float_t* costs, bool runInParallel ) const
+    {
+        float_t totalCost = 0;
+
+        XParallel::For( outputs.size( ), runInParallel, [&]( size_t i )
+        {
+            costs[i] = CostGradient( *outputs[i], *targets[i], *grads[i] );
+        } );
+
+        // sum is done sequentially, so it does not depend on the way samples are split between threads
+        for ( size_t i = 0, n = outputs.size( ); i < n; i++ )
+        {
+            totalCost += costs[i];
+        }
+
+        return totalCost;
+    }
+};
+
+} } } // namespace ANNT::Neuro::Training
+
+#endif // ANNT_ICOST_FUNCTION_HPP
@@ -0,0 +1,83 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XMSE_COST_HPP
+#define ANNT_XMSE_COST_HPP
+
+#include <algorithm>
+
+#include "ICostFunction.hpp"
+#include "../../Tools/XVectorize.hpp"
+
+namespace ANNT { namespace Neuro { namespace Training {
+
+// Implementation of Mean Square Error cost function
+//
+// Calculated as sum of squared differences divided by 2N
+//
+class XMSECost : public ICostFunction
+{
+public:
+
+    // Calculates cost value of the specified output vector
+    float_t Cost( const fvector_t& output, const fvector_t& target ) const override
+    {
+        size_t  length = output.size( );
+        float_t cost   = float_t( 0 );
+        float_t diff;
+
+        for ( size_t i = 0; i < length; i++ )
+        {
+            diff  = output[i] - target[i];
+            cost += diff * diff;
+        }
+
+        cost /= ( float( 2 ) * length );
+
+        return cost;
+    }
+
+    // Calculates gradient for the specified output/target pair
+    fvector_t Gradient( const fvector_t& output, const fvector_t& target ) const override
+    {
+        fvector_t grad( output );
+
+        XVectorize::Axpy( target.data( ), float_t( -1 ), grad.data( ), grad.size( ) );
+
+        return grad;
+    }
+
+    // Calculates cost value and gradient for the specified output/target pair
+    float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const override
+    {
+        size_t length = output.size( );
+
+        std::copy( output.begin( ), output.end( ), grad.begin( ) );
+        XVectorize::Axpy( target.data( ), float_t( -1 ), grad.data( ), length );
+
+        // the gradient is the difference, so cost is sum of its squares
+        return XVectorize::SumOfSquares( grad.data( ), length ) / ( float( 2 ) * length );
+    }
+};
+
+} } } // namespace ANNT::Neuro::Training
+
+#endif // ANNT_XMSE_COST_HPP
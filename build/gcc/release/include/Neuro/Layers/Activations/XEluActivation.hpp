@@ -0,0 +1,85 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XELU_ACTIVATION_HPP
+#define ANNT_XELU_ACTIVATION_HPP
+
+#include <algorithm>
+
+#include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Implementation of ELU activation function,
+//   f(x) = | x                      , x >= 0
+//          | alpha * ( exp(x) - 1 ) , x <  0
+class XEluActivation : public IActivationLayer
+{
+private:
+    float   mAlpha;
+
+public:
+
+    XEluActivation( float alpha = 1.0f ) : mAlpha( alpha )
+    {
+    }
+
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
+    {
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
+    {
+        // exponent is calculated for blocks of values first, which keeps input intact when output aliases it
+        const size_t blockSize = 256;
+        float_t      expValues[blockSize];
+
+        for ( size_t start = 0; start < len; start += blockSize )
+        {
+            size_t count = std::min( blockSize, len - start );
+
+            XVectorize::Exp( input + start, expValues, count );
+
+            for ( size_t i = 0; i < count; i++ )
+            {
+                output[start + i] = ( input[start + i] >= float_t( 0 ) ) ? input[start + i] : mAlpha * ( expValues[i] - float_t( 1 ) );
+            }
+        }
+    }
+
+    void BackwardActivate( const float_t* /* input */, const float_t* output,
+                           const float_t* delta, float_t* prevDelta, size_t len ) override
+    {
+        for ( size_t i = 0; i < len; i++ )
+        {
+            // derivative(ELU) = 1        , y >= 0
+            //                 = alpha + y, otherwise
+            prevDelta[i] = ( output[i] >= float_t( 0 ) ) ? delta[i] : ( mAlpha + output[i] ) * delta[i];
+        }
+    }
+};
+
+} } // namespace ANNT::Neuro
+
+#endif // ANNT_XELU_ACTIVATION_HPP
@@ -0,0 +1,60 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XSOFT_MAX_ACTIVATION_HPP
+#define ANNT_XSOFT_MAX_ACTIVATION_HPP
+
+#include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Implementation of SoftMax activation function
+class XSoftMaxActivation : public IActivationLayer
+{
+public:
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
+    {
+        float_t max = XVectorize::MaxValue( input, len );
+
+        // output = exp( input - max ) / sum( exp( input - max ) )
+        XVectorize::Scale( input, float_t( 1 ), -max, output, len );
+        XVectorize::Exp( output, output, len );
+        XVectorize::Scale( output, float_t( 1 ) / XVectorize::Sum( output, len ), output, len );
+    }
+
+    void BackwardActivate( const float_t* /* input */, const float_t* output,
+                           const float_t* delta, float_t* prevDelta, size_t len ) override
+    {
+        // prevDelta[i] = sum( delta[j] * der(i, j) ), where der(i, j) = y[i] * ( 1 - y[j] ), i == j
+        //                                                                = -y[i] * y[j]     , otherwise
+        // which is the same as y[i] * ( delta[i] - sum( delta[j] * y[j] ) )
+        float_t deltaDotOutput = XVectorize::Dot( delta, output, len );
+
+        XVectorize::Scale( output, -deltaDotOutput, prevDelta, len );
+        XVectorize::MulAdd( output, delta, prevDelta, len );
+    }
+};
+
+} } // namespace ANNT::Neuro
+
+#endif // ANNT_XSOFT_MAX_ACTIVATION_HPP
@@ -0,0 +1,382 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XCONVOLUTION_LAYER_HPP
+#define ANNT_XCONVOLUTION_LAYER_HPP
+
+#include "ITrainableLayer.hpp"
+#include "Activations/IActivationLayer.hpp"
+#include "../../Tools/XDepthwiseConvolution.hpp"
+#include "../../Tools/XFft.hpp"
+#include "../../Tools/XParallelAccumulator.hpp"
+#include "../../Tools/XQuantizedWeights.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Algorithms convolution layer can use to do its computations
+enum class ConvolutionAlgorithm
+{
+    Auto,   // Algorithm is chosen by the layer depending on its configuration.
+
+    Direct, // Kernels are slid over input maps directly.
+
+    Gemm,   // Inputs are lowered into matrices (im2col), so convolution turns into matrix multiplication.
+            // Grouped convolution does one multiplication per group, while depthwise convolution uses
+            // dedicated kernels instead.
+
+    Winograd2x2,    // Winograd F(2x2, 3x3) algorithm. Applies to 3x3 kernels with unit step only, which are not grouped - other
+                    // configurations fall back to Gemm.
+
+    Winograd4x4,    // Winograd F(4x4, 3x3) algorithm. Does less multiplications than F(2x2, 3x3), but is a bit
+                    // less accurate. Same restrictions apply.
+
+    Fft     // Convolution is done as element-wise multiplication in frequency domain. Applies to unit step only -
+            // other configurations fall back to Gemm. Pays off for large kernels.
+};
+
+// Implementation of convolution layer - output is the result of convolving input with layer's weight (convolution kernel)
+class XConvolutionLayer : public ITrainableLayer
+{
+private:
+    size_t      mInputWidth;
+    size_t      mInputHeight;
+    size_t      mInputDepth;
+    size_t      mOutputWidth;
+    size_t      mOutputHeight;
+    size_t      mKernelWidth;
+    size_t      mKernelHeight;
+    size_t      mKernelsCount;
+    size_t      mHorizontalStep;
+    size_t      mVerticalStep;
+    BorderMode  mBorderMode;
+
+    std::vector<bool>   mConnectionTable;
+    std::vector<size_t> mKernelOffsets;
+
+    // Number of groups input maps and kernels are split into (1 if all input maps are connected to all kernels),
+    // or 0 for arbitrary connection table. Kernels of every group are kept packed together as
+    // ( kernelsCount / groups ) x ( inputDepth / groups * kernelHeight * kernelWidth ) matrix.
+    size_t      mGroupsCount;
+
+    size_t      mPaddedWidth;
+    size_t      mPaddedHeight;
+    size_t      mPadLeft;
+    size_t      mPadTop;
+
+    ConvolutionAlgorithm mAlgorithm;
+
+    // Number of weights, excluding biases
+    size_t      mWeightCount;
+
+    // Pointers to weights and biases, which are all kept together in mAllWeights
+    float_t*    mKernelsWeights;
+    float_t*    mKernelsBiases;
+
+    // Weights laid out as kernelsCount x ( inputDepth * kernelHeight * kernelWidth ) matrix including
+    // missing connections as zeros - used for matrix multiplication with arbitrary connection table only
+    fvector_t   mDenseWeights;
+
+    // Kernels transformed for Winograd algorithm - for forward pass and for error propagation to previous layer
+    fvector_t   mWinogradKernels;
+    fvector_t   mWinogradBackwardKernels;
+
+    // Fourier transform of (padded) input size and spectra of all kernels (including missing connections),
+    // which are built only when FFT algorithm is selected
+    XRealFft2d  mFft;
+    cvector_t   mKernelsSpectra;
+
+    // Depthwise convolution used when every input map has its own kernels
+    XDepthwiseConvolution mDepthwise;
+
+    // Per thread gradients accumulated over samples/kernels in parallel
+    XParallelAccumulator  mGradientsAccumulator;
+
+    // Kernels and biases quantized to 8 bit integers, which are used for inference if not empty
+    XQuantizedWeights     mQuantizedWeights;
+
+public:
+
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           std::vector<bool>( ) , BorderMode::Valid, 1, 1 )
+    {
+    }
+
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       BorderMode borderMode ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           std::vector<bool>( ) , borderMode, 1, 1 )
+    {
+    }
+
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       BorderMode borderMode, size_t horizontalStep, size_t verticalStep ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           std::vector<bool>( ) , borderMode, horizontalStep, verticalStep )
+    {
+    }
+
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       const std::vector<bool>& connectionTable ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           connectionTable, BorderMode::Valid, 1, 1 )
+    {
+    }
+
+    // Arbitrary connection table is handled as dense convolution with missing connections being zero kernels
+    // (use grouped convolution constructors below for connection tables describing groups)
+    XConvolutionLayer( size_t inputWidth,  size_t inputHeight,  size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       const std::vector<bool>& connectionTable,
+                       BorderMode borderMode, size_t horizontalStep, size_t verticalStep ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           0, connectionTable, borderMode, horizontalStep, verticalStep )
+    {
+    }
+
+    // Grouped convolution - input maps and kernels are split into the specified number of groups, so that kernels of
+    // a group are applied only to input maps of the same group. If number of groups equals to input depth, it is
+    // depthwise convolution (kernelsCount / inputDepth kernels per input map). Input depth and kernels count must
+    // be divisible by groups count.
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       size_t groupsCount, BorderMode borderMode ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           groupsCount, std::vector<bool>( ), borderMode, 1, 1 )
+    {
+    }
+
+    XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       size_t groupsCount, BorderMode borderMode, size_t horizontalStep, size_t verticalStep ) :
+        XConvolutionLayer( inputWidth, inputHeight, inputDepth,
+                           kernelWidth, kernelHeight, kernelsCount,
+                           groupsCount, std::vector<bool>( ), borderMode, horizontalStep, verticalStep )
+    {
+    }
+
+    // Builds connection table for grouped convolution (input depth and kernels count must be divisible by groups count)
+    static std::vector<bool> GroupedConnectionTable( size_t inputDepth, size_t kernelsCount, size_t groupsCount );
+
+    // Number of kernels, which is the depth of output
+    size_t KernelsCount( ) const
+    {
+        return mKernelsCount;
+    }
+
+    // Number of groups the layer's convolution is split into (1 if all input maps are connected to all kernels),
+    // or 0 if the layer was created with arbitrary connection table
+    size_t GroupsCount( ) const
+    {
+        return mGroupsCount;
+    }
+
+    // Get/set algorithm used to compute convolution. Working memory requirements depend on it, so inference objects
+    // re-allocate it on change, while training objects must be created after it is set.
+    ConvolutionAlgorithm Algorithm( ) const
+    {
+        return mAlgorithm;
+    }
+    void SetAlgorithm( ConvolutionAlgorithm algorithm )
+    {
+        mAlgorithm = algorithm;
+        PrepareWeights( );
+        ConfigurationChanged( );
+    }
+
+    // Tells that we may need some extra memory for padding/unpadding or lowering inputs into matrices
+    uvector_t WorkingMemSize( bool trainingMode ) const override;
+
+    // Randomizes layer's weights, clears biases
+    void Randomize( ) override;
+
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
+    // Calculates outputs for the given inputs
+    void ForwardCompute( const std::vector<fvector_t*>& inputs,
+                         std::vector<fvector_t*>& outputs,
+                         const XNetworkContext& ctx ) const override;
+
+    // Calculates outputs for the given inputs and applies element wise activation to them (activation is skipped
+    // if not provided). Gemm algorithm activates blocks of outputs while they are still in cache.
+    void ForwardCompute( const std::vector<fvector_t*>& inputs,
+                         std::vector<fvector_t*>& outputs,
+                         const XNetworkContext& ctx,
+                         const IActivationLayer* activation ) const;
+
+    // Propagates error to the previous layer and calculates weights/biases gradients
+    void BackwardCompute( const std::vector<fvector_t*>& inputs,
+                          const std::vector<fvector_t*>& outputs,
+                          const std::vector<fvector_t*>& deltas,
+                          std::vector<fvector_t*>& prevDeltas,
+                          float_t* gradWeights,
+                          const XNetworkContext& ctx ) override;
+
+    // Kernels can be kept in half precision - those are widened to float for matrix multiplication (Gemm algorithm
+    // is used whatever is selected)
+    bool HalfPrecisionSupported( ) const override
+    {
+        return true;
+    }
+
+    // Saves/loads layer's kernels and biases in the specified 16 bit precision
+    bool SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const override;
+    bool LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision ) override;
+
+    // Saves layer's learnt parameters/weights
+    bool SaveLearnedParams( FILE* file ) const override;
+    // Loads layer's learnt parameters
+    bool LoadLearnedParams( FILE* file ) override;
+
+    // Updates weights prepared for the selected algorithm, when original weights get changed
+    // (quantized weights are dropped, since those don't match any more)
+    void WeightsChanged( ) override
+    {
+        PrepareWeights( );
+
+        if ( IsQuantized( ) )
+        {
+            mQuantizedWeights.Clear( );
+            ConfigurationChanged( );
+        }
+    }
+
+    // Scales outputs of every kernel and shifts them by changing weights and biases,
+    // i.e. output[k] = output[k] * scale[k] + shift[k] (vectors of kernels count size)
+    void ScaleOutputs( const fvector_t& scale, const fvector_t& shift );
+
+    // Scales bias of every kernel by the number of input maps connected to it - converts parameters saved by
+    // versions adding bias once for every connected input map, so those give the same outputs
+    void ScaleLegacyBiases( );
+
+    // Quantizes kernels and biases to 8 bit integers for inputs in the specified range, so inference runs on
+    // integer SIMD kernels (inputs are lowered into matrices, whatever algorithm is selected). Depthwise convolution
+    // is not quantized. Any change of weights reverts the layer to floating point inference.
+    void Quantize( float_t inputMin, float_t inputMax );
+
+    // Checks if the layer uses quantized weights for inference
+    bool IsQuantized( ) const
+    {
+        return !mQuantizedWeights.IsEmpty( );
+    }
+
+    // Saves/loads layer's quantized kernels and biases
+    bool SaveQuantizedParams( FILE* file ) const;
+    bool LoadQuantizedParams( FILE* file );
+
+protected:
+
+    // Sets weights/biases pointers
+    void SetWeightsPointers( ) override;
+
+private:
+    // Creates either grouped convolution (groups count is not 0) or convolution with the specified connection table
+    XConvolutionLayer( size_t inputWidth,  size_t inputHeight,  size_t inputDepth,
+                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                       size_t groupsCount, const std::vector<bool>& connectionTable,
+                       BorderMode borderMode, size_t horizontalStep, size_t verticalStep );
+
+    // Resolves algorithm to use if it is set to Auto
+    ConvolutionAlgorithm SelectedAlgorithm( ) const;
+
+    // Checks if inputs need to be lowered for matrix multiplication
+    bool NeedsLowering( ) const;
+
+    // Checks if the layer does depthwise convolution (every input map has its own kernels)
+    bool IsDepthwise( ) const;
+
+    // Checks if Winograd algorithm can be used for the layer's configuration
+    bool IsWinogradApplicable( ) const;
+
+    // Output tile size of the selected Winograd algorithm (0 if other algorithm is selected)
+    size_t WinogradTileSize( ) const;
+
+    // Checks if FFT based algorithm can be used for the layer's configuration
+    bool IsFftApplicable( ) const;
+
+    // Size of working memory needed to compute single frequency domain product and transform it back
+    size_t FftSlotSize( ) const;
+
+    // Prepares weights for the selected algorithm after they get changed
+    void PrepareWeights( );
+
+    // Lays out kernels as dense matrix, where missing connections are zero kernels
+    void BuildDenseWeights( fvector_t& denseWeights ) const;
+
+    // Forward/backward computations done by sliding kernels over inputs
+    void ForwardDirect( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const;
+    void BackwardDirect( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                         std::vector<fvector_t*>& prevDeltas, float_t* gradWeightsData, const XNetworkContext& ctx );
+
+    // Forward/backward computations done as matrix multiplications on lowered inputs
+    void ForwardGemm( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx,
+                      const IActivationLayer* activation ) const;
+    void BackwardGemm( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                       std::vector<fvector_t*>& prevDeltas, float_t* gradWeightsData, const XNetworkContext& ctx );
+
+    // Calculates outputs using kernels kept in half precision - blocks of kernels are widened once per call
+    // and multiplied with lowered inputs of all samples
+    void ForwardHalfPrecision( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx,
+                               const IActivationLayer* activation ) const;
+
+    // Widens the specified kernels kept in half precision into rows of the weights matrix used by Gemm algorithm
+    void WidenKernels( size_t firstKernel, size_t kernelsCount, float_t* widened ) const;
+
+    // Forward/backward computations done by depthwise convolution kernels
+    void ForwardDepthwise( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const;
+    void BackwardDepthwise( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                            std::vector<fvector_t*>& prevDeltas, float_t* gradWeightsData, const XNetworkContext& ctx );
+
+    // Forward/backward computations done using Winograd algorithm (weights' gradients are still done as GEMM)
+    void ForwardWinograd( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const;
+    void BackwardWinograd( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                           std::vector<fvector_t*>& prevDeltas, float_t* gradWeightsData, const XNetworkContext& ctx );
+
+    // Forward/backward computations done in frequency domain
+    void ForwardFft( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const;
+    void BackwardFft( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                      std::vector<fvector_t*>& prevDeltas, float_t* gradWeightsData, const XNetworkContext& ctx );
+
+    // Forward computation done as integer matrix multiplication of lowered quantized inputs and quantized kernels
+    void ForwardQuantized( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const;
+
+    // Accumulates weights' gradients as multiplication of deltas and lowered inputs
+    void CalculateGradientsGemm( const std::vector<fvector_t*>& inputs, const std::vector<fvector_t*>& deltas,
+                                 float_t* gradWeightsData, const XNetworkContext& ctx );
+};
+
+} } // namespace ANNT::Neuro
+
+#endif // ANNT_XCONVOLUTION_LAYER_HPP
@@ -0,0 +1,107 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XDEPTHWISE_SEPARABLE_CONVOLUTION_LAYER_HPP
+#define ANNT_XDEPTHWISE_SEPARABLE_CONVOLUTION_LAYER_HPP
+
+#include "ITrainableLayer.hpp"
+#include "../../Tools/XDepthwiseConvolution.hpp"
+#include "../../Tools/XParallelAccumulator.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Implementation of depthwise separable convolution layer - each input map is first convolved with its own
+// kernel (depthwise step), then the resulting maps are combined by 1x1 convolution (pointwise step). This
+// is the same as [convolution with inputDepth groups -> 1x1 convolution] pair of layers, but needs much
+// less weights/computations than a regular convolution and keeps the intermediate maps internal.
+//
+// Weights are kept as inputDepth x kernelHeight x kernelWidth depthwise kernels, followed by kernelsCount x inputDepth
+// pointwise weights and kernelsCount biases.
+class XDepthwiseSeparableConvolutionLayer : public ITrainableLayer
+{
+private:
+    size_t      mInputWidth;
+    size_t      mInputHeight;
+    size_t      mInputDepth;
+    size_t      mOutputWidth;
+    size_t      mOutputHeight;
+    size_t      mKernelWidth;
+    size_t      mKernelHeight;
+    size_t      mKernelsCount;
+    size_t      mHorizontalStep;
+    size_t      mVerticalStep;
+    BorderMode  mBorderMode;
+
+    // Pointers to weights and biases, which are all kept together in mAllWeights
+    float_t*    mDepthwiseWeights;
+    float_t*    mPointwiseWeights;
+    float_t*    mBiases;
+
+    XDepthwiseConvolution mDepthwise;
+
+    // Per thread gradients accumulated over samples in parallel
+    XParallelAccumulator  mGradientsAccumulator;
+
+public:
+    XDepthwiseSeparableConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                                         size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                                         BorderMode borderMode = BorderMode::Valid,
+                                         size_t horizontalStep = 1, size_t verticalStep = 1 );
+
+    // Tells that we may need some extra memory for keeping depthwise step's outputs and their deltas
+    uvector_t WorkingMemSize( bool trainingMode ) const override;
+
+    // Randomizes layer's weights, clears biases
+    void Randomize( ) override;
+
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
+    // Calculates outputs for the given inputs
+    void ForwardCompute( const std::vector<fvector_t*>& inputs,
+                         std::vector<fvector_t*>& outputs,
+                         const XNetworkContext& ctx ) const override;
+
+    // Propagates error to the previous layer and calculates weights/biases gradients
+    void BackwardCompute( const std::vector<fvector_t*>& inputs,
+                          const std::vector<fvector_t*>& outputs,
+                          const std::vector<fvector_t*>& deltas,
+                          std::vector<fvector_t*>& prevDeltas,
+                          float_t* gradWeights,
+                          const XNetworkContext& ctx ) override;
+
+    // Saves layer's learnt parameters/weights
+    bool SaveLearnedParams( FILE* file ) const override;
+    // Loads layer's learnt parameters
+    bool LoadLearnedParams( FILE* file ) override;
+
+protected:
+
+    // Sets weights/biases pointers
+    void SetWeightsPointers( ) override;
+};
+
+} } // namespace ANNT::Neuro
+
+#endif // ANNT_XDEPTHWISE_SEPARABLE_CONVOLUTION_LAYER_HPP
@@ -0,0 +1,118 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XRECURRENT_LAYER_HPP
+#define ANNT_XRECURRENT_LAYER_HPP
+
+#include "ITrainableLayer.hpp"
+#include "Activations/XTanhActivation.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Implementation of simple recurent layer, which perform calculations as:
+//
+//  Internal activation:  A(t) = U * X(t) + W * H(t-1) + B
+//  Output/History:       H(t) = tanh(A(t))
+//
+// See: http://www.deeplearningbook.org/contents/rnn.html
+//
+class XRecurrentLayer : public ITrainableLayer
+{
+private:
+    XTanhActivation    mTanh;
+
+    // Pointers to specific weights/biases, which are all kept together in mAllWeights
+    float_t*    mWeightsU;
+    float_t*    mWeightsW;
+
+    float_t*    mBiasesB;
+    
+    // --------------------------------------------------------------------------------------
+    enum
+    {
+        // per batch
+        BUFFER_INDEX_STATE          = 0,
+        BUFFER_INDEX_STATE_GRAD     = 1,
+
+        // per sample
+        BUFFER_INDEX_STATE_PREV           = 2, // H(t-1)
+        BUFFER_INDEX_STATE_CURRENT        = 3, // H(t)
+        BUFFER_INDEX_STATE_DELTA_CURRENT  = 4, // state delta for the current sample
+    };
+
+public:
+
+    XRecurrentLayer( size_t inputsCount, size_t outputsCount );
+
+    // Tells that we may need some extra memory for internal state/calculations
+    uvector_t WorkingMemSize( bool /* trainingMode */ ) const override
+    {
+        uvector_t workingMemSize = uvector_t( 5, mOutputsCount * sizeof( float_t ) );
+
+        return workingMemSize;
+    }
+
+    // Randomizes layer's weights, clears biases
+    void Randomize( ) override;
+
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
+    // Calculates outputs for the given inputs
+    void ForwardCompute( const std::vector<fvector_t*>& inputs,
+                         std::vector<fvector_t*>& outputs,
+                         const XNetworkContext& ctx ) const override;
+
+    // Propagates error to the previous layer and calculates weights/biases gradients
+    void BackwardCompute( const std::vector<fvector_t*>& inputs,
+                          const std::vector<fvector_t*>& outputs,
+                          const std::vector<fvector_t*>& deltas,
+                          std::vector<fvector_t*>& prevDeltas,
+                          float_t* gradWeights,
+                          const XNetworkContext& ctx ) override;
+
+    // Weights can be kept in half precision - those are widened to float on the fly while computing outputs
+    bool HalfPrecisionSupported( ) const override
+    {
+        return true;
+    }
+
+    // Saves/loads layer's weights in the specified 16 bit precision
+    bool SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const override;
+    bool LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision ) override;
+
+    // Saves layer's learnt parameters/weights
+    bool SaveLearnedParams( FILE* file ) const override;
+    // Loads layer's learnt parameters
+    bool LoadLearnedParams( FILE* file ) override;
+
+protected:
+
+    // Sets weights/biases pointers
+    void SetWeightsPointers( ) override;
+};
+
+} } // ANNT::Neuro
+
+#endif // ANNT_XRECURRENT_LAYER_HPP
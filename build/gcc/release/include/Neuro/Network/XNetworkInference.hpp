@@ -0,0 +1,176 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XNETWORK_COMPUTATION_HPP
+#define ANNT_XNETWORK_COMPUTATION_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "XNeuralNetwork.hpp"
+#include "XNetworkContext.hpp"
+
+namespace ANNT { namespace Neuro {
+
+// Implementation of artificial neural network inference - wraps
+// everything necessary to compute network's outputs for a given inputs.
+//
+// The network is not changed by inference - all the mutable state (layers' outputs and
+// working buffers) is kept by the inference object. So a single instance of a trained
+// network can be shared by any number of inference objects (one per thread), which run
+// concurrently with no locking. A single inference object is not thread safe though.
+//
+class XNetworkInference
+{
+protected:
+    std::shared_ptr<const XNeuralNetwork> mNetwork;
+
+protected:
+    // layers' outputs are kept in memory slots shared by layers, which outputs are not needed at the same time
+    std::vector<std::vector<fvector_t>>  mComputeSlotsStorage;
+    uvector_t                            mLayersSlots;
+    uvector_t                            mSlotsSize;
+    std::vector<std::vector<fvector_t*>> mComputeOutputs;
+    std::vector<fvector_t*>              mComputeInputs;
+    std::vector<fvector_t*>              mBatchOutputs;
+
+    // inference plan - number of layers computed by every step (more than one for fused layers) and number
+    // of samples fused layers process at once, so that intermediate outputs are consumed while still in cache
+    uvector_t                            mStepsLayersCount;
+    uvector_t                            mStepsBlockSize;
+    std::vector<fvector_t*>              mBlockInputs;
+    std::vector<fvector_t*>              mBlockOutputs;
+
+    // version of network's configuration the plan was made for and if the network has recurrent layers
+    size_t                               mPlannedVersion;
+    bool                                 mIsRecurrent;
+
+    XNetworkContext                      mInferenceContext;
+
+    // per-thread inference sessions used to test classification in parallel
+    size_t                                          mTestChunkSize;
+    std::vector<std::unique_ptr<XNetworkInference>> mTestSessions;
+
+public:
+    // The passed network must be fully constructed at this point - no adding new layers
+    XNetworkInference( const std::shared_ptr<const XNeuralNetwork>& network );
+
+    // Reset working buffers for all layers
+    virtual void ResetState( )
+    {
+        mInferenceContext.ResetWorkingBuffers( );
+    }
+
+    // Reset working buffers for the specified layers
+    virtual void ResetLayersState( uvector_t layersIndexes )
+    {
+        mInferenceContext.ResetWorkingBuffers( layersIndexes );
+    }
+
+    // Computes output vector for the given input vector
+    void Compute( const fvector_t& input, fvector_t& output );
+
+    // Runs classification for the given input - returns index of the maximum
+    // element in the corresponding output vector
+    size_t Classify( const fvector_t& input );
+
+    // Computes output vectors for the given batch of input vectors, running every layer once for the entire batch.
+    // Output vectors are resized to network's outputs count (no memory allocation when reused) and
+    // are written directly by the last layer.
+    // NOTE: for recurrent networks every sample index of a batch keeps its own state; changing to a bigger
+    // batch size resets state of all samples.
+    void ComputeBatch( const std::vector<fvector_t>& inputs, std::vector<fvector_t>& outputs );
+
+    // Computes output vectors for the given batch of input vectors - same as above, but output vectors
+    // are provided by caller and must be of network's outputs count size already
+    void ComputeBatch( const std::vector<fvector_t*>& inputs, std::vector<fvector_t*>& outputs );
+
+    // Runs classification for the given batch of inputs - provides index of the maximum element
+    // in the corresponding output vector for every input
+    void ClassifyBatch( const std::vector<fvector_t>& inputs, uvector_t& classes );
+
+    // Tests classification for the provided inputs and target labels -
+    // provides number of correctly classified samples.
+    // NOTE: samples are computed in chunks by all available threads, unless the network is recurrent - samples
+    // of recurrent networks are computed one by one in order, carrying state from one sample to the next one.
+    size_t TestClassification( const std::vector<fvector_t>& inputs,
+                               const uvector_t& targetLabels );
+
+    // Runs the calibration inputs through the network and collects range of values every layer gets as its inputs
+    // (the range always includes zero) - used to quantize the network (see XNeuralNetwork::Quantize( )).
+    // Samples are computed in batches of the test chunk size. The object can be used for inference of the quantized
+    // network afterwards, since it re-allocates working buffers for quantized layers.
+    void CalibrateInputsRange( const std::vector<fvector_t>& inputs, fvector_t& inputsMin, fvector_t& inputsMax );
+
+    // Get/set number of samples, which are computed as a single batch when testing classification
+    size_t TestChunkSize( ) const
+    {
+        return mTestChunkSize;
+    }
+    void SetTestChunkSize( size_t chunkSize )
+    {
+        mTestChunkSize = ( chunkSize == 0 ) ? 1 : chunkSize;
+    }
+
+protected:
+
+    // Plans memory slots for layers' outputs and inference steps for the current configuration of the network,
+    // dropping everything allocated for the previous plan
+    void PlanInference( );
+
+    // Plans inference again if the network was changed since the last plan (see XNeuralNetwork::ConfigurationVersion( ))
+    void UpdatePlan( )
+    {
+        if ( mNetwork->ConfigurationVersion( ) != mPlannedVersion )
+        {
+            PlanInference( );
+        }
+    }
+
+    // Prepares layers' outputs and working buffers for the given batch size, allocating more only
+    // if the batch size is bigger than any used before (or the network was changed)
+    void SetBatchSize( size_t batchSize );
+
+    // Number of chunks the specified number of samples is split into when testing classification
+    size_t TestChunksCount( size_t samplesCount ) const
+    {
+        return ( samplesCount + mTestChunkSize - 1 ) / mTestChunkSize;
+    }
+
+    // Computes chunks of samples in parallel using per-thread inference sessions. The test function is called for
+    // every chunk and gets its index, index of its first sample and outputs computed for samples of the chunk.
+    // Recurrent networks are computed sequentially by this object, calling the test function for every sample.
+    void RunParallelTest( size_t samplesCount,
+                          const std::function<fvector_t*( size_t )>& getInput,
+                          const std::function<void( size_t, size_t, const std::vector<fvector_t*>& )>& testChunk );
+
+    // Computes outputs of all layers for the inputs set in mComputeInputs
+    void DoInference( );
+
+    // Computes a step of fused layers - convolution/fully connected layer followed by activation and pooling,
+    // which are applied to blocks of samples right after the first layer computes them
+    void DoFusedInference( size_t firstLayer, size_t layersCount, size_t blockSize );
+};
+
+} } // namespace ANNT::Neuro
+
+#endif // ANNT_XNETWORK_COMPUTATION_HPP
@@ -0,0 +1,250 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XNETWORK_TRAINING_HPP
+#define ANNT_XNETWORK_TRAINING_HPP
+
+#include <memory>
+#include <vector>
+
+#include "XNetworkInference.hpp"
+#include "XParameterArena.hpp"
+#include "../Optimizers/INetworkOptimizer.hpp"
+#include "../CostFunctions/ICostFunction.hpp"
+#include "../../Tools/XHalfWeights.hpp"
+
+namespace ANNT { namespace Neuro { namespace Training {
+
+// Implementation of artificial neural network training with
+// error back propagation algorithm - wraps memory buffers and
+// infrastructure required for training a network: run forward
+// pass, calculate error, propagate it backward through the
+// network calculating gradients of weights/biases and applying
+// them.
+//
+class XNetworkTraining : public XNetworkInference
+{
+private:
+    // Output stages, which are recognized as combination of the last layer and cost function. Those
+    // get error gradient for the last layer's input directly, skipping its backward pass.
+    enum class OutputStage
+    {
+        Generic,
+        SoftMaxCrossEntropy,            // XSoftMaxActivation + XCrossEntropyCost, gradient = output - target
+        LogSoftMaxNegativeLogLikelihood // XLogSoftMaxActivation + XNegativeLogLikelihoodCost, gradient = exp(output) - target
+    };
+
+private:
+    std::shared_ptr<XNeuralNetwork>      mTrainedNetwork;   // same as mNetwork, but allowed to change layers
+    std::shared_ptr<INetworkOptimizer >  mOptimizer;
+    std::shared_ptr<ICostFunction>       mCostFunction;
+    bool                                 mAverageWeightGradients;
+    OutputStage                          mOutputStage;
+
+private:
+    // storage and pointers for outputs computed during training
+    std::vector<std::vector<fvector_t>>  mTrainOutputsStorage;
+    std::vector<std::vector<fvector_t*>> mTrainOutputs;
+
+    // precision of the outputs kept for backward pass; when reduced, outputs of layers are kept converted and only
+    // those used by the layer being computed are widened into float buffers, which layers owning storage take in turns
+    WeightsPrecision                     mStoredOutputsPrecision;
+    uvector_t                            mOutputsOwners;
+    uvector_t                            mOutputsBuffersIndexes;
+    std::vector<std::vector<XHalfWeights>> mConvertedOutputs;
+    std::vector<fvector_t>               mOutputsBuffers[2];
+
+    // storade and pointers to compute deltas for each layer
+    std::vector<std::vector<fvector_t>>  mDeltasStorage;
+    std::vector<std::vector<fvector_t*>> mDeltas;
+
+    // storage and pointers "input deltas"
+    // no needed, just to make calculations consistent
+    std::vector<fvector_t>               mInputDeltasStorage;
+    std::vector<fvector_t*>              mInputDeltas;
+
+    // vectors used to assemble pointers to training samples (input/outputs)
+    std::vector<fvector_t*>              mTrainInputs;
+    std::vector<fvector_t*>              mTargetOuputs;
+
+    // cost values of individual samples in a batch
+    fvector_t                            mSampleCosts;
+
+    // weights/biases gradients for all layers
+    std::vector<fvector_t>               mGradWeights;
+
+    // layer index and offset of parameters' chunks, which are updated in parallel
+    std::vector<std::pair<size_t, size_t>> mWeightsUpdateChunks;
+
+    // vectors with parameter variables for optimizer
+    std::vector<std::vector<fvector_t>>  mOptimizerParameterVariables;
+
+    // vectors with layer variables for optimizer
+    std::vector<fvector_t>               mOptimizerLayerVariables;
+
+    // arena keeping all weights, gradients and optimizer's variables together (replaces the above per layer vectors)
+    std::unique_ptr<XParameterArena>     mParameterArena;
+
+    // layers' working buffers and context for training
+    XNetworkContext                      mTrainingContext;
+
+public:
+
+    XNetworkTraining( const std::shared_ptr<XNeuralNetwork>& network,
+                      const std::shared_ptr<INetworkOptimizer>& optimizer,
+                      const std::shared_ptr<ICostFunction>& costFunction );
+
+    // Provides access to the ANN
+    std::shared_ptr<XNeuralNetwork> Network( ) const
+    {
+        return mTrainedNetwork;
+    }
+
+    // Provides access to the weights/biases optimizer
+    std::shared_ptr<INetworkOptimizer> Optimizer( ) const
+    {
+        return mOptimizer;
+    }
+
+    // Provides access to the cost function used for error calculation
+    std::shared_ptr<ICostFunction> CostFunction( ) const
+    {
+        return mCostFunction;
+    }
+
+    // Average or not weights/biases gradients when running in batch mode
+    bool AverageWeightGradients( ) const
+    {
+        return mAverageWeightGradients;
+    }
+    void SetAverageWeightGradients( bool average )
+    {
+        mAverageWeightGradients = average;
+    }
+
+    // Keep all weights/biases, their gradients and optimizer's variables in a single parameters' arena,
+    // so weights' update is done as one pass over parameters of all layers. Weights are moved back into
+    // layers when the arena gets disabled (or training object is destroyed). Returns false if the arena
+    // could not be enabled, since some of the layers can not keep weights in external storage.
+    bool UseParameterArena( ) const
+    {
+        return static_cast<bool>( mParameterArena );
+    }
+    bool SetUseParameterArena( bool useArena );
+
+    // Provides access to the parameters' arena (null if not used)
+    XParameterArena* ParameterArena( ) const
+    {
+        return mParameterArena.get( );
+    }
+
+    // Get/set precision of layers' outputs kept for backward pass. Reduced precision (half or bfloat16) takes half
+    // of the memory - forward pass is still computed in float, but outputs are converted once the next layer has
+    // computed its outputs and are widened back when backward pass gets to them.
+    WeightsPrecision StoredOutputsPrecision( ) const
+    {
+        return mStoredOutputsPrecision;
+    }
+    void SetStoredOutputsPrecision( WeightsPrecision precision );
+
+    // Get/set length of training sequences used for recurrent networks
+    size_t TrainingSequenceLength( ) const
+    {
+        return mTrainingContext.TrainingSequenceLength( );
+    }
+    void SetTrainingSequenceLength( size_t sequenceLength )
+    {
+        mTrainingContext.SetTrainingSequenceLength( sequenceLength );
+    }
+
+    // Reset working buffers for all layers
+    void ResetState( ) override
+    {
+        XNetworkInference::ResetState( );
+        mTrainingContext.ResetWorkingBuffers( );
+    }
+    // Reset working buffers for the specified layers
+    void ResetLayersState( uvector_t layersIndexes ) override
+    {
+        XNetworkInference::ResetLayersState( layersIndexes );
+        mTrainingContext.ResetWorkingBuffers( layersIndexes );
+    }
+
+    // Trains single input/output sample
+    float_t TrainSample( const fvector_t& input, const fvector_t& targetOutput );
+
+    // Trains single batch of prepared samples (as vectors)
+    float_t TrainBatch( const std::vector<fvector_t>& inputs,
+                        const std::vector<fvector_t>& targetOutputs );
+
+    // Trains single batch of prepared samples (as pointers to vectors)
+    float_t TrainBatch( const std::vector<fvector_t*>& inputs,
+                        const std::vector<fvector_t*>& targetOutputs );
+
+    // Trains single epoch using batches of the specified size (samples are provided as vectors)
+    float_t TrainEpoch( const std::vector<fvector_t>& inputs, 
+                        const std::vector<fvector_t>& targetOutputs,
+                        size_t batchSize,
+                        bool randomPickIntoBatch = false );
+
+    // Trains single epoch using batches of the specified size (samples are provided as pointers to vectors)
+    float_t TrainEpoch( const std::vector<fvector_t*>& inputs, 
+                        const std::vector<fvector_t*>& targetOutputs,
+                        size_t batchSize,
+                        bool randomPickIntoBatch = false );
+
+    // Tests sample - calculates real output and provides error cost
+    float_t TestSample( const fvector_t& input,
+                        const fvector_t& targetOutput,
+                        fvector_t& output );
+
+    // Tests classification for the provided inputs and target labels -
+    // provides number of correctly classified samples and average cost (target outputs are used)
+    size_t TestClassification( const std::vector<fvector_t>& inputs,
+                               const uvector_t& targetLabels,
+                               const std::vector<fvector_t>& targetOutputs,
+                               float_t* pAvgCost );
+    size_t TestClassification( const std::vector<fvector_t*>& inputs,
+                               const uvector_t& targetLabels,
+                               const std::vector<fvector_t*>& targetOutputs,
+                               float_t* pAvgCost );
+
+private:
+
+    float_t RunTraining( );
+    void    DoForwardCompute( );
+    float_t CalculateError( );
+    void    DoBackwardCompute( );
+    void    UpdateWeights( );
+    float_t* LayerGradients( size_t layerIndex );
+    void    AllocateTrainVectors( size_t samplesCount );
+    void    AllocateTrainOutputs( size_t samplesCount );
+    void    AcquireOutputsBuffers( size_t layerIndex, bool widen );
+    void    ReleaseOutputsBuffers( size_t layerIndex, bool convert );
+    size_t  DoTestClassification( size_t samplesCount,
+                                  const std::function<fvector_t*( size_t )>& getInput,
+                                  const std::function<const fvector_t&( size_t )>& getTargetOutput,
+                                  const uvector_t& targetLabels, float_t* pAvgCost );
+};
+
+} } } // namespace ANNT::Neuro::Training
+
+#endif // ANNT_XNETWORK_TRAINING_HPP
@@ -0,0 +1,142 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XPARAMETER_ARENA_HPP
+#define ANNT_XPARAMETER_ARENA_HPP
+
+#include <memory>
+#include <vector>
+
+#include "XNeuralNetwork.hpp"
+#include "../Optimizers/INetworkOptimizer.hpp"
+
+namespace ANNT { namespace Neuro { namespace Training {
+
+// Flat storage of all trainable parameters of a network - weights/biases of all layers are kept
+// in a single aligned buffer, which layers use as their weights' storage (see ITrainableLayer::AttachWeightsStorage).
+// Gradients and optimizer's per parameter variables are kept the same way with same layout, so that
+// gradients' averaging, applying updates, etc. can be done in one pass over all layers' parameters.
+// Each layer's part is padded to keep it aligned - padding is kept zero and so is never changed by optimizers.
+//
+class XParameterArena
+{
+private:
+    std::shared_ptr<XNeuralNetwork> mNetwork;
+
+    uvector_t               mLayersOffsets;
+    uvector_t               mLayersWeightsCount;
+
+    fvector_t               mWeights;
+    fvector_t               mGradients;
+    std::vector<fvector_t>  mParameterVariables;
+    fvector_t               mLayerVariables;
+    bool                    mAttached;
+
+private:
+    XParameterArena( const XParameterArena& ) = delete;
+    XParameterArena& operator= ( const XParameterArena& ) = delete;
+
+public:
+    // Creates parameters' arena for the specified network and moves weights of its trainable layers there
+    // (if any of the layers can not use arena's storage, none of them are moved - see IsAttached( ))
+    XParameterArena( const std::shared_ptr<XNeuralNetwork>& network,
+                     size_t parameterVariablesCount = 0,
+                     size_t layerVariablesCount     = 0 );
+    // Moves weights back into layers' own storage
+    ~XParameterArena( );
+
+    // Checks if layers' weights were moved into the arena - the arena must not be used otherwise
+    bool IsAttached( ) const
+    {
+        return mAttached;
+    }
+
+    // Total number of parameters kept in the arena (including padding)
+    size_t ParametersCount( ) const
+    {
+        return mWeights.size( );
+    }
+
+    // Offset/count of the specified layer's parameters within arena (count is 0 for non-trainable layers)
+    size_t LayerOffset( size_t layerIndex ) const
+    {
+        return mLayersOffsets[layerIndex];
+    }
+    size_t LayerWeightsCount( size_t layerIndex ) const
+    {
+        return mLayersWeightsCount[layerIndex];
+    }
+
+    // Weights/biases of all layers
+    const fvector_t& Weights( ) const
+    {
+        return mWeights;
+    }
+
+    // Gradients of all layers' weights/biases
+    fvector_t& Gradients( )
+    {
+        return mGradients;
+    }
+    float_t* LayerGradients( size_t layerIndex )
+    {
+        return mGradients.data( ) + mLayersOffsets[layerIndex];
+    }
+
+    // Optimizer's variables kept for every parameter
+    std::vector<fvector_t>& ParameterVariables( )
+    {
+        return mParameterVariables;
+    }
+    float_t* LayerParameterVariables( size_t variableIndex, size_t layerIndex )
+    {
+        return mParameterVariables[variableIndex].data( ) + mLayersOffsets[layerIndex];
+    }
+
+    // Optimizer's variables kept for the entire arena (all layers get updated together)
+    fvector_t& LayerVariables( )
+    {
+        return mLayerVariables;
+    }
+
+    // Updates all weights from their gradients (multiplied by gradScale) using the specified optimizer, resets
+    // gradients and notifies layers about the change
+    void UpdateWeights( INetworkOptimizer& optimizer, float_t gradScale );
+
+    // Sets all gradients to zero
+    void ZeroGradients( );
+
+    // Copies all weights into the specified snapshot or restores them from it
+    void SaveSnapshot( fvector_t& snapshot ) const;
+    bool RestoreSnapshot( const fvector_t& snapshot );
+
+private:
+
+    // Notifies trainable layers their weights were changed
+    void NotifyWeightsChanged( );
+
+    // Moves weights of the specified number of first layers back into their own storage
+    void DetachLayers( size_t layersCount );
+};
+
+} } } // namespace ANNT::Neuro::Training
+
+#endif // ANNT_XPARAMETER_ARENA_HPP
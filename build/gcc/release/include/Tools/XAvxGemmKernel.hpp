@@ -0,0 +1,131 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XAVX_GEMM_KERNEL_HPP
+#define ANNT_XAVX_GEMM_KERNEL_HPP
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#elif __GNUC__
+    #include <x86intrin.h>
+#endif
+
+#include "XGemmKernels.hpp"
+
+// Body of AVX GEMM micro kernels, which is shared by translation units compiled with different
+// instruction sets enabled. Everything is kept in anonymous namespace, so each of those gets own copy.
+
+namespace ANNT { namespace {
+
+// Wrappers of AVX intrinsics for single/double precision numbers.
+// MAdd is provided by the including translation unit, since it differs with/without FMA.
+template <typename T> struct AvxGemmOps;
+
+template <> struct AvxGemmOps<float>
+{
+    typedef __m256 Vector;
+
+    static inline Vector Zero( )                            { return _mm256_setzero_ps( ); }
+    static inline Vector Load( const float* src )           { return _mm256_load_ps( src ); }
+    static inline Vector LoadU( const float* src )          { return _mm256_loadu_ps( src ); }
+    static inline void   StoreU( float* dst, Vector value ) { _mm256_storeu_ps( dst, value ); }
+    static inline Vector Set1( float value )                { return _mm256_set1_ps( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )        { return _mm256_add_ps( v1, v2 ); }
+};
+
+template <> struct AvxGemmOps<double>
+{
+    typedef __m256d Vector;
+
+    static inline Vector Zero( )                             { return _mm256_setzero_pd( ); }
+    static inline Vector Load( const double* src )           { return _mm256_load_pd( src ); }
+    static inline Vector LoadU( const double* src )          { return _mm256_loadu_pd( src ); }
+    static inline void   StoreU( double* dst, Vector value ) { _mm256_storeu_pd( dst, value ); }
+    static inline Vector Set1( double value )                { return _mm256_set1_pd( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )         { return _mm256_add_pd( v1, v2 ); }
+};
+
+// 6 x ( 2 * AVX register size ) micro kernel - keeps 12 accumulators in registers, while
+// loading two vectors of B panel and broadcasting single value of A panel at a time
+template <typename T, typename MAdd> static inline void AvxGemmMicroKernel( size_t kc, const T* a, const T* b, T* const* c )
+{
+    typedef AvxGemmOps<T>           Ops;
+    typedef typename Ops::Vector    Vector;
+
+    const size_t step = XGemmTile<T>::Cols / 2;
+
+    static_assert( XGemmTile<T>::Rows == 6, "Micro kernel is written for 6 rows tile" );
+
+    Vector c00 = Ops::Zero( ), c01 = Ops::Zero( );
+    Vector c10 = Ops::Zero( ), c11 = Ops::Zero( );
+    Vector c20 = Ops::Zero( ), c21 = Ops::Zero( );
+    Vector c30 = Ops::Zero( ), c31 = Ops::Zero( );
+    Vector c40 = Ops::Zero( ), c41 = Ops::Zero( );
+    Vector c50 = Ops::Zero( ), c51 = Ops::Zero( );
+
+    for ( size_t p = 0; p < kc; p++, a += 6, b += 2 * step )
+    {
+        Vector b0 = Ops::Load( b );
+        Vector b1 = Ops::Load( b + step );
+        Vector av;
+
+        av  = Ops::Set1( a[0] );
+        c00 = MAdd::Do( av, b0, c00 );
+        c01 = MAdd::Do( av, b1, c01 );
+
+        av  = Ops::Set1( a[1] );
+        c10 = MAdd::Do( av, b0, c10 );
+        c11 = MAdd::Do( av, b1, c11 );
+
+        av  = Ops::Set1( a[2] );
+        c20 = MAdd::Do( av, b0, c20 );
+        c21 = MAdd::Do( av, b1, c21 );
+
+        av  = Ops::Set1( a[3] );
+        c30 = MAdd::Do( av, b0, c30 );
+        c31 = MAdd::Do( av, b1, c31 );
+
+        av  = Ops::Set1( a[4] );
+        c40 = MAdd::Do( av, b0, c40 );
+        c41 = MAdd::Do( av, b1, c41 );
+
+        av  = Ops::Set1( a[5] );
+        c50 = MAdd::Do( av, b0, c50 );
+        c51 = MAdd::Do( av, b1, c51 );
+    }
+
+    Ops::StoreU( c[0],        Ops::Add( Ops::LoadU( c[0] ),        c00 ) );
+    Ops::StoreU( c[0] + step, Ops::Add( Ops::LoadU( c[0] + step ), c01 ) );
+    Ops::StoreU( c[1],        Ops::Add( Ops::LoadU( c[1] ),        c10 ) );
+    Ops::StoreU( c[1] + step, Ops::Add( Ops::LoadU( c[1] + step ), c11 ) );
+    Ops::StoreU( c[2],        Ops::Add( Ops::LoadU( c[2] ),        c20 ) );
+    Ops::StoreU( c[2] + step, Ops::Add( Ops::LoadU( c[2] + step ), c21 ) );
+    Ops::StoreU( c[3],        Ops::Add( Ops::LoadU( c[3] ),        c30 ) );
+    Ops::StoreU( c[3] + step, Ops::Add( Ops::LoadU( c[3] + step ), c31 ) );
+    Ops::StoreU( c[4],        Ops::Add( Ops::LoadU( c[4] ),        c40 ) );
+    Ops::StoreU( c[4] + step, Ops::Add( Ops::LoadU( c[4] + step ), c41 ) );
+    Ops::StoreU( c[5],        Ops::Add( Ops::LoadU( c[5] ),        c50 ) );
+    Ops::StoreU( c[5] + step, Ops::Add( Ops::LoadU( c[5] + step ), c51 ) );
+}
+
+} } // namespace ANNT::<anonymous>
+
+#endif // ANNT_XAVX_GEMM_KERNEL_HPP
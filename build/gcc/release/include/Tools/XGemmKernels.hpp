@@ -0,0 +1,58 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XGEMM_KERNELS_HPP
+#define ANNT_XGEMM_KERNELS_HPP
+
+#include <cstddef>
+
+namespace ANNT {
+
+// Size of the C tile computed by GEMM micro kernels
+template <typename T> struct XGemmTile;
+
+template <> struct XGemmTile<float>
+{
+    static const size_t Rows = 6;
+    static const size_t Cols = 16;
+};
+
+template <> struct XGemmTile<double>
+{
+    static const size_t Rows = 6;
+    static const size_t Cols = 8;
+};
+
+// GEMM micro kernels. Multiply packed panel of A (kc x Rows, column after column) by packed panel
+// of B (kc x Cols, row after row) and add the result to the C tile given by its row pointers.
+// Packed panels must be 32 bytes aligned.
+
+// AVX implementation
+void AvxGemmKernel( size_t kc, const float*  a, const float*  b, float*  const* c );
+void AvxGemmKernel( size_t kc, const double* a, const double* b, double* const* c );
+
+// AVX + FMA implementation
+void FmaGemmKernel( size_t kc, const float*  a, const float*  b, float*  const* c );
+void FmaGemmKernel( size_t kc, const double* a, const double* b, double* const* c );
+
+} // namespace ANNT
+
+#endif // ANNT_XGEMM_KERNELS_HPP
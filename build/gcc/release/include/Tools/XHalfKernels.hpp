@@ -0,0 +1,45 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XHALF_KERNELS_HPP
+#define ANNT_XHALF_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ANNT {
+
+// Kernels converting float values to 16 bit floating point weights (see XHalfWeights) and back, and computing
+// dot products of those weights with float vectors. Products are accumulated in float.
+
+// F16C/FMA implementations for half precision weights
+void F16cFloatToHalf( const float* values, uint16_t* narrowed, size_t count );
+void F16cHalfToFloat( const uint16_t* values, float* widened, size_t count );
+float F16cHalfDot( const uint16_t* values, const float* vector, size_t count );
+
+// AVX2/FMA implementations for bfloat16 weights
+void Avx2FloatToBFloat16( const float* values, uint16_t* narrowed, size_t count );
+void Avx2BFloat16ToFloat( const uint16_t* values, float* widened, size_t count );
+float Avx2BFloat16Dot( const uint16_t* values, const float* vector, size_t count );
+
+} // namespace ANNT
+
+#endif // ANNT_XHALF_KERNELS_HPP
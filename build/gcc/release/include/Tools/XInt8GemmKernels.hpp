@@ -0,0 +1,43 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XINT8_GEMM_KERNELS_HPP
+#define ANNT_XINT8_GEMM_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ANNT {
+
+// INT8 GEMM micro kernels. Compute 4 x 16 tile of C from 4 rows of A (unsigned 7 bit values) and a panel of B
+// (signed 8 bit values, see XInt8Gemm::Pack( )) - the tile is stored into 16 values of each C row. Number of
+// values in rows (k) must be multiple of 4. Keeping A values below 128 guarantees sums of pairs of products fit
+// into 16 bit integers, so maddubs instructions can be used without saturation.
+
+// SSE4.1 implementation
+void Sse41Int8GemmKernel( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c );
+
+// AVX2 implementation
+void Avx2Int8GemmKernel( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c );
+
+} // namespace ANNT
+
+#endif // ANNT_XINT8_GEMM_KERNELS_HPP
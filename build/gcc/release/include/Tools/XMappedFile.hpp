@@ -0,0 +1,77 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XMAPPED_FILE_HPP
+#define ANNT_XMAPPED_FILE_HPP
+
+#include <stdint.h>
+#include <string>
+
+namespace ANNT {
+
+// Read-only memory mapping of a file. Pages of the mapping are shared by all processes
+// mapping the same file, so it is only loaded into memory once (and only when accessed).
+//
+class XMappedFile
+{
+private:
+    const uint8_t* mData;
+    size_t         mSize;
+
+    #ifdef _WIN32
+    void*          mFileHandle;
+    void*          mMappingHandle;
+    #endif
+
+private:
+    XMappedFile( const XMappedFile& ) = delete;
+    XMappedFile& operator= ( const XMappedFile& ) = delete;
+
+public:
+    XMappedFile( );
+    ~XMappedFile( );
+
+    // Maps the specified file into memory (closes previous mapping, if any)
+    bool Open( const std::string& fileName );
+
+    // Unmaps the file
+    void Close( );
+
+    // Checks if a file is mapped
+    bool IsOpen( ) const
+    {
+        return ( mData != nullptr );
+    }
+
+    // Start and size of the mapped memory
+    const uint8_t* Data( ) const
+    {
+        return mData;
+    }
+    size_t Size( ) const
+    {
+        return mSize;
+    }
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XMAPPED_FILE_HPP
@@ -0,0 +1,117 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XQUANTIZED_WEIGHTS_HPP
+#define ANNT_XQUANTIZED_WEIGHTS_HPP
+
+#include <stdio.h>
+#include <cstdint>
+
+#include "../Types/Types.hpp"
+
+namespace ANNT {
+
+// Weights and biases of a layer quantized to 8 bit integers for inference - every output (neuron/kernel) has
+// its own row of weights with individual scale. Inputs are quantized to unsigned 7 bit values using the scale and
+// zero point calibrated for the range of layer's inputs, so the products can be computed by XInt8Gemm.
+//
+// output[j] = inputScale * weightScale[j] * ( sum( qinput[i] * qweight[j][i] ) - zeroPoint * sum( qweight[j][i] ) ) + bias[j]
+class XQuantizedWeights
+{
+private:
+    size_t    mRowsCount;
+    size_t    mRowSize;
+    size_t    mPaddedRowSize;
+    float_t   mInputScale;
+    uint8_t   mInputZeroPoint;
+
+    std::vector<int8_t>                                mWeights;
+    std::vector<int8_t, XAlignedAllocator<int8_t, 32>> mPackedWeights;
+    std::vector<int32_t>                               mZeroPointOffsets;
+    fvector_t                                          mWeightScales;
+    fvector_t                                          mOutputScales;
+    fvector_t                                          mBiases;
+
+public:
+    XQuantizedWeights( );
+
+    // Checks if there are no quantized weights
+    bool IsEmpty( ) const
+    {
+        return mWeights.empty( );
+    }
+
+    // Releases quantized weights
+    void Clear( );
+
+    // Number of rows (outputs) and number of weights in a row (inputs)
+    size_t RowsCount( ) const
+    {
+        return mRowsCount;
+    }
+    size_t RowSize( ) const
+    {
+        return mRowSize;
+    }
+
+    // Size of quantized input rows expected by Multiply( ) - row size padded for SIMD kernels (padded values don't matter)
+    size_t PaddedRowSize( ) const
+    {
+        return mPaddedRowSize;
+    }
+
+    // Zero point of quantized inputs, i.e. quantized value of input's zero
+    uint8_t InputZeroPoint( ) const
+    {
+        return mInputZeroPoint;
+    }
+
+    // Quantizes rows of weights (rowsCount x rowSize matrix) and biases (rowsCount values) for inputs in the specified range
+    void Quantize( const float_t* weights, const float_t* biases, size_t rowsCount, size_t rowSize,
+                   float_t inputMin, float_t inputMax );
+
+    // Quantizes input values into unsigned 7 bit values
+    void QuantizeInputs( const float_t* inputs, uint8_t* quantized, size_t count ) const;
+
+    // Multiplies rows of quantized inputs (padded row size) by rows of quantized weights, giving RowsCount( ) products for every input row
+    void Multiply( size_t inputRows, const uint8_t* const* inputs, int32_t* const* products, bool parallel ) const;
+    void Multiply( size_t inputRows, const uint8_t* inputs, int32_t* products, bool parallel ) const;
+
+    // Converts products of quantized inputs and weights into outputs (biases added), which are outputsStride apart
+    void Dequantize( const int32_t* products, float_t* outputs, size_t outputsStride ) const;
+
+    // Converts products of the specified number of input rows into outputs, which are stored by rows of weights,
+    // i.e. outputs[j * inputRows + i] is output j for input row i (output maps of convolution)
+    void DequantizeTransposed( const int32_t* products, size_t inputRows, float_t* outputs ) const;
+
+    // Saves quantized weights
+    bool Save( FILE* file ) const;
+    // Loads quantized weights, which must be of the specified size
+    bool Load( FILE* file, size_t rowsCount, size_t rowSize );
+
+private:
+    // Calculates padded row size, zero point offsets and output scales for the current weights, packs them for multiplication
+    void PrepareWeights( );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XQUANTIZED_WEIGHTS_HPP
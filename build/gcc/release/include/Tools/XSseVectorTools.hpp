@@ -0,0 +1,134 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XSSE_VECTOR_TOOLS_HPP
+#define ANNT_XSSE_VECTOR_TOOLS_HPP
+
+#include "IVectorTools.hpp"
+
+namespace ANNT {
+
+// Implementation of common vector routines using SSE/SSE2 instructions
+class XSseVectorTools : public IVectorTools
+{
+public:
+    // Check if the implementation of vector tools is available on the current system
+    bool IsAvailable( ) const override;
+
+    // Add two vectors: dst[i] += src[i]
+    void Add( const float*  src, float*  dst, size_t size ) const override;
+    void Add( const double* src, double* dst, size_t size ) const override;
+
+    // Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+    void Mul( const float*  src, float*  dst, size_t size ) const override;
+    void Mul( const double* src, double* dst, size_t size ) const override;
+
+    // Dot product of two vectors: sum( vec1[i] * vec2[i] )
+    float  Dot( const float*  vec1, const float*  vec2, size_t size ) const override;
+    double Dot( const double* vec1, const double* vec2, size_t size ) const override;
+
+    // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+    void Max( const float*  src, float  alpha, float*  dst, size_t size ) const override;
+    void Max( const double* src, double alpha, double* dst, size_t size ) const override;
+
+    // Scales vector and adds it to another one: dst[i] += alpha * src[i]
+    void Axpy( const float*  src, float  alpha, float*  dst, size_t size ) const override;
+    void Axpy( const double* src, double alpha, double* dst, size_t size ) const override;
+
+    // Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+    void Scale( const float*  src, float  alpha, float  beta, float*  dst, size_t size ) const override;
+    void Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const override;
+
+    // Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+    void ScaledAdd( const float*  src, float  alpha, float  beta, float*  dst, size_t size ) const override;
+    void ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const override;
+
+    // Element wise multiply-add: dst[i] += src1[i] * src2[i]
+    void MulAdd( const float*  src1, const float*  src2, float*  dst, size_t size ) const override;
+    void MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const override;
+
+    // Sum of vector's elements: sum( src[i] )
+    float  Sum( const float*  src, size_t size ) const override;
+    double Sum( const double* src, size_t size ) const override;
+
+    // Sum of squared vector's elements: sum( src[i] * src[i] )
+    float  SumOfSquares( const float*  src, size_t size ) const override;
+    double SumOfSquares( const double* src, size_t size ) const override;
+
+    // Minimum of vector's elements (0 for empty vector)
+    float  MinValue( const float*  src, size_t size ) const override;
+    double MinValue( const double* src, size_t size ) const override;
+
+    // Maximum of vector's elements (0 for empty vector)
+    float  MaxValue( const float*  src, size_t size ) const override;
+    double MaxValue( const double* src, size_t size ) const override;
+
+    // Index of the first maximum element of the vector (0 for empty vector)
+    size_t ArgMax( const float*  src, size_t size ) const override;
+    size_t ArgMax( const double* src, size_t size ) const override;
+
+    // Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+    void Gather( const float*  src, const size_t* indexes, float*  dst, size_t size ) const override;
+    void Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const override;
+
+    // Exponent of vector's elements: dst[i] = exp( src[i] )
+    void Exp( const float*  src, float*  dst, size_t size ) const override;
+    void Exp( const double* src, double* dst, size_t size ) const override;
+
+    // Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+    void Sigmoid( const float*  src, float*  dst, size_t size ) const override;
+    void Sigmoid( const double* src, double* dst, size_t size ) const override;
+
+    // Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+    void Tanh( const float*  src, float*  dst, size_t size ) const override;
+    void Tanh( const double* src, double* dst, size_t size ) const override;
+
+    // Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+    void SigmoidDerivative( const float*  y, const float*  delta, float*  dst, size_t size ) const override;
+    void SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const override;
+
+    // Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+    void TanhDerivative( const float*  y, const float*  delta, float*  dst, size_t size ) const override;
+    void TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const override;
+
+    // Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+    void SgdStep( float*  weights, float*  gradients, float  gradScale, float  learningRate, size_t size ) const override;
+    void SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const override;
+
+    // Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+    //   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+    void MomentumStep( float*  weights, float*  gradients, float*  velocity, float  gradScale, float  momentum, float  alpha, float  beta, float  gamma, size_t size ) const override;
+    void MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const override;
+
+    // Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+    //   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+    void AdaptiveStep( float*  weights, float*  gradients, float*  sqSum, float  gradScale, float  decay, float  sqFactor, float  learningRate, float  epsilon, size_t size ) const override;
+    void AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const override;
+
+    // Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+    //   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+    void AdamStep( float*  weights, float*  gradients, float*  mt, float*  vt, float  gradScale, float  b1, float  b2, float  mtScale, float  vtScale, float  learningRate, float  epsilon, size_t size ) const override;
+    void AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const override;
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XSSE_VECTOR_TOOLS_HPP
@@ -0,0 +1,195 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XVECTORIZE_HPP
+#define ANNT_XVECTORIZE_HPP
+
+#include "IVectorTools.hpp"
+
+namespace ANNT {
+
+class XVectorize
+{
+private:
+    XVectorize( );
+
+public:
+    // Add two vectors: dst[i] += src[i]
+    template <typename T> static inline void Add( const T* src, T* dst, size_t size )
+    {
+        mVectorTools->Add( src, dst, size );
+    }
+
+    // Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+    template <typename T> static inline void Mul( const T* src, T* dst, size_t size )
+    {
+        mVectorTools->Mul( src, dst, size );
+    }
+
+    // Dot product of two vectors: sum( vec1[i] * vec2[i] )
+    template <typename T> static inline T Dot( const T* vec1, const T* vec2, size_t size )
+    {
+        return mVectorTools->Dot( vec1, vec2, size );
+    }
+
+    // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+    template <typename T> static inline void Max( const T* src, T alpha, T* dst, size_t size )
+    {
+        mVectorTools->Max( src, alpha, dst, size );
+    }
+
+    // Scales vector and adds it to another one: dst[i] += alpha * src[i]
+    template <typename T> static inline void Axpy( const T* src, T alpha, T* dst, size_t size )
+    {
+        mVectorTools->Axpy( src, alpha, dst, size );
+    }
+
+    // Scales vector's elements: dst[i] = alpha * src[i]
+    template <typename T> static inline void Scale( const T* src, T alpha, T* dst, size_t size )
+    {
+        mVectorTools->Scale( src, alpha, T( 0 ), dst, size );
+    }
+
+    // Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+    template <typename T> static inline void Scale( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        mVectorTools->Scale( src, alpha, beta, dst, size );
+    }
+
+    // Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+    template <typename T> static inline void ScaledAdd( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        mVectorTools->ScaledAdd( src, alpha, beta, dst, size );
+    }
+
+    // Element wise multiply-add: dst[i] += src1[i] * src2[i]
+    template <typename T> static inline void MulAdd( const T* src1, const T* src2, T* dst, size_t size )
+    {
+        mVectorTools->MulAdd( src1, src2, dst, size );
+    }
+
+    // Sum of vector's elements: sum( src[i] )
+    template <typename T> static inline T Sum( const T* src, size_t size )
+    {
+        return mVectorTools->Sum( src, size );
+    }
+
+    // Mean of vector's elements (0 for empty vector)
+    template <typename T> static inline T Mean( const T* src, size_t size )
+    {
+        return ( size == 0 ) ? T( 0 ) : mVectorTools->Sum( src, size ) / size;
+    }
+
+    // Sum of squared vector's elements: sum( src[i] * src[i] )
+    template <typename T> static inline T SumOfSquares( const T* src, size_t size )
+    {
+        return mVectorTools->SumOfSquares( src, size );
+    }
+
+    // Minimum of vector's elements (0 for empty vector)
+    template <typename T> static inline T MinValue( const T* src, size_t size )
+    {
+        return mVectorTools->MinValue( src, size );
+    }
+
+    // Maximum of vector's elements (0 for empty vector)
+    template <typename T> static inline T MaxValue( const T* src, size_t size )
+    {
+        return mVectorTools->MaxValue( src, size );
+    }
+
+    // Index of the first maximum element of the vector (0 for empty vector)
+    template <typename T> static inline size_t ArgMax( const T* src, size_t size )
+    {
+        return mVectorTools->ArgMax( src, size );
+    }
+
+    // Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+    template <typename T> static inline void Gather( const T* src, const size_t* indexes, T* dst, size_t size )
+    {
+        mVectorTools->Gather( src, indexes, dst, size );
+    }
+
+    // Exponent of vector's elements: dst[i] = exp( src[i] )
+    template <typename T> static inline void Exp( const T* src, T* dst, size_t size )
+    {
+        mVectorTools->Exp( src, dst, size );
+    }
+
+    // Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+    template <typename T> static inline void Sigmoid( const T* src, T* dst, size_t size )
+    {
+        mVectorTools->Sigmoid( src, dst, size );
+    }
+
+    // Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+    template <typename T> static inline void Tanh( const T* src, T* dst, size_t size )
+    {
+        mVectorTools->Tanh( src, dst, size );
+    }
+
+    // Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+    template <typename T> static inline void SigmoidDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        mVectorTools->SigmoidDerivative( y, delta, dst, size );
+    }
+
+    // Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+    template <typename T> static inline void TanhDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        mVectorTools->TanhDerivative( y, delta, dst, size );
+    }
+
+    // Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+    template <typename T> static inline void SgdStep( T* weights, T* gradients, T gradScale, T learningRate, size_t size )
+    {
+        mVectorTools->SgdStep( weights, gradients, gradScale, learningRate, size );
+    }
+
+    // Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+    //   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+    template <typename T> static inline void MomentumStep( T* weights, T* gradients, T* velocity, T gradScale, T momentum, T alpha, T beta, T gamma, size_t size )
+    {
+        mVectorTools->MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+    }
+
+    // Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+    //   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+    template <typename T> static inline void AdaptiveStep( T* weights, T* gradients, T* sqSum, T gradScale, T decay, T sqFactor, T learningRate, T epsilon, size_t size )
+    {
+        mVectorTools->AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+    }
+
+    // Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+    //   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+    template <typename T> static inline void AdamStep( T* weights, T* gradients, T* mt, T* vt, T gradScale, T b1, T b2, T mtScale, T vtScale, T learningRate, T epsilon, size_t size )
+    {
+        mVectorTools->AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+    }
+
+private:
+
+    static IVectorTools* mVectorTools;
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XVECTORIZE_HPP
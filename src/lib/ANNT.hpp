@@ -29,6 +29,7 @@
 
 #include "Neuro/Layers/XFullyConnectedLayer.hpp"
 #include "Neuro/Layers/XConvolutionLayer.hpp"
+#include "Neuro/Layers/XDepthwiseSeparableConvolutionLayer.hpp"
 #include "Neuro/Layers/XRecurrentLayer.hpp"
 #include "Neuro/Layers/XLSTMLayer.hpp"
 #include "Neuro/Layers/XGRULayer.hpp"
@@ -28,6 +28,12 @@
 // Enable support of AVX instructions set
 #define ANNT_USE_AVX
 
+// Enable support of AVX2/FMA instructions set
+#define ANNT_USE_AVX2
+
+// Enable support of AVX-512 instructions set
+#define ANNT_USE_AVX512
+
 // Enable Open MP usage for loops parallelization
 #define ANNT_USE_OMP
 
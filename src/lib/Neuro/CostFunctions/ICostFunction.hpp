@@ -22,7 +22,10 @@
 #ifndef ANNT_ICOST_FUNCTION_HPP
 #define ANNT_ICOST_FUNCTION_HPP
 
+#include <vector>
+
 #include "../../Types/Types.hpp"
+#include "../../Tools/XParallel.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -38,6 +41,39 @@ public:
 
     // Calculates gradient for the specified output/target pair
     virtual fvector_t Gradient( const fvector_t& output, const fvector_t& target ) const = 0;
+
+    // Calculates cost value and gradient for the specified output/target pair, the gradient is written
+    // into the provided vector of the output's size. Default implementation is based on the above methods;
+    // cost functions override it to avoid allocation of a temporary vector.
+    virtual float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const
+    {
+        grad = Gradient( output, target );
+
+        return Cost( output, target );
+    }
+
+    // Calculates cost values and gradients for a batch of output/target pairs - gradients are written into the
+    // provided vectors and cost values into the provided array; returns total cost of the batch
+    float_t BatchCostGradient( const std::vector<fvector_t*>& outputs,
+                               const std::vector<fvector_t*>& targets,
+                               const std::vector<fvector_t*>& grads,
+                               float_t* costs, bool runInParallel ) const
+    {
+        float_t totalCost = 0;
+
+        XParallel::For( outputs.size( ), runInParallel, [&]( size_t i )
+        {
+            costs[i] = CostGradient( *outputs[i], *targets[i], *grads[i] );
+        } );
+
+        // sum is done sequentially, so it does not depend on the way samples are split between threads
+        for ( size_t i = 0, n = outputs.size( ); i < n; i++ )
+        {
+            totalCost += costs[i];
+        }
+
+        return totalCost;
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
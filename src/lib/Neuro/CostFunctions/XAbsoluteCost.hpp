@@ -76,6 +76,35 @@ public:
 
         return grad;
     }
+
+    // Calculates cost value and gradient for the specified output/target pair
+    float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const override
+    {
+        size_t  length = output.size( );
+        float_t cost   = float_t( 0 );
+        float_t diff;
+
+        for ( size_t i = 0; i < length; i++ )
+        {
+            diff  = output[i] - target[i];
+            cost += std::abs( diff );
+
+            if ( diff > float_t( 0 ) )
+            {
+                grad[i] = float_t( 1 );
+            }
+            else if ( diff < float_t( 0 ) )
+            {
+                grad[i] = float_t( -1 );
+            }
+            else
+            {
+                grad[i] = float_t( 0 );
+            }
+        }
+
+        return cost / length;
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
@@ -58,6 +58,23 @@ public:
 
         return grad;
     }
+
+    // Calculates cost value and gradient for the specified output/target pair
+    float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const override
+    {
+        size_t  length = output.size( );
+        float_t cost   = float_t( 0 );
+
+        for ( size_t i = 0; i < length; i++ )
+        {
+            cost += -( target[i] * std::log( output[i] ) +
+                     ( float_t( 1 ) - target[i] ) * std::log( float_t( 1 ) - output[i] ) );
+
+            grad[i] = ( output[i] - target[i] ) / ( output[i] * ( float_t( 1 ) - output[i] ) );
+        }
+
+        return cost;
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
@@ -22,7 +22,10 @@
 #ifndef ANNT_XMSE_COST_HPP
 #define ANNT_XMSE_COST_HPP
 
+#include <algorithm>
+
 #include "ICostFunction.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -55,16 +58,24 @@ public:
     // Calculates gradient for the specified output/target pair
     fvector_t Gradient( const fvector_t& output, const fvector_t& target ) const override
     {
-        size_t    length = output.size( );
-        fvector_t grad( length );
+        fvector_t grad( output );
 
-        for ( size_t i = 0; i < length; i++ )
-        {
-            grad[i] = output[i] - target[i];
-        }
+        XVectorize::Axpy( target.data( ), float_t( -1 ), grad.data( ), grad.size( ) );
 
         return grad;
     }
+
+    // Calculates cost value and gradient for the specified output/target pair
+    float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const override
+    {
+        size_t length = output.size( );
+
+        std::copy( output.begin( ), output.end( ), grad.begin( ) );
+        XVectorize::Axpy( target.data( ), float_t( -1 ), grad.data( ), length );
+
+        // the gradient is the difference, so cost is sum of its squares
+        return XVectorize::SumOfSquares( grad.data( ), length ) / ( float( 2 ) * length );
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
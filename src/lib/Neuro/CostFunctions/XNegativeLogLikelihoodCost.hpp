@@ -23,6 +23,7 @@
 #define ANNT_XNEGATIVE_LOG_LIKELIHOOD_COST_HPP
 
 #include "ICostFunction.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -36,30 +37,26 @@ public:
     // Calculates cost value of the specified output vector
     float_t Cost( const fvector_t& output, const fvector_t& target ) const override
     {
-        size_t  length = output.size( );
-        float_t cost   = float_t( 0 );
-
-        for ( size_t i = 0; i < length; i++ )
-        {
-            cost += -target[i] * output[i];
-        }
-
-        return cost;
+        return -XVectorize::Dot( target.data( ), output.data( ), output.size( ) );
     }
 
     // Calculates gradient for the specified output/target pair
     fvector_t Gradient( const fvector_t& output, const fvector_t& target ) const override
     {
-        size_t    length = output.size( );
-        fvector_t grad( length );
+        fvector_t grad( target.size( ) );
 
-        for ( size_t i = 0; i < length; i++ )
-        {
-            grad[i] = -target[i];
-        }
+        XVectorize::Scale( target.data( ), float_t( -1 ), grad.data( ), grad.size( ) );
 
         return grad;
     }
+
+    // Calculates cost value and gradient for the specified output/target pair
+    float_t CostGradient( const fvector_t& output, const fvector_t& target, fvector_t& grad ) const override
+    {
+        XVectorize::Scale( target.data( ), float_t( -1 ), grad.data( ), grad.size( ) );
+
+        return -XVectorize::Dot( target.data( ), output.data( ), output.size( ) );
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
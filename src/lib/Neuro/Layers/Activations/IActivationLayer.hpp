@@ -43,7 +43,7 @@ public:
     // Calls ForwardActivate() for individual input/output vectors passed by reference
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override
+                         const XNetworkContext& ctx ) const override
     {
         XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
         {
@@ -56,7 +56,7 @@ public:
                           const std::vector<fvector_t*>& outputs,
                           const std::vector<fvector_t*>& deltas,
                           std::vector<fvector_t*>& prevDeltas,
-                          fvector_t& /* gradWeights */,
+                          float_t* /* gradWeights */,
                           const XNetworkContext& ctx ) override
     {
         XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
@@ -66,7 +66,7 @@ public:
     }
 
     // Applies activation function to the input vector
-    virtual void ForwardActivate( const float_t* input, float_t* output, size_t len ) = 0;
+    virtual void ForwardActivate( const float_t* input, float_t* output, size_t len ) const = 0;
 
     // Propagates error back to previous layer by multiplying delta with activation function's derivative
     virtual void BackwardActivate( const float_t* input, const float_t* output,
@@ -22,7 +22,10 @@
 #ifndef ANNT_XELU_ACTIVATION_HPP
 #define ANNT_XELU_ACTIVATION_HPP
 
+#include <algorithm>
+
 #include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -40,11 +43,28 @@ public:
     {
     }
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
     {
-        for ( size_t i = 0; i < len; i++ )
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
+    {
+        // exponent is calculated for blocks of values first, which keeps input intact when output aliases it
+        const size_t blockSize = 256;
+        float_t      expValues[blockSize];
+
+        for ( size_t start = 0; start < len; start += blockSize )
         {
-            output[i] = ( input[i] >= float_t( 0 ) ) ? input[i] : mAlpha * ( std::exp( input[i] ) - float_t( 1 ) );
+            size_t count = std::min( blockSize, len - start );
+
+            XVectorize::Exp( input + start, expValues, count );
+
+            for ( size_t i = 0; i < count; i++ )
+            {
+                output[start + i] = ( input[start + i] >= float_t( 0 ) ) ? input[start + i] : mAlpha * ( expValues[i] - float_t( 1 ) );
+            }
         }
     }
 
@@ -40,7 +40,13 @@ public:
     {
     }
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
+    {
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
     {
         for ( size_t i = 0; i < len; i++ )
         {
@@ -23,6 +23,7 @@
 #define ANNT_XLOG_SOFT_MAX_ACTIVATION_HPP
 
 #include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -37,37 +38,21 @@ class XLogSoftMaxActivation : public IActivationLayer
 {
 public:
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
     {
-        float_t sum = 0;
-        float_t max = input[0];
+        float_t max = XVectorize::MaxValue( input, len );
 
-        for ( size_t i = 1; i < len; i++ )
-        {
-            if ( input[i] > max ) max = input[i];
-        }
-
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] = std::exp( input[i] - max );
-            sum      += output[i];
-        }
-
-        sum = std::log( sum );
-
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] = input[i] - max - sum;
-        }
+        // output = input - max - log( sum( exp( input - max ) ) ), using output for temporary exponents
+        XVectorize::Scale( input, float_t( 1 ), -max, output, len );
+        XVectorize::Exp( output, output, len );
+        XVectorize::Scale( input, float_t( 1 ), -max - std::log( XVectorize::Sum( output, len ) ), output, len );
     }
 
     void BackwardActivate( const float_t* /* input */, const float_t* output,
                            const float_t* delta, float_t* prevDelta, size_t len ) override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            prevDelta[i] = std::exp( output[i] ) +  delta[i];
-        }
+        XVectorize::Exp( output, prevDelta, len );
+        XVectorize::Add( delta, prevDelta, len );
     }
 };
 
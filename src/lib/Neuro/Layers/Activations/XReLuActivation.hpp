@@ -32,7 +32,13 @@ class XReLuActivation : public IActivationLayer
 {
 public:
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
+    {
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
     {
         XVectorize::Max( input, float_t( 0 ), output, len );
     }
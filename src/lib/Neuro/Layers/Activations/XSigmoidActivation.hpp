@@ -23,6 +23,7 @@
 #define ANNT_XSIGMOID_ACTIVATION_HPP
 
 #include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -31,22 +32,22 @@ class XSigmoidActivation : public IActivationLayer
 {
 public:
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] = float_t( 1 ) / ( float_t( 1 ) + std::exp( -input[i] ) );
-        }
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
+    {
+        XVectorize::Sigmoid( input, output, len );
     }
 
     void BackwardActivate( const float_t* /* input */, const float_t* output,
                            const float_t* delta, float_t* prevDelta, size_t len ) override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            // derivative(Sigmoid) = y * ( 1 - y )
-            prevDelta[i] = delta[i] * output[i] * ( float_t( 1 ) - output[i] );
-        }
+        // derivative(Sigmoid) = y * ( 1 - y )
+        XVectorize::SigmoidDerivative( output, delta, prevDelta, len );
     }
 };
 
@@ -23,6 +23,7 @@
 #define ANNT_XSOFT_MAX_ACTIVATION_HPP
 
 #include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -31,43 +32,26 @@ class XSoftMaxActivation : public IActivationLayer
 {
 public:
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
     {
-        float_t sum = 0;
-        float_t max = input[0];
+        float_t max = XVectorize::MaxValue( input, len );
 
-        for ( size_t i = 1; i < len; i++ )
-        {
-            if ( input[i] > max ) max = input[i];
-        }
-
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] = std::exp( input[i] - max );
-            sum      += output[i];
-        }
-
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] /= sum;
-        }
+        // output = exp( input - max ) / sum( exp( input - max ) )
+        XVectorize::Scale( input, float_t( 1 ), -max, output, len );
+        XVectorize::Exp( output, output, len );
+        XVectorize::Scale( output, float_t( 1 ) / XVectorize::Sum( output, len ), output, len );
     }
 
     void BackwardActivate( const float_t* /* input */, const float_t* output,
                            const float_t* delta, float_t* prevDelta, size_t len ) override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            float_t sum = 0;
-
-            for ( size_t j = 0; j < len; j++ )
-            {
-                //sum += delta[j] * der[j];
-                sum += delta[j] * ( ( j == i ) ? output[i] * ( float_t( 1 ) - output[j] ) : -output[i] * output[j] );
-            }
+        // prevDelta[i] = sum( delta[j] * der(i, j) ), where der(i, j) = y[i] * ( 1 - y[j] ), i == j
+        //                                                                = -y[i] * y[j]     , otherwise
+        // which is the same as y[i] * ( delta[i] - sum( delta[j] * y[j] ) )
+        float_t deltaDotOutput = XVectorize::Dot( delta, output, len );
 
-            prevDelta[i] = sum;
-        }
+        XVectorize::Scale( output, -deltaDotOutput, prevDelta, len );
+        XVectorize::MulAdd( output, delta, prevDelta, len );
     }
 };
 
@@ -23,6 +23,7 @@
 #define ANNT_XTANH_ACTIVATION_HPP
 
 #include "IActivationLayer.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -31,21 +32,21 @@ class XTanhActivation : public IActivationLayer
 {
 public:
 
-    void ForwardActivate( const float_t* input, float_t* output, size_t len ) override
+    // Computes element wise, so can be done in place
+    bool CanComputeInPlace( ) const override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            output[i] = std::tanh( input[i] );
-        }
+        return true;
+    }
+
+    void ForwardActivate( const float_t* input, float_t* output, size_t len ) const override
+    {
+        XVectorize::Tanh( input, output, len );
     }
 
     void BackwardActivate( const float_t* /* input */, const float_t* output, const float_t* delta, float_t* prevDelta, size_t len ) override
     {
-        for ( size_t i = 0; i < len; i++ )
-        {
-            // derivative(Tanh) = 1 - y^2
-            prevDelta[i] = delta[i] * ( float_t( 1 ) - output[i] * output[i] );
-        }
+        // derivative(Tanh) = 1 - y^2
+        XVectorize::TanhDerivative( output, delta, prevDelta, len );
     }
 };
 
@@ -39,6 +39,11 @@ protected:
     size_t mInputsCount;
     size_t mOutputsCount;
 
+private:
+    size_t mConfigurationVersion;
+
+protected:
+
     // To be called by XNeuralNetwork to set size of layers with zero inputs/outputs,
     // which is the case for activation layers.
     virtual void Initialize( size_t inputsCount, size_t outputsCount )
@@ -48,7 +53,8 @@ protected:
     }
 
 public:
-    ILayer( size_t inputsCount, size_t outputsCount )
+    ILayer( size_t inputsCount, size_t outputsCount ) :
+        mConfigurationVersion( 0 )
     {
         Initialize( inputsCount, outputsCount );
     }
@@ -67,6 +73,13 @@ public:
         return mOutputsCount;
     }
 
+    // Version of layer's configuration, which changes every time the layer is changed in a way affecting memory it
+    // needs for computation (algorithm, quantization, precision of weights), so inference objects could re-allocate it
+    size_t ConfigurationVersion( ) const
+    {
+        return mConfigurationVersion;
+    }
+
     // Some of the layers may need extra memory required for processing inputs or for
     // keeping state between forward and backward pass. The method below tells
     // how many buffers are required and their size.
@@ -84,10 +97,27 @@ public:
     // Reports if the layer is trainable or not (has weights/biases)
     virtual bool Trainable( ) const = 0;
 
+    // Reports if the layer can compute its outputs in place of its inputs (outputs may be same vectors
+    // as inputs). Backward pass of such layers must not use inputs, since those are overwritten.
+    virtual bool CanComputeInPlace( ) const { return false; }
+
+    // Reports if backward pass of the layer uses its outputs, which otherwise can be overwritten
+    // by the next layer computing in place
+    virtual bool BackwardNeedsOutputs( ) const { return true; }
+
     // Calculates outputs for the given inputs - forward pass
     virtual void ForwardCompute( const std::vector<fvector_t*>& inputs,
                                  std::vector<fvector_t*>& outputs,
-                                 const XNetworkContext& ctx ) = 0;
+                                 const XNetworkContext& ctx ) const = 0;
+
+    // Calculates outputs for the given inputs while training - layers, which learn anything from training samples
+    // apart from weights (running statistics, etc.), update it here, so forward pass itself never changes a layer
+    virtual void ForwardTrainingCompute( const std::vector<fvector_t*>& inputs,
+                                         std::vector<fvector_t*>& outputs,
+                                         const XNetworkContext& ctx )
+    {
+        ForwardCompute( inputs, outputs, ctx );
+    }
 
     // Propagates error to the previous layer and calculates weights/biases
     // gradients (in the case the layer is trainable)
@@ -95,9 +125,12 @@ public:
                                   const std::vector<fvector_t*>& outputs,
                                   const std::vector<fvector_t*>& deltas,
                                   std::vector<fvector_t*>& prevDeltas,
-                                  fvector_t& gradWeights,
+                                  float_t* gradWeights,
                                   const XNetworkContext& ctx ) = 0;
 
+    // Reports if the layer has any learnt parameters to save/load
+    virtual bool HasLearnedParams( ) const { return Trainable( ); }
+
     // Saves layer's learnt parameters/weights
     virtual bool SaveLearnedParams( FILE* /* file */ ) const { return true; }
     // Loads layer's learnt parameters
@@ -105,8 +138,29 @@ public:
 
 protected:
 
+    // To be called by layers when their configuration changes (see ConfigurationVersion( ))
+    void ConfigurationChanged( )
+    {
+        mConfigurationVersion++;
+    }
+
     // Default implementation of saving layer's learned parameter, which are represented as fvector_t
     bool SaveLearnedParamsHelper( FILE* file, LayerID id, const std::vector<const fvector_t*>& params ) const
+    {
+        std::vector<const float_t*> data;
+        uvector_t                   sizes;
+
+        for ( size_t i = 0; i < params.size( ); i++ )
+        {
+            data.push_back( params[i]->data( ) );
+            sizes.push_back( params[i]->size( ) );
+        }
+
+        return SaveLearnedParamsHelper( file, id, data, sizes );
+    }
+
+    // Saves layer's learned parameters, which are represented as arrays of the specified sizes
+    bool SaveLearnedParamsHelper( FILE* file, LayerID id, const std::vector<const float_t*>& params, const uvector_t& sizes ) const
     {
         bool     ret     = false;
         uint32_t layerID = static_cast<uint32_t>( id );
@@ -117,7 +171,7 @@ protected:
 
             for ( i = 0; i < params.size( ); i++ )
             {
-                uint32_t paramsCount = static_cast<uint32_t>( params[i]->size( ) );
+                uint32_t paramsCount = static_cast<uint32_t>( sizes[i] );
 
                 if ( fwrite( &paramsCount, sizeof( paramsCount ), 1, file ) != 1 )
                 {
@@ -129,7 +183,7 @@ protected:
             {
                 for ( i = 0; i < params.size( ); i++ )
                 {
-                    if ( fwrite( params[i]->data( ), sizeof( float_t ), params[i]->size( ), file ) != params[i]->size( ) )
+                    if ( fwrite( params[i], sizeof( float_t ), sizes[i], file ) != sizes[i] )
                     {
                         break;
                     }
@@ -144,6 +198,21 @@ protected:
 
     // Default implementation of loading layer's learned parameter, which are represented as fvector_t
     bool LoadLearnedParamsHelper( FILE* file, LayerID id, std::vector<fvector_t*>& params )
+    {
+        std::vector<float_t*> data;
+        uvector_t             sizes;
+
+        for ( size_t i = 0; i < params.size( ); i++ )
+        {
+            data.push_back( params[i]->data( ) );
+            sizes.push_back( params[i]->size( ) );
+        }
+
+        return LoadLearnedParamsHelper( file, id, data, sizes );
+    }
+
+    // Loads layer's learned parameters, which are represented as arrays of the specified sizes
+    bool LoadLearnedParamsHelper( FILE* file, LayerID id, const std::vector<float_t*>& params, const uvector_t& sizes )
     {
         bool     ret = false;
         uint32_t layerID;
@@ -158,7 +227,7 @@ protected:
                 uint32_t paramsCount;
 
                 if ( ( fread( &paramsCount, sizeof( paramsCount ), 1, file ) != 1 ) ||
-                     ( paramsCount != static_cast<uint32_t>( params[i]->size( ) ) ) )
+                     ( paramsCount != static_cast<uint32_t>( sizes[i] ) ) )
                 {
                     break;
                 }
@@ -168,7 +237,7 @@ protected:
             {
                 for ( i = 0; i < params.size( ); i++ )
                 {
-                    if ( fread( params[i]->data( ), sizeof( float_t ), params[i]->size( ), file ) != params[i]->size( ) )
+                    if ( fread( params[i], sizeof( float_t ), sizes[i], file ) != sizes[i] )
                     {
                         break;
                     }
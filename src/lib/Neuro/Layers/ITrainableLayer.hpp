@@ -22,15 +22,38 @@
 #ifndef ANNT_ITRAINABLE_LAYER_HPP
 #define ANNT_ITRAINABLE_LAYER_HPP
 
+#include <string.h>
+#include <memory>
+#include <utility>
+
 #include "ILayer.hpp"
+#include "../../Tools/XHalfWeights.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
 class ITrainableLayer : public ILayer
 {
+private:
+    // Layer's own storage of weights, which is released while external storage is attached
+    fvector_t mOwnWeights;
+
+    // Owner of read-only memory the weights are mapped from (see MapWeights), which is kept alive by the layer
+    std::shared_ptr<const void> mMappedWeightsOwner;
+
+    // Weights kept in half precision or bfloat16 instead of float storage (see SetStoragePrecision)
+    XHalfWeights mHalfWeights;
+
+protected:
+    // All weights and biases of the layer kept together - either in own or in external storage
+    // (null while weights are kept in half precision)
+    float_t*  mAllWeights;
+    size_t    mAllWeightsCount;
+
 public:
     ITrainableLayer( size_t inputsCount, size_t outputsCount ) :
-        ILayer( inputsCount, outputsCount )
+        ILayer( inputsCount, outputsCount ),
+        mAllWeights( nullptr ), mAllWeightsCount( 0 )
     {
     }
 
@@ -41,17 +64,293 @@ public:
     }
 
     // Reports number of weight coefficients the layer has
-    virtual size_t WeightsCount( ) const = 0;
+    virtual size_t WeightsCount( ) const
+    {
+        return mAllWeightsCount;
+    }
 
     // Get/set layer's weights
-    virtual fvector_t Weights( ) const = 0;
-    virtual void SetWeights( const fvector_t& weights ) = 0;
+    virtual fvector_t Weights( ) const
+    {
+        fvector_t weights( mAllWeightsCount );
+
+        CopyWeights( 0, mAllWeightsCount, weights.data( ) );
+
+        return weights;
+    }
+    virtual void SetWeights( const fvector_t& weights )
+    {
+        if ( weights.size( ) == mAllWeightsCount )
+        {
+            UnmapWeights( );
+            memcpy( mAllWeights, weights.data( ), mAllWeightsCount * sizeof( float_t ) );
+            WeightsChanged( );
+        }
+    }
 
     // Randomizes layer's weights/biases
     virtual void Randomize( ) = 0;
 
     // Applies updates to the layer's weights and biases
-    virtual void UpdateWeights( const fvector_t& updates ) = 0;
+    virtual void UpdateWeights( const fvector_t& updates )
+    {
+        UnmapWeights( );
+        XVectorize::Add( updates.data( ), mAllWeights, mAllWeightsCount );
+        WeightsChanged( );
+    }
+
+    // Provides direct access to layer's weights for in place updates (WeightsChanged( ) must be called after)
+    float_t* WeightsData( )
+    {
+        UnmapWeights( );
+        return mAllWeights;
+    }
+
+    // Moves layer's weights into the specified external storage of WeightsCount( ) size, which is kept
+    // by the caller (see XParameterArena). Null pointer moves weights back into layer's own storage.
+    // Returns false if the layer does not keep its weights in the storage provided by this class.
+    bool AttachWeightsStorage( float_t* storage )
+    {
+        // weights kept in half precision are widened into own storage first
+        if ( !mHalfWeights.IsEmpty( ) )
+        {
+            UnmapWeights( );
+        }
+
+        bool ret = ( mAllWeights != nullptr );
+
+        if ( ( ret ) && ( storage != mAllWeights ) )
+        {
+            if ( storage != nullptr )
+            {
+                memcpy( storage, mAllWeights, mAllWeightsCount * sizeof( float_t ) );
+                fvector_t( ).swap( mOwnWeights );
+                mAllWeights = storage;
+            }
+            else
+            {
+                mOwnWeights = fvector_t( mAllWeights, mAllWeights + mAllWeightsCount );
+                mAllWeights = mOwnWeights.data( );
+            }
+
+            mMappedWeightsOwner.reset( );
+            SetWeightsPointers( );
+        }
+
+        return ret;
+    }
+
+    // Makes the layer use weights from the specified read-only memory (WeightsCount( ) values) without copying them,
+    // keeping the memory's owner alive. Weights are copied into layer's own storage when anything is going to change them.
+    void MapWeights( const float_t* weights, const std::shared_ptr<const void>& owner )
+    {
+        fvector_t( ).swap( mOwnWeights );
+        mHalfWeights.Clear( );
+        mAllWeights         = const_cast<float_t*>( weights );
+        mMappedWeightsOwner = owner;
+
+        SetWeightsPointers( );
+        WeightsChanged( );
+    }
+
+    // Copies weights mapped from read-only memory or kept in half precision into layer's own float storage
+    // (nothing is done if weights are already there)
+    void UnmapWeights( )
+    {
+        if ( !mHalfWeights.IsEmpty( ) )
+        {
+            mOwnWeights = fvector_t( mAllWeightsCount );
+            mHalfWeights.ToFloat( 0, mAllWeightsCount, mOwnWeights.data( ) );
+            mHalfWeights.Clear( );
+            mAllWeights = mOwnWeights.data( );
+
+            SetWeightsPointers( );
+            WeightsChanged( );
+            ConfigurationChanged( );
+        }
+        else if ( mMappedWeightsOwner )
+        {
+            AttachWeightsStorage( nullptr );
+        }
+    }
+
+    // Checks if weights are mapped from read-only memory
+    bool WeightsMapped( ) const
+    {
+        return static_cast<bool>( mMappedWeightsOwner );
+    }
+
+    // Tells if the layer can compute its outputs using weights kept in half precision
+    virtual bool HalfPrecisionSupported( ) const
+    {
+        return false;
+    }
+
+    // Precision layer's weights are stored in
+    WeightsPrecision StoragePrecision( ) const
+    {
+        return ( mHalfWeights.IsEmpty( ) ) ? WeightsPrecision::Float : mHalfWeights.Precision( );
+    }
+
+    // Checks if weights are kept in half precision or bfloat16
+    bool IsHalfPrecision( ) const
+    {
+        return !mHalfWeights.IsEmpty( );
+    }
+
+    // Converts layer's weights to the specified precision for inference - float storage is released, so 16 bit weights take
+    // half of the memory (computations are still done in float). Any change of weights (training included) converts them
+    // back to float. Returns false if the layer does not support weights in half precision.
+    bool SetStoragePrecision( WeightsPrecision precision )
+    {
+        bool ret = ( ( precision == WeightsPrecision::Float ) || ( HalfPrecisionSupported( ) ) );
+
+        if ( ( ret ) && ( precision != StoragePrecision( ) ) )
+        {
+            // conversion between 16 bit formats goes through float
+            UnmapWeights( );
+
+            if ( precision != WeightsPrecision::Float )
+            {
+                mHalfWeights.Convert( mAllWeights, mAllWeightsCount, precision );
+                ReleaseFloatWeights( );
+            }
+        }
+
+        return ret;
+    }
+
+    // Saves/loads layer's weights in the specified 16 bit precision - loading makes the layer keep them in that precision.
+    // Those are done by layers supporting half precision weights only.
+    virtual bool SaveHalfPrecisionParams( FILE* /* file */, WeightsPrecision /* precision */ ) const
+    {
+        return false;
+    }
+    virtual bool LoadHalfPrecisionParams( FILE* /* file */, WeightsPrecision /* precision */ )
+    {
+        return false;
+    }
+
+    // Notifies the layer its weights were changed, so it could update anything derived from them
+    virtual void WeightsChanged( ) { }
+
+protected:
+
+    // Allocates layer's own storage for the specified number of weights
+    void AllocateWeights( size_t weightsCount )
+    {
+        mOwnWeights      = fvector_t( weightsCount );
+        mAllWeights      = mOwnWeights.data( );
+        mAllWeightsCount = weightsCount;
+
+        SetWeightsPointers( );
+    }
+
+    // Sets pointers to the parts of weights' storage (weights/biases of different types), which is
+    // done every time the storage gets changed
+    virtual void SetWeightsPointers( ) { }
+
+    // Offsets pointer to a part of weights' storage - pointers stay null while weights are not kept in float
+    static float_t* OffsetWeights( float_t* weights, size_t offset )
+    {
+        return ( weights == nullptr ) ? nullptr : weights + offset;
+    }
+
+    // Copies the specified number of weights starting from the given offset in all weights, widening them if those are
+    // kept in half precision
+    void CopyWeights( size_t offset, size_t count, float_t* weights ) const
+    {
+        if ( mHalfWeights.IsEmpty( ) )
+        {
+            memcpy( weights, mAllWeights + offset, count * sizeof( float_t ) );
+        }
+        else
+        {
+            mHalfWeights.ToFloat( offset, count, weights );
+        }
+    }
+
+    // Calculates dot product of the vector and the specified number of weights starting from the given offset in all weights
+    // (weights kept in half precision are widened on the fly)
+    float_t WeightsDot( size_t offset, const float_t* vector, size_t count ) const
+    {
+        return ( mHalfWeights.IsEmpty( ) ) ? XVectorize::Dot( vector, mAllWeights + offset, count ) :
+                                             mHalfWeights.Dot( offset, vector, count );
+    }
+
+    // Saves/loads layer's weights as single vector of parameters
+    bool SaveWeightsHelper( FILE* file, LayerID id ) const
+    {
+        if ( !mHalfWeights.IsEmpty( ) )
+        {
+            fvector_t weights = Weights( );
+
+            return SaveLearnedParamsHelper( file, id, std::vector<const float_t*>( { weights.data( ) } ), uvector_t( { mAllWeightsCount } ) );
+        }
+
+        return SaveLearnedParamsHelper( file, id, std::vector<const float_t*>( { mAllWeights } ), uvector_t( { mAllWeightsCount } ) );
+    }
+    bool LoadWeightsHelper( FILE* file, LayerID id )
+    {
+        UnmapWeights( );
+
+        bool ret = LoadLearnedParamsHelper( file, id, std::vector<float_t*>( { mAllWeights } ), uvector_t( { mAllWeightsCount } ) );
+
+        WeightsChanged( );
+
+        return ret;
+    }
+
+    // Saves/loads layer's weights as single vector of 16 bit values of the specified precision -
+    // layer's ID, number of weights (as uint32_t) and the weights
+    bool SaveHalfWeightsHelper( FILE* file, LayerID id, WeightsPrecision precision ) const
+    {
+        uint32_t     header[2] = { static_cast<uint32_t>( id ), static_cast<uint32_t>( mAllWeightsCount ) };
+        XHalfWeights converted;
+
+        // weights are converted, unless already kept in the requested precision
+        if ( ( precision != WeightsPrecision::Float ) && ( mHalfWeights.Precision( ) != precision ) )
+        {
+            converted.Convert( Weights( ).data( ), mAllWeightsCount, precision );
+        }
+
+        const XHalfWeights& weights = ( converted.IsEmpty( ) ) ? mHalfWeights : converted;
+
+        return ( precision != WeightsPrecision::Float ) &&
+               ( fwrite( header, sizeof( uint32_t ), 2, file ) == 2 ) &&
+               ( weights.Save( file ) );
+    }
+    bool LoadHalfWeightsHelper( FILE* file, LayerID id, WeightsPrecision precision )
+    {
+        uint32_t     header[2];
+        XHalfWeights loaded;
+        bool         ret = ( fread( header, sizeof( uint32_t ), 2, file ) == 2 ) &&
+                           ( header[0] == static_cast<uint32_t>( id ) ) &&
+                           ( header[1] == static_cast<uint32_t>( mAllWeightsCount ) ) &&
+                           ( loaded.Load( file, mAllWeightsCount, precision ) );
+
+        if ( ret )
+        {
+            std::swap( mHalfWeights, loaded );
+            ReleaseFloatWeights( );
+        }
+
+        return ret;
+    }
+
+private:
+
+    // Releases float storage of weights once those are kept in half precision (pointers to its parts are set to null)
+    void ReleaseFloatWeights( )
+    {
+        fvector_t( ).swap( mOwnWeights );
+        mMappedWeightsOwner.reset( );
+        mAllWeights = nullptr;
+
+        SetWeightsPointers( );
+        WeightsChanged( );
+        ConfigurationChanged( );
+    }
 };
 
 } } // namespace ANNT::Neuro
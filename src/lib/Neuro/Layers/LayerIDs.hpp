@@ -33,6 +33,7 @@ enum class LayerID
     RecurrentBasic     = 3,
     RecurrentLSTM      = 4,
     RecurrentGRU       = 5,
+    DepthwiseSeparableConvolution = 6,
 
     Sigmoid            = 1000,
     Tanh               = 1001,
@@ -46,7 +46,7 @@ public:
                           const std::vector<fvector_t*>& outputs,
                           const std::vector<fvector_t*>& deltas,
                           std::vector<fvector_t*>& prevDeltas,
-                          fvector_t& /* gradWeights */,
+                          float_t* /* gradWeights */,
                           const XNetworkContext& ctx ) override
     {
         BackwardProcess( inputs, outputs, deltas, prevDeltas, ctx );
@@ -25,6 +25,7 @@
 #include "IProcessingLayer.hpp"
 #include "../../../Tools/XDataEncodingTools.hpp"
 #include "../../../Tools/XParallel.hpp"
+#include "../../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -48,6 +49,9 @@ class XAveragePooling : public IProcessingLayer
     std::vector<uvector_t> mOutToInMap;
     uvector_t              mInToOutMap;
 
+    // all inputs are connected and all pools are of the same size
+    bool                   mUniformPools;
+
 public:
 
     XAveragePooling( size_t inputWidth, size_t inputHeight, size_t inputDepth, size_t poolSize = 2 )
@@ -68,7 +72,7 @@ public:
         mOutputWidth( 0 ), mOutputHeight( 0 ),
         mPoolSizeX( poolSizeX ), mPoolSizeY( poolSizeY ),
         mHorizontalStep( horizontalStep ), mVerticalStep( verticalStep ),
-        mBorderMode( borderMode )
+        mBorderMode( borderMode ), mUniformPools( true )
     {
         size_t padWidth    = 0;
         size_t padHeight   = 0;
@@ -98,12 +102,27 @@ public:
                                                                   horizontalStep, verticalStep, borderMode );
         mOutToInMap = XDataEncodingTools::BuildPoolingOutToInMap( inputWidth, inputHeight, inputDepth, poolSizeX, poolSizeY,
                                                                   horizontalStep, verticalStep, borderMode );
+
+        for ( auto outputIndex : mInToOutMap )
+        {
+            mUniformPools &= ( outputIndex != ANNT_NOT_CONNECTED );
+        }
+        for ( const auto& outputMap : mOutToInMap )
+        {
+            mUniformPools &= ( outputMap.size( ) == mOutToInMap[0].size( ) );
+        }
+    }
+
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
     }
 
     // Calculates outputs for the given inputs
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override
+                         const XNetworkContext& ctx ) const override
     {
         XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
         {
@@ -137,17 +156,26 @@ public:
             const fvector_t& delta     = *( deltas[i] );
             fvector_t&       prevDelta = *( prevDeltas[i] );
 
-            for ( size_t inputIndex = 0; inputIndex < mInputsCount; inputIndex++ )
+            if ( mUniformPools )
             {
-                if ( mInToOutMap[inputIndex] == ANNT_NOT_CONNECTED )
-                {
-                    prevDelta[inputIndex] = float_t( 0 );
-                }
-                else
+                // gather deltas of the outputs each input is connected to and scale them by the pool size
+                XVectorize::Gather( delta.data( ), mInToOutMap.data( ), prevDelta.data( ), mInputsCount );
+                XVectorize::Scale( prevDelta.data( ), float_t( 1 ) / mOutToInMap[0].size( ), prevDelta.data( ), mInputsCount );
+            }
+            else
+            {
+                for ( size_t inputIndex = 0; inputIndex < mInputsCount; inputIndex++ )
                 {
-                    size_t outputIndex = mInToOutMap[inputIndex];
-
-                    prevDelta[inputIndex] = delta[outputIndex] / mOutToInMap[outputIndex].size( );
+                    if ( mInToOutMap[inputIndex] == ANNT_NOT_CONNECTED )
+                    {
+                        prevDelta[inputIndex] = float_t( 0 );
+                    }
+                    else
+                    {
+                        size_t outputIndex = mInToOutMap[inputIndex];
+
+                        prevDelta[inputIndex] = delta[outputIndex] / mOutToInMap[outputIndex].size( );
+                    }
                 }
             }
         } );
@@ -26,7 +26,6 @@
 #include "../../../Tools/XParallel.hpp"
 #include "../../../Tools/XVectorize.hpp"
 #include <cstring>
-#include <numeric>
 
 namespace ANNT { namespace Neuro {
 
@@ -34,15 +33,14 @@ namespace ANNT { namespace Neuro {
 class XBatchNormalization : public IProcessingLayer
 {
 private:
-    bool      mFirstUpdate;
-
     size_t    mSpatialSize;
     size_t    mInputDepth;
 
     float_t   mMomentum;
     float_t   mEpsilon;
 
-    // learn't mean and std.dev.
+    // learn't mean and std.dev. - updated by training forward pass only
+    bool      mFirstUpdate;
     fvector_t mMean;
     fvector_t mStdDev;
 
@@ -59,14 +57,34 @@ private:
 public:
     XBatchNormalization( size_t inputWidth, size_t inputHeight, size_t inputDepth, float_t momentum = float_t( 0.999 ) ) :
         IProcessingLayer( inputWidth * inputHeight * inputDepth, inputWidth * inputHeight * inputDepth ),
-        mFirstUpdate( true ),
         mSpatialSize( inputWidth * inputHeight ), mInputDepth( inputDepth ),
-        mMomentum( momentum ), mEpsilon( float_t( 0.00001 ) )
+        mMomentum( momentum ), mEpsilon( float_t( 0.00001 ) ),
+        mFirstUpdate( true )
     {
         mMean   = fvector_t( mInputDepth, float_t( 0.0f ) );
         mStdDev = fvector_t( mInputDepth, float_t( 1.0f ) );
     }
 
+    // Number of input maps (channels) and size of each of them
+    size_t InputDepth( ) const
+    {
+        return mInputDepth;
+    }
+    size_t SpatialSize( ) const
+    {
+        return mSpatialSize;
+    }
+
+    // Learnt mean and std.dev. of every input map
+    const fvector_t& Mean( ) const
+    {
+        return mMean;
+    }
+    const fvector_t& StdDev( ) const
+    {
+        return mStdDev;
+    }
+
     // Tells that we may need some extra memory for keeping temporary calculations
     uvector_t WorkingMemSize( bool /* trainingMode */ ) const override
     {
@@ -91,21 +109,23 @@ public:
         return workingMemSize;
     }
 
+    // Normalization is done element wise, so can be done in place (backward pass needs outputs only)
+    bool CanComputeInPlace( ) const override
+    {
+        return true;
+    }
+
     // Calculates outputs for the given inputs
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override
+                         const XNetworkContext& ctx ) const override
     {
         float_t* batchMean      = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_BATCH_MEAN, 0 ) );
         float_t* batchVariance  = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_BATCH_VARIANCE, 0 ) );
         float_t* batchStdDEv    = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_BATCH_STD_DEV, 0 ) );
 
-        float_t* learntMean     = mMean.data( );
-        float_t* learntVariance = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_LEARNT_VARIANCE, 0 ) );
-        float_t* learntStdDev   = mStdDev.data( );
-
-        float_t* meanToUse      = ( ctx.IsTraining( ) ) ? batchMean   : learntMean;
-        float_t* stdDevToUse    = ( ctx.IsTraining( ) ) ? batchStdDEv : learntStdDev;
+        const float_t* meanToUse   = ( ctx.IsTraining( ) ) ? batchMean   : mMean.data( );
+        const float_t* stdDevToUse = ( ctx.IsTraining( ) ) ? batchStdDEv : mStdDev.data( );
 
         if ( ctx.IsTraining( ) )
         {
@@ -117,21 +137,31 @@ public:
         {
             for ( size_t depthIndex = 0; depthIndex < mInputDepth; depthIndex++ )
             {
-                float_t meanValue   = meanToUse[depthIndex];
-                float_t stdDevValue = stdDevToUse[depthIndex];
+                float_t invStdDev = float_t( 1 ) / stdDevToUse[depthIndex];
 
-                const float_t* input  = inputs[i]->data( )  + depthIndex * mSpatialSize;
-                float_t*       output = outputs[i]->data( ) + depthIndex * mSpatialSize;
-
-                for ( size_t spatialIndex = 0; spatialIndex < mSpatialSize; spatialIndex++, input++, output++ )
-                {
-                    *output = ( *input - meanValue ) / stdDevValue;
-                }
+                // output = ( input - mean ) / stdDev
+                XVectorize::Scale( inputs[i]->data( ) + depthIndex * mSpatialSize, invStdDev, -meanToUse[depthIndex] * invStdDev,
+                                   outputs[i]->data( ) + depthIndex * mSpatialSize, mSpatialSize );
             }
         } );
+    }
+
+    // Calculates outputs for the given training samples and updates learnt mean and std.dev. with statistics of the batch
+    void ForwardTrainingCompute( const std::vector<fvector_t*>& inputs,
+                                 std::vector<fvector_t*>& outputs,
+                                 const XNetworkContext& ctx ) override
+    {
+        ForwardCompute( inputs, outputs, ctx );
 
         if ( ctx.IsTraining( ) )
         {
+            float_t* batchMean      = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_BATCH_MEAN, 0 ) );
+            float_t* batchVariance  = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_BATCH_VARIANCE, 0 ) );
+
+            float_t* learntMean     = mMean.data( );
+            float_t* learntVariance = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_LEARNT_VARIANCE, 0 ) );
+            float_t* learntStdDev   = mStdDev.data( );
+
             if ( mFirstUpdate )
             {
                 memcpy( learntMean, batchMean, mInputDepth * sizeof( float_t ) );
@@ -144,11 +174,8 @@ public:
                 float_t antiMomentum = float_t( 1 ) - mMomentum;
 
                 // update learnt mean and variance
-                for ( size_t depthIndex = 0; depthIndex < mInputDepth; depthIndex++ )
-                {
-                    learntMean[depthIndex]     = mMomentum * learntMean[depthIndex]     + antiMomentum * batchMean[depthIndex];
-                    learntVariance[depthIndex] = mMomentum * learntVariance[depthIndex] + antiMomentum * batchVariance[depthIndex];
-                }
+                XVectorize::ScaledAdd( batchMean, antiMomentum, mMomentum, learntMean, mInputDepth );
+                XVectorize::ScaledAdd( batchVariance, antiMomentum, mMomentum, learntVariance, mInputDepth );
             }
 
             // calculate std dev on learnt variance
@@ -188,20 +215,26 @@ public:
 
         XParallel::For( outputs.size( ), ctx.IsTraining( ), [&]( size_t i )
         {
-            const fvector_t& output    = *( outputs[i] );
-            const fvector_t& delta     = *( deltas[i] );
-            fvector_t&       prevDelta = *( prevDeltas[i] );
-
             for ( size_t depthIndex = 0; depthIndex < mInputDepth; depthIndex++ )
             {
-                for ( size_t spatialIndex = 0, j = depthIndex * mSpatialSize; spatialIndex < mSpatialSize; spatialIndex++, j++ )
-                {
-                    prevDelta[j] = ( delta[j] - deltasMean[depthIndex] - deltasDotOutputsMean[depthIndex] * output[j] ) / stdDevToUse[depthIndex];
-                }
+                const float_t* output    = outputs[i]->data( )    + depthIndex * mSpatialSize;
+                const float_t* delta     = deltas[i]->data( )     + depthIndex * mSpatialSize;
+                float_t*       prevDelta = prevDeltas[i]->data( ) + depthIndex * mSpatialSize;
+                float_t        invStdDev = float_t( 1 ) / stdDevToUse[depthIndex];
+
+                // prevDelta = ( delta - deltasMean - deltasDotOutputsMean * output ) / stdDev
+                XVectorize::Scale( delta, invStdDev, -deltasMean[depthIndex] * invStdDev, prevDelta, mSpatialSize );
+                XVectorize::Axpy( output, -deltasDotOutputsMean[depthIndex] * invStdDev, prevDelta, mSpatialSize );
             }
         } );
     }
 
+    // Learnt mean and std.dev. are saved with layer's parameters
+    bool HasLearnedParams( ) const override
+    {
+        return true;
+    }
+
     // Saves layer's learnt parameters/weights
     bool SaveLearnedParams( FILE* file ) const override
     {
@@ -229,9 +262,7 @@ private:
 
             for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
             {
-                mean[depthIndex] += std::accumulate( inputs[i]->begin( ) +   depthIndex       * mSpatialSize,
-                                                     inputs[i]->begin( ) + ( depthIndex + 1 ) * mSpatialSize,
-                                                     float_t( 0 ) ) / mSpatialSize;
+                mean[depthIndex] += XVectorize::Mean( inputs[i]->data( ) + depthIndex * mSpatialSize, mSpatialSize );
             }
 
             mean[depthIndex] /= inputs.size( );
@@ -267,7 +298,7 @@ private:
         } );
     }
 
-    void CalculateStdDev( const float_t* variance, float_t* stdDev )
+    void CalculateStdDev( const float_t* variance, float_t* stdDev ) const
     {
         for ( size_t depthIndex = 0; depthIndex < mInputDepth; depthIndex++ )
         {
@@ -24,6 +24,7 @@
 
 #include "IProcessingLayer.hpp"
 #include "../../../Tools/XParallel.hpp"
+#include "../../../Tools/XVectorize.hpp"
 #include <random>
 
 namespace ANNT { namespace Neuro {
@@ -33,6 +34,7 @@ class XDropOutLayer : public IProcessingLayer
 private:
     float_t mDropOutRate;
 
+    // drop out mask is generated by training forward pass only
     std::mt19937                            mGenerator;
     std::uniform_real_distribution<float_t> mDistribution;
 
@@ -58,10 +60,20 @@ public:
         return workingMemSize;
     }
 
-    // Calculates outputs for the given inputs
+    // Drop out mask is applied element wise, so can be done in place. Backward pass needs the mask only.
+    bool CanComputeInPlace( ) const override
+    {
+        return true;
+    }
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
+    // Calculates outputs for the given inputs (in training mode the drop out mask set by ForwardTrainingCompute( ) is applied)
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override
+                         const XNetworkContext& ctx ) const override
     {
         XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
         {
@@ -76,17 +88,31 @@ public:
             {
                 float_t* dropOutMask = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
 
-                for ( size_t j = 0; j < mOutputsCount; j++ )
-                {
-                    dropOutMask[j] = ( mDistribution( mGenerator ) < mDropOutRate ) ? float_t( 0.0f ) : float_t( 1.0f );
-                }
+                output = input;
+                XVectorize::Mul( dropOutMask, output.data( ), mOutputsCount );
+            }
+        } );
+    }
+
+    // Generates new drop out mask for every training sample and applies it
+    void ForwardTrainingCompute( const std::vector<fvector_t*>& inputs,
+                                 std::vector<fvector_t*>& outputs,
+                                 const XNetworkContext& ctx ) override
+    {
+        if ( ctx.IsTraining( ) )
+        {
+            for ( size_t i = 0; i < inputs.size( ); i++ )
+            {
+                float_t* dropOutMask = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
 
                 for ( size_t j = 0; j < mOutputsCount; j++ )
                 {
-                    output[j] = input[j] * dropOutMask[j];
+                    dropOutMask[j] = ( mDistribution( mGenerator ) < mDropOutRate ) ? float_t( 0.0f ) : float_t( 1.0f );
                 }
             }
-        } );
+        }
+
+        ForwardCompute( inputs, outputs, ctx );
     }
 
     // Propagates error to the previous layer
@@ -109,10 +135,8 @@ public:
             {
                 float_t* dropOutMask = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
 
-                for ( size_t j = 0; j < mOutputsCount; j++ )
-                {
-                    prevDelta[j] = delta[j] * dropOutMask[j];
-                }
+                prevDelta = delta;
+                XVectorize::Mul( dropOutMask, prevDelta.data( ), mOutputsCount );
             }
         } );
     }
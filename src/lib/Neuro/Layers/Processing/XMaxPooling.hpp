@@ -111,10 +111,16 @@ public:
         return workingMemSize;
     }
 
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
     // Calculates outputs for the given inputs
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override
+                         const XNetworkContext& ctx ) const override
     {
         XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
         {
@@ -20,23 +20,89 @@
 
 #include "XConvolutionLayer.hpp"
 #include "../../Tools/XDataEncodingTools.hpp"
+#include "../../Tools/XGemm.hpp"
 #include "../../Tools/XParallel.hpp"
+#include "../../Tools/XVectorize.hpp"
+#include "../../Tools/XWinograd.hpp"
+#include <algorithm>
+#include <cstring>
+#include <assert.h>
 
 using namespace std;
 
 namespace ANNT { namespace Neuro {
 
+// Indexes of working buffers used by quantized inference - quantized inputs, lowered quantized inputs and their products with kernels
+static const size_t QUANTIZED_INPUT_BUFFER    = 3;
+static const size_t QUANTIZED_LOWERED_BUFFER  = 4;
+static const size_t QUANTIZED_PRODUCTS_BUFFER = 5;
+
+// Number of kernels' weights widened from half precision at once, so a block stays in cache while multiplied with inputs
+static const size_t HALF_PRECISION_BLOCK_SIZE = 64 * 1024;
+
+// Extra bytes of quantized input and lowered input buffers, so kernel rows can be copied by whole 8 byte words
+static const size_t QUANTIZED_COPY_SLACK = sizeof( uint64_t );
+
+// Lowers padded quantized input maps into rows of values covered by kernels at every output position (input maps x
+// kernel rows x kernel columns), which are loweredRowSize apart
+static void LowerQuantizedInput( const uint8_t* input, size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                                 size_t kernelWidth, size_t kernelHeight, size_t horizontalStep, size_t verticalStep,
+                                 size_t outputWidth, size_t outputHeight, uint8_t* lowered, size_t loweredRowSize )
+{
+    size_t inputMapSize = inputWidth * inputHeight;
+    bool   copyWords    = ( kernelWidth <= QUANTIZED_COPY_SLACK );
+
+    for ( size_t oy = 0; oy < outputHeight; oy++ )
+    {
+        for ( size_t ox = 0; ox < outputWidth; ox++ )
+        {
+            const uint8_t* window = input + oy * verticalStep * inputWidth + ox * horizontalStep;
+            uint8_t*       row    = lowered + ( oy * outputWidth + ox ) * loweredRowSize;
+
+            for ( size_t depthIndex = 0; depthIndex < inputDepth; depthIndex++, window += inputMapSize )
+            {
+                for ( size_t ky = 0; ky < kernelHeight; ky++, row += kernelWidth )
+                {
+                    const uint8_t* inputRow = window + ky * inputWidth;
+
+                    if ( copyWords )
+                    {
+                        // extra copied values get overwritten by the next kernel row or end up in row's padding
+                        memcpy( row, inputRow, QUANTIZED_COPY_SLACK );
+                    }
+                    else
+                    {
+                        memcpy( row, inputRow, kernelWidth );
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Splits working memory of the specified FFT slot into frequency domain product, scratch buffer and spatial plane
+static void GetFftSlot( const XRealFft2d& fft, void* buffer, size_t slotSize, size_t slotIndex,
+                        fcomplex_t** spectrum, fcomplex_t** scratch, float_t** plane )
+{
+    uint8_t* slot = static_cast<uint8_t*>( buffer ) + slotIndex * slotSize;
+
+    *spectrum = reinterpret_cast<fcomplex_t*>( slot );
+    *scratch  = *spectrum + fft.SpectrumSize( );
+    *plane    = reinterpret_cast<float_t*>( *scratch + fft.ScratchSize( ) );
+}
+
 XConvolutionLayer::XConvolutionLayer( size_t inputWidth, size_t inputHeight, size_t inputDepth,
                                       size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
-                                      const vector<bool>& connectionTable,
+                                      size_t groupsCount, const vector<bool>& connectionTable,
                                       BorderMode borderMode, size_t horizontalStep, size_t verticalStep ) :
                                       ITrainableLayer( 0, 0 ),
     mInputWidth( inputWidth ), mInputHeight( inputHeight ), mInputDepth( inputDepth ),
     mOutputWidth( 0 ), mOutputHeight( 0 ),
     mKernelWidth( kernelWidth ), mKernelHeight( kernelHeight ), mKernelsCount( kernelsCount ),
     mHorizontalStep( horizontalStep ), mVerticalStep( verticalStep ), mBorderMode( borderMode ),
-    mConnectionTable( connectionTable ), mKernelOffsets( mInputDepth * mKernelsCount ),
-    mPaddedWidth( inputWidth ), mPaddedHeight( inputHeight )
+    mConnectionTable( connectionTable ), mKernelOffsets( mInputDepth * mKernelsCount ), mGroupsCount( groupsCount ),
+    mPaddedWidth( inputWidth ), mPaddedHeight( inputHeight ), mPadLeft( 0 ), mPadTop( 0 ),
+    mAlgorithm( ConvolutionAlgorithm::Auto )
 {
     size_t padWidth = 0, padHeight = 0;
 
@@ -49,6 +115,10 @@ XConvolutionLayer::XConvolutionLayer( size_t inputWidth, size_t inputHeight, siz
 
         mPaddedWidth  = mInputWidth  + padWidth;
         mPaddedHeight = mInputHeight + padHeight;
+
+        // same as XDataEncodingTools::AddPadding2d() does - odd padding goes first to right/bottom
+        mPadLeft = padWidth  >> 1;
+        mPadTop  = padHeight >> 1;
     }
 
     // calculation of output width/height as:
@@ -60,10 +130,23 @@ XConvolutionLayer::XConvolutionLayer( size_t inputWidth, size_t inputHeight, siz
     Initialize( mInputWidth  * mInputHeight  * mInputDepth,
                 mOutputWidth * mOutputHeight * mKernelsCount );
 
-    // invalid or missing connections - assume all output feature maps are built using all input maps
-    if ( mConnectionTable.size( ) != mInputDepth * mKernelsCount )
+    if ( mGroupsCount != 0 )
+    {
+        // input maps and kernels must be split into groups evenly
+        assert( ( ( mInputDepth % mGroupsCount ) == 0 ) && ( ( mKernelsCount % mGroupsCount ) == 0 ) );
+
+        // connections of groups give kernels' offsets, so that kernels of every group are packed together
+        mConnectionTable = GroupedConnectionTable( mInputDepth, mKernelsCount, mGroupsCount );
+    }
+    else if ( mConnectionTable.size( ) != mInputDepth * mKernelsCount )
     {
+        // invalid or missing connections - assume all output feature maps are built using all input maps
         mConnectionTable = vector<bool>( mInputDepth * mKernelsCount, true );
+        mGroupsCount     = 1;
+    }
+    else if ( find( mConnectionTable.begin( ), mConnectionTable.end( ), false ) == mConnectionTable.end( ) )
+    {
+        mGroupsCount = 1;
     }
 
     // check number of kernels' weights and set offsets
@@ -84,18 +167,314 @@ XConvolutionLayer::XConvolutionLayer( size_t inputWidth, size_t inputHeight, siz
 
     // allocate vector of weights/biases
     mWeightCount = mKernelWidth * mKernelHeight * totalConnectionsCount;
-    mAllWeights  = fvector_t( mWeightCount + mKernelsCount );
+    AllocateWeights( mWeightCount + mKernelsCount );
 
-    // set up weights/biases pointers
-    mKernelsWeights = mAllWeights.data( );
-    mKernelsBiases  = mKernelsWeights + mWeightCount;
+    if ( IsDepthwise( ) )
+    {
+        mDepthwise = XDepthwiseConvolution( mInputWidth, mInputHeight, mInputDepth,
+                                            mKernelWidth, mKernelHeight, mKernelsCount / mInputDepth,
+                                            mPadLeft, mPadTop, mHorizontalStep, mVerticalStep,
+                                            mOutputWidth, mOutputHeight );
+    }
 
     Randomize( );
 }
 
+// Sets weights/biases pointers
+void XConvolutionLayer::SetWeightsPointers( )
+{
+    mKernelsWeights = mAllWeights;
+    mKernelsBiases  = OffsetWeights( mKernelsWeights, mWeightCount );
+}
+
+// Tells that we may need some extra memory for padding/unpadding or lowering inputs into matrices
+uvector_t XConvolutionLayer::WorkingMemSize( bool trainingMode ) const
+{
+    uvector_t            workingMemSize = uvector_t( 2, 0 );
+    ConvolutionAlgorithm algorithm      = SelectedAlgorithm( );
+
+    if ( ( !trainingMode ) && ( IsQuantized( ) ) )
+    {
+        // quantized inference does not need buffers of any algorithm
+        workingMemSize = uvector_t( QUANTIZED_PRODUCTS_BUFFER + 1, 0 );
+
+        workingMemSize[QUANTIZED_INPUT_BUFFER]    = mPaddedWidth * mPaddedHeight * mInputDepth * sizeof( uint8_t ) + QUANTIZED_COPY_SLACK;
+        workingMemSize[QUANTIZED_LOWERED_BUFFER]  = mOutputWidth * mOutputHeight * mQuantizedWeights.PaddedRowSize( ) * sizeof( uint8_t ) + QUANTIZED_COPY_SLACK;
+        workingMemSize[QUANTIZED_PRODUCTS_BUFFER] = mOutputWidth * mOutputHeight * mKernelsCount * sizeof( int32_t );
+    }
+    else if ( ( algorithm == ConvolutionAlgorithm::Winograd2x2 ) || ( algorithm == ConvolutionAlgorithm::Winograd4x4 ) )
+    {
+        size_t tileSize      = WinogradTileSize( );
+        size_t transformSize = XWinograd::TransformedTileSize( tileSize );
+        // tiles to cover outputs in forward pass and to cover inputs when propagating error backward
+        size_t forwardTiles  = XWinograd::TilesCount( mOutputWidth, mOutputHeight, tileSize );
+        size_t backwardTiles = XWinograd::TilesCount( mInputWidth,  mInputHeight,  tileSize );
+
+        workingMemSize = uvector_t( 3, 0 );
+
+        // lowered inputs are needed only for weights' gradients calculation
+        if ( trainingMode )
+        {
+            workingMemSize[0] = mInputDepth * mKernelWidth * mKernelHeight * mOutputWidth * mOutputHeight * sizeof( float_t );
+        }
+
+        // transformed inputs and their products with transformed kernels
+        workingMemSize[1] = transformSize * forwardTiles * mInputDepth   * sizeof( float_t );
+        workingMemSize[2] = transformSize * forwardTiles * mKernelsCount * sizeof( float_t );
+
+        if ( trainingMode )
+        {
+            workingMemSize[1] = max( workingMemSize[1], transformSize * backwardTiles * mKernelsCount * sizeof( float_t ) );
+            workingMemSize[2] = max( workingMemSize[2], transformSize * backwardTiles * mInputDepth   * sizeof( float_t ) );
+        }
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Fft )
+    {
+        workingMemSize = uvector_t( 3, 0 );
+
+        // spectra of inputs (kept for weights' gradients calculation) and spectra of deltas
+        workingMemSize[0] = mFft.SpectrumSize( ) * mInputDepth * sizeof( fcomplex_t );
+
+        if ( trainingMode )
+        {
+            workingMemSize[1] = mFft.SpectrumSize( ) * mKernelsCount * sizeof( fcomplex_t );
+        }
+
+        // slots for computing products of spectra and transforming them back - one per map for
+        // inference, since it is paralleled over maps
+        workingMemSize[2] = FftSlotSize( ) * ( ( trainingMode ) ? 1 : max( mInputDepth, mKernelsCount ) );
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Gemm )
+    {
+        // depthwise kernels work on inputs directly
+        if ( ( NeedsLowering( ) ) && ( !IsDepthwise( ) ) )
+        {
+            // lowered inputs are kept for weights' gradients calculation, plus the same size for lowered deltas
+            size_t loweredSize = mInputDepth * mKernelWidth * mKernelHeight * mOutputWidth * mOutputHeight * sizeof( float_t );
+
+            workingMemSize[0] = loweredSize;
+
+            if ( trainingMode )
+            {
+                workingMemSize[1] = loweredSize;
+            }
+        }
+    }
+    else if ( mBorderMode == BorderMode::Same )
+    {
+        workingMemSize[1] = workingMemSize[0] = mPaddedWidth * mPaddedHeight * mInputDepth * sizeof( float_t );
+    }
+
+    return workingMemSize;
+}
+
+// Resolves algorithm to use if it is set to Auto
+ConvolutionAlgorithm XConvolutionLayer::SelectedAlgorithm( ) const
+{
+    ConvolutionAlgorithm algorithm = mAlgorithm;
+
+    if ( IsHalfPrecision( ) )
+    {
+        // weights kept in half precision are widened for matrix multiplication, since other algorithms need kernels transformed
+        algorithm = ConvolutionAlgorithm::Gemm;
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Auto )
+    {
+        // Winograd pays off only when there are enough maps and tiles to amortize input/output transforms
+        if ( ( IsWinogradApplicable( ) ) && ( mGroupsCount == 1 ) && ( mInputDepth >= 16 ) && ( mKernelsCount >= 16 ) &&
+             ( mOutputWidth * mOutputHeight >= 256 ) )
+        {
+            algorithm = ConvolutionAlgorithm::Winograd4x4;
+        }
+        // FFT cost does not depend on kernel size, so it wins for large kernels (7x7+) on large inputs (64x64+)
+        else if ( ( IsFftApplicable( ) ) && ( mGroupsCount == 1 ) && ( mKernelWidth * mKernelHeight >= 49 ) &&
+                  ( mInputWidth * mInputHeight >= 4096 ) && ( mInputDepth >= 8 ) )
+        {
+            algorithm = ConvolutionAlgorithm::Fft;
+        }
+        else
+        {
+            algorithm = ConvolutionAlgorithm::Gemm;
+        }
+    }
+    else if ( ( ( algorithm == ConvolutionAlgorithm::Winograd2x2 ) || ( algorithm == ConvolutionAlgorithm::Winograd4x4 ) ) &&
+              ( !IsWinogradApplicable( ) ) )
+    {
+        algorithm = ConvolutionAlgorithm::Gemm;
+    }
+    else if ( ( algorithm == ConvolutionAlgorithm::Fft ) && ( !IsFftApplicable( ) ) )
+    {
+        algorithm = ConvolutionAlgorithm::Gemm;
+    }
+
+    return algorithm;
+}
+
+// Checks if inputs need to be lowered for matrix multiplication - not the case for 1x1 kernels with unit steps
+bool XConvolutionLayer::NeedsLowering( ) const
+{
+    return ( ( mKernelWidth != 1 ) || ( mKernelHeight != 1 ) || ( mHorizontalStep != 1 ) || ( mVerticalStep != 1 ) );
+}
+
+// Builds connection table for grouped convolution
+vector<bool> XConvolutionLayer::GroupedConnectionTable( size_t inputDepth, size_t kernelsCount, size_t groupsCount )
+{
+    vector<bool> connectionTable( inputDepth * kernelsCount, false );
+    size_t       groupInputs  = inputDepth   / groupsCount;
+    size_t       groupKernels = kernelsCount / groupsCount;
+
+    for ( size_t kernelIndex = 0; kernelIndex < kernelsCount; kernelIndex++ )
+    {
+        for ( size_t inputDepthIndex = 0; inputDepthIndex < inputDepth; inputDepthIndex++ )
+        {
+            connectionTable[kernelIndex * inputDepth + inputDepthIndex] = ( kernelIndex / groupKernels == inputDepthIndex / groupInputs );
+        }
+    }
+
+    return connectionTable;
+}
+
+// Checks if the layer does depthwise convolution - each input map is a group of its own
+bool XConvolutionLayer::IsDepthwise( ) const
+{
+    return ( ( mInputDepth > 1 ) && ( mGroupsCount == mInputDepth ) );
+}
+
+// Checks if Winograd algorithm can be used - 3x3 kernels with unit steps only, which are not grouped (transformed
+// kernels are dense)
+bool XConvolutionLayer::IsWinogradApplicable( ) const
+{
+    return ( ( mKernelWidth == 3 ) && ( mKernelHeight == 3 ) && ( mHorizontalStep == 1 ) && ( mVerticalStep == 1 ) &&
+             ( mGroupsCount <= 1 ) );
+}
+
+// Output tile size of the selected Winograd algorithm
+size_t XConvolutionLayer::WinogradTileSize( ) const
+{
+    ConvolutionAlgorithm algorithm = SelectedAlgorithm( );
+
+    return ( algorithm == ConvolutionAlgorithm::Winograd2x2 ) ? 2 :
+           ( algorithm == ConvolutionAlgorithm::Winograd4x4 ) ? 4 : 0;
+}
+
+// Checks if FFT based algorithm can be used - unit steps only
+bool XConvolutionLayer::IsFftApplicable( ) const
+{
+    return ( ( mHorizontalStep == 1 ) && ( mVerticalStep == 1 ) );
+}
+
+// Size of working memory needed to compute single frequency domain product and transform it back
+size_t XConvolutionLayer::FftSlotSize( ) const
+{
+    return ( mFft.SpectrumSize( ) + mFft.ScratchSize( ) ) * sizeof( fcomplex_t ) +
+             mFft.Height( ) * mFft.Width( ) * sizeof( float_t );
+}
+
+// Prepares weights for the selected algorithm after they get changed
+void XConvolutionLayer::PrepareWeights( )
+{
+    if ( IsHalfPrecision( ) )
+    {
+        // nothing is derived from weights kept in half precision - those are widened while computing outputs
+        fvector_t( ).swap( mDenseWeights );
+        fvector_t( ).swap( mWinogradKernels );
+        fvector_t( ).swap( mWinogradBackwardKernels );
+        cvector_t( ).swap( mKernelsSpectra );
+        mFft = XRealFft2d( );
+        return;
+    }
+
+    // kernels of grouped convolution are multiplied as they are kept, so only arbitrary connections need dense weights
+    if ( mGroupsCount == 0 )
+    {
+        BuildDenseWeights( mDenseWeights );
+    }
+    else
+    {
+        fvector_t( ).swap( mDenseWeights );
+    }
+
+    size_t tileSize = WinogradTileSize( );
+
+    if ( tileSize != 0 )
+    {
+        // missing connections are zero kernels in dense weights, so they stay zeros after transformation as well
+        const float_t* weights         = ( mGroupsCount == 1 ) ? mKernelsWeights : mDenseWeights.data( );
+        size_t         transformedSize = XWinograd::TransformedTileSize( tileSize ) * mKernelsCount * mInputDepth;
+
+        mWinogradKernels.resize( transformedSize );
+        mWinogradBackwardKernels.resize( transformedSize );
+
+        XWinograd::TransformKernels( weights, mKernelsCount, mInputDepth, tileSize, false, mWinogradKernels.data( ) );
+        XWinograd::TransformKernels( weights, mKernelsCount, mInputDepth, tileSize, true,  mWinogradBackwardKernels.data( ) );
+    }
+    else
+    {
+        mWinogradKernels.clear( );
+        mWinogradBackwardKernels.clear( );
+    }
+
+    if ( SelectedAlgorithm( ) == ConvolutionAlgorithm::Fft )
+    {
+        // transform is built only when FFT algorithm gets selected; it must be large enough to avoid
+        // wrapping around of circular convolution into valid outputs
+        if ( mFft.Width( ) == 0 )
+        {
+            mFft = XRealFft2d( XFft::GoodSize( mPaddedHeight ), XRealFft2d::GoodWidth( mPaddedWidth ) );
+        }
+
+        size_t    spectrumSize = mFft.SpectrumSize( );
+        fvector_t plane( mFft.Height( ) * mFft.Width( ), float_t( 0 ) );
+        cvector_t scratch( mFft.ScratchSize( ) );
+
+        mKernelsSpectra.resize( spectrumSize * mConnectionTable.size( ) );
+
+        // kernels are placed into top-left corner of otherwise zero plane
+        for ( size_t connectionIndex = 0, n = mConnectionTable.size( ); connectionIndex < n; connectionIndex++ )
+        {
+            if ( mConnectionTable[connectionIndex] )
+            {
+                const float_t* kernel = mKernelsWeights + mKernelOffsets[connectionIndex];
+
+                for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+                {
+                    copy( kernel + ky * mKernelWidth, kernel + ( ky + 1 ) * mKernelWidth, plane.begin( ) + ky * mFft.Width( ) );
+                }
+
+                mFft.Forward( plane.data( ), mKernelsSpectra.data( ) + connectionIndex * spectrumSize, scratch.data( ) );
+            }
+        }
+    }
+    else
+    {
+        mFft = XRealFft2d( );
+        cvector_t( ).swap( mKernelsSpectra );
+    }
+}
+
+// Lays out kernels as dense matrix, where missing connections are zero kernels
+void XConvolutionLayer::BuildDenseWeights( fvector_t& denseWeights ) const
+{
+    size_t kernelSize = mKernelWidth * mKernelHeight;
+
+    denseWeights.assign( mKernelsCount * mInputDepth * kernelSize, float_t( 0 ) );
+
+    for ( size_t connectionIndex = 0, n = mConnectionTable.size( ); connectionIndex < n; connectionIndex++ )
+    {
+        if ( mConnectionTable[connectionIndex] )
+        {
+            copy( mKernelsWeights + mKernelOffsets[connectionIndex],
+                  mKernelsWeights + mKernelOffsets[connectionIndex] + kernelSize,
+                  denseWeights.begin( ) + connectionIndex * kernelSize );
+        }
+    }
+}
+
 // Randomizes layer's weights, clears biases
 void XConvolutionLayer::Randomize( )
 {
+    UnmapWeights( );
+
     float halfRange = sqrt( 3.0f / ( mKernelWidth * mKernelHeight * mInputDepth ) );
 
     for ( size_t i = 0; i < mWeightCount; i++ )
@@ -106,12 +485,116 @@ void XConvolutionLayer::Randomize( )
     {
         mKernelsBiases[i] = 0;
     }
+
+    PrepareWeights( );
+}
+
+// Scales outputs of every kernel and shifts them by changing weights and biases
+void XConvolutionLayer::ScaleOutputs( const fvector_t& scale, const fvector_t& shift )
+{
+    size_t kernelSize = mKernelWidth * mKernelHeight;
+
+    UnmapWeights( );
+
+    for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+    {
+        for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
+        {
+            size_t connectionIndex = kernelIndex * mInputDepth + inputDepthIndex;
+
+            if ( mConnectionTable[connectionIndex] )
+            {
+                float_t* kernel = mKernelsWeights + mKernelOffsets[connectionIndex];
+
+                XVectorize::Scale( kernel, scale[kernelIndex], kernel, kernelSize );
+            }
+        }
+
+        mKernelsBiases[kernelIndex] = mKernelsBiases[kernelIndex] * scale[kernelIndex] + shift[kernelIndex];
+    }
+
+    WeightsChanged( );
+}
+
+// Scales bias of every kernel by the number of input maps connected to it
+void XConvolutionLayer::ScaleLegacyBiases( )
+{
+    UnmapWeights( );
+
+    for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+    {
+        auto   connections      = mConnectionTable.begin( ) + kernelIndex * mInputDepth;
+        size_t connectionsCount = static_cast<size_t>( count( connections, connections + mInputDepth, true ) );
+
+        mKernelsBiases[kernelIndex] *= static_cast<float_t>( connectionsCount );
+    }
+
+    WeightsChanged( );
 }
 
 // Calculates outputs for the given inputs
 void XConvolutionLayer::ForwardCompute( const vector<fvector_t*>& inputs,
                                         vector<fvector_t*>& outputs,
-                                        const XNetworkContext& ctx )
+                                        const XNetworkContext& ctx ) const
+{
+    ForwardCompute( inputs, outputs, ctx, nullptr );
+}
+
+// Calculates outputs for the given inputs and applies element wise activation to them
+void XConvolutionLayer::ForwardCompute( const vector<fvector_t*>& inputs,
+                                        vector<fvector_t*>& outputs,
+                                        const XNetworkContext& ctx,
+                                        const IActivationLayer* activation ) const
+{
+    ConvolutionAlgorithm algorithm = SelectedAlgorithm( );
+
+    if ( ( !ctx.IsTraining( ) ) && ( IsQuantized( ) ) )
+    {
+        ForwardQuantized( inputs, outputs, ctx );
+    }
+    else if ( ( algorithm == ConvolutionAlgorithm::Gemm ) && ( IsDepthwise( ) ) )
+    {
+        ForwardDepthwise( inputs, outputs, ctx );
+    }
+    else if ( IsHalfPrecision( ) )
+    {
+        // widened blocks of kernels are activated as soon as they are multiplied
+        ForwardHalfPrecision( inputs, outputs, ctx, activation );
+        return;
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Gemm )
+    {
+        // matrix multiplication activates blocks of outputs as soon as it completes them
+        ForwardGemm( inputs, outputs, ctx, activation );
+        return;
+    }
+    else if ( ( algorithm == ConvolutionAlgorithm::Winograd2x2 ) || ( algorithm == ConvolutionAlgorithm::Winograd4x4 ) )
+    {
+        ForwardWinograd( inputs, outputs, ctx );
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Fft )
+    {
+        ForwardFft( inputs, outputs, ctx );
+    }
+    else
+    {
+        ForwardDirect( inputs, outputs, ctx );
+    }
+
+    // other algorithms get their outputs activated in place once computed
+    if ( activation != nullptr )
+    {
+        XParallel::For( outputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+        {
+            activation->ForwardActivate( outputs[i]->data( ), outputs[i]->data( ), outputs[i]->size( ) );
+        } );
+    }
+}
+
+// Calculates outputs by sliding kernels over input maps
+void XConvolutionLayer::ForwardDirect( const vector<fvector_t*>& inputs,
+                                       vector<fvector_t*>& outputs,
+                                       const XNetworkContext& ctx ) const
 {
     // will be using either original input width/heigh or padded
     size_t  inputWidth   = mInputWidth;
@@ -145,14 +628,13 @@ void XConvolutionLayer::ForwardCompute( const vector<fvector_t*>& inputs,
             inputData = paddedInput;
         }
 
-        // clear the output
-        fill( outputData, outputData + mOutputsCount, float_t( 0 ) );
-
         // go through all kernels to build output feature maps
         XParallel::For( mKernelsCount, !ctx.IsTraining( ), [&]( size_t kernelIndex )
         {
             float_t* outputBase = outputData + kernelIndex * mOutputWidth * mOutputHeight;
-            float_t  biasValue  = mKernelsBiases[kernelIndex];
+
+            // start with bias value in the output feature map
+            fill( outputBase, outputBase + mOutputWidth * mOutputHeight, mKernelsBiases[kernelIndex] );
 
             // go through all input layers (or feature maps produced by previous layers)
             for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
@@ -195,7 +677,6 @@ void XConvolutionLayer::ForwardCompute( const vector<fvector_t*>& inputs,
                         }
 
                         *outputRow += sum;
-                        *outputRow += biasValue;
 
                         // shift output/input row pointers to the next position of the sliding kernel's window
                         outputRow++;
@@ -212,13 +693,58 @@ void XConvolutionLayer::BackwardCompute( const vector<fvector_t*>& inputs,
                                          const vector<fvector_t*>& /* outputs */,
                                          const vector<fvector_t*>& deltas,
                                          vector<fvector_t*>& prevDeltas,
-                                         fvector_t& gradWeights,
+                                         float_t* gradWeights,
                                          const XNetworkContext& ctx )
 {
     // set up weights/biases gradients pointers
-    float_t* gradWeightsData = gradWeights.data( );
+    float_t* gradWeightsData = gradWeights;
     float_t* gradBiasesData  = gradWeightsData + mWeightCount;
     size_t   outputSize      = mOutputWidth * mOutputHeight;
+
+    // 1/2 - propagate deltas to the previous layer and accumulate weights' difference
+    ConvolutionAlgorithm algorithm = SelectedAlgorithm( );
+
+    if ( ( algorithm == ConvolutionAlgorithm::Gemm ) && ( IsDepthwise( ) ) )
+    {
+        BackwardDepthwise( inputs, deltas, prevDeltas, gradWeightsData, ctx );
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Gemm )
+    {
+        BackwardGemm( inputs, deltas, prevDeltas, gradWeightsData, ctx );
+    }
+    else if ( ( algorithm == ConvolutionAlgorithm::Winograd2x2 ) || ( algorithm == ConvolutionAlgorithm::Winograd4x4 ) )
+    {
+        BackwardWinograd( inputs, deltas, prevDeltas, gradWeightsData, ctx );
+    }
+    else if ( algorithm == ConvolutionAlgorithm::Fft )
+    {
+        BackwardFft( inputs, deltas, prevDeltas, gradWeightsData, ctx );
+    }
+    else
+    {
+        BackwardDirect( inputs, deltas, prevDeltas, gradWeightsData, ctx );
+    }
+
+    // 3 - accumulate baises' difference, samples in parallel
+    mGradientsAccumulator.For( inputs.size( ), ctx.IsTraining( ), gradBiasesData, mKernelsCount, [&]( size_t i, float_t* gradBiases )
+    {
+        const float_t* deltaPtr = deltas[i]->data( );
+
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++, deltaPtr += outputSize )
+        {
+            gradBiases[kernelIndex] += XVectorize::Sum( deltaPtr, outputSize );
+        }
+    } );
+}
+
+// Propagates error to the previous layer and calculates weights' gradients by sliding kernels over inputs/deltas
+void XConvolutionLayer::BackwardDirect( const vector<fvector_t*>& inputs,
+                                        const vector<fvector_t*>& deltas,
+                                        vector<fvector_t*>& prevDeltas,
+                                        float_t* gradWeightsData,
+                                        const XNetworkContext& ctx )
+{
+    size_t   outputSize      = mOutputWidth * mOutputHeight;
     // will be using either original input width/heigh or padded
     size_t   inputWidth      = mInputWidth;
     size_t   inputHeight     = mInputHeight;
@@ -246,7 +772,7 @@ void XConvolutionLayer::BackwardCompute( const vector<fvector_t*>& inputs,
             prevDeltaData = static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) );
         }
 
-        fill( prevDeltaData, prevDeltaData + mInputsCount, float_t( 0 ) );
+        fill( prevDeltaData, prevDeltaData + inputWidth * inputHeight * mInputDepth, float_t( 0 ) );
 
         // go through all input feature maps (which are the outputs of the previous layer)
         for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
@@ -309,108 +835,764 @@ void XConvolutionLayer::BackwardCompute( const vector<fvector_t*>& inputs,
 
     // 2 - accumulate weights' difference
 
-    // go through all input feature maps
-    XParallel::For( mInputDepth, ctx.IsTraining( ), [&]( size_t inputDepthIndex )
+    // go through all samples and kernels - every thread accumulates into its own gradients' buffer
+    mGradientsAccumulator.For( inputs.size( ) * mKernelsCount, ctx.IsTraining( ), gradWeightsData, mWeightCount, [&]( size_t task, float_t* gradWeights )
     {
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+        size_t         i           = task / mKernelsCount;
+        size_t         kernelIndex = task % mKernelsCount;
+        const float_t* deltaBase   = deltas[i]->data( ) + kernelIndex * outputSize;
+        const float_t* inputData   = inputs[i]->data( );
+
+        if ( mBorderMode == BorderMode::Same )
         {
-            const float_t* deltaData = deltas[i]->data( );
-            const float_t* inputData = inputs[i]->data( );
+            // get working buffer for padded inputs
+            inputData = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
+        }
 
-            if ( mBorderMode == BorderMode::Same )
+        // go through all input feature maps, the kernel was applied to
+        for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
+        {
+            if ( !mConnectionTable[kernelIndex * mInputDepth + inputDepthIndex] )
             {
-                // get working buffer for padded inputs
-                inputData = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
+                // the input map is not used for the output feature map
+                continue;
             }
 
             const float_t* inputBase = inputData + inputDepthIndex * inputWidth * inputHeight;
+            // get the 2D portion of weights' gradients for the current input/output map combination
+            float_t* gradWeightsPtr  = gradWeights + mKernelOffsets[kernelIndex * mInputDepth + inputDepthIndex];
 
-            // go through all kernels, which were applied to the feature map
-            for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+            // calculate gradients for each weight (kernel element)
+            for ( size_t ky = 0; ky < mKernelHeight; ky++ )
             {
-                if ( !mConnectionTable[kernelIndex * mInputDepth + inputDepthIndex] )
+                for ( size_t kx = 0; kx < mKernelWidth; kx++ )
                 {
-                    // the input map is not used for the output feature map
+                    float_t sum = float_t( 0 );
+
+                    // multiply output deltas by corresponding inputs
+                    for ( size_t oy = 0; oy < mOutputHeight; oy++ )
+                    {
+                        const float_t* deltaPtr = deltaBase + oy * mOutputWidth;
+                        const float_t* inputPtr = inputBase + oy * inputRowInc + ky * inputWidth + kx;
+
+                        for ( size_t ox = 0; ox < mOutputWidth; ox++ )
+                        {
+                            sum += *deltaPtr * *inputPtr;
+
+                            deltaPtr++;
+                            inputPtr += mHorizontalStep;
+                        }
+                    }
+
+                    *gradWeightsPtr += sum;
+                    gradWeightsPtr++;
+                }
+            }
+        }
+    } );
+}
+
+// Calculates outputs as multiplication of kernels' weights matrix and lowered inputs. For grouped convolution
+// every group of kernels is multiplied with the lowered inputs of its group only.
+void XConvolutionLayer::ForwardGemm( const vector<fvector_t*>& inputs,
+                                     vector<fvector_t*>& outputs,
+                                     const XNetworkContext& ctx,
+                                     const IActivationLayer* activation ) const
+{
+    size_t         outputSize    = mOutputWidth * mOutputHeight;
+    size_t         groupsCount   = ( mGroupsCount == 0 ) ? 1 : mGroupsCount;
+    size_t         groupKernels  = mKernelsCount / groupsCount;
+    size_t         loweredRows   = mInputDepth / groupsCount * mKernelWidth * mKernelHeight;
+    bool           needsLowering = NeedsLowering( );
+
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        const float_t* inputData  = inputs[i]->data( );
+        float_t*       outputData = outputs[i]->data( );
+        const float_t* weights    = ( mGroupsCount != 0 ) ? mKernelsWeights : mDenseWeights.data( );
+        const float_t* biases     = mKernelsBiases;
+
+        if ( needsLowering )
+        {
+            // padding is handled while lowering, so no need to pad inputs first
+            float_t* loweredInput = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
+
+            XDataEncodingTools::Im2Col( inputData, loweredInput, mInputWidth, mInputHeight, mInputDepth,
+                                        mKernelWidth, mKernelHeight, mPadLeft, mPadTop,
+                                        mHorizontalStep, mVerticalStep, mOutputWidth, mOutputHeight );
+            inputData = loweredInput;
+        }
+
+        // start with bias values in the output feature maps
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+        {
+            fill( outputData + kernelIndex * outputSize, outputData + ( kernelIndex + 1 ) * outputSize, biases[kernelIndex] );
+        }
+
+        // outputs = weights * loweredInputs + biases
+        for ( size_t groupIndex = 0; groupIndex < groupsCount; groupIndex++ )
+        {
+            const float_t* groupWeights = weights + groupIndex * groupKernels * loweredRows;
+            const float_t* groupInput   = inputData + groupIndex * loweredRows * outputSize;
+            float_t*       groupOutput  = outputData + groupIndex * groupKernels * outputSize;
+
+            if ( activation == nullptr )
+            {
+                XGemm::Multiply( false, false, groupKernels, outputSize, loweredRows,
+                                 float_t( 1 ), groupWeights, loweredRows, groupInput, outputSize,
+                                 float_t( 1 ), groupOutput, outputSize, !ctx.IsTraining( ) );
+            }
+            else
+            {
+                XGemm::Multiply( false, false, groupKernels, outputSize, loweredRows,
+                                 float_t( 1 ), groupWeights, loweredRows, groupInput, outputSize,
+                                 float_t( 1 ), groupOutput, outputSize,
+                                 [activation]( float_t* values, size_t count )
+                                 {
+                                     activation->ForwardActivate( values, values, count );
+                                 }, !ctx.IsTraining( ) );
+            }
+        }
+    } );
+}
+
+// Propagates error to the previous layer and calculates weights' gradients using matrix multiplications
+void XConvolutionLayer::BackwardGemm( const vector<fvector_t*>& inputs,
+                                      const vector<fvector_t*>& deltas,
+                                      vector<fvector_t*>& prevDeltas,
+                                      float_t* gradWeightsData,
+                                      const XNetworkContext& ctx )
+{
+    size_t         outputSize    = mOutputWidth * mOutputHeight;
+    size_t         groupsCount   = ( mGroupsCount == 0 ) ? 1 : mGroupsCount;
+    size_t         groupKernels  = mKernelsCount / groupsCount;
+    size_t         loweredRows   = mInputDepth / groupsCount * mKernelWidth * mKernelHeight;
+    const float_t* weights       = ( mGroupsCount != 0 ) ? mKernelsWeights : mDenseWeights.data( );
+    bool           needsLowering = NeedsLowering( );
+
+    // 1 - first propagate deltas to the previous layer: lowered deltas = weights^T * deltas,
+    //     which are then accumulated back into input maps' shape
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        const float_t* deltaData     = deltas[i]->data( );
+        float_t*       prevDeltaData = prevDeltas[i]->data( );
+        float_t*       loweredDelta  = ( needsLowering ) ? static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) ) : prevDeltaData;
+
+        // without lowering ( 1x1 kernels ) the product is the previous layer's deltas already
+        for ( size_t groupIndex = 0; groupIndex < groupsCount; groupIndex++ )
+        {
+            XGemm::Multiply( true, false, loweredRows, outputSize, groupKernels,
+                             float_t( 1 ), weights + groupIndex * groupKernels * loweredRows, loweredRows,
+                             deltaData + groupIndex * groupKernels * outputSize, outputSize,
+                             float_t( 0 ), loweredDelta + groupIndex * loweredRows * outputSize, outputSize, false );
+        }
+
+        if ( needsLowering )
+        {
+            fill( prevDeltaData, prevDeltaData + mInputsCount, float_t( 0 ) );
+
+            XDataEncodingTools::Col2Im( loweredDelta, prevDeltaData, mInputWidth, mInputHeight, mInputDepth,
+                                        mKernelWidth, mKernelHeight, mPadLeft, mPadTop,
+                                        mHorizontalStep, mVerticalStep, mOutputWidth, mOutputHeight );
+        }
+    } );
+
+    // 2 - accumulate weights' difference
+    CalculateGradientsGemm( inputs, deltas, gradWeightsData, ctx );
+}
+
+// Accumulates weights' gradients as gradWeights += deltas * loweredInputs^T (lowered inputs are expected to be
+// in the working buffer 0 if lowering is needed). Grouped convolution accumulates straight into kernels' gradients,
+// while for irregular connection tables gradients are calculated for all connections and then the needed are picked.
+// Samples/groups are processed in parallel, each thread accumulating into its own gradients' buffer.
+void XConvolutionLayer::CalculateGradientsGemm( const vector<fvector_t*>& inputs,
+                                                const vector<fvector_t*>& deltas,
+                                                float_t* gradWeightsData,
+                                                const XNetworkContext& ctx )
+{
+    size_t    outputSize    = mOutputWidth * mOutputHeight;
+    size_t    groupsCount   = ( mGroupsCount == 0 ) ? 1 : mGroupsCount;
+    size_t    groupKernels  = mKernelsCount / groupsCount;
+    size_t    loweredRows   = mInputDepth / groupsCount * mKernelWidth * mKernelHeight;
+    bool      needsLowering = NeedsLowering( );
+    fvector_t denseGradWeights;
+    float_t*  gradDense = gradWeightsData;
+
+    if ( mGroupsCount == 0 )
+    {
+        denseGradWeights = fvector_t( mKernelsCount * loweredRows, float_t( 0 ) );
+        gradDense        = denseGradWeights.data( );
+    }
+
+    size_t tasksCount   = inputs.size( ) * groupsCount;
+    // single multiplication is better to be parallelized on its own
+    bool   parallelGemm = ( tasksCount == 1 );
+
+    mGradientsAccumulator.For( tasksCount, ctx.IsTraining( ), gradDense, mKernelsCount * loweredRows, [&]( size_t task, float_t* gradWeights )
+    {
+        size_t         i            = task / groupsCount;
+        size_t         groupIndex   = task % groupsCount;
+        const float_t* loweredInput = ( needsLowering ) ? static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) ) : inputs[i]->data( );
+
+        XGemm::Multiply( false, true, groupKernels, loweredRows, outputSize,
+                         float_t( 1 ), deltas[i]->data( ) + groupIndex * groupKernels * outputSize, outputSize,
+                         loweredInput + groupIndex * loweredRows * outputSize, outputSize,
+                         float_t( 1 ), gradWeights + groupIndex * groupKernels * loweredRows, loweredRows, parallelGemm );
+    } );
+
+    if ( mGroupsCount == 0 )
+    {
+        size_t kernelSize = mKernelWidth * mKernelHeight;
+
+        for ( size_t connectionIndex = 0, n = mConnectionTable.size( ); connectionIndex < n; connectionIndex++ )
+        {
+            if ( mConnectionTable[connectionIndex] )
+            {
+                const float_t* src = gradDense + connectionIndex * kernelSize;
+                float_t*       dst = gradWeightsData + mKernelOffsets[connectionIndex];
+
+                for ( size_t j = 0; j < kernelSize; j++ )
+                {
+                    dst[j] += src[j];
+                }
+            }
+        }
+    }
+}
+
+// Calculates outputs of depthwise convolution - every input map is convolved with its own kernels only
+void XConvolutionLayer::ForwardDepthwise( const vector<fvector_t*>& inputs,
+                                          vector<fvector_t*>& outputs,
+                                          const XNetworkContext& ctx ) const
+{
+    const float_t* weights = mKernelsWeights;
+    const float_t* biases  = mKernelsBiases;
+    fvector_t      widened;
+
+    // depthwise kernels are small, so those are widened all at once
+    if ( IsHalfPrecision( ) )
+    {
+        widened = fvector_t( mWeightCount + mKernelsCount );
+        CopyWeights( 0, mWeightCount + mKernelsCount, widened.data( ) );
+
+        weights = widened.data( );
+        biases  = weights + mWeightCount;
+    }
+
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        mDepthwise.Forward( inputs[i]->data( ), weights, biases, outputs[i]->data( ), !ctx.IsTraining( ) );
+    } );
+}
+
+// Calculates outputs using kernels kept in half precision. Inputs of all samples are lowered first, so every block of
+// kernels is widened only once and then multiplied with lowered inputs of every sample, giving final values of the block's outputs.
+void XConvolutionLayer::ForwardHalfPrecision( const vector<fvector_t*>& inputs,
+                                              vector<fvector_t*>& outputs,
+                                              const XNetworkContext& ctx,
+                                              const IActivationLayer* activation ) const
+{
+    size_t                 batchSize     = inputs.size( );
+    size_t                 outputSize    = mOutputWidth * mOutputHeight;
+    size_t                 groupsCount   = ( mGroupsCount == 0 ) ? 1 : mGroupsCount;
+    size_t                 groupKernels  = mKernelsCount / groupsCount;
+    size_t                 loweredRows   = mInputDepth / groupsCount * mKernelWidth * mKernelHeight;
+    size_t                 blockKernels  = min( groupKernels, max( size_t( 1 ), HALF_PRECISION_BLOCK_SIZE / loweredRows ) );
+    bool                   needsLowering = NeedsLowering( );
+    fvector_t              biases( mKernelsCount );
+    fvector_t              widened( blockKernels * loweredRows );
+    vector<const float_t*> loweredInputs( batchSize );
+
+    function<void( float_t*, size_t )> epilogue;
+
+    if ( activation != nullptr )
+    {
+        epilogue = [activation]( float_t* values, size_t count )
+        {
+            activation->ForwardActivate( values, values, count );
+        };
+    }
+
+    CopyWeights( mWeightCount, mKernelsCount, biases.data( ) );
+
+    XParallel::For( batchSize, ctx.IsTraining( ), [&]( size_t i )
+    {
+        float_t* outputData = outputs[i]->data( );
+
+        loweredInputs[i] = inputs[i]->data( );
+
+        if ( needsLowering )
+        {
+            float_t* loweredInput = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
+
+            XDataEncodingTools::Im2Col( inputs[i]->data( ), loweredInput, mInputWidth, mInputHeight, mInputDepth,
+                                        mKernelWidth, mKernelHeight, mPadLeft, mPadTop,
+                                        mHorizontalStep, mVerticalStep, mOutputWidth, mOutputHeight );
+            loweredInputs[i] = loweredInput;
+        }
+
+        // start with bias values in the output feature maps
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+        {
+            fill( outputData + kernelIndex * outputSize, outputData + ( kernelIndex + 1 ) * outputSize, biases[kernelIndex] );
+        }
+    } );
+
+    for ( size_t groupIndex = 0; groupIndex < groupsCount; groupIndex++ )
+    {
+        for ( size_t blockStart = 0; blockStart < groupKernels; blockStart += blockKernels )
+        {
+            size_t firstKernel  = groupIndex * groupKernels + blockStart;
+            size_t kernelsCount = min( blockKernels, groupKernels - blockStart );
+
+            WidenKernels( firstKernel, kernelsCount, widened.data( ) );
+
+            for ( size_t i = 0; i < batchSize; i++ )
+            {
+                XGemm::Multiply( false, false, kernelsCount, outputSize, loweredRows,
+                                 float_t( 1 ), widened.data( ), loweredRows, loweredInputs[i] + groupIndex * loweredRows * outputSize, outputSize,
+                                 float_t( 1 ), outputs[i]->data( ) + firstKernel * outputSize, outputSize, epilogue, !ctx.IsTraining( ) );
+            }
+        }
+    }
+}
+
+// Widens the specified kernels kept in half precision into rows of the weights matrix used by Gemm algorithm -
+// kernels of grouped convolution are kept packed as needed, while the rest are widened into rows of dense weights
+void XConvolutionLayer::WidenKernels( size_t firstKernel, size_t kernelsCount, float_t* widened ) const
+{
+    if ( mGroupsCount != 0 )
+    {
+        size_t kernelWeights = mWeightCount / mKernelsCount;
+
+        CopyWeights( firstKernel * kernelWeights, kernelsCount * kernelWeights, widened );
+    }
+    else
+    {
+        size_t kernelSize = mKernelWidth * mKernelHeight;
+
+        fill( widened, widened + kernelsCount * mInputDepth * kernelSize, float_t( 0 ) );
+
+        for ( size_t connectionIndex = firstKernel * mInputDepth, n = ( firstKernel + kernelsCount ) * mInputDepth;
+              connectionIndex < n; connectionIndex++ )
+        {
+            if ( mConnectionTable[connectionIndex] )
+            {
+                CopyWeights( mKernelOffsets[connectionIndex], kernelSize, widened + ( connectionIndex - firstKernel * mInputDepth ) * kernelSize );
+            }
+        }
+    }
+}
+
+// Propagates error to the previous layer and calculates weights' gradients of depthwise convolution
+void XConvolutionLayer::BackwardDepthwise( const vector<fvector_t*>& inputs,
+                                           const vector<fvector_t*>& deltas,
+                                           vector<fvector_t*>& prevDeltas,
+                                           float_t* gradWeightsData,
+                                           const XNetworkContext& ctx )
+{
+    // 1 - propagate deltas to the previous layer
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        mDepthwise.Backward( deltas[i]->data( ), mKernelsWeights, prevDeltas[i]->data( ), false );
+    } );
+
+    // 2 - accumulate weights' difference, samples in parallel (or kernels, if there is single sample only)
+    mGradientsAccumulator.For( inputs.size( ), ctx.IsTraining( ), gradWeightsData, mWeightCount, [&]( size_t i, float_t* gradWeights )
+    {
+        mDepthwise.CalculateGradients( inputs[i]->data( ), deltas[i]->data( ), gradWeights, ( inputs.size( ) == 1 ) );
+    } );
+}
+
+// Calculates outputs using Winograd algorithm - inputs and kernels are transformed into tiles, which are multiplied
+// element-wise (as matrix multiplications over all input maps) and then transformed back into outputs
+void XConvolutionLayer::ForwardWinograd( const vector<fvector_t*>& inputs,
+                                         vector<fvector_t*>& outputs,
+                                         const XNetworkContext& ctx ) const
+{
+    size_t tileSize = WinogradTileSize( );
+
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        // padding is handled while transforming input tiles
+        XWinograd::Convolve( inputs[i]->data( ), mInputWidth, mInputHeight, mInputDepth,
+                             mWinogradKernels.data( ), mKernelsCount, tileSize, mPadLeft, mPadTop,
+                             outputs[i]->data( ), mOutputWidth, mOutputHeight, mKernelsBiases,
+                             static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) ),
+                             static_cast<float_t*>( ctx.GetWorkingBuffer( 2, i ) ), !ctx.IsTraining( ) );
+    } );
+}
+
+// Propagates error to the previous layer using Winograd algorithm and calculates weights' gradients using
+// matrix multiplications
+void XConvolutionLayer::BackwardWinograd( const vector<fvector_t*>& inputs,
+                                          const vector<fvector_t*>& deltas,
+                                          vector<fvector_t*>& prevDeltas,
+                                          float_t* gradWeightsData,
+                                          const XNetworkContext& ctx )
+{
+    size_t tileSize = WinogradTileSize( );
+
+    // 1 - propagate deltas to the previous layer, which is "full" convolution of deltas with kernels rotated
+    //     by 180 degrees, i.e. deltas are padded with ( kernelSize - 1 - pad ) zeros. Also lower inputs
+    //     for the next step.
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        XWinograd::Convolve( deltas[i]->data( ), mOutputWidth, mOutputHeight, mKernelsCount,
+                             mWinogradBackwardKernels.data( ), mInputDepth, tileSize,
+                             mKernelWidth - 1 - mPadLeft, mKernelHeight - 1 - mPadTop,
+                             prevDeltas[i]->data( ), mInputWidth, mInputHeight, nullptr,
+                             static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) ),
+                             static_cast<float_t*>( ctx.GetWorkingBuffer( 2, i ) ), false );
+
+        XDataEncodingTools::Im2Col( inputs[i]->data( ), static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) ),
+                                    mInputWidth, mInputHeight, mInputDepth,
+                                    mKernelWidth, mKernelHeight, mPadLeft, mPadTop,
+                                    mHorizontalStep, mVerticalStep, mOutputWidth, mOutputHeight );
+    } );
+
+    // 2 - accumulate weights' difference
+    CalculateGradientsGemm( inputs, deltas, gradWeightsData, ctx );
+}
+
+// Calculates outputs in frequency domain. Correlation of input with kernel turns into multiplication of input's spectrum
+// with conjugated spectrum of the kernel. The transform size is large enough for circular correlation not to wrap
+// around into the valid part of output.
+void XConvolutionLayer::ForwardFft( const vector<fvector_t*>& inputs,
+                                    vector<fvector_t*>& outputs,
+                                    const XNetworkContext& ctx ) const
+{
+    size_t spectrumSize = mFft.SpectrumSize( );
+    size_t planeWidth   = mFft.Width( );
+    size_t planeSize    = mFft.Height( ) * planeWidth;
+    size_t slotSize     = FftSlotSize( );
+    size_t outputSize   = mOutputWidth * mOutputHeight;
+
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        const float_t* inputData     = inputs[i]->data( );
+        float_t*       outputData    = outputs[i]->data( );
+        fcomplex_t*    inputsSpectra = static_cast<fcomplex_t*>( ctx.GetWorkingBuffer( 0, i ) );
+        void*          slots         = ctx.GetWorkingBuffer( 2, i );
+
+        // 1 - get spectra of input maps (padding is done by placing input at the needed offset)
+        XParallel::For( mInputDepth, !ctx.IsTraining( ), [&]( size_t inputDepthIndex )
+        {
+            const float_t* inputBase = inputData + inputDepthIndex * mInputWidth * mInputHeight;
+            fcomplex_t*    spectrum;
+            fcomplex_t*    scratch;
+            float_t*       plane;
+
+            GetFftSlot( mFft, slots, slotSize, ( ctx.IsTraining( ) ) ? 0 : inputDepthIndex, &spectrum, &scratch, &plane );
+
+            fill( plane, plane + planeSize, float_t( 0 ) );
+
+            for ( size_t y = 0; y < mInputHeight; y++ )
+            {
+                copy( inputBase + y * mInputWidth, inputBase + ( y + 1 ) * mInputWidth,
+                      plane + ( y + mPadTop ) * planeWidth + mPadLeft );
+            }
+
+            mFft.Forward( plane, inputsSpectra + inputDepthIndex * spectrumSize, scratch );
+        } );
+
+        // 2 - multiply them with kernels' spectra and get outputs back
+        XParallel::For( mKernelsCount, !ctx.IsTraining( ), [&]( size_t kernelIndex )
+        {
+            float_t*    outputBase = outputData + kernelIndex * outputSize;
+            fcomplex_t* product;
+            fcomplex_t* scratch;
+            float_t*    plane;
+
+            GetFftSlot( mFft, slots, slotSize, ( ctx.IsTraining( ) ) ? 0 : kernelIndex, &product, &scratch, &plane );
+
+            fill( product, product + spectrumSize, fcomplex_t( 0 ) );
+
+            for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
+            {
+                size_t connectionIndex = kernelIndex * mInputDepth + inputDepthIndex;
+
+                if ( !mConnectionTable[connectionIndex] )
+                {
+                    // the input map is not used for the output feature map
                     continue;
                 }
 
-                const float_t* deltaBase = deltaData + kernelIndex * outputSize;
-                // get the 2D portion of weights' gradients for the current input/output map combination
-                float_t* gradWeightsPtr  = gradWeightsData + mKernelOffsets[kernelIndex * mInputDepth + inputDepthIndex];
+                const fcomplex_t* inputSpectrum  = inputsSpectra + inputDepthIndex * spectrumSize;
+                const fcomplex_t* kernelSpectrum = mKernelsSpectra.data( ) + connectionIndex * spectrumSize;
 
-                // calculate gradients for each weight (kernel element)
-                for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+                // product += input * conj( kernel )
+                for ( size_t j = 0; j < spectrumSize; j++ )
                 {
-                    for ( size_t kx = 0; kx < mKernelWidth; kx++ )
-                    {
-                        float_t sum = float_t( 0 );
+                    float_t ir = inputSpectrum[j].real( ), ii = inputSpectrum[j].imag( );
+                    float_t kr = kernelSpectrum[j].real( ), ki = kernelSpectrum[j].imag( );
 
-                        // multiply output deltas by corresponding inputs
-                        for ( size_t oy = 0; oy < mOutputHeight; oy++ )
-                        {
-                            const float_t* deltaPtr = deltaBase + oy * mOutputWidth;
-                            const float_t* inputPtr = inputBase + oy * inputRowInc + ky * inputWidth + kx;
+                    product[j] = fcomplex_t( product[j].real( ) + ir * kr + ii * ki,
+                                             product[j].imag( ) + ii * kr - ir * ki );
+                }
+            }
 
-                            for ( size_t ox = 0; ox < mOutputWidth; ox++ )
-                            {
-                                sum += *deltaPtr * *inputPtr;
+            mFft.Inverse( product, plane, scratch );
 
-                                deltaPtr++;
-                                inputPtr += mHorizontalStep;
-                            }
-                        }
+            for ( size_t y = 0; y < mOutputHeight; y++ )
+            {
+                const float_t* planeRow  = plane + y * planeWidth;
+                float_t*       outputRow = outputBase + y * mOutputWidth;
 
-                        *gradWeightsPtr += sum;
-                        gradWeightsPtr++;
-                    }
+                for ( size_t x = 0; x < mOutputWidth; x++ )
+                {
+                    outputRow[x] = planeRow[x] + mKernelsBiases[kernelIndex];
+                }
+            }
+        } );
+    } );
+}
+
+// Propagates error to the previous layer and calculates weights' gradients in frequency domain
+void XConvolutionLayer::BackwardFft( const vector<fvector_t*>& inputs,
+                                     const vector<fvector_t*>& deltas,
+                                     vector<fvector_t*>& prevDeltas,
+                                     float_t* gradWeightsData,
+                                     const XNetworkContext& ctx )
+{
+    size_t spectrumSize = mFft.SpectrumSize( );
+    size_t planeWidth   = mFft.Width( );
+    size_t planeSize    = mFft.Height( ) * planeWidth;
+    size_t slotSize     = FftSlotSize( );
+    size_t outputSize   = mOutputWidth * mOutputHeight;
+
+    // 1 - propagate deltas to the previous layer, which is convolution (not correlation) of deltas with kernels,
+    //     i.e. multiplication of spectra. Result is in padded coordinates, so the padding is cropped.
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        const float_t* deltaData     = deltas[i]->data( );
+        float_t*       prevDeltaData = prevDeltas[i]->data( );
+        fcomplex_t*    deltasSpectra = static_cast<fcomplex_t*>( ctx.GetWorkingBuffer( 1, i ) );
+        fcomplex_t*    product;
+        fcomplex_t*    scratch;
+        float_t*       plane;
+
+        GetFftSlot( mFft, ctx.GetWorkingBuffer( 2, i ), slotSize, 0, &product, &scratch, &plane );
+
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+        {
+            const float_t* deltaBase = deltaData + kernelIndex * outputSize;
+
+            fill( plane, plane + planeSize, float_t( 0 ) );
+
+            for ( size_t y = 0; y < mOutputHeight; y++ )
+            {
+                copy( deltaBase + y * mOutputWidth, deltaBase + ( y + 1 ) * mOutputWidth, plane + y * planeWidth );
+            }
+
+            mFft.Forward( plane, deltasSpectra + kernelIndex * spectrumSize, scratch );
+        }
+
+        for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
+        {
+            float_t* prevDeltaBase = prevDeltaData + inputDepthIndex * mInputWidth * mInputHeight;
+
+            fill( product, product + spectrumSize, fcomplex_t( 0 ) );
+
+            for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+            {
+                size_t connectionIndex = kernelIndex * mInputDepth + inputDepthIndex;
+
+                if ( !mConnectionTable[connectionIndex] )
+                {
+                    continue;
+                }
+
+                const fcomplex_t* deltaSpectrum  = deltasSpectra + kernelIndex * spectrumSize;
+                const fcomplex_t* kernelSpectrum = mKernelsSpectra.data( ) + connectionIndex * spectrumSize;
+
+                // product += delta * kernel
+                for ( size_t j = 0; j < spectrumSize; j++ )
+                {
+                    float_t dr = deltaSpectrum[j].real( ),  di = deltaSpectrum[j].imag( );
+                    float_t kr = kernelSpectrum[j].real( ), ki = kernelSpectrum[j].imag( );
+
+                    product[j] = fcomplex_t( product[j].real( ) + dr * kr - di * ki,
+                                             product[j].imag( ) + di * kr + dr * ki );
                 }
             }
+
+            mFft.Inverse( product, plane, scratch );
+
+            for ( size_t y = 0; y < mInputHeight; y++ )
+            {
+                const float_t* planeRow = plane + ( y + mPadTop ) * planeWidth + mPadLeft;
+
+                copy( planeRow, planeRow + mInputWidth, prevDeltaBase + y * mInputWidth );
+            }
         }
     } );
 
-    // 3 - accumulate baises' difference
+    // 2 - accumulate weights' difference, which is correlation of (padded) inputs with deltas - products of
+    //     spectra are summed over all samples, so only one inverse transform per kernel is needed
     XParallel::For( mKernelsCount, ctx.IsTraining( ), [&]( size_t kernelIndex )
     {
-        float_t sum = 0;
+        cvector_t product( spectrumSize );
+        cvector_t scratch( mFft.ScratchSize( ) );
+        fvector_t plane( planeSize );
 
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+        for ( size_t inputDepthIndex = 0; inputDepthIndex < mInputDepth; inputDepthIndex++ )
         {
-            const float_t* deltaPtr = deltas[i]->data( ) + kernelIndex * outputSize;
+            size_t connectionIndex = kernelIndex * mInputDepth + inputDepthIndex;
+
+            if ( !mConnectionTable[connectionIndex] )
+            {
+                continue;
+            }
+
+            fill( product.begin( ), product.end( ), fcomplex_t( 0 ) );
+
+            for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+            {
+                const fcomplex_t* inputSpectrum = static_cast<fcomplex_t*>( ctx.GetWorkingBuffer( 0, i ) ) + inputDepthIndex * spectrumSize;
+                const fcomplex_t* deltaSpectrum = static_cast<fcomplex_t*>( ctx.GetWorkingBuffer( 1, i ) ) + kernelIndex * spectrumSize;
+
+                // product += input * conj( delta )
+                for ( size_t j = 0; j < spectrumSize; j++ )
+                {
+                    float_t ir = inputSpectrum[j].real( ), ii = inputSpectrum[j].imag( );
+                    float_t dr = deltaSpectrum[j].real( ), di = deltaSpectrum[j].imag( );
+
+                    product[j] = fcomplex_t( product[j].real( ) + ir * dr + ii * di,
+                                             product[j].imag( ) + ii * dr - ir * di );
+                }
+            }
+
+            mFft.Inverse( product.data( ), plane.data( ), scratch.data( ) );
+
+            float_t* gradWeightsPtr = gradWeightsData + mKernelOffsets[connectionIndex];
 
-            for ( size_t outputIndex = 0; outputIndex < outputSize; outputIndex++ )
+            for ( size_t ky = 0; ky < mKernelHeight; ky++ )
             {
-                sum += *deltaPtr;
-                deltaPtr++;
+                for ( size_t kx = 0; kx < mKernelWidth; kx++ )
+                {
+                    *gradWeightsPtr += plane[ky * planeWidth + kx];
+                    gradWeightsPtr++;
+                }
             }
         }
+    } );
+}
+
+// Calculates outputs as integer matrix multiplication of lowered quantized inputs and quantized kernels
+void XConvolutionLayer::ForwardQuantized( const vector<fvector_t*>& inputs,
+                                          vector<fvector_t*>& outputs,
+                                          const XNetworkContext& ctx ) const
+{
+    size_t outputSize = mOutputWidth * mOutputHeight;
 
-        gradBiasesData[kernelIndex] += sum;
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        uint8_t* quantizedInput = static_cast<uint8_t*>( ctx.GetWorkingBuffer( QUANTIZED_INPUT_BUFFER, i ) );
+        uint8_t* loweredInput   = static_cast<uint8_t*>( ctx.GetWorkingBuffer( QUANTIZED_LOWERED_BUFFER, i ) );
+        int32_t* products       = static_cast<int32_t*>( ctx.GetWorkingBuffer( QUANTIZED_PRODUCTS_BUFFER, i ) );
+        float_t* outputData     = outputs[i]->data( );
+
+        if ( ( mPaddedWidth == mInputWidth ) && ( mPaddedHeight == mInputHeight ) )
+        {
+            mQuantizedWeights.QuantizeInputs( inputs[i]->data( ), quantizedInput, mInputWidth * mInputHeight * mInputDepth );
+        }
+        else
+        {
+            // padding gets quantized zero, so lowering does not need to check borders
+            memset( quantizedInput, mQuantizedWeights.InputZeroPoint( ), mPaddedWidth * mPaddedHeight * mInputDepth );
+
+            for ( size_t depthIndex = 0; depthIndex < mInputDepth; depthIndex++ )
+            {
+                for ( size_t y = 0; y < mInputHeight; y++ )
+                {
+                    mQuantizedWeights.QuantizeInputs( inputs[i]->data( ) + ( depthIndex * mInputHeight + y ) * mInputWidth,
+                                                      quantizedInput + ( depthIndex * mPaddedHeight + y + mPadTop ) * mPaddedWidth + mPadLeft,
+                                                      mInputWidth );
+                }
+            }
+        }
+
+        LowerQuantizedInput( quantizedInput, mPaddedWidth, mPaddedHeight, mInputDepth, mKernelWidth, mKernelHeight,
+                             mHorizontalStep, mVerticalStep, mOutputWidth, mOutputHeight,
+                             loweredInput, mQuantizedWeights.PaddedRowSize( ) );
+
+        // products = loweredInputs * kernels^T, giving values of all output maps at every output position
+        mQuantizedWeights.Multiply( outputSize, loweredInput, products, !ctx.IsTraining( ) );
+
+        mQuantizedWeights.DequantizeTransposed( products, outputSize, outputData );
     } );
 }
 
-// Applies updates to the layer's weights and biases
-void XConvolutionLayer::UpdateWeights( const fvector_t& updates )
+// Quantizes kernels and biases to 8 bit integers for inputs in the specified range
+void XConvolutionLayer::Quantize( float_t inputMin, float_t inputMax )
 {
-    for ( size_t i = 0, n = mAllWeights.size( ); i < n; i++ )
+    UnmapWeights( );
+
+    // depthwise convolution is left in floating point, since its dense weights would be mostly zeros
+    if ( !IsDepthwise( ) )
     {
-        mAllWeights[i] += updates[i];
+        // quantized inference multiplies all input maps with all kernels, so grouped kernels are made dense as well
+        fvector_t      denseWeights;
+        const float_t* weights = ( mGroupsCount == 1 ) ? mKernelsWeights : mDenseWeights.data( );
+
+        if ( mGroupsCount > 1 )
+        {
+            BuildDenseWeights( denseWeights );
+            weights = denseWeights.data( );
+        }
+
+        mQuantizedWeights.Quantize( weights, mKernelsBiases, mKernelsCount, mInputDepth * mKernelWidth * mKernelHeight,
+                                    inputMin, inputMax );
+        ConfigurationChanged( );
     }
 }
 
+// Saves layer's quantized kernels and biases
+bool XConvolutionLayer::SaveQuantizedParams( FILE* file ) const
+{
+    uint32_t layerID = static_cast<uint32_t>( LayerID::Convolution );
+
+    return ( IsQuantized( ) ) &&
+           ( fwrite( &layerID, sizeof( layerID ), 1, file ) == 1 ) &&
+           ( mQuantizedWeights.Save( file ) );
+}
+
+// Loads layer's quantized kernels and biases
+bool XConvolutionLayer::LoadQuantizedParams( FILE* file )
+{
+    uint32_t layerID;
+    bool     ret = ( fread( &layerID, sizeof( layerID ), 1, file ) == 1 ) &&
+                   ( layerID == static_cast<uint32_t>( LayerID::Convolution ) ) &&
+                   ( mQuantizedWeights.Load( file, mKernelsCount, mInputDepth * mKernelWidth * mKernelHeight ) );
+
+    ConfigurationChanged( );
+
+    return ret;
+}
+
 // Saves layer's learnt parameters/weights
 bool XConvolutionLayer::SaveLearnedParams( FILE* file ) const
 {
-    vector<const fvector_t*> params( { &mAllWeights } );
-
-    return SaveLearnedParamsHelper( file, LayerID::Convolution, params );
+    return SaveWeightsHelper( file, LayerID::Convolution );
 }
 
 // Loads layer's learnt parameters
 bool XConvolutionLayer::LoadLearnedParams( FILE* file )
 {
-    vector<fvector_t*> params( { &mAllWeights } );
+    return LoadWeightsHelper( file, LayerID::Convolution );
+}
+
+// Saves layer's kernels and biases in the specified 16 bit precision
+bool XConvolutionLayer::SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const
+{
+    return SaveHalfWeightsHelper( file, LayerID::Convolution, precision );
+}
 
-    return LoadLearnedParamsHelper( file, LayerID::Convolution, params );
+// Loads layer's kernels and biases of the specified 16 bit precision
+bool XConvolutionLayer::LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision )
+{
+    return LoadHalfWeightsHelper( file, LayerID::Convolution, precision );
 }
 
 } } // namespace ANNT::Neuro
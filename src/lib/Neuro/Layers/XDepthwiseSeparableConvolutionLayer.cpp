@@ -0,0 +1,195 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XDepthwiseSeparableConvolutionLayer.hpp"
+#include "../../Tools/XGemm.hpp"
+#include "../../Tools/XParallel.hpp"
+#include "../../Tools/XVectorize.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace ANNT { namespace Neuro {
+
+XDepthwiseSeparableConvolutionLayer::XDepthwiseSeparableConvolutionLayer(
+                                      size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                                      size_t kernelWidth, size_t kernelHeight, size_t kernelsCount,
+                                      BorderMode borderMode, size_t horizontalStep, size_t verticalStep ) :
+                                      ITrainableLayer( 0, 0 ),
+    mInputWidth( inputWidth ), mInputHeight( inputHeight ), mInputDepth( inputDepth ),
+    mOutputWidth( 0 ), mOutputHeight( 0 ),
+    mKernelWidth( kernelWidth ), mKernelHeight( kernelHeight ), mKernelsCount( kernelsCount ),
+    mHorizontalStep( horizontalStep ), mVerticalStep( verticalStep ), mBorderMode( borderMode )
+{
+    size_t padWidth = 0, padHeight = 0;
+
+    // same padding rules as in convolution layer - odd padding goes first to right/bottom
+    if ( mBorderMode == BorderMode::Same )
+    {
+        padWidth  = mKernelWidth  - 1;
+        padHeight = mKernelHeight - 1;
+    }
+
+    mOutputWidth  = ( mInputWidth  - mKernelWidth  + padWidth  ) / mHorizontalStep + 1;
+    mOutputHeight = ( mInputHeight - mKernelHeight + padHeight ) / mVerticalStep   + 1;
+
+    // total input/output size
+    Initialize( mInputWidth  * mInputHeight  * mInputDepth,
+                mOutputWidth * mOutputHeight * mKernelsCount );
+
+    mDepthwise = XDepthwiseConvolution( mInputWidth, mInputHeight, mInputDepth, mKernelWidth, mKernelHeight, 1,
+                                        padWidth >> 1, padHeight >> 1, mHorizontalStep, mVerticalStep,
+                                        mOutputWidth, mOutputHeight );
+
+    AllocateWeights( mInputDepth * mKernelHeight * mKernelWidth + mKernelsCount * mInputDepth + mKernelsCount );
+    Randomize( );
+}
+
+// Sets weights/biases pointers
+void XDepthwiseSeparableConvolutionLayer::SetWeightsPointers( )
+{
+    mDepthwiseWeights = mAllWeights;
+    mPointwiseWeights = OffsetWeights( mDepthwiseWeights, mInputDepth * mKernelHeight * mKernelWidth );
+    mBiases           = OffsetWeights( mPointwiseWeights, mKernelsCount * mInputDepth );
+}
+
+// Tells that we may need some extra memory for keeping depthwise step's outputs and their deltas
+uvector_t XDepthwiseSeparableConvolutionLayer::WorkingMemSize( bool trainingMode ) const
+{
+    uvector_t workingMemSize( ( trainingMode ) ? 2 : 1 );
+
+    for ( size_t i = 0; i < workingMemSize.size( ); i++ )
+    {
+        workingMemSize[i] = mInputDepth * mOutputWidth * mOutputHeight * sizeof( float_t );
+    }
+
+    return workingMemSize;
+}
+
+// Randomizes layer's weights, clears biases
+void XDepthwiseSeparableConvolutionLayer::Randomize( )
+{
+    float_t depthwiseHalfRange = sqrt( float_t( 3 ) / ( mKernelWidth * mKernelHeight ) );
+    float_t pointwiseHalfRange = sqrt( float_t( 3 ) / mInputDepth );
+
+    for ( size_t i = 0, n = mInputDepth * mKernelHeight * mKernelWidth; i < n; i++ )
+    {
+        mDepthwiseWeights[i] = ( static_cast<float_t>( rand( ) ) / RAND_MAX ) * ( float_t( 2 ) * depthwiseHalfRange ) - depthwiseHalfRange;
+    }
+    for ( size_t i = 0, n = mKernelsCount * mInputDepth; i < n; i++ )
+    {
+        mPointwiseWeights[i] = ( static_cast<float_t>( rand( ) ) / RAND_MAX ) * ( float_t( 2 ) * pointwiseHalfRange ) - pointwiseHalfRange;
+    }
+    for ( size_t i = 0; i < mKernelsCount; i++ )
+    {
+        mBiases[i] = 0;
+    }
+}
+
+// Calculates outputs for the given inputs
+void XDepthwiseSeparableConvolutionLayer::ForwardCompute( const vector<fvector_t*>& inputs,
+                                                          vector<fvector_t*>& outputs,
+                                                          const XNetworkContext& ctx ) const
+{
+    size_t outputSize = mOutputWidth * mOutputHeight;
+
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        float_t* depthwiseOutput = static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) );
+        float_t* outputData      = outputs[i]->data( );
+
+        // 1 - depthwise step
+        mDepthwise.Forward( inputs[i]->data( ), mDepthwiseWeights, nullptr, depthwiseOutput, !ctx.IsTraining( ) );
+
+        // 2 - pointwise step: outputs = pointwiseWeights * depthwiseOutput + biases
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++ )
+        {
+            fill( outputData + kernelIndex * outputSize, outputData + ( kernelIndex + 1 ) * outputSize, mBiases[kernelIndex] );
+        }
+
+        XGemm::Multiply( false, false, mKernelsCount, outputSize, mInputDepth,
+                         float_t( 1 ), mPointwiseWeights, mInputDepth, depthwiseOutput, outputSize,
+                         float_t( 1 ), outputData, outputSize, !ctx.IsTraining( ) );
+    } );
+}
+
+// Propagates error to the previous layer and calculates weights/biases gradients
+void XDepthwiseSeparableConvolutionLayer::BackwardCompute( const vector<fvector_t*>& inputs,
+                                                           const vector<fvector_t*>& /* outputs */,
+                                                           const vector<fvector_t*>& deltas,
+                                                           vector<fvector_t*>& prevDeltas,
+                                                           float_t* gradWeights,
+                                                           const XNetworkContext& ctx )
+{
+    // offsets of pointwise weights' and biases' gradients
+    size_t   pointwiseOffset   = mInputDepth * mKernelHeight * mKernelWidth;
+    size_t   biasesOffset      = pointwiseOffset + mKernelsCount * mInputDepth;
+    size_t   outputSize        = mOutputWidth * mOutputHeight;
+
+    // 1 - propagate deltas through pointwise step: depthwiseDeltas = pointwiseWeights^T * deltas,
+    //     and then through depthwise step to the previous layer
+    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    {
+        float_t* depthwiseDeltas = static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) );
+
+        XGemm::Multiply( true, false, mInputDepth, outputSize, mKernelsCount,
+                         float_t( 1 ), mPointwiseWeights, mInputDepth, deltas[i]->data( ), outputSize,
+                         float_t( 0 ), depthwiseDeltas, outputSize, false );
+
+        mDepthwise.Backward( depthwiseDeltas, mDepthwiseWeights, prevDeltas[i]->data( ), false );
+    } );
+
+    // 2 - accumulate weights' and biases' difference, samples in parallel: pointwise gradients += deltas * depthwiseOutput^T,
+    //     then depthwise gradients and biases
+    bool parallelSample = ( inputs.size( ) == 1 );
+
+    mGradientsAccumulator.For( inputs.size( ), ctx.IsTraining( ), gradWeights, mAllWeightsCount, [&]( size_t i, float_t* gradAll )
+    {
+        const float_t* deltaPtr = deltas[i]->data( );
+        float_t*       gradBias = gradAll + biasesOffset;
+
+        XGemm::Multiply( false, true, mKernelsCount, mInputDepth, outputSize,
+                         float_t( 1 ), deltaPtr, outputSize,
+                         static_cast<float_t*>( ctx.GetWorkingBuffer( 0, i ) ), outputSize,
+                         float_t( 1 ), gradAll + pointwiseOffset, mInputDepth, parallelSample );
+
+        mDepthwise.CalculateGradients( inputs[i]->data( ), static_cast<float_t*>( ctx.GetWorkingBuffer( 1, i ) ),
+                                       gradAll, parallelSample );
+
+        for ( size_t kernelIndex = 0; kernelIndex < mKernelsCount; kernelIndex++, deltaPtr += outputSize )
+        {
+            gradBias[kernelIndex] += XVectorize::Sum( deltaPtr, outputSize );
+        }
+    } );
+}
+
+// Saves layer's learnt parameters/weights
+bool XDepthwiseSeparableConvolutionLayer::SaveLearnedParams( FILE* file ) const
+{
+    return SaveWeightsHelper( file, LayerID::DepthwiseSeparableConvolution );
+}
+
+// Loads layer's learnt parameters
+bool XDepthwiseSeparableConvolutionLayer::LoadLearnedParams( FILE* file )
+{
+    return LoadWeightsHelper( file, LayerID::DepthwiseSeparableConvolution );
+}
+
+} } // namespace ANNT::Neuro
@@ -19,27 +19,42 @@
 */
 
 #include "XFullyConnectedLayer.hpp"
+#include "../../Tools/XGemm.hpp"
 #include "../../Tools/XParallel.hpp"
 #include "../../Tools/XVectorize.hpp"
+#include <algorithm>
 
 using namespace std;
 
 namespace ANNT { namespace Neuro {
 
+// Batches smaller than this are computed as dot products of inputs and half precision weights (widened on the fly),
+// while larger batches amortize widening of weights' blocks for matrix multiplication
+static const size_t HALF_PRECISION_GEMM_BATCH = 16;
+
+// Number of weights (floats) widened at once for matrix multiplication - large enough to keep multiplication efficient,
+// while small enough to stay in L2 cache
+static const size_t HALF_PRECISION_BLOCK_SIZE = 256 * 1024;
+
 XFullyConnectedLayer::XFullyConnectedLayer( size_t inputsCount, size_t outputsCount ) :
-    ITrainableLayer( inputsCount, outputsCount ),
-    mAllWeights( inputsCount * outputsCount + outputsCount )
+    ITrainableLayer( inputsCount, outputsCount )
 {
-    // set up weights/biases pointers
-    mWeights = mAllWeights.data( );
-    mBiases  = mWeights + mInputsCount * mOutputsCount;
-
+    AllocateWeights( inputsCount * outputsCount + outputsCount );
     Randomize( );
 }
 
+// Sets weights/biases pointers
+void XFullyConnectedLayer::SetWeightsPointers( )
+{
+    mWeights = mAllWeights;
+    mBiases  = OffsetWeights( mWeights, mInputsCount * mOutputsCount );
+}
+
 // Randomizes layer's weights, clears biases
 void XFullyConnectedLayer::Randomize( )
 {
+    UnmapWeights( );
+
     float_t halfRange = sqrt( float_t( 3 ) / mInputsCount );
 
     for ( size_t i = 0, n = mInputsCount * mOutputsCount; i < n; i++ )
@@ -55,105 +70,314 @@ void XFullyConnectedLayer::Randomize( )
 // Calculates outputs for the given inputs
 void XFullyConnectedLayer::ForwardCompute( const vector<fvector_t*>& inputs,
                                            vector<fvector_t*>& outputs,
-                                           const XNetworkContext& ctx )
+                                           const XNetworkContext& ctx ) const
+{
+    ForwardCompute( inputs, outputs, ctx, nullptr );
+}
+
+// Tells that quantized inference needs memory for quantized inputs and their products with weights
+uvector_t XFullyConnectedLayer::WorkingMemSize( bool trainingMode ) const
 {
-    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    uvector_t workingMemSize;
+
+    if ( ( !trainingMode ) && ( IsQuantized( ) ) )
     {
-        const float_t* weights = mWeights;
-        const float_t* input   = inputs[i]->data( );
-        fvector_t&     output  = *( outputs[i] );
+        workingMemSize.push_back( mQuantizedWeights.PaddedRowSize( ) * sizeof( uint8_t ) );
+        workingMemSize.push_back( mOutputsCount * sizeof( int32_t ) );
+    }
 
-        for ( size_t otputIndex = 0; otputIndex < mOutputsCount; otputIndex++ )
-        {
-            output[otputIndex] = XVectorize::Dot( input, weights, mInputsCount ) + mBiases[otputIndex];
+    return workingMemSize;
+}
+
+// Calculates outputs for the given inputs and applies element wise activation to them
+void XFullyConnectedLayer::ForwardCompute( const vector<fvector_t*>& inputs,
+                                           vector<fvector_t*>& outputs,
+                                           const XNetworkContext& ctx,
+                                           const IActivationLayer* activation ) const
+{
+    if ( ( !ctx.IsTraining( ) ) && ( IsQuantized( ) ) )
+    {
+        ForwardQuantized( inputs, outputs, ctx, activation );
+        return;
+    }
+
+    if ( IsHalfPrecision( ) )
+    {
+        ForwardHalfPrecision( inputs, outputs, activation );
+        return;
+    }
+
+    size_t                 batchSize = inputs.size( );
+    vector<const float_t*> inputRows( batchSize );
+    vector<float_t*>       outputRows( batchSize );
+    vector<const float_t*> weightRows( mOutputsCount );
+
+    // start with biases in all outputs, so they get added to the product
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        inputRows[i]  = inputs[i]->data( );
+        outputRows[i] = outputs[i]->data( );
+
+        std::copy( mBiases, mBiases + mOutputsCount, outputRows[i] );
+    }
+
+    for ( size_t i = 0; i < mOutputsCount; i++ )
+    {
+        weightRows[i] = mWeights + i * mInputsCount;
+    }
+
+    // outputs = inputs * weights^T + outputs, with inputs/outputs being batchSize x inputs/outputs matrices
+    if ( activation == nullptr )
+    {
+        XGemm::Multiply( false, true, batchSize, mOutputsCount, mInputsCount,
+                         float_t( 1 ), inputRows.data( ), weightRows.data( ),
+                         float_t( 1 ), outputRows.data( ) );
+    }
+    else
+    {
+        // activate blocks of outputs as soon as matrix multiplication completes them
+        XGemm::Multiply( false, true, batchSize, mOutputsCount, mInputsCount,
+                         float_t( 1 ), inputRows.data( ), weightRows.data( ),
+                         float_t( 1 ), outputRows.data( ),
+                         [activation]( float_t* values, size_t count )
+                         {
+                             activation->ForwardActivate( values, values, count );
+                         } );
+    }
+}
+
+// Calculates outputs using quantized weights
+void XFullyConnectedLayer::ForwardQuantized( const vector<fvector_t*>& inputs,
+                                             vector<fvector_t*>& outputs,
+                                             const XNetworkContext& ctx,
+                                             const IActivationLayer* activation ) const
+{
+    size_t                 batchSize = inputs.size( );
+    vector<const uint8_t*> quantizedRows( batchSize );
+    vector<int32_t*>       productRows( batchSize );
+
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        uint8_t* quantizedInput = static_cast<uint8_t*>( ctx.GetWorkingBuffer( 0, i ) );
+
+        mQuantizedWeights.QuantizeInputs( inputs[i]->data( ), quantizedInput, mInputsCount );
 
-            weights += mInputsCount;
+        quantizedRows[i] = quantizedInput;
+        productRows[i]   = static_cast<int32_t*>( ctx.GetWorkingBuffer( 1, i ) );
+    }
+
+    // products = quantizedInputs * quantizedWeights^T
+    mQuantizedWeights.Multiply( batchSize, quantizedRows.data( ), productRows.data( ), true );
+
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        float_t* output = outputs[i]->data( );
+
+        mQuantizedWeights.Dequantize( productRows[i], output, 1 );
+
+        if ( activation != nullptr )
+        {
+            activation->ForwardActivate( output, output, mOutputsCount );
         }
-    } );
+    }
 }
 
-// Propagates error to the previous layer and calculates weights/biases gradients
-void XFullyConnectedLayer::BackwardCompute( const vector<fvector_t*>& inputs,
-                                            const vector<fvector_t*>& /* outputs */,
-                                            const vector<fvector_t*>& deltas,
-                                            vector<fvector_t*>& prevDeltas,
-                                            fvector_t& gradWeights,
-                                            const XNetworkContext& ctx )
+// Calculates outputs using weights kept in half precision
+void XFullyConnectedLayer::ForwardHalfPrecision( const vector<fvector_t*>& inputs,
+                                                 vector<fvector_t*>& outputs,
+                                                 const IActivationLayer* activation ) const
 {
-    // set up weights/biases gradients pointers
-    float_t*  gradWeightsData = gradWeights.data( );
-    float_t*  gradBiasesData  = gradWeightsData + mInputsCount * mOutputsCount;
+    size_t batchSize    = inputs.size( );
+    size_t weightsCount = mInputsCount * mOutputsCount;
 
-    // 1 - first propagate deltas to the previous layer
-    XParallel::For( inputs.size( ), ctx.IsTraining( ), [&]( size_t i )
+    // start with biases in all outputs
+    for ( size_t i = 0; i < batchSize; i++ )
     {
-        fvector_t&       prevDelta = *( prevDeltas[i] );
-        const fvector_t& delta     = *( deltas[i] );
+        CopyWeights( weightsCount, mOutputsCount, outputs[i]->data( ) );
+    }
 
-        for ( size_t inputIndex = 0; inputIndex < mInputsCount; inputIndex++ )
+    if ( batchSize < HALF_PRECISION_GEMM_BATCH )
+    {
+        XParallel::For( mOutputsCount, true, [&]( size_t outputIndex )
         {
-            size_t  weightIndex = inputIndex;
-            float_t sum         = 0;
+            for ( size_t i = 0; i < batchSize; i++ )
+            {
+                ( *outputs[i] )[outputIndex] += WeightsDot( outputIndex * mInputsCount, inputs[i]->data( ), mInputsCount );
+            }
+        } );
 
-            for ( size_t otputIndex = 0; otputIndex < mOutputsCount; otputIndex++, weightIndex += mInputsCount )
+        if ( activation != nullptr )
+        {
+            for ( size_t i = 0; i < batchSize; i++ )
             {
-                sum += delta[otputIndex] * mWeights[weightIndex];
+                activation->ForwardActivate( outputs[i]->data( ), outputs[i]->data( ), mOutputsCount );
             }
+        }
+    }
+    else
+    {
+        // blocks of weights' rows are widened and multiplied with inputs, giving final values of the block's outputs
+        size_t                 blockRows = min( mOutputsCount, max( size_t( 1 ), HALF_PRECISION_BLOCK_SIZE / mInputsCount ) );
+        fvector_t              widened( blockRows * mInputsCount );
+        vector<const float_t*> inputRows( batchSize );
+        vector<float_t*>       outputRows( batchSize );
+        vector<const float_t*> weightRows( blockRows );
 
-            prevDelta[inputIndex] = sum;
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            inputRows[i] = inputs[i]->data( );
         }
-    } );
 
-    // 2 - accumulate weights' difference
-    XParallel::For( mOutputsCount, ctx.IsTraining( ), [&]( size_t outputIndex )
-    {
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+        for ( size_t j = 0; j < blockRows; j++ )
+        {
+            weightRows[j] = widened.data( ) + j * mInputsCount;
+        }
+
+        for ( size_t blockStart = 0; blockStart < mOutputsCount; blockStart += blockRows )
         {
-            const fvector_t& input      = *( inputs[i] );
-            float_t          deltaValue = ( *( deltas[i] ) )[outputIndex];
+            size_t rowsCount = min( blockRows, mOutputsCount - blockStart );
+
+            CopyWeights( blockStart * mInputsCount, rowsCount * mInputsCount, widened.data( ) );
+
+            for ( size_t i = 0; i < batchSize; i++ )
+            {
+                outputRows[i] = outputs[i]->data( ) + blockStart;
+            }
+
+            XGemm::Multiply( false, true, batchSize, rowsCount, mInputsCount,
+                             float_t( 1 ), inputRows.data( ), weightRows.data( ),
+                             float_t( 1 ), outputRows.data( ) );
 
-            for ( size_t inputIndex = 0, weightIndex = outputIndex * mInputsCount; inputIndex < mInputsCount; inputIndex++, weightIndex++ )
+            if ( activation != nullptr )
             {
-                gradWeightsData[weightIndex] += deltaValue * input[inputIndex];
+                for ( size_t i = 0; i < batchSize; i++ )
+                {
+                    activation->ForwardActivate( outputRows[i], outputRows[i], rowsCount );
+                }
             }
         }
-    } );
+    }
+}
 
-    // 3 - accumulate baises' difference
-    for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+// Scales outputs of every neuron and shifts them by changing weights and biases
+void XFullyConnectedLayer::ScaleOutputs( const fvector_t& scale, const fvector_t& shift )
+{
+    UnmapWeights( );
+
+    for ( size_t i = 0; i < mOutputsCount; i++ )
     {
-        const fvector_t& delta = *( deltas[i] );
+        float_t* neuronWeights = mWeights + i * mInputsCount;
 
-        for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
-        {
-            gradBiasesData[outputIndex] += delta[outputIndex];
-        }
+        XVectorize::Scale( neuronWeights, scale[i], neuronWeights, mInputsCount );
+        mBiases[i] = mBiases[i] * scale[i] + shift[i];
     }
+
+    WeightsChanged( );
 }
 
-// Applies updates to the layer's weights and biases
-void XFullyConnectedLayer::UpdateWeights( const fvector_t& updates )
+// Propagates error to the previous layer and calculates weights/biases gradients
+void XFullyConnectedLayer::BackwardCompute( const vector<fvector_t*>& inputs,
+                                            const vector<fvector_t*>& /* outputs */,
+                                            const vector<fvector_t*>& deltas,
+                                            vector<fvector_t*>& prevDeltas,
+                                            float_t* gradWeights,
+                                            const XNetworkContext& /* ctx */ )
 {
-    for ( size_t i = 0, n = mAllWeights.size( ); i < n; i++ )
+    // set up weights/biases gradients pointers
+    float_t*  gradWeightsData = gradWeights;
+    float_t*  gradBiasesData  = gradWeightsData + mInputsCount * mOutputsCount;
+
+    size_t                 batchSize = inputs.size( );
+    vector<const float_t*> inputRows( batchSize );
+    vector<const float_t*> deltaRows( batchSize );
+    vector<float_t*>       prevDeltaRows( batchSize );
+    vector<const float_t*> weightRows( mOutputsCount );
+    vector<float_t*>       gradWeightRows( mOutputsCount );
+
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        inputRows[i]     = inputs[i]->data( );
+        deltaRows[i]     = deltas[i]->data( );
+        prevDeltaRows[i] = prevDeltas[i]->data( );
+    }
+
+    for ( size_t i = 0; i < mOutputsCount; i++ )
     {
-        mAllWeights[i] += updates[i];
+        weightRows[i]     = mWeights + i * mInputsCount;
+        gradWeightRows[i] = gradWeightsData + i * mInputsCount;
     }
+
+    // 1 - first propagate deltas to the previous layer: prevDeltas = deltas * weights
+    XGemm::Multiply( false, false, batchSize, mInputsCount, mOutputsCount,
+                     float_t( 1 ), deltaRows.data( ), weightRows.data( ),
+                     float_t( 0 ), prevDeltaRows.data( ) );
+
+    // 2 - accumulate weights' difference: gradWeights += deltas^T * inputs
+    XGemm::Multiply( true, false, mOutputsCount, mInputsCount, batchSize,
+                     float_t( 1 ), deltaRows.data( ), inputRows.data( ),
+                     float_t( 1 ), gradWeightRows.data( ) );
+
+    // 3 - accumulate baises' difference
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        XVectorize::Add( deltaRows[i], gradBiasesData, mOutputsCount );
+    }
+}
+
+// Quantizes weights and biases to 8 bit integers for inputs in the specified range
+void XFullyConnectedLayer::Quantize( float_t inputMin, float_t inputMax )
+{
+    UnmapWeights( );
+
+    mQuantizedWeights.Quantize( mWeights, mBiases, mOutputsCount, mInputsCount, inputMin, inputMax );
+    ConfigurationChanged( );
+}
+
+// Saves layer's quantized weights and biases
+bool XFullyConnectedLayer::SaveQuantizedParams( FILE* file ) const
+{
+    uint32_t layerID = static_cast<uint32_t>( LayerID::FullyConnected );
+
+    return ( IsQuantized( ) ) &&
+           ( fwrite( &layerID, sizeof( layerID ), 1, file ) == 1 ) &&
+           ( mQuantizedWeights.Save( file ) );
+}
+
+// Loads layer's quantized weights and biases
+bool XFullyConnectedLayer::LoadQuantizedParams( FILE* file )
+{
+    uint32_t layerID;
+    bool     ret = ( fread( &layerID, sizeof( layerID ), 1, file ) == 1 ) &&
+                   ( layerID == static_cast<uint32_t>( LayerID::FullyConnected ) ) &&
+                   ( mQuantizedWeights.Load( file, mOutputsCount, mInputsCount ) );
+
+    ConfigurationChanged( );
+
+    return ret;
 }
 
 // Saves layer's learnt parameters/weights
 bool XFullyConnectedLayer::SaveLearnedParams( FILE* file ) const
 {
-    vector<const fvector_t*> params( { &mAllWeights } );
-
-    return SaveLearnedParamsHelper( file, LayerID::FullyConnected, params );
+    return SaveWeightsHelper( file, LayerID::FullyConnected );
 }
 
 // Loads layer's learnt parameters
 bool XFullyConnectedLayer::LoadLearnedParams( FILE* file )
 {
-    vector<fvector_t*> params( { &mAllWeights } );
+    return LoadWeightsHelper( file, LayerID::FullyConnected );
+}
 
-    return LoadLearnedParamsHelper( file, LayerID::FullyConnected, params );
+// Saves layer's weights in the specified 16 bit precision
+bool XFullyConnectedLayer::SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const
+{
+    return SaveHalfWeightsHelper( file, LayerID::FullyConnected, precision );
+}
+
+// Loads layer's weights of the specified 16 bit precision
+bool XFullyConnectedLayer::LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision )
+{
+    return LoadHalfWeightsHelper( file, LayerID::FullyConnected, precision );
 }
 
 } } // namespace ANNT::Neuro
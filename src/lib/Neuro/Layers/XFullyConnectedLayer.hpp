@@ -23,6 +23,8 @@
 #define ANNT_XFULLY_CONNECTED_LAYER_HPP
 
 #include "ITrainableLayer.hpp"
+#include "Activations/IActivationLayer.hpp"
+#include "../../Tools/XQuantizedWeights.hpp"
 
 namespace ANNT { namespace Neuro {
 
@@ -30,55 +32,108 @@ namespace ANNT { namespace Neuro {
 class XFullyConnectedLayer : public ITrainableLayer
 {
 private:
-    // Weights and biases are all kept together
-    fvector_t mAllWeights;
-
-    // And here are their pointers
+    // Pointers to weights and biases, which are all kept together in mAllWeights
     float_t*  mWeights;
     float_t*  mBiases;
 
+    // Weights and biases quantized to 8 bit integers, which are used for inference if not empty
+    XQuantizedWeights mQuantizedWeights;
+
 public:
     XFullyConnectedLayer( size_t inputsCount, size_t outputsCount );
 
-    // Reports number of weight coefficients the layer has
-    size_t WeightsCount( ) const override
-    {
-        return mAllWeights.size( );
-    }
+    // Randomizes layer's weights, clears biases
+    void Randomize( ) override;
 
-    // Get/set layer's weights
-    fvector_t Weights( ) const override
-    {
-        return mAllWeights;
-    }
-    void SetWeights( const fvector_t& weights ) override
+    // Tells that quantized inference needs memory for quantized inputs and their products with weights
+    uvector_t WorkingMemSize( bool trainingMode ) const override;
+
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
     {
-        mAllWeights = weights;
+        return false;
     }
 
-    // Randomizes layer's weights, clears biases
-    void Randomize( ) override;
-
     // Calculates outputs for the given inputs
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override;
+                         const XNetworkContext& ctx ) const override;
+
+    // Calculates outputs for the given inputs and applies element wise activation to them
+    // while they are still in cache (activation is skipped if not provided)
+    void ForwardCompute( const std::vector<fvector_t*>& inputs,
+                         std::vector<fvector_t*>& outputs,
+                         const XNetworkContext& ctx,
+                         const IActivationLayer* activation ) const;
 
     // Propagates error to the previous layer and calculates weights/biases gradients
     void BackwardCompute( const std::vector<fvector_t*>& inputs,
                           const std::vector<fvector_t*>& outputs,
                           const std::vector<fvector_t*>& deltas,
                           std::vector<fvector_t*>& prevDeltas,
-                          fvector_t& gradWeights,
+                          float_t* gradWeights,
                           const XNetworkContext& ctx ) override;
 
-    // Applies updates to the layer's weights and biases
-    void UpdateWeights( const fvector_t& updates ) override;
+    // Scales outputs of every neuron and shifts them by changing weights and biases,
+    // i.e. output[i] = output[i] * scale[i] + shift[i] (vectors of outputs count size)
+    void ScaleOutputs( const fvector_t& scale, const fvector_t& shift );
+
+    // Quantizes weights and biases to 8 bit integers for inputs in the specified range, so inference
+    // runs on integer SIMD kernels. Any change of weights reverts the layer to floating point inference.
+    void Quantize( float_t inputMin, float_t inputMax );
+
+    // Checks if the layer uses quantized weights for inference
+    bool IsQuantized( ) const
+    {
+        return !mQuantizedWeights.IsEmpty( );
+    }
+
+    // Saves/loads layer's quantized weights and biases
+    bool SaveQuantizedParams( FILE* file ) const;
+    bool LoadQuantizedParams( FILE* file );
+
+    // Drops quantized weights, which don't match the changed weights any more
+    void WeightsChanged( ) override
+    {
+        if ( IsQuantized( ) )
+        {
+            mQuantizedWeights.Clear( );
+            ConfigurationChanged( );
+        }
+    }
+
+    // Weights can be kept in half precision - those are widened to float while computing outputs
+    bool HalfPrecisionSupported( ) const override
+    {
+        return true;
+    }
+
+    // Saves/loads layer's weights in the specified 16 bit precision
+    bool SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const override;
+    bool LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision ) override;
 
     // Saves layer's learnt parameters/weights
     bool SaveLearnedParams( FILE* file ) const override;
     // Loads layer's learnt parameters
     bool LoadLearnedParams( FILE* file ) override;
+
+protected:
+
+    // Sets weights/biases pointers
+    void SetWeightsPointers( ) override;
+
+private:
+    // Calculates outputs using quantized weights
+    void ForwardQuantized( const std::vector<fvector_t*>& inputs,
+                           std::vector<fvector_t*>& outputs,
+                           const XNetworkContext& ctx,
+                           const IActivationLayer* activation ) const;
+
+    // Calculates outputs using weights kept in half precision - small batches use dot products with weights widened on
+    // the fly, while larger ones widen blocks of weights for matrix multiplication
+    void ForwardHalfPrecision( const std::vector<fvector_t*>& inputs,
+                               std::vector<fvector_t*>& outputs,
+                               const IActivationLayer* activation ) const;
 };
 
 } } // namespace ANNT::Neuro
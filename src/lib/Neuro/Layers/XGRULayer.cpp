@@ -29,33 +29,39 @@ namespace ANNT { namespace Neuro {
 
 XGRULayer::XGRULayer( size_t inputsCount, size_t outputsCount ) :
     ITrainableLayer( inputsCount, outputsCount ),
-    mSigmoid( ), mTanh( ),
-    mAllWeights( ( inputsCount * outputsCount + outputsCount * outputsCount ) * 3 + outputsCount * 3 )
+    mSigmoid( ), mTanh( )
+{
+    AllocateWeights( ( inputsCount * outputsCount + outputsCount * outputsCount ) * 3 + outputsCount * 3 );
+    Randomize( );
+}
+
+// Sets weights/biases pointers
+void XGRULayer::SetWeightsPointers( )
 {
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights pointers
-    mWeightsX2Z  = mAllWeights.data( );
-    mWeightsH2Z  = mWeightsX2Z + weightsCountInputs;
+    mWeightsX2Z  = mAllWeights;
+    mWeightsH2Z  = OffsetWeights( mWeightsX2Z, weightsCountInputs );
 
-    mWeightsX2R  = mWeightsH2Z + weightsCountHistory;
-    mWeightsH2R  = mWeightsX2R + weightsCountInputs;
+    mWeightsX2R  = OffsetWeights( mWeightsH2Z, weightsCountHistory );
+    mWeightsH2R  = OffsetWeights( mWeightsX2R, weightsCountInputs );
 
-    mWeightsX2H  = mWeightsH2R + weightsCountHistory;
-    mWeightsHR2H = mWeightsX2H + weightsCountInputs;
+    mWeightsX2H  = OffsetWeights( mWeightsH2R, weightsCountHistory );
+    mWeightsHR2H = OffsetWeights( mWeightsX2H, weightsCountInputs );
 
     // set up biases pointers
-    mBiasesZ = mWeightsHR2H + weightsCountHistory;
-    mBiasesR = mBiasesZ + mOutputsCount;
-    mBiasesH = mBiasesR + mOutputsCount;
-
-    Randomize( );
+    mBiasesZ = OffsetWeights( mWeightsHR2H, weightsCountHistory );
+    mBiasesR = OffsetWeights( mBiasesZ, mOutputsCount );
+    mBiasesH = OffsetWeights( mBiasesR, mOutputsCount );
 }
 
 // Randomizes layer's weights, clears biases
 void XGRULayer::Randomize( )
 {
+    UnmapWeights( );
+
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
@@ -87,11 +93,24 @@ void XGRULayer::Randomize( )
 }
 
 // Calculates outputs for the given inputs
-void XGRULayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector_t*>& outputs, const XNetworkContext& ctx )
+void XGRULayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const
 {
     size_t sequenceLen = ctx.TrainingSequenceLength( );
     size_t batchSize   = inputs.size( ) / sequenceLen;
 
+    // weights are accessed by their offsets (see SetWeightsPointers( )), so they can be kept in half precision as well
+    size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
+    size_t weightsCountHistory = mOutputsCount * mOutputsCount;
+    size_t offsetX2Z           = 0;
+    size_t offsetH2Z           = offsetX2Z + weightsCountInputs;
+    size_t offsetX2R           = offsetH2Z + weightsCountHistory;
+    size_t offsetH2R           = offsetX2R + weightsCountInputs;
+    size_t offsetX2H           = offsetH2R + weightsCountHistory;
+    size_t offsetHR2H          = offsetX2H + weightsCountInputs;
+    size_t offsetBiasesZ       = offsetHR2H + weightsCountHistory;
+    size_t offsetBiasesR       = offsetBiasesZ + mOutputsCount;
+    size_t offsetBiasesH       = offsetBiasesR + mOutputsCount;
+
     XParallel::For( batchSize, ctx.IsTraining( ), [&]( size_t batchIndex )
     {
         float_t* history = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_HISTORY, batchIndex ) );
@@ -111,19 +130,21 @@ void XGRULayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector
             // remember previous history for this particular sample
             memcpy( historyPrev, history, mOutputsCount * sizeof( float_t ) );
 
+            // start with biases
+            CopyWeights( offsetBiasesZ, mOutputsCount, updateGate );
+            CopyWeights( offsetBiasesR, mOutputsCount, resetGate );
+            CopyWeights( offsetBiasesH, mOutputsCount, historyHat );
+
             for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
             {
                 // Wz [X(t), H(t-1)] + Bz
-                updateGate[outputIndex] = XVectorize::Dot( input, &( mWeightsX2Z[outputIndex * mInputsCount] ), mInputsCount ) +
-                                          XVectorize::Dot( historyPrev, &( mWeightsH2Z[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                          mBiasesZ[outputIndex];
+                updateGate[outputIndex] += WeightsDot( offsetX2Z + outputIndex * mInputsCount, input, mInputsCount ) +
+                                           WeightsDot( offsetH2Z + outputIndex * mOutputsCount, historyPrev, mOutputsCount );
                 // Wr [X(t), H(t-1)] + Br
-                resetGate[outputIndex] =  XVectorize::Dot( input, &( mWeightsX2R[outputIndex * mInputsCount] ), mInputsCount ) +
-                                          XVectorize::Dot( historyPrev, &( mWeightsH2R[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                          mBiasesR[outputIndex];
+                resetGate[outputIndex]  += WeightsDot( offsetX2R + outputIndex * mInputsCount, input, mInputsCount ) +
+                                           WeightsDot( offsetH2R + outputIndex * mOutputsCount, historyPrev, mOutputsCount );
                 // W [X(t)] + B
-                historyHat[outputIndex] = XVectorize::Dot( input, &( mWeightsX2H[outputIndex * mInputsCount] ), mInputsCount ) +
-                                          mBiasesH[outputIndex];
+                historyHat[outputIndex] += WeightsDot( offsetX2H + outputIndex * mInputsCount, input, mInputsCount );
             }
 
             // apply activations
@@ -142,7 +163,7 @@ void XGRULayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector
             // complete current memory content by adding reseted previous history ...
             for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
             {
-                historyHat[outputIndex] += XVectorize::Dot( historyPrevReset, &( mWeightsHR2H[outputIndex * mOutputsCount] ), mOutputsCount );
+                historyHat[outputIndex] += WeightsDot( offsetHR2H + outputIndex * mOutputsCount, historyPrevReset, mOutputsCount );
             }
             // ... and passing through tanh() activation
             mTanh.ForwardActivate( historyHat, historyHat, mOutputsCount );
@@ -163,7 +184,7 @@ void XGRULayer::BackwardCompute( const vector<fvector_t*>& inputs,
                                  const vector<fvector_t*>& /* outputs */,
                                  const vector<fvector_t*>& deltas,
                                  vector<fvector_t*>& prevDeltas,
-                                 fvector_t& gradWeights,
+                                 float_t* gradWeights,
                                  const XNetworkContext& ctx )
 {
     size_t sequenceLen   = ctx.TrainingSequenceLength( );
@@ -173,7 +194,7 @@ void XGRULayer::BackwardCompute( const vector<fvector_t*>& inputs,
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights gradient pointers
-    float_t* gradWeightsX2Z  = gradWeights.data( );
+    float_t* gradWeightsX2Z  = gradWeights;
     float_t* gradWeightsH2Z  = gradWeightsX2Z + weightsCountInputs;
 
     float_t* gradWeightsX2R  = gradWeightsH2Z + weightsCountHistory;
@@ -311,22 +332,16 @@ void XGRULayer::BackwardCompute( const vector<fvector_t*>& inputs,
                 float_t  dHistoryHatVal   = dHistoryHat[outputIndex];
 
                 // accumulate gradients for inputs' weights
-                for ( size_t inputIndex = 0, weightIndex = weightIndexStartI; inputIndex < mInputsCount; inputIndex++, weightIndex++ )
-                {
-                    gradWeightsX2Z[weightIndex] += dUpdateGateVal * input[inputIndex];
-                    gradWeightsX2R[weightIndex] += dResetGateVal  * input[inputIndex];
-                    gradWeightsX2H[weightIndex] += dHistoryHatVal * input[inputIndex];
-                }
+                XVectorize::Axpy( input, dUpdateGateVal, &( gradWeightsX2Z[weightIndexStartI] ), mInputsCount );
+                XVectorize::Axpy( input, dResetGateVal,  &( gradWeightsX2R[weightIndexStartI] ), mInputsCount );
+                XVectorize::Axpy( input, dHistoryHatVal, &( gradWeightsX2H[weightIndexStartI] ), mInputsCount );
 
                 // accumulate gradients for history weights
                 if ( sequenceIndex != 0 )
                 {
-                    for ( size_t historyIndex = 0, weightIndex = weightIndexStartH; historyIndex < mOutputsCount; historyIndex++, weightIndex++ )
-                    {
-                        gradWeightsH2Z[weightIndex]  += dUpdateGateVal * historyPrev[historyIndex];
-                        gradWeightsH2R[weightIndex]  += dResetGateVal  * historyPrev[historyIndex];
-                        gradWeightsHR2H[weightIndex] += dHistoryHatVal * historyPrevReset[historyIndex];
-                    }
+                    XVectorize::Axpy( historyPrev,      dUpdateGateVal, &( gradWeightsH2Z[weightIndexStartH] ),  mOutputsCount );
+                    XVectorize::Axpy( historyPrev,      dResetGateVal,  &( gradWeightsH2R[weightIndexStartH] ),  mOutputsCount );
+                    XVectorize::Axpy( historyPrevReset, dHistoryHatVal, &( gradWeightsHR2H[weightIndexStartH] ), mOutputsCount );
                 }
 
                 // accumulate gradients for biases
@@ -338,29 +353,28 @@ void XGRULayer::BackwardCompute( const vector<fvector_t*>& inputs,
     } );
 }
 
-// Applies updates to the layer's weights and biases
-void XGRULayer::UpdateWeights( const fvector_t& updates )
-{
-    for ( size_t i = 0, n = mAllWeights.size( ); i < n; i++ )
-    {
-        mAllWeights[i] += updates[i];
-    }
-}
-
 // Saves layer's learnt parameters/weights
 bool XGRULayer::SaveLearnedParams( FILE* file ) const
 {
-    vector<const fvector_t*> params( { &mAllWeights } );
-
-    return SaveLearnedParamsHelper( file, LayerID::RecurrentGRU, params );
+    return SaveWeightsHelper( file, LayerID::RecurrentGRU );
 }
 
 // Loads layer's learnt parameters
 bool XGRULayer::LoadLearnedParams( FILE* file )
 {
-    vector<fvector_t*> params( { &mAllWeights } );
+    return LoadWeightsHelper( file, LayerID::RecurrentGRU );
+}
+
+// Saves layer's weights in the specified 16 bit precision
+bool XGRULayer::SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const
+{
+    return SaveHalfWeightsHelper( file, LayerID::RecurrentGRU, precision );
+}
 
-    return LoadLearnedParamsHelper( file, LayerID::RecurrentGRU, params );
+// Loads layer's weights of the specified 16 bit precision
+bool XGRULayer::LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision )
+{
+    return LoadHalfWeightsHelper( file, LayerID::RecurrentGRU, precision );
 }
 
 } } // ANNT::Neuro
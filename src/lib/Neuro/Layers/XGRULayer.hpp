@@ -54,10 +54,7 @@ private:
     XSigmoidActivation mSigmoid;
     XTanhActivation    mTanh;
 
-    // Weights and biases are all kept together
-    fvector_t mAllWeights;
-
-    // And here are the pointers to specific weights/biases, which are used to calculate different
+    // Pointers to specific weights/biases (all kept together in mAllWeights), which are used to calculate different
     // vectors from current layer's input, X(t), and its previous output/history, H(t-1):
 
     // 1) to calculate "update gate" vector, Z(t);
@@ -97,22 +94,6 @@ private:
 public:
     XGRULayer( size_t inputsCount, size_t outputsCount );
 
-    // Reports number of weight coefficients the layer has
-    size_t WeightsCount( ) const override
-    {
-        return mAllWeights.size( );
-    }
-
-    // Get/set layer's weights
-    fvector_t Weights( ) const override
-    {
-        return mAllWeights;
-    }
-    void SetWeights( const fvector_t& weights ) override
-    {
-        mAllWeights = weights;
-    }
-
     // Tells that we may need some extra memory for internal state/calculations
     uvector_t WorkingMemSize( bool /* trainingMode */ ) const override
     {
@@ -124,26 +105,44 @@ public:
     // Randomizes layer's weights, clears biases (forget gate biases are set to 1 though)
     void Randomize( ) override;
 
+    // Backward pass does not use outputs, so those can be overwritten by the next layer
+    bool BackwardNeedsOutputs( ) const override
+    {
+        return false;
+    }
+
     // Calculates outputs for the given inputs
     void ForwardCompute( const std::vector<fvector_t*>& inputs,
                          std::vector<fvector_t*>& outputs,
-                         const XNetworkContext& ctx ) override;
+                         const XNetworkContext& ctx ) const override;
 
     // Propagates error to the previous layer and calculates weights/biases gradients
     void BackwardCompute( const std::vector<fvector_t*>& inputs,
                           const std::vector<fvector_t*>& outputs,
                           const std::vector<fvector_t*>& deltas,
                           std::vector<fvector_t*>& prevDeltas,
-                          fvector_t& gradWeights,
+                          float_t* gradWeights,
                           const XNetworkContext& ctx ) override;
 
-    // Applies updates to the layer's weights and biases
-    void UpdateWeights( const fvector_t& updates ) override;
+    // Weights can be kept in half precision - those are widened to float on the fly while computing outputs
+    bool HalfPrecisionSupported( ) const override
+    {
+        return true;
+    }
+
+    // Saves/loads layer's weights in the specified 16 bit precision
+    bool SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const override;
+    bool LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision ) override;
 
     // Saves layer's learnt parameters/weights
     bool SaveLearnedParams( FILE* file ) const override;
     // Loads layer's learnt parameters
     bool LoadLearnedParams( FILE* file ) override;
+
+protected:
+
+    // Sets weights/biases pointers
+    void SetWeightsPointers( ) override;
 };
 
 } } // ANNT::Neuro
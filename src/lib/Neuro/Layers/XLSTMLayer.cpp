@@ -29,37 +29,43 @@ namespace ANNT { namespace Neuro {
 
 XLSTMLayer::XLSTMLayer( size_t inputsCount, size_t outputsCount ) :
     ITrainableLayer( inputsCount, outputsCount ),
-    mSigmoid( ), mTanh( ),
-    mAllWeights( ( inputsCount * outputsCount + outputsCount * outputsCount ) * 4 + outputsCount * 4 )
+    mSigmoid( ), mTanh( )
+{
+    AllocateWeights( ( inputsCount * outputsCount + outputsCount * outputsCount ) * 4 + outputsCount * 4 );
+    Randomize( );
+}
+
+// Sets weights/biases pointers
+void XLSTMLayer::SetWeightsPointers( )
 {
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights pointers
-    mWeightsX2F = mAllWeights.data( );
-    mWeightsH2F = mWeightsX2F + weightsCountInputs;
+    mWeightsX2F = mAllWeights;
+    mWeightsH2F = OffsetWeights( mWeightsX2F, weightsCountInputs );
 
-    mWeightsX2I = mWeightsH2F + weightsCountHistory;
-    mWeightsH2I = mWeightsX2I + weightsCountInputs;
+    mWeightsX2I = OffsetWeights( mWeightsH2F, weightsCountHistory );
+    mWeightsH2I = OffsetWeights( mWeightsX2I, weightsCountInputs );
 
-    mWeightsX2Z = mWeightsH2I + weightsCountHistory;
-    mWeightsH2Z = mWeightsX2Z + weightsCountInputs;
+    mWeightsX2Z = OffsetWeights( mWeightsH2I, weightsCountHistory );
+    mWeightsH2Z = OffsetWeights( mWeightsX2Z, weightsCountInputs );
 
-    mWeightsX2O = mWeightsH2Z + weightsCountHistory;
-    mWeightsH2O = mWeightsX2O + weightsCountInputs;
+    mWeightsX2O = OffsetWeights( mWeightsH2Z, weightsCountHistory );
+    mWeightsH2O = OffsetWeights( mWeightsX2O, weightsCountInputs );
 
     // set up biases pointers
-    mBiasesF = mWeightsH2O + weightsCountHistory;
-    mBiasesI = mBiasesF + mOutputsCount;
-    mBiasesZ = mBiasesI + mOutputsCount;
-    mBiasesO = mBiasesZ + mOutputsCount;
-
-    Randomize( );
+    mBiasesF = OffsetWeights( mWeightsH2O, weightsCountHistory );
+    mBiasesI = OffsetWeights( mBiasesF, mOutputsCount );
+    mBiasesZ = OffsetWeights( mBiasesI, mOutputsCount );
+    mBiasesO = OffsetWeights( mBiasesZ, mOutputsCount );
 }
 
 // Randomizes layer's weights, clears biases
 void XLSTMLayer::Randomize( )
 {
+    UnmapWeights( );
+
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
@@ -94,11 +100,17 @@ void XLSTMLayer::Randomize( )
 }
 
 // Calculates outputs for the given inputs
-void XLSTMLayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector_t*>& outputs, const XNetworkContext& ctx )
+void XLSTMLayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvector_t*>& outputs, const XNetworkContext& ctx ) const
 {
     size_t sequenceLen = ctx.TrainingSequenceLength( );
     size_t batchSize   = inputs.size( ) / sequenceLen;
 
+    // weights are accessed by their offsets (see SetWeightsPointers( )), so they can be kept in half precision as well
+    size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
+    size_t weightsCountHistory = mOutputsCount * mOutputsCount;
+    size_t gateWeightsCount    = weightsCountInputs + weightsCountHistory;
+    size_t biasesOffset        = gateWeightsCount * 4;
+
     XParallel::For( batchSize, ctx.IsTraining( ), [&]( size_t batchIndex )
     {
         float_t* state   = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_STATE,   batchIndex ) );
@@ -122,24 +134,22 @@ void XLSTMLayer::ForwardCompute( const vector<fvector_t*>& inputs, vector<fvecto
             memcpy( statePrev, state, mOutputsCount * sizeof( float_t ) );
             memcpy( historyPrev, history, mOutputsCount * sizeof( float_t ) );
 
-            for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
+            // W [X(t), H(t-1)] + B for every gate, which are laid out in the order of F, I, Z, O
+            float_t* gates[4] = { forgetGate, inputGate, candidateState, outputGate };
+
+            for ( size_t gateIndex = 0; gateIndex < 4; gateIndex++ )
             {
-                // Wf [X(t), H(t-1)] + Bf
-                forgetGate[outputIndex]     = XVectorize::Dot( input, &( mWeightsX2F[outputIndex * mInputsCount] ), mInputsCount ) +
-                                              XVectorize::Dot( historyPrev, &( mWeightsH2F[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                              mBiasesF[outputIndex];
-                // Wi [X(t), H(t-1)] + Bi
-                inputGate[outputIndex]      = XVectorize::Dot( input, &( mWeightsX2I[outputIndex * mInputsCount] ), mInputsCount ) +
-                                              XVectorize::Dot( historyPrev, &( mWeightsH2I[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                              mBiasesI[outputIndex];
-                // Wz [X(t), H(t-1)] + Bz
-                candidateState[outputIndex] = XVectorize::Dot( input, &( mWeightsX2Z[outputIndex * mInputsCount] ), mInputsCount ) +
-                                              XVectorize::Dot( historyPrev, &( mWeightsH2Z[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                              mBiasesZ[outputIndex];
-                // Wo [X(t), H(t-1)] + Bo
-                outputGate[outputIndex]     = XVectorize::Dot( input, &( mWeightsX2O[outputIndex * mInputsCount] ), mInputsCount ) +
-                                              XVectorize::Dot( historyPrev, &( mWeightsH2O[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                                              mBiasesO[outputIndex];
+                float_t* gate                 = gates[gateIndex];
+                size_t   weightsOffsetInputs  = gateIndex * gateWeightsCount;
+                size_t   weightsOffsetHistory = weightsOffsetInputs + weightsCountInputs;
+
+                CopyWeights( biasesOffset + gateIndex * mOutputsCount, mOutputsCount, gate );
+
+                for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
+                {
+                    gate[outputIndex] += WeightsDot( weightsOffsetInputs + outputIndex * mInputsCount, input, mInputsCount ) +
+                                         WeightsDot( weightsOffsetHistory + outputIndex * mOutputsCount, historyPrev, mOutputsCount );
+                }
             }
 
             // apply activations
@@ -174,7 +184,7 @@ void XLSTMLayer::BackwardCompute( const vector<fvector_t*>& inputs,
                                   const vector<fvector_t*>& /* outputs */,
                                   const vector<fvector_t*>& deltas,
                                   vector<fvector_t*>& prevDeltas,
-                                  fvector_t& gradWeights,
+                                  float_t* gradWeights,
                                   const XNetworkContext& ctx )
 {
     size_t sequenceLen   = ctx.TrainingSequenceLength( );
@@ -184,7 +194,7 @@ void XLSTMLayer::BackwardCompute( const vector<fvector_t*>& inputs,
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights gradient pointers
-    float_t* gradWeightsX2F = gradWeights.data( );
+    float_t* gradWeightsX2F = gradWeights;
     float_t* gradWeightsH2F = gradWeightsX2F + weightsCountInputs;
 
     float_t* gradWeightsX2I = gradWeightsH2F + weightsCountHistory;
@@ -351,24 +361,18 @@ void XLSTMLayer::BackwardCompute( const vector<fvector_t*>& inputs,
                 float_t dOutputGateVal    = dOutputGate[outputIndex];
 
                 // accumulate gradients for inputs' weights
-                for ( size_t inputIndex = 0, weightIndex = weightIndexStartI; inputIndex < mInputsCount; inputIndex++, weightIndex++ )
-                {
-                    gradWeightsX2F[weightIndex] += dForgetGateVal    * input[inputIndex];
-                    gradWeightsX2I[weightIndex] += dInputGateVal     * input[inputIndex];
-                    gradWeightsX2Z[weightIndex] += dCadidateStateVal * input[inputIndex];
-                    gradWeightsX2O[weightIndex] += dOutputGateVal    * input[inputIndex];
-                }
+                XVectorize::Axpy( input, dForgetGateVal,    &( gradWeightsX2F[weightIndexStartI] ), mInputsCount );
+                XVectorize::Axpy( input, dInputGateVal,     &( gradWeightsX2I[weightIndexStartI] ), mInputsCount );
+                XVectorize::Axpy( input, dCadidateStateVal, &( gradWeightsX2Z[weightIndexStartI] ), mInputsCount );
+                XVectorize::Axpy( input, dOutputGateVal,    &( gradWeightsX2O[weightIndexStartI] ), mInputsCount );
 
                 // accumulate gradients for history weights
                 if ( sequenceIndex != 0 )
                 {
-                    for ( size_t historyIndex = 0, weightIndex = weightIndexStartH; historyIndex < mOutputsCount; historyIndex++, weightIndex++ )
-                    {
-                        gradWeightsH2F[weightIndex] += dForgetGateVal    * historyPrev[historyIndex];
-                        gradWeightsH2I[weightIndex] += dInputGateVal     * historyPrev[historyIndex];
-                        gradWeightsH2Z[weightIndex] += dCadidateStateVal * historyPrev[historyIndex];
-                        gradWeightsH2O[weightIndex] += dOutputGateVal    * historyPrev[historyIndex];
-                    }
+                    XVectorize::Axpy( historyPrev, dForgetGateVal,    &( gradWeightsH2F[weightIndexStartH] ), mOutputsCount );
+                    XVectorize::Axpy( historyPrev, dInputGateVal,     &( gradWeightsH2I[weightIndexStartH] ), mOutputsCount );
+                    XVectorize::Axpy( historyPrev, dCadidateStateVal, &( gradWeightsH2Z[weightIndexStartH] ), mOutputsCount );
+                    XVectorize::Axpy( historyPrev, dOutputGateVal,    &( gradWeightsH2O[weightIndexStartH] ), mOutputsCount );
                 }
 
                 // accumulate gradients for biases
@@ -381,29 +385,28 @@ void XLSTMLayer::BackwardCompute( const vector<fvector_t*>& inputs,
     } );
 }
 
-// Applies updates to the layer's weights and biases
-void XLSTMLayer::UpdateWeights( const fvector_t& updates )
-{
-    for ( size_t i = 0, n = mAllWeights.size( ); i < n; i++ )
-    {
-        mAllWeights[i] += updates[i];
-    }
-}
-
 // Saves layer's learnt parameters/weights
 bool XLSTMLayer::SaveLearnedParams( FILE* file ) const
 {
-    vector<const fvector_t*> params( { &mAllWeights } );
-
-    return SaveLearnedParamsHelper( file, LayerID::RecurrentLSTM, params );
+    return SaveWeightsHelper( file, LayerID::RecurrentLSTM );
 }
 
 // Loads layer's learnt parameters
 bool XLSTMLayer::LoadLearnedParams( FILE* file )
 {
-    vector<fvector_t*> params( { &mAllWeights } );
+    return LoadWeightsHelper( file, LayerID::RecurrentLSTM );
+}
 
-    return LoadLearnedParamsHelper( file, LayerID::RecurrentLSTM, params );
+// Saves layer's weights in the specified 16 bit precision
+bool XLSTMLayer::SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const
+{
+    return SaveHalfWeightsHelper( file, LayerID::RecurrentLSTM, precision );
+}
+
+// Loads layer's weights of the specified 16 bit precision
+bool XLSTMLayer::LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision )
+{
+    return LoadHalfWeightsHelper( file, LayerID::RecurrentLSTM, precision );
 }
 
 } } // ANNT::Neuro
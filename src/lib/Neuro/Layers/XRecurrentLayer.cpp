@@ -29,25 +29,31 @@ namespace ANNT { namespace Neuro {
 
 XRecurrentLayer::XRecurrentLayer( size_t inputsCount, size_t outputsCount ) :
     ITrainableLayer( inputsCount, outputsCount ),
-    mTanh( ),
-    mAllWeights( ( inputsCount + outputsCount ) * outputsCount  + outputsCount )
+    mTanh( )
+{
+    AllocateWeights( ( inputsCount + outputsCount ) * outputsCount  + outputsCount );
+    Randomize( );
+}
+
+// Sets weights/biases pointers
+void XRecurrentLayer::SetWeightsPointers( )
 {
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights pointers
-    mWeightsU = mAllWeights.data( );
-    mWeightsW = mWeightsU + weightsCountInputs;
+    mWeightsU = mAllWeights;
+    mWeightsW = OffsetWeights( mWeightsU, weightsCountInputs );
 
     // set up biases pointers
-    mBiasesB  = mWeightsW + weightsCountHistory;
-
-    Randomize( );
+    mBiasesB  = OffsetWeights( mWeightsW, weightsCountHistory );
 }
 
 // Randomizes layer's weights, clears biases
 void XRecurrentLayer::Randomize( )
 {
+    UnmapWeights( );
+
     size_t weightsCountInputs  = mInputsCount  * mOutputsCount;
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
@@ -73,11 +79,16 @@ void XRecurrentLayer::Randomize( )
 // Calculates outputs for the given inputs
 void XRecurrentLayer::ForwardCompute( const vector<fvector_t*>& inputs,
                                       vector<fvector_t*>& outputs,
-                                      const XNetworkContext& ctx )
+                                      const XNetworkContext& ctx ) const
 {
     size_t sequenceLen = ctx.TrainingSequenceLength( );
     size_t batchSize   = inputs.size( ) / sequenceLen;
 
+    // weights are accessed by their offsets (see SetWeightsPointers( )), so they can be kept in half precision as well
+    size_t offsetU      = 0;
+    size_t offsetW      = offsetU + mInputsCount * mOutputsCount;
+    size_t offsetBiases = offsetW + mOutputsCount * mOutputsCount;
+
     XParallel::For( batchSize, ctx.IsTraining( ), [&]( size_t batchIndex )
     {
         float_t* state = static_cast<float_t*>( ctx.GetWorkingBuffer( BUFFER_INDEX_STATE, batchIndex ) );
@@ -94,15 +105,16 @@ void XRecurrentLayer::ForwardCompute( const vector<fvector_t*>& inputs,
             // remember previous state for this particular sample
             memcpy( statePrev, state, mOutputsCount * sizeof( float_t ) );
 
+            // start with B
+            CopyWeights( offsetBiases, mOutputsCount, state );
+
             for ( size_t outputIndex = 0; outputIndex < mOutputsCount; outputIndex++ )
             {
-                state[outputIndex] =
+                state[outputIndex] +=
                     // X(t) * U
-                    XVectorize::Dot( input, &( mWeightsU[outputIndex * mInputsCount] ), mInputsCount ) +
+                    WeightsDot( offsetU + outputIndex * mInputsCount, input, mInputsCount ) +
                     // H(t-1) * W
-                    XVectorize::Dot( statePrev, &( mWeightsW[outputIndex * mOutputsCount] ), mOutputsCount ) +
-                    // B
-                    mBiasesB[outputIndex];
+                    WeightsDot( offsetW + outputIndex * mOutputsCount, statePrev, mOutputsCount );
             }
 
             // apply tanh() to get the final H(t)
@@ -122,7 +134,7 @@ void XRecurrentLayer::BackwardCompute( const vector<fvector_t*>& inputs,
                                        const vector<fvector_t*>& /* outputs */,
                                        const vector<fvector_t*>& deltas,
                                        vector<fvector_t*>& prevDeltas,
-                                       fvector_t& gradWeights,
+                                       float_t* gradWeights,
                                        const XNetworkContext& ctx )
 {
     size_t sequenceLen   = ctx.TrainingSequenceLength( );
@@ -132,7 +144,7 @@ void XRecurrentLayer::BackwardCompute( const vector<fvector_t*>& inputs,
     size_t weightsCountHistory = mOutputsCount * mOutputsCount;
 
     // set up weights gradient pointers
-    float_t* gradWeightsU = gradWeights.data( );
+    float_t* gradWeightsU = gradWeights;
     float_t* gradWeightsW = gradWeightsU + weightsCountInputs;
     
     // set up biases gradient pointers
@@ -208,18 +220,12 @@ void XRecurrentLayer::BackwardCompute( const vector<fvector_t*>& inputs,
 
                 // accumulate weights' gradients
                 // dU
-                for ( size_t inputIndex = 0, weightIndex = weightIndexStartI; inputIndex < mInputsCount; inputIndex++, weightIndex++ )
-                {
-                    gradWeightsU[weightIndex] += stateDeltaCurrnet[outputIndex] * input[inputIndex];
-                }
+                XVectorize::Axpy( input.data( ), stateDeltaCurrnet[outputIndex], &( gradWeightsU[weightIndexStartI] ), mInputsCount );
 
                 // dW
                 if ( sequenceIndex != 0 )
                 {
-                    for ( size_t historyIndex = 0, weightIndex = weightIndexStartH; historyIndex < mOutputsCount; historyIndex++, weightIndex++ )
-                    {
-                        gradWeightsW[weightIndex] += stateDeltaCurrnet[outputIndex] * statePrev[historyIndex];
-                    }
+                    XVectorize::Axpy( statePrev, stateDeltaCurrnet[outputIndex], &( gradWeightsW[weightIndexStartH] ), mOutputsCount );
                 }
 
                 // accumulate biases' gradients
@@ -230,29 +236,28 @@ void XRecurrentLayer::BackwardCompute( const vector<fvector_t*>& inputs,
     } );
 }
 
-// Applies updates to the layer's weights and biases
-void XRecurrentLayer::UpdateWeights( const fvector_t& updates )
-{
-    for ( size_t i = 0, n = mAllWeights.size( ); i < n; i++ )
-    {
-        mAllWeights[i] += updates[i];
-    }
-}
-
 // Saves layer's learnt parameters/weights
 bool XRecurrentLayer::SaveLearnedParams( FILE* file ) const
 {
-    vector<const fvector_t*> params( { &mAllWeights } );
-
-    return SaveLearnedParamsHelper( file, LayerID::RecurrentBasic, params );
+    return SaveWeightsHelper( file, LayerID::RecurrentBasic );
 }
 
 // Loads layer's learnt parameters
 bool XRecurrentLayer::LoadLearnedParams( FILE* file )
 {
-    vector<fvector_t*> params( { &mAllWeights } );
+    return LoadWeightsHelper( file, LayerID::RecurrentBasic );
+}
 
-    return LoadLearnedParamsHelper( file, LayerID::RecurrentBasic, params );
+// Saves layer's weights in the specified 16 bit precision
+bool XRecurrentLayer::SaveHalfPrecisionParams( FILE* file, WeightsPrecision precision ) const
+{
+    return SaveHalfWeightsHelper( file, LayerID::RecurrentBasic, precision );
+}
+
+// Loads layer's weights of the specified 16 bit precision
+bool XRecurrentLayer::LoadHalfPrecisionParams( FILE* file, WeightsPrecision precision )
+{
+    return LoadHalfWeightsHelper( file, LayerID::RecurrentBasic, precision );
 }
 
 } } // ANNT::Neuro
@@ -37,7 +37,7 @@ XNetworkContext::~XNetworkContext( )
 }
 
 // Allocate working buffer for laters of the network
-void XNetworkContext::AllocateWorkingBuffers( const std::shared_ptr<XNeuralNetwork>& net, size_t batchSize )
+void XNetworkContext::AllocateWorkingBuffers( const std::shared_ptr<const XNeuralNetwork>& net, size_t batchSize )
 {
     FreeWorkingBuffers( );
 
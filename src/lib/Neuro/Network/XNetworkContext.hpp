@@ -81,7 +81,7 @@ public:
 protected:
 
     // Allocate working buffer for layers of the network
-    void AllocateWorkingBuffers( const std::shared_ptr<XNeuralNetwork>& net, size_t batchSize );
+    void AllocateWorkingBuffers( const std::shared_ptr<const XNeuralNetwork>& net, size_t batchSize );
 
     // Clear layers' working buffers (memset zero)
     void ResetWorkingBuffers( );
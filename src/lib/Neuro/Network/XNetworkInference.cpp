@@ -18,28 +18,219 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
+
 #include "XNetworkInference.hpp"
 #include "XNetworkContext.hpp"
+#include "../Layers/XConvolutionLayer.hpp"
+#include "../Layers/XFullyConnectedLayer.hpp"
+#include "../Layers/XGRULayer.hpp"
+#include "../Layers/XLSTMLayer.hpp"
+#include "../Layers/XRecurrentLayer.hpp"
+#include "../Layers/Activations/IActivationLayer.hpp"
+#include "../Layers/Processing/XAveragePooling.hpp"
+#include "../Layers/Processing/XMaxPooling.hpp"
 #include "../../Tools/XDataEncodingTools.hpp"
+#include "../../Tools/XParallel.hpp"
 
 using namespace std;
 
 namespace ANNT { namespace Neuro {
 
-XNetworkInference::XNetworkInference( const shared_ptr<XNeuralNetwork>& network ) :
+namespace {
+
+// Default number of samples computed as a single batch when testing classification
+static const size_t DEFAULT_TEST_CHUNK_SIZE = 16;
+
+// Number of output values fused layers compute at once (rounded to whole samples), so they stay in L2 cache
+// until activated and pooled
+static const size_t FUSED_BLOCK_SIZE = 65536;
+
+// Assigns layers' outputs to memory slots, so that outputs needed at the same time don't share a slot.
+// Output of a layer is only needed until the next layer is computed, so picking the best fitting free
+// slot for every layer keeps the peak memory close to the sum of the two largest adjacent outputs.
+// Layers computing in place get the slot of their inputs.
+static void PlanOutputSlots( const uvector_t& outputsCount, const vector<bool>& inPlace,
+                             uvector_t& layersSlots, uvector_t& slotsSize )
+{
+    uvector_t slotsFreeFrom;    // index of the first layer, which may reuse a slot
+
+    layersSlots.resize( outputsCount.size( ) );
+    slotsSize.clear( );
+
+    for ( size_t layerIndex = 0; layerIndex < outputsCount.size( ); layerIndex++ )
+    {
+        size_t outputSize = outputsCount[layerIndex];
+        size_t bestSlot   = slotsSize.size( );
+
+        if ( inPlace[layerIndex] )
+        {
+            bestSlot = layersSlots[layerIndex - 1];
+        }
+
+        for ( size_t slot = 0; ( slot < slotsSize.size( ) ) && ( !inPlace[layerIndex] ); slot++ )
+        {
+            if ( slotsFreeFrom[slot] > layerIndex )
+            {
+                continue;
+            }
+
+            if ( bestSlot == slotsSize.size( ) )
+            {
+                bestSlot = slot;
+            }
+            else
+            {
+                bool fits     = ( slotsSize[slot] >= outputSize );
+                bool bestFits = ( slotsSize[bestSlot] >= outputSize );
+
+                // prefer the smallest slot big enough for the output, otherwise the one needing least growth
+                if ( ( ( fits ) && ( ( !bestFits ) || ( slotsSize[slot] < slotsSize[bestSlot] ) ) ) ||
+                     ( ( !fits ) && ( !bestFits ) && ( slotsSize[slot] > slotsSize[bestSlot] ) ) )
+                {
+                    bestSlot = slot;
+                }
+            }
+        }
+
+        if ( bestSlot == slotsSize.size( ) )
+        {
+            slotsSize.push_back( 0 );
+            slotsFreeFrom.push_back( 0 );
+        }
+
+        layersSlots[layerIndex]  = bestSlot;
+        slotsSize[bestSlot]      = std::max( slotsSize[bestSlot], outputSize );
+        slotsFreeFrom[bestSlot]  = layerIndex + 2;
+    }
+}
+
+// Splits layers of the network into inference steps. Convolution or fully connected layer followed by element wise
+// activation is fused into a single step, which also includes pooling if it follows activation of convolution.
+// Both layers apply activation themselves (see their ForwardCompute( ) taking activation), while convolution
+// also computes blocks of samples, so pooling gets their outputs while still in cache.
+static void PlanInferenceSteps( const XNeuralNetwork& network, uvector_t& stepsLayersCount, uvector_t& stepsBlockSize )
+{
+    size_t layersCount = network.LayersCount( );
+    auto   layers      = network.begin( );
+
+    stepsLayersCount.clear( );
+    stepsBlockSize.clear( );
+
+    for ( size_t layerIndex = 0; layerIndex < layersCount; )
+    {
+        bool   isConvolution = static_cast<bool>( dynamic_pointer_cast<XConvolutionLayer>( layers[layerIndex] ) );
+        bool   isFullyConn   = static_cast<bool>( dynamic_pointer_cast<XFullyConnectedLayer>( layers[layerIndex] ) );
+        size_t stepLayers    = 1;
+
+        // activation must compute in place, so it shares memory slot with the layer it is fused with
+        if ( ( ( isConvolution ) || ( isFullyConn ) ) && ( layerIndex + 1 < layersCount ) &&
+             ( dynamic_pointer_cast<IActivationLayer>( layers[layerIndex + 1] ) ) &&
+             ( layers[layerIndex + 1]->CanComputeInPlace( ) ) )
+        {
+            stepLayers = 2;
+
+            if ( ( isConvolution ) && ( layerIndex + 2 < layersCount ) &&
+                 ( ( dynamic_pointer_cast<XMaxPooling>( layers[layerIndex + 2] ) ) ||
+                   ( dynamic_pointer_cast<XAveragePooling>( layers[layerIndex + 2] ) ) ) )
+            {
+                stepLayers = 3;
+            }
+        }
+
+        stepsLayersCount.push_back( stepLayers );
+        stepsBlockSize.push_back( std::max( FUSED_BLOCK_SIZE / layers[layerIndex]->OutputsCount( ), size_t( 1 ) ) );
+
+        layerIndex += stepLayers;
+    }
+}
+
+} // namespace <anonymous>
+
+XNetworkInference::XNetworkInference( const shared_ptr<const XNeuralNetwork>& network ) :
     mNetwork( network ),
-    mInferenceContext( false )
+    mInferenceContext( false ),
+    mTestChunkSize( DEFAULT_TEST_CHUNK_SIZE )
+{
+    PlanInference( );
+
+    // prepare output vectors for a single sample; more are allocated when batches are computed
+    SetBatchSize( 1 );
+}
+
+// Plans memory slots for layers' outputs and inference steps for the current configuration of the network
+void XNetworkInference::PlanInference( )
 {
-    mComputeInputs.resize( 1 );
+    uvector_t    outputsCount;
+    vector<bool> inPlace;
 
-    // prepare output vectors for all layers and for all samples (only one sample here for now)
+    mIsRecurrent = false;
+
+    // network's inputs are provided by caller, so the first layer never computes in place
     for ( auto layer : *mNetwork )
     {
-        mComputeOutputsStorage.push_back( vector<fvector_t>( { fvector_t( layer->OutputsCount( ) ) } ) );
-        mComputeOutputs.push_back( vector<fvector_t*>( { &( mComputeOutputsStorage.back( )[0] ) } ) );
+        inPlace.push_back( ( !outputsCount.empty( ) ) && ( layer->CanComputeInPlace( ) ) );
+        outputsCount.push_back( layer->OutputsCount( ) );
+
+        if ( ( dynamic_pointer_cast<XRecurrentLayer>( layer ) ) ||
+             ( dynamic_pointer_cast<XLSTMLayer>( layer ) ) ||
+             ( dynamic_pointer_cast<XGRULayer>( layer ) ) )
+        {
+            mIsRecurrent = true;
+        }
     }
 
-    mInferenceContext.AllocateWorkingBuffers( network, 1 );
+    PlanOutputSlots( outputsCount, inPlace, mLayersSlots, mSlotsSize );
+    PlanInferenceSteps( *mNetwork, mStepsLayersCount, mStepsBlockSize );
+
+    // nothing is allocated for the new plan yet, so SetBatchSize( ) allocates outputs and working buffers
+    mComputeSlotsStorage.clear( );
+    mComputeSlotsStorage.resize( mSlotsSize.size( ) );
+    mComputeOutputs.clear( );
+    mComputeOutputs.resize( mNetwork->LayersCount( ) );
+    mComputeInputs.clear( );
+
+    // sessions were planned for the previous configuration as well
+    mTestSessions.clear( );
+
+    mPlannedVersion = mNetwork->ConfigurationVersion( );
+}
+
+// Prepares layers' outputs and working buffers for the given batch size
+void XNetworkInference::SetBatchSize( size_t batchSize )
+{
+    size_t layersCount;
+
+    UpdatePlan( );
+
+    layersCount = mNetwork->LayersCount( );
+
+    if ( mComputeInputs.size( ) == batchSize )
+    {
+        return;
+    }
+
+    if ( ( layersCount != 0 ) && ( mComputeSlotsStorage[0].size( ) < batchSize ) )
+    {
+        for ( size_t slot = 0; slot < mComputeSlotsStorage.size( ); slot++ )
+        {
+            mComputeSlotsStorage[slot].resize( batchSize, fvector_t( mSlotsSize[slot] ) );
+        }
+
+        mInferenceContext.AllocateWorkingBuffers( mNetwork, batchSize );
+    }
+
+    mComputeInputs.resize( batchSize );
+
+    for ( size_t layerIndex = 0; layerIndex < layersCount; layerIndex++ )
+    {
+        mComputeOutputs[layerIndex].resize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            mComputeOutputs[layerIndex][i] = &( mComputeSlotsStorage[mLayersSlots[layerIndex]][i] );
+        }
+    }
 }
 
 // Computes output vector for the given input vector
@@ -47,12 +238,13 @@ void XNetworkInference::Compute( const fvector_t& input, fvector_t& output )
 {
     if ( mNetwork->LayersCount( ) != 0 )
     {
+        SetBatchSize( 1 );
         mComputeInputs[0] = const_cast<fvector_t*>( &input );
 
-        DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
+        DoInference( );
 
         // copy output produced by the last layer
-        output = mComputeOutputsStorage.back( )[0];
+        output = *( mComputeOutputs.back( )[0] );
     }
 }
 
@@ -63,51 +255,307 @@ size_t XNetworkInference::Classify( const fvector_t& input )
 
     if ( mNetwork->LayersCount( ) != 0 )
     {
+        SetBatchSize( 1 );
         mComputeInputs[0] = const_cast<fvector_t*>( &input );
 
-        DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
+        DoInference( );
 
-        classIndex = XDataEncodingTools::MaxIndex( mComputeOutputsStorage.back( )[0] );
+        classIndex = XDataEncodingTools::MaxIndex( *( mComputeOutputs.back( )[0] ) );
     }
 
     return classIndex;
 }
 
+// Computes output vectors for the given batch of input vectors
+void XNetworkInference::ComputeBatch( const vector<fvector_t>& inputs, vector<fvector_t>& outputs )
+{
+    size_t batchSize = inputs.size( );
+
+    outputs.resize( batchSize );
+    mBatchOutputs.resize( batchSize );
+
+    for ( size_t i = 0; i < batchSize; i++ )
+    {
+        outputs[i].resize( mNetwork->OutputsCount( ) );
+        mBatchOutputs[i] = &( outputs[i] );
+    }
+
+    if ( ( mNetwork->LayersCount( ) != 0 ) && ( batchSize != 0 ) )
+    {
+        SetBatchSize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            mComputeInputs[i] = const_cast<fvector_t*>( &( inputs[i] ) );
+        }
+
+        // let the last layer write directly into caller's vectors
+        mComputeOutputs.back( ).swap( mBatchOutputs );
+        DoInference( );
+        mComputeOutputs.back( ).swap( mBatchOutputs );
+    }
+}
+
+// Computes output vectors for the given batch of input vectors into caller provided vectors
+void XNetworkInference::ComputeBatch( const vector<fvector_t*>& inputs, vector<fvector_t*>& outputs )
+{
+    size_t batchSize = inputs.size( );
+
+    assert( outputs.size( ) == batchSize );
+
+    if ( ( mNetwork->LayersCount( ) != 0 ) && ( batchSize != 0 ) )
+    {
+        SetBatchSize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            assert( outputs[i]->size( ) == mNetwork->OutputsCount( ) );
+            mComputeInputs[i] = inputs[i];
+        }
+
+        mComputeOutputs.back( ).swap( outputs );
+        DoInference( );
+        mComputeOutputs.back( ).swap( outputs );
+    }
+}
+
+// Runs classification for the given batch of inputs
+void XNetworkInference::ClassifyBatch( const vector<fvector_t>& inputs, uvector_t& classes )
+{
+    size_t batchSize = inputs.size( );
+
+    classes.resize( batchSize );
+
+    if ( ( mNetwork->LayersCount( ) != 0 ) && ( batchSize != 0 ) )
+    {
+        SetBatchSize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            mComputeInputs[i] = const_cast<fvector_t*>( &( inputs[i] ) );
+        }
+
+        DoInference( );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            classes[i] = XDataEncodingTools::MaxIndex( *mComputeOutputs.back( )[i] );
+        }
+    }
+}
+
 // Tests classification for the provided inputs and target labels - provides number of correctly classified samples
 size_t XNetworkInference::TestClassification( const vector<fvector_t>& inputs, const uvector_t& targetLabels )
 {
     size_t correctLabelsCounter = 0;
 
-    if ( mNetwork->LayersCount( ) != 0 )
+    if ( ( mNetwork->LayersCount( ) != 0 ) && ( inputs.size( ) != 0 ) )
     {
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+        uvector_t chunksCorrectLabels( TestChunksCount( inputs.size( ) ) );
+
+        RunParallelTest( inputs.size( ),
+            [&]( size_t i )
+            {
+                return const_cast<fvector_t*>( &( inputs[i] ) );
+            },
+            [&]( size_t chunkIndex, size_t firstSample, const vector<fvector_t*>& outputs )
+            {
+                for ( size_t i = 0; i < outputs.size( ); i++ )
+                {
+                    if ( XDataEncodingTools::MaxIndex( *( outputs[i] ) ) == targetLabels[firstSample + i] )
+                    {
+                        chunksCorrectLabels[chunkIndex]++;
+                    }
+                }
+            } );
+
+        for ( size_t counter : chunksCorrectLabels )
         {
-            mComputeInputs[0] = const_cast<fvector_t*>( &( inputs[i] ) );
+            correctLabelsCounter += counter;
+        }
+    }
 
-            DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
+    return correctLabelsCounter;
+}
+
+// Runs the calibration inputs through the network and collects range of values every layer gets as its inputs
+void XNetworkInference::CalibrateInputsRange( const vector<fvector_t>& inputs, fvector_t& inputsMin, fvector_t& inputsMax )
+{
+    size_t layersCount = mNetwork->LayersCount( );
+    auto   layers      = mNetwork->begin( );
+
+    inputsMin.assign( layersCount, float_t( 0 ) );
+    inputsMax.assign( layersCount, float_t( 0 ) );
+
+    for ( size_t chunkStart = 0; ( layersCount != 0 ) && ( chunkStart < inputs.size( ) ); chunkStart += mTestChunkSize )
+    {
+        size_t batchSize = std::min( mTestChunkSize, inputs.size( ) - chunkStart );
+
+        SetBatchSize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            mComputeInputs[i] = const_cast<fvector_t*>( &( inputs[chunkStart + i] ) );
+        }
+
+        // layers are computed one by one with no fusion, since their inputs get overwritten by the layers sharing memory slots
+        for ( size_t layerIndex = 0; layerIndex < layersCount; layerIndex++ )
+        {
+            const vector<fvector_t*>& layerInputs = ( layerIndex == 0 ) ? mComputeInputs : mComputeOutputs[layerIndex - 1];
+
+            for ( auto input : layerInputs )
+            {
+                auto range = std::minmax_element( input->begin( ), input->end( ) );
 
-            if ( XDataEncodingTools::MaxIndex( mComputeOutputsStorage.back( )[0] ) == targetLabels[i] )
+                if ( range.first != input->end( ) )
+                {
+                    inputsMin[layerIndex] = std::min( inputsMin[layerIndex], *range.first );
+                    inputsMax[layerIndex] = std::max( inputsMax[layerIndex], *range.second );
+                }
+            }
+
+            for ( auto output : mComputeOutputs[layerIndex] )
             {
-                correctLabelsCounter++;
+                output->resize( layers[layerIndex]->OutputsCount( ) );
             }
+
+            mInferenceContext.SetCurrentLayerIndex( layerIndex );
+            layers[layerIndex]->ForwardCompute( layerInputs, mComputeOutputs[layerIndex], mInferenceContext );
         }
     }
+}
 
-    return correctLabelsCounter;
+// Computes chunks of samples in parallel using per-thread inference sessions
+void XNetworkInference::RunParallelTest( size_t samplesCount,
+                                         const function<fvector_t*( size_t )>& getInput,
+                                         const function<void( size_t, size_t, const vector<fvector_t*>& )>& testChunk )
+{
+    size_t chunksCount = TestChunksCount( samplesCount );
+
+    UpdatePlan( );
+
+    // recurrent layers carry state from one sample to the next, so samples are computed one by one in order
+    if ( mIsRecurrent )
+    {
+        SetBatchSize( 1 );
+
+        for ( size_t i = 0; i < samplesCount; i++ )
+        {
+            mComputeInputs[0] = getInput( i );
+
+            DoInference( );
+
+            testChunk( i / mTestChunkSize, i, mComputeOutputs.back( ) );
+        }
+
+        return;
+    }
+
+    // sessions share the network, but have their own outputs and working buffers
+    while ( mTestSessions.size( ) < XParallel::ThreadsCount( ) )
+    {
+        mTestSessions.push_back( unique_ptr<XNetworkInference>( new XNetworkInference( mNetwork ) ) );
+    }
+
+    for ( auto& session : mTestSessions )
+    {
+        session->ResetState( );
+    }
+
+    XParallel::For( chunksCount, chunksCount > 1, [&]( size_t chunkIndex )
+    {
+        XNetworkInference* session     = mTestSessions[XParallel::ThreadIndex( )].get( );
+        size_t             firstSample = chunkIndex * mTestChunkSize;
+        size_t             batchSize   = std::min( mTestChunkSize, samplesCount - firstSample );
+
+        session->SetBatchSize( batchSize );
+
+        for ( size_t i = 0; i < batchSize; i++ )
+        {
+            session->mComputeInputs[i] = getInput( firstSample + i );
+        }
+
+        session->DoInference( );
+
+        testChunk( chunkIndex, firstSample, session->mComputeOutputs.back( ) );
+    } );
+}
+
+// Computes outputs of all layers for the inputs set in mComputeInputs
+void XNetworkInference::DoInference( )
+{
+    auto   layers     = mNetwork->begin( );
+    size_t layerIndex = 0;
+
+    for ( size_t step = 0; step < mStepsLayersCount.size( ); step++ )
+    {
+        size_t stepLayers = mStepsLayersCount[step];
+
+        // slots are shared by layers of different size, so set outputs' size expected by the step's layers
+        for ( size_t i = layerIndex; i < layerIndex + stepLayers; i++ )
+        {
+            size_t outputsCount = layers[i]->OutputsCount( );
+
+            for ( auto output : mComputeOutputs[i] )
+            {
+                output->resize( outputsCount );
+            }
+        }
+
+        if ( stepLayers == 1 )
+        {
+            mInferenceContext.SetCurrentLayerIndex( layerIndex );
+            layers[layerIndex]->ForwardCompute( ( layerIndex == 0 ) ? mComputeInputs : mComputeOutputs[layerIndex - 1],
+                                                mComputeOutputs[layerIndex], mInferenceContext );
+        }
+        else
+        {
+            DoFusedInference( layerIndex, stepLayers, mStepsBlockSize[step] );
+        }
+
+        layerIndex += stepLayers;
+    }
 }
 
-// Helper method to compute output vectors for the given input vectors
-void XNetworkInference::DoCompute( const vector<fvector_t*>& inputs,
-                                   vector<vector<fvector_t*>>& outputs,
-                                   XNetworkContext& ctx )
+// Computes a step of fused layers block by block
+void XNetworkInference::DoFusedInference( size_t firstLayer, size_t layersCount, size_t blockSize )
 {
-    ctx.SetCurrentLayerIndex( 0 );
-    mNetwork->LayerAt( 0 )->ForwardCompute( inputs, outputs[0], ctx );
+    auto                        layers     = mNetwork->begin( ) + firstLayer;
+    const XFullyConnectedLayer* fcLayer    = dynamic_cast<const XFullyConnectedLayer*>( layers[0].get( ) );
+    const XConvolutionLayer*    convLayer  = dynamic_cast<const XConvolutionLayer*>( layers[0].get( ) );
+    const IActivationLayer*     activation = static_cast<const IActivationLayer*>( layers[1].get( ) );
+    const vector<fvector_t*>&   inputs     = ( firstLayer == 0 ) ? mComputeInputs : mComputeOutputs[firstLayer - 1];
+    vector<fvector_t*>&         activated  = mComputeOutputs[firstLayer + 1];
+    size_t                      batchSize  = inputs.size( );
+
+    if ( fcLayer != nullptr )
+    {
+        // matrix multiplication activates blocks of outputs it completes, writing them directly as activation's outputs
+        mInferenceContext.SetCurrentLayerIndex( firstLayer );
+        fcLayer->ForwardCompute( inputs, activated, mInferenceContext, activation );
+        return;
+    }
 
-    for ( size_t i = 1, layersCount = mNetwork->LayersCount( ); i < layersCount; i++ )
+    for ( size_t blockStart = 0; blockStart < batchSize; blockStart += blockSize )
     {
-        ctx.SetCurrentLayerIndex( i );
-        mNetwork->LayerAt( i )->ForwardCompute( outputs[i - 1], outputs[i], ctx );
+        size_t blockEnd = std::min( blockStart + blockSize, batchSize );
+
+        mBlockInputs.assign( inputs.begin( ) + blockStart, inputs.begin( ) + blockEnd );
+        mBlockOutputs.assign( activated.begin( ) + blockStart, activated.begin( ) + blockEnd );
+
+        // convolution writes activated outputs directly as activation's outputs
+        mInferenceContext.SetCurrentLayerIndex( firstLayer );
+        convLayer->ForwardCompute( mBlockInputs, mBlockOutputs, mInferenceContext, activation );
+
+        if ( layersCount == 3 )
+        {
+            mBlockInputs.assign( activated.begin( ) + blockStart, activated.begin( ) + blockEnd );
+            mBlockOutputs.assign( mComputeOutputs[firstLayer + 2].begin( ) + blockStart,
+                                  mComputeOutputs[firstLayer + 2].begin( ) + blockEnd );
+
+            mInferenceContext.SetCurrentLayerIndex( firstLayer + 2 );
+            layers[2]->ForwardCompute( mBlockInputs, mBlockOutputs, mInferenceContext );
+        }
     }
 }
 
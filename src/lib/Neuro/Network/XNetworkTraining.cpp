@@ -20,23 +20,40 @@
 
 #include <algorithm>
 #include <functional>
+#include <string.h>
 
 #include "XNetworkTraining.hpp"
 #include "XNetworkContext.hpp"
 #include "../Layers/ITrainableLayer.hpp"
+#include "../Layers/Activations/XSoftMaxActivation.hpp"
+#include "../Layers/Activations/XLogSoftMaxActivation.hpp"
+#include "../CostFunctions/XCrossEntropyCost.hpp"
+#include "../CostFunctions/XNegativeLogLikelihoodCost.hpp"
+#include "../../Tools/XParallel.hpp"
+#include "../../Tools/XVectorize.hpp"
 #include "../../Tools/XDataEncodingTools.hpp"
 
 using namespace std;
 
 namespace ANNT { namespace Neuro { namespace Training {
 
+namespace {
+
+// Number of parameters updated by a single task, when layers' weights are updated in parallel
+static const size_t WEIGHTS_UPDATE_CHUNK_SIZE = 16384;
+
+} // namespace <anonymous>
+
 XNetworkTraining::XNetworkTraining( const shared_ptr<XNeuralNetwork>& network,
                                     const shared_ptr<INetworkOptimizer>& optimizer,
                                     const shared_ptr<ICostFunction>& costFunction ) :
     XNetworkInference( network ),
+    mTrainedNetwork( network ),
     mOptimizer( optimizer ),
     mCostFunction( costFunction ),
     mAverageWeightGradients( true ),
+    mOutputStage( OutputStage::Generic ),
+    mStoredOutputsPrecision( WeightsPrecision::Float ),
     mTrainingContext( true, 1 )
 {
     size_t optimizerParameterVariablesCount = mOptimizer->ParameterVariablesCount( );
@@ -47,7 +64,7 @@ XNetworkTraining::XNetworkTraining( const shared_ptr<XNeuralNetwork>& network,
     // 1) weight and bias gradients (accumulated over samples during batch);
     // 2) optimizer's variables;
 
-    for ( auto layer : *mNetwork )
+    for ( auto layer : *mTrainedNetwork )
     {
         size_t weightsCount = 0;
 
@@ -56,10 +73,19 @@ XNetworkTraining::XNetworkTraining( const shared_ptr<XNeuralNetwork>& network,
         if ( layer->Trainable( ) )
         {
             weightsCount = static_pointer_cast<ITrainableLayer>( layer )->WeightsCount( );
+
+            // weights mapped from read-only memory need to be copied before training can change them
+            static_pointer_cast<ITrainableLayer>( layer )->UnmapWeights( );
         }
 
         mGradWeights.push_back( fvector_t( weightsCount ) );
 
+        // split layer's parameters into chunks, which can be updated in parallel
+        for ( size_t offset = 0; offset < weightsCount; offset += WEIGHTS_UPDATE_CHUNK_SIZE )
+        {
+            mWeightsUpdateChunks.push_back( make_pair( mGradWeights.size( ) - 1, offset ) );
+        }
+
         // optimizer's variables ...
         mOptimizerParameterVariables.push_back( vector<fvector_t>( optimizerParameterVariablesCount ) );
         mOptimizerLayerVariables.push_back( fvector_t( optimizerLayerVariablesCount ) );
@@ -69,40 +95,129 @@ XNetworkTraining::XNetworkTraining( const shared_ptr<XNeuralNetwork>& network,
             mOptimizerParameterVariables.back( )[i] = fvector_t( weightsCount );
         }
     }
+
+    // check if the last layer together with cost function can be handled as fused output stage
+    if ( mTrainedNetwork->LayersCount( ) != 0 )
+    {
+        shared_ptr<ILayer> lastLayer = mTrainedNetwork->LayerAt( mTrainedNetwork->LayersCount( ) - 1 );
+
+        if ( ( dynamic_pointer_cast<XSoftMaxActivation>( lastLayer ) ) &&
+             ( dynamic_pointer_cast<XCrossEntropyCost>( mCostFunction ) ) )
+        {
+            mOutputStage = OutputStage::SoftMaxCrossEntropy;
+        }
+        else if ( ( dynamic_pointer_cast<XLogSoftMaxActivation>( lastLayer ) ) &&
+                  ( dynamic_pointer_cast<XNegativeLogLikelihoodCost>( mCostFunction ) ) )
+        {
+            mOutputStage = OutputStage::LogSoftMaxNegativeLogLikelihood;
+        }
+    }
+}
+
+// Enables/disables keeping all parameters in a single arena
+bool XNetworkTraining::SetUseParameterArena( bool useArena )
+{
+    if ( useArena == static_cast<bool>( mParameterArena ) )
+    {
+        return true;
+    }
+
+    size_t optimizerParameterVariablesCount = mOptimizer->ParameterVariablesCount( );
+    size_t optimizerLayerVariablesCount     = mOptimizer->LayerVariablesCount( );
+    bool   layerVariablesMoved              = false;
+
+    if ( useArena )
+    {
+        mParameterArena.reset( new XParameterArena( mTrainedNetwork, optimizerParameterVariablesCount, optimizerLayerVariablesCount ) );
+
+        if ( !mParameterArena->IsAttached( ) )
+        {
+            mParameterArena.reset( );
+            return false;
+        }
+    }
+
+    // move gradients and optimizer's variables between arena and per layer vectors, so training continues
+    // from the same state; per layer vectors are released while arena is used
+    for ( size_t i = 0, n = mTrainedNetwork->LayersCount( ); i < n; i++ )
+    {
+        size_t weightsCount = mParameterArena->LayerWeightsCount( i );
+
+        if ( weightsCount == 0 )
+        {
+            continue;
+        }
+
+        if ( useArena )
+        {
+            memcpy( mParameterArena->LayerGradients( i ), mGradWeights[i].data( ), weightsCount * sizeof( float_t ) );
+            fvector_t( ).swap( mGradWeights[i] );
+
+            for ( size_t j = 0; j < optimizerParameterVariablesCount; j++ )
+            {
+                memcpy( mParameterArena->LayerParameterVariables( j, i ), mOptimizerParameterVariables[i][j].data( ),
+                        weightsCount * sizeof( float_t ) );
+                fvector_t( ).swap( mOptimizerParameterVariables[i][j] );
+            }
+
+            // all layers are updated together, so their layer variables are the same
+            if ( !layerVariablesMoved )
+            {
+                mParameterArena->LayerVariables( ) = mOptimizerLayerVariables[i];
+                layerVariablesMoved = true;
+            }
+        }
+        else
+        {
+            float_t* gradients = mParameterArena->LayerGradients( i );
+
+            mGradWeights[i] = fvector_t( gradients, gradients + weightsCount );
+
+            for ( size_t j = 0; j < optimizerParameterVariablesCount; j++ )
+            {
+                float_t* variables = mParameterArena->LayerParameterVariables( j, i );
+
+                mOptimizerParameterVariables[i][j] = fvector_t( variables, variables + weightsCount );
+            }
+
+            mOptimizerLayerVariables[i] = mParameterArena->LayerVariables( );
+        }
+    }
+
+    if ( !useArena )
+    {
+        mParameterArena.reset( );
+    }
+
+    return true;
 }
 
 // Allocate the rest of vectors required for training - those which depend on the batch size
 void XNetworkTraining::AllocateTrainVectors( size_t samplesCount )
 {
-    size_t layersCount = mNetwork->LayersCount( );
+    size_t layersCount = mTrainedNetwork->LayersCount( );
 
     if ( mTrainInputs.size( ) != samplesCount )
     {
         mTrainInputs.resize( samplesCount );
         mTargetOuputs.resize( samplesCount );
+        mSampleCosts.resize( samplesCount );
 
-        mTrainOutputsStorage.resize( layersCount );
-        mTrainOutputs.resize( layersCount );
+        AllocateTrainOutputs( samplesCount );
 
         mDeltasStorage.resize( layersCount );
         mDeltas.resize( layersCount );
 
-        // prepare output vector and deltas for all samples and for all layers
+        // prepare deltas for all samples and for all layers
         for ( size_t layerIndex = 0; layerIndex < layersCount; layerIndex++ )
         {
-            size_t layerOutputCount = mNetwork->LayerAt( layerIndex )->OutputsCount( );
-
-            mTrainOutputsStorage[layerIndex].resize( samplesCount );
-            mTrainOutputs[layerIndex].resize( samplesCount );
+            size_t layerOutputCount = mTrainedNetwork->LayerAt( layerIndex )->OutputsCount( );
 
             mDeltasStorage[layerIndex].resize( samplesCount );
             mDeltas[layerIndex].resize( samplesCount );
 
             for ( size_t i = 0; i < samplesCount; i++ )
             {
-                mTrainOutputsStorage[layerIndex][i] = fvector_t( layerOutputCount );
-                mTrainOutputs[layerIndex][i]        = &( mTrainOutputsStorage[layerIndex][i] );
-
                 mDeltasStorage[layerIndex][i] = fvector_t( layerOutputCount );
                 mDeltas[layerIndex][i]        = &( mDeltasStorage[layerIndex][i] );
             }
@@ -114,33 +229,204 @@ void XNetworkTraining::AllocateTrainVectors( size_t samplesCount )
 
         for ( size_t i = 0; i < samplesCount; i++ )
         {
-            mInputDeltasStorage[i] = fvector_t( mNetwork->InputsCount( ) );
+            mInputDeltasStorage[i] = fvector_t( mTrainedNetwork->InputsCount( ) );
             mInputDeltas[i] = &( mInputDeltasStorage[i] );
         }
 
         // allocate new buffers for layers
-        mTrainingContext.AllocateWorkingBuffers( mNetwork, samplesCount );
+        mTrainingContext.AllocateWorkingBuffers( mTrainedNetwork, samplesCount );
+    }
+}
+
+// Prepare storage and pointers for outputs of all layers
+void XNetworkTraining::AllocateTrainOutputs( size_t samplesCount )
+{
+    size_t layersCount    = mTrainedNetwork->LayersCount( );
+    bool   reduced        = ( mStoredOutputsPrecision != WeightsPrecision::Float );
+    size_t ownersCount    = 0;
+    size_t buffersSize[2] = { 0, 0 };
+
+    mTrainOutputsStorage.resize( layersCount );
+    mTrainOutputs.resize( layersCount );
+    mOutputsOwners.resize( layersCount );
+    mOutputsBuffersIndexes.resize( layersCount );
+    mConvertedOutputs.resize( layersCount );
+
+    for ( size_t layerIndex = 0; layerIndex < layersCount; layerIndex++ )
+    {
+        size_t layerOutputCount = mTrainedNetwork->LayerAt( layerIndex )->OutputsCount( );
+
+        // a layer computes in place of its inputs, if those are not training inputs and are not needed
+        // by backward pass of the previous layer - no storage is allocated for its outputs then
+        bool inPlace = ( layerIndex != 0 ) && ( mTrainedNetwork->LayerAt( layerIndex )->CanComputeInPlace( ) ) &&
+                       ( !mTrainedNetwork->LayerAt( layerIndex - 1 )->BackwardNeedsOutputs( ) );
+
+        if ( inPlace )
+        {
+            mOutputsOwners[layerIndex]         = mOutputsOwners[layerIndex - 1];
+            mOutputsBuffersIndexes[layerIndex] = mOutputsBuffersIndexes[layerIndex - 1];
+        }
+        else
+        {
+            // layers owning storage of outputs use float buffers in turns, so outputs of the next layer
+            // never need the same buffers as its inputs
+            mOutputsOwners[layerIndex]         = layerIndex;
+            mOutputsBuffersIndexes[layerIndex] = ownersCount++ % 2;
+
+            buffersSize[mOutputsBuffersIndexes[layerIndex]] = std::max( buffersSize[mOutputsBuffersIndexes[layerIndex]], layerOutputCount );
+        }
+
+        mTrainOutputsStorage[layerIndex].resize( samplesCount );
+        mTrainOutputs[layerIndex].resize( samplesCount );
+        mConvertedOutputs[layerIndex] = vector<XHalfWeights>( ( ( reduced ) && ( !inPlace ) ) ? samplesCount : 0 );
+
+        for ( size_t i = 0; i < samplesCount; i++ )
+        {
+            if ( inPlace )
+            {
+                mTrainOutputsStorage[layerIndex][i] = fvector_t( );
+                mTrainOutputs[layerIndex][i]        = mTrainOutputs[layerIndex - 1][i];
+            }
+            else
+            {
+                // with reduced precision the storage gets float buffers only while outputs are used
+                mTrainOutputsStorage[layerIndex][i] = fvector_t( ( reduced ) ? 0 : layerOutputCount );
+                mTrainOutputs[layerIndex][i]        = &( mTrainOutputsStorage[layerIndex][i] );
+            }
+        }
+    }
+
+    for ( size_t buffersIndex = 0; buffersIndex < 2; buffersIndex++ )
+    {
+        mOutputsBuffers[buffersIndex] = vector<fvector_t>( ( reduced ) ? samplesCount : 0 );
+
+        for ( auto& buffer : mOutputsBuffers[buffersIndex] )
+        {
+            buffer.reserve( buffersSize[buffersIndex] );
+        }
+    }
+}
+
+// Sets precision of layers' outputs kept for backward pass
+void XNetworkTraining::SetStoredOutputsPrecision( WeightsPrecision precision )
+{
+    if ( precision != mStoredOutputsPrecision )
+    {
+        mStoredOutputsPrecision = precision;
+
+        if ( !mTrainInputs.empty( ) )
+        {
+            AllocateTrainOutputs( mTrainInputs.size( ) );
+        }
+    }
+}
+
+// Moves float buffers into storage of the specified layer's outputs, widening its converted outputs if requested
+void XNetworkTraining::AcquireOutputsBuffers( size_t layerIndex, bool widen )
+{
+    size_t outputsCount = mTrainedNetwork->LayerAt( layerIndex )->OutputsCount( );
+
+    XParallel::For( mTrainInputs.size( ), true, [&]( size_t i )
+    {
+        fvector_t& outputs = mTrainOutputsStorage[layerIndex][i];
+
+        outputs.swap( mOutputsBuffers[mOutputsBuffersIndexes[layerIndex]][i] );
+        outputs.resize( outputsCount );
+
+        if ( widen )
+        {
+            mConvertedOutputs[layerIndex][i].ToFloat( 0, outputsCount, outputs.data( ) );
+        }
+    } );
+}
+
+// Moves float buffers out of storage of the specified layer's outputs, converting its outputs first if requested
+void XNetworkTraining::ReleaseOutputsBuffers( size_t layerIndex, bool convert )
+{
+    XParallel::For( mTrainInputs.size( ), true, [&]( size_t i )
+    {
+        fvector_t& outputs = mTrainOutputsStorage[layerIndex][i];
+
+        if ( convert )
+        {
+            mConvertedOutputs[layerIndex][i].Convert( outputs.data( ), outputs.size( ), mStoredOutputsPrecision );
+        }
+
+        outputs.swap( mOutputsBuffers[mOutputsBuffersIndexes[layerIndex]][i] );
+    } );
+}
+
+// Compute outputs of all layers for the training samples
+void XNetworkTraining::DoForwardCompute( )
+{
+    bool storeOutputs = ( mStoredOutputsPrecision != WeightsPrecision::Float );
+
+    for ( size_t layerIndex = 0, layersCount = mTrainedNetwork->LayersCount( ); layerIndex < layersCount; layerIndex++ )
+    {
+        if ( ( storeOutputs ) && ( mOutputsOwners[layerIndex] == layerIndex ) )
+        {
+            AcquireOutputsBuffers( layerIndex, false );
+        }
+
+        mTrainingContext.SetCurrentLayerIndex( layerIndex );
+        mTrainedNetwork->LayerAt( layerIndex )->
+            ForwardTrainingCompute( ( layerIndex == 0 ) ? mTrainInputs : mTrainOutputs[layerIndex - 1], mTrainOutputs[layerIndex], mTrainingContext );
+
+        // outputs of the previous layer are not needed by forward pass any more, so are kept converted
+        if ( ( storeOutputs ) && ( layerIndex != 0 ) && ( mOutputsOwners[layerIndex - 1] != mOutputsOwners[layerIndex] ) )
+        {
+            ReleaseOutputsBuffers( mOutputsOwners[layerIndex - 1], true );
+        }
     }
 }
 
 // Calculate error of the last layer for each training sample
 float_t XNetworkTraining::CalculateError( )
 {
-    vector<fvector_t>& lastOutputs = mTrainOutputsStorage.back( );
-    vector<fvector_t>& lastDeltas  = mDeltasStorage.back( );
-    float_t            totalCost   = 0;
+    size_t  samplesCount = mTrainInputs.size( );
+    float_t totalCost    = 0;
 
-    for ( size_t i = 0, n = mTrainInputs.size( ); i < n; i++ )
+    if ( mOutputStage == OutputStage::Generic )
     {
-        fvector_t& lastDelta    = lastDeltas[i];
-        fvector_t& lastOutput   = lastOutputs[i];
-        fvector_t& targetOutput = *mTargetOuputs[i];
+        totalCost = mCostFunction->BatchCostGradient( mTrainOutputs.back( ), mTargetOuputs, mDeltas.back( ),
+                                                      mSampleCosts.data( ), true );
+    }
+    else
+    {
+        // for fused output stage the error goes directly to the input of the last layer, which is
+        // deltas of the previous layer (target outputs are expected to sum to 1)
+        size_t             layersCount     = mDeltasStorage.size( );
+        vector<fvector_t>& lastInputDeltas = ( layersCount > 1 ) ? mDeltasStorage[layersCount - 2] : mInputDeltasStorage;
+
+        XParallel::For( samplesCount, true, [&]( size_t i )
+        {
+            fvector_t& lastInputDelta = lastInputDeltas[i];
+            fvector_t& lastOutput     = *mTrainOutputs.back( )[i];
+            fvector_t& targetOutput   = *mTargetOuputs[i];
+            size_t     outputsCount   = lastOutput.size( );
+
+            mSampleCosts[i] = mCostFunction->Cost( lastOutput, targetOutput );
 
-        totalCost += mCostFunction->Cost( lastOutput, targetOutput );
-        lastDelta  = mCostFunction->Gradient( lastOutput, targetOutput );
+            if ( mOutputStage == OutputStage::SoftMaxCrossEntropy )
+            {
+                std::copy( lastOutput.begin( ), lastOutput.end( ), lastInputDelta.begin( ) );
+            }
+            else
+            {
+                // log-probabilities are turned back into probabilities
+                XVectorize::Exp( lastOutput.data( ), lastInputDelta.data( ), outputsCount );
+            }
+
+            XVectorize::Axpy( targetOutput.data( ), float_t( -1 ), lastInputDelta.data( ), outputsCount );
+        } );
+
+        for ( size_t i = 0; i < samplesCount; i++ )
+        {
+            totalCost += mSampleCosts[i];
+        }
     }
 
-    totalCost /= mTrainInputs.size( );
+    totalCost /= samplesCount;
 
     return totalCost;
 }
@@ -148,32 +434,70 @@ float_t XNetworkTraining::CalculateError( )
 // Propagate error through the network starting from last layer
 void XNetworkTraining::DoBackwardCompute( )
 {
-    size_t  layerIndex  = mNetwork->LayersCount( ) - 1;
-    
+    size_t  layerIndex  = mTrainedNetwork->LayersCount( ) - 1;
+    bool    reduced     = ( mStoredOutputsPrecision != WeightsPrecision::Float );
+
+    // fused output stage has already provided deltas for the last layer's input
+    if ( mOutputStage != OutputStage::Generic )
+    {
+        if ( ( reduced ) && ( mOutputsOwners[layerIndex] == layerIndex ) )
+        {
+            ReleaseOutputsBuffers( layerIndex, false );
+
+            if ( layerIndex != 0 )
+            {
+                AcquireOutputsBuffers( mOutputsOwners[layerIndex - 1], true );
+            }
+        }
+
+        if ( layerIndex == 0 )
+        {
+            return;
+        }
+
+        layerIndex--;
+    }
+
     // propagate deltas for all layers except the first one
     for ( ; layerIndex > 0; layerIndex-- )
     {
+        // outputs of the layer are in float buffers already, while its inputs may need to be widened
+        if ( ( reduced ) && ( mOutputsOwners[layerIndex - 1] != mOutputsOwners[layerIndex] ) )
+        {
+            AcquireOutputsBuffers( mOutputsOwners[layerIndex - 1], true );
+        }
+
         mTrainingContext.SetCurrentLayerIndex( layerIndex );
 
-        mNetwork->LayerAt( layerIndex )->
+        mTrainedNetwork->LayerAt( layerIndex )->
             BackwardCompute( mTrainOutputs[layerIndex - 1], mTrainOutputs[layerIndex],
                              mDeltas[layerIndex], mDeltas[layerIndex - 1],
-                             mGradWeights[layerIndex], mTrainingContext );
+                             LayerGradients( layerIndex ), mTrainingContext );
+
+        if ( ( reduced ) && ( mOutputsOwners[layerIndex] == layerIndex ) )
+        {
+            ReleaseOutputsBuffers( layerIndex, false );
+        }
     }
 
     // now same for the first layer
     mTrainingContext.SetCurrentLayerIndex( 0 );
 
-    mNetwork->LayerAt( 0 )->
+    mTrainedNetwork->LayerAt( 0 )->
         BackwardCompute( mTrainInputs, mTrainOutputs[0],
                          mDeltas[0], mInputDeltas,
-                         mGradWeights[0], mTrainingContext );
+                         LayerGradients( 0 ), mTrainingContext );
+
+    if ( reduced )
+    {
+        ReleaseOutputsBuffers( 0, false );
+    }
 }
 
 // Calculate weights/biases updates from gradients and apply them
 void XNetworkTraining::UpdateWeights( )
 {
-    auto    itLayers          = mNetwork->begin( );
+    auto    itLayers          = mTrainedNetwork->begin( );
     float_t batchUpdateFactor = float_t( 1 );
     
     if ( mAverageWeightGradients )
@@ -181,33 +505,49 @@ void XNetworkTraining::UpdateWeights( )
         batchUpdateFactor /= mTrainInputs.size( );
     }
 
-    for ( size_t i = 0, n = mNetwork->LayersCount( ); i < n; i++, ++itLayers )
+    if ( mParameterArena )
     {
-        if ( (*itLayers)->Trainable( ) )
-        {
-            if ( mAverageWeightGradients )
-            {
-                std::transform( mGradWeights[i].begin( ), mGradWeights[i].end( ), mGradWeights[i].begin( ),
-                                [&]( float_t v ) -> float_t { return v * batchUpdateFactor; } );
-            }
+        // all layers are updated at once when their parameters are kept in arena
+        mParameterArena->UpdateWeights( *mOptimizer, batchUpdateFactor );
+        return;
+    }
 
-            mOptimizer->CalculateUpdatesFromGradients( mGradWeights[i], mOptimizerParameterVariables[i], mOptimizerLayerVariables[i] );
+    // gradients' scaling, optimizer's step, weights' update and gradients' reset are done in one pass
+    // for chunks of parameters, which are processed in parallel
+    XParallel::For( mWeightsUpdateChunks.size( ), mWeightsUpdateChunks.size( ) > 1, [&]( size_t chunk )
+    {
+        size_t layerIndex = mWeightsUpdateChunks[chunk].first;
+        size_t offset     = mWeightsUpdateChunks[chunk].second;
+        size_t count      = std::min( WEIGHTS_UPDATE_CHUNK_SIZE, mGradWeights[layerIndex].size( ) - offset );
 
-            static_pointer_cast<ITrainableLayer>( *itLayers )->UpdateWeights( mGradWeights[i] );
+        mOptimizer->UpdateWeightsFromGradients( static_pointer_cast<ITrainableLayer>( mTrainedNetwork->LayerAt( layerIndex ) )->WeightsData( ),
+                                                mGradWeights[layerIndex].data( ), mOptimizerParameterVariables[layerIndex],
+                                                mOptimizerLayerVariables[layerIndex], batchUpdateFactor, offset, count );
+    } );
 
-            // reset gradients for the next training cycle
-            fill( mGradWeights[i].begin( ), mGradWeights[i].end( ), float_t( 0 ) );
+    for ( size_t i = 0, n = mTrainedNetwork->LayersCount( ); i < n; i++, ++itLayers )
+    {
+        if ( (*itLayers)->Trainable( ) )
+        {
+            mOptimizer->UpdateLayerVariables( mOptimizerLayerVariables[i] );
+            static_pointer_cast<ITrainableLayer>( *itLayers )->WeightsChanged( );
         }
     }
 }
 
+// Provides storage for the specified layer's weights/biases gradients
+float_t* XNetworkTraining::LayerGradients( size_t layerIndex )
+{
+    return ( mParameterArena ) ? mParameterArena->LayerGradients( layerIndex ) : mGradWeights[layerIndex].data( );
+}
+
 // Run single training cycle
 float_t XNetworkTraining::RunTraining( )
 {
     float_t cost;
 
     // 1 - compute the network to get the actual output
-    DoCompute( mTrainInputs, mTrainOutputs, mTrainingContext );
+    DoForwardCompute( );
 
     // 2 - get error of the last layer
     cost = CalculateError( );
@@ -226,7 +566,7 @@ float_t XNetworkTraining::TrainSample( const fvector_t& input, const fvector_t&
 {
     float_t cost = 0;
 
-    if ( mNetwork->LayersCount( ) != 0 )
+    if ( mTrainedNetwork->LayersCount( ) != 0 )
     {
         AllocateTrainVectors( 1 );
 
@@ -246,7 +586,7 @@ float_t XNetworkTraining::TrainBatch( const vector<fvector_t>& inputs,
 {
     float_t cost = 0;
 
-    if ( mNetwork->LayersCount( ) != 0 )
+    if ( mTrainedNetwork->LayersCount( ) != 0 )
     {
         AllocateTrainVectors( inputs.size( ) );
 
@@ -269,7 +609,7 @@ float_t XNetworkTraining::TrainBatch( const vector<fvector_t*>& inputs,
 {
     float_t cost = 0;
 
-    if ( mNetwork->LayersCount( ) != 0 )
+    if ( mTrainedNetwork->LayersCount( ) != 0 )
     {
         AllocateTrainVectors( inputs.size( ) );
 
@@ -397,13 +737,14 @@ float_t XNetworkTraining::TestSample( const fvector_t& input,
 {
     float_t cost = 0;
 
-    if ( mNetwork->LayersCount( ) != 0 )
+    if ( mTrainedNetwork->LayersCount( ) != 0 )
     {
         // compute the network to get the actual output
+        SetBatchSize( 1 );
         mComputeInputs[0] = const_cast<fvector_t*>( &input );
-        DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
+        DoInference( );
 
-        output = mComputeOutputsStorage.back( )[0];
+        output = *( mComputeOutputs.back( )[0] );
         cost   = mCostFunction->Cost( output, targetOutput );
     }
 
@@ -415,57 +756,70 @@ float_t XNetworkTraining::TestSample( const fvector_t& input,
 size_t XNetworkTraining::TestClassification( const std::vector<fvector_t>& inputs, const uvector_t& targetLabels,
                                              const std::vector<fvector_t>& targetOutputs, float_t* pAvgCost )
 {
-    size_t  correctLabelsCounter = 0;
-    float_t cost = 0;
-
-    if ( ( mNetwork->LayersCount( ) != 0 ) && ( inputs.size( ) != 0 ) )
-    {
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
+    return DoTestClassification( inputs.size( ),
+        [&]( size_t i )
         {
-            mComputeInputs[0] = const_cast<fvector_t*>( &( inputs[i] ) );
-            DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
-
-            cost += mCostFunction->Cost( mComputeOutputsStorage.back( )[0], targetOutputs[i] );
-
-            if ( XDataEncodingTools::MaxIndex( mComputeOutputsStorage.back( )[0] ) == targetLabels[i] )
-            {
-                correctLabelsCounter++;
-            }
-        }
-
-        cost /= inputs.size( );
-    }
-
-    if ( pAvgCost )
-    {
-        *pAvgCost = cost;
-    }
-
-    return correctLabelsCounter;
+            return const_cast<fvector_t*>( &( inputs[i] ) );
+        },
+        [&]( size_t i ) -> const fvector_t&
+        {
+            return targetOutputs[i];
+        },
+        targetLabels, pAvgCost );
 }
 
 size_t XNetworkTraining::TestClassification( const std::vector<fvector_t*>& inputs, const uvector_t& targetLabels,
                                              const std::vector<fvector_t*>& targetOutputs, float_t* pAvgCost )
+{
+    return DoTestClassification( inputs.size( ),
+        [&]( size_t i )
+        {
+            return inputs[i];
+        },
+        [&]( size_t i ) -> const fvector_t&
+        {
+            return *( targetOutputs[i] );
+        },
+        targetLabels, pAvgCost );
+}
+
+// Tests classification of samples provided by the specified functions - chunks of samples are computed in
+// parallel and their costs/correct labels counters are summed afterwards, so results don't depend on threads count
+size_t XNetworkTraining::DoTestClassification( size_t samplesCount,
+                                               const function<fvector_t*( size_t )>& getInput,
+                                               const function<const fvector_t&( size_t )>& getTargetOutput,
+                                               const uvector_t& targetLabels, float_t* pAvgCost )
 {
     size_t  correctLabelsCounter = 0;
     float_t cost = 0;
 
-    if ( ( mNetwork->LayersCount( ) != 0 ) && ( inputs.size( ) != 0 ) )
+    if ( ( mTrainedNetwork->LayersCount( ) != 0 ) && ( samplesCount != 0 ) )
     {
-        for ( size_t i = 0, n = inputs.size( ); i < n; i++ )
-        {
-            mComputeInputs[0] = inputs[i];
-            DoCompute( mComputeInputs, mComputeOutputs, mInferenceContext );
+        size_t    chunksCount = TestChunksCount( samplesCount );
+        uvector_t chunksCorrectLabels( chunksCount );
+        fvector_t chunksCost( chunksCount );
 
-            cost += mCostFunction->Cost( mComputeOutputsStorage.back( )[0], *( targetOutputs[i] ) );
-
-            if ( XDataEncodingTools::MaxIndex( mComputeOutputsStorage.back( )[0] ) == targetLabels[i] )
+        RunParallelTest( samplesCount, getInput,
+            [&]( size_t chunkIndex, size_t firstSample, const vector<fvector_t*>& outputs )
             {
-                correctLabelsCounter++;
-            }
+                for ( size_t i = 0; i < outputs.size( ); i++ )
+                {
+                    chunksCost[chunkIndex] += mCostFunction->Cost( *( outputs[i] ), getTargetOutput( firstSample + i ) );
+
+                    if ( XDataEncodingTools::MaxIndex( *( outputs[i] ) ) == targetLabels[firstSample + i] )
+                    {
+                        chunksCorrectLabels[chunkIndex]++;
+                    }
+                }
+            } );
+
+        for ( size_t i = 0; i < chunksCount; i++ )
+        {
+            correctLabelsCounter += chunksCorrectLabels[i];
+            cost                 += chunksCost[i];
         }
 
-        cost /= inputs.size( );
+        cost /= samplesCount;
     }
 
     if ( pAvgCost )
@@ -26,8 +26,10 @@
 #include <vector>
 
 #include "XNetworkInference.hpp"
+#include "XParameterArena.hpp"
 #include "../Optimizers/INetworkOptimizer.hpp"
 #include "../CostFunctions/ICostFunction.hpp"
+#include "../../Tools/XHalfWeights.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -41,15 +43,35 @@ namespace ANNT { namespace Neuro { namespace Training {
 class XNetworkTraining : public XNetworkInference
 {
 private:
+    // Output stages, which are recognized as combination of the last layer and cost function. Those
+    // get error gradient for the last layer's input directly, skipping its backward pass.
+    enum class OutputStage
+    {
+        Generic,
+        SoftMaxCrossEntropy,            // XSoftMaxActivation + XCrossEntropyCost, gradient = output - target
+        LogSoftMaxNegativeLogLikelihood // XLogSoftMaxActivation + XNegativeLogLikelihoodCost, gradient = exp(output) - target
+    };
+
+private:
+    std::shared_ptr<XNeuralNetwork>      mTrainedNetwork;   // same as mNetwork, but allowed to change layers
     std::shared_ptr<INetworkOptimizer >  mOptimizer;
     std::shared_ptr<ICostFunction>       mCostFunction;
     bool                                 mAverageWeightGradients;
+    OutputStage                          mOutputStage;
 
 private:
     // storage and pointers for outputs computed during training
     std::vector<std::vector<fvector_t>>  mTrainOutputsStorage;
     std::vector<std::vector<fvector_t*>> mTrainOutputs;
 
+    // precision of the outputs kept for backward pass; when reduced, outputs of layers are kept converted and only
+    // those used by the layer being computed are widened into float buffers, which layers owning storage take in turns
+    WeightsPrecision                     mStoredOutputsPrecision;
+    uvector_t                            mOutputsOwners;
+    uvector_t                            mOutputsBuffersIndexes;
+    std::vector<std::vector<XHalfWeights>> mConvertedOutputs;
+    std::vector<fvector_t>               mOutputsBuffers[2];
+
     // storade and pointers to compute deltas for each layer
     std::vector<std::vector<fvector_t>>  mDeltasStorage;
     std::vector<std::vector<fvector_t*>> mDeltas;
@@ -63,15 +85,24 @@ private:
     std::vector<fvector_t*>              mTrainInputs;
     std::vector<fvector_t*>              mTargetOuputs;
 
+    // cost values of individual samples in a batch
+    fvector_t                            mSampleCosts;
+
     // weights/biases gradients for all layers
     std::vector<fvector_t>               mGradWeights;
 
+    // layer index and offset of parameters' chunks, which are updated in parallel
+    std::vector<std::pair<size_t, size_t>> mWeightsUpdateChunks;
+
     // vectors with parameter variables for optimizer
     std::vector<std::vector<fvector_t>>  mOptimizerParameterVariables;
 
     // vectors with layer variables for optimizer
     std::vector<fvector_t>               mOptimizerLayerVariables;
 
+    // arena keeping all weights, gradients and optimizer's variables together (replaces the above per layer vectors)
+    std::unique_ptr<XParameterArena>     mParameterArena;
+
     // layers' working buffers and context for training
     XNetworkContext                      mTrainingContext;
 
@@ -84,7 +115,7 @@ public:
     // Provides access to the ANN
     std::shared_ptr<XNeuralNetwork> Network( ) const
     {
-        return mNetwork;
+        return mTrainedNetwork;
     }
 
     // Provides access to the weights/biases optimizer
@@ -109,6 +140,31 @@ public:
         mAverageWeightGradients = average;
     }
 
+    // Keep all weights/biases, their gradients and optimizer's variables in a single parameters' arena,
+    // so weights' update is done as one pass over parameters of all layers. Weights are moved back into
+    // layers when the arena gets disabled (or training object is destroyed). Returns false if the arena
+    // could not be enabled, since some of the layers can not keep weights in external storage.
+    bool UseParameterArena( ) const
+    {
+        return static_cast<bool>( mParameterArena );
+    }
+    bool SetUseParameterArena( bool useArena );
+
+    // Provides access to the parameters' arena (null if not used)
+    XParameterArena* ParameterArena( ) const
+    {
+        return mParameterArena.get( );
+    }
+
+    // Get/set precision of layers' outputs kept for backward pass. Reduced precision (half or bfloat16) takes half
+    // of the memory - forward pass is still computed in float, but outputs are converted once the next layer has
+    // computed its outputs and are widened back when backward pass gets to them.
+    WeightsPrecision StoredOutputsPrecision( ) const
+    {
+        return mStoredOutputsPrecision;
+    }
+    void SetStoredOutputsPrecision( WeightsPrecision precision );
+
     // Get/set length of training sequences used for recurrent networks
     size_t TrainingSequenceLength( ) const
     {
@@ -174,10 +230,19 @@ public:
 private:
 
     float_t RunTraining( );
+    void    DoForwardCompute( );
     float_t CalculateError( );
     void    DoBackwardCompute( );
     void    UpdateWeights( );
+    float_t* LayerGradients( size_t layerIndex );
     void    AllocateTrainVectors( size_t samplesCount );
+    void    AllocateTrainOutputs( size_t samplesCount );
+    void    AcquireOutputsBuffers( size_t layerIndex, bool widen );
+    void    ReleaseOutputsBuffers( size_t layerIndex, bool convert );
+    size_t  DoTestClassification( size_t samplesCount,
+                                  const std::function<fvector_t*( size_t )>& getInput,
+                                  const std::function<const fvector_t&( size_t )>& getTargetOutput,
+                                  const uvector_t& targetLabels, float_t* pAvgCost );
 };
 
 } } } // namespace ANNT::Neuro::Training
@@ -18,12 +18,317 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
+
 #include "XNeuralNetwork.hpp"
+#include "../Layers/ITrainableLayer.hpp"
+#include "../Layers/XConvolutionLayer.hpp"
+#include "../Layers/XFullyConnectedLayer.hpp"
+#include "../Layers/Processing/XBatchNormalization.hpp"
+#include "../../Tools/XMappedFile.hpp"
 
 using namespace std;
 
 namespace ANNT { namespace Neuro {
 
+namespace {
+
+// Layout of mappable parameters' file:
+//   "ANNM", sizeof( float_t ) as uint8_t, 3 reserved bytes, layers count as uint32_t;
+//   MappedParamsEntry for every layer;
+//   layers' parameters, each starting at MAPPED_PARAMS_ALIGNMENT aligned offset.
+static const size_t MAPPED_PARAMS_ALIGNMENT   = 64;
+static const size_t MAPPED_PARAMS_HEADER_SIZE = 12;
+
+enum class MappedParamsType : uint32_t
+{
+    Weights = 0,    // raw weights of a trainable layer
+    Stream  = 1     // parameters saved with layer's SaveLearnedParams( )
+};
+
+struct MappedParamsEntry
+{
+    MappedParamsType Type;
+    uint32_t         Reserved;
+    uint64_t         Offset;
+    uint64_t         Size;
+};
+
+// Gets/sets position in file as 64 bit offset, since parameters of big networks may take more than 2GB
+// (position is -1 on failure)
+static int64_t GetFilePosition( FILE* file )
+{
+#ifdef _WIN32
+    return static_cast<int64_t>( _ftelli64( file ) );
+#else
+    return static_cast<int64_t>( ftello( file ) );
+#endif
+}
+static bool SetFilePosition( FILE* file, uint64_t position )
+{
+#ifdef _WIN32
+    return ( _fseeki64( file, static_cast<__int64>( position ), SEEK_SET ) == 0 );
+#else
+    return ( fseeko( file, static_cast<off_t>( position ), SEEK_SET ) == 0 );
+#endif
+}
+
+// Pads file with zeros, so its current position gets aligned
+static bool AlignFilePosition( FILE* file, size_t alignment )
+{
+    static const uint8_t zeros[MAPPED_PARAMS_ALIGNMENT] = { };
+
+    int64_t position = GetFilePosition( file );
+    size_t  padding  = ( alignment - static_cast<size_t>( position ) % alignment ) % alignment;
+
+    return ( position >= 0 ) && ( fwrite( zeros, 1, padding, file ) == padding );
+}
+
+// Folds batch normalization into the layer preceding it, so it gives normalized outputs -
+// returns false if the layer can not do it
+static bool FoldBatchNormalization( const shared_ptr<ILayer>& layer, const XBatchNormalization& batchNorm )
+{
+    shared_ptr<XConvolutionLayer>    convLayer = dynamic_pointer_cast<XConvolutionLayer>( layer );
+    shared_ptr<XFullyConnectedLayer> fcLayer   = dynamic_pointer_cast<XFullyConnectedLayer>( layer );
+    const fvector_t&                 mean      = batchNorm.Mean( );
+    const fvector_t&                 stdDev    = batchNorm.StdDev( );
+    bool                             ret       = false;
+
+    // output = ( input - mean ) / stdDev = input * ( 1 / stdDev ) - mean / stdDev
+    if ( ( convLayer ) && ( convLayer->KernelsCount( ) == batchNorm.InputDepth( ) ) )
+    {
+        fvector_t scale( batchNorm.InputDepth( ) );
+        fvector_t shift( batchNorm.InputDepth( ) );
+
+        for ( size_t i = 0; i < scale.size( ); i++ )
+        {
+            scale[i] = float_t( 1 ) / stdDev[i];
+            shift[i] = -mean[i] * scale[i];
+        }
+
+        convLayer->ScaleOutputs( scale, shift );
+        ret = true;
+    }
+    else if ( ( fcLayer ) && ( fcLayer->OutputsCount( ) == batchNorm.InputDepth( ) * batchNorm.SpatialSize( ) ) )
+    {
+        // every input map of batch normalization covers a range of neurons
+        fvector_t scale( fcLayer->OutputsCount( ) );
+        fvector_t shift( fcLayer->OutputsCount( ) );
+
+        for ( size_t i = 0; i < scale.size( ); i++ )
+        {
+            size_t depthIndex = i / batchNorm.SpatialSize( );
+
+            scale[i] = float_t( 1 ) / stdDev[depthIndex];
+            shift[i] = -mean[depthIndex] * scale[i];
+        }
+
+        fcLayer->ScaleOutputs( scale, shift );
+        ret = true;
+    }
+
+    return ret;
+}
+
+// Quantizes convolution or fully connected layer for the specified range of its inputs (other layers are not changed)
+static void QuantizeLayer( const shared_ptr<ILayer>& layer, float_t inputMin, float_t inputMax )
+{
+    shared_ptr<XConvolutionLayer>    convLayer = dynamic_pointer_cast<XConvolutionLayer>( layer );
+    shared_ptr<XFullyConnectedLayer> fcLayer   = dynamic_pointer_cast<XFullyConnectedLayer>( layer );
+
+    if ( convLayer )
+    {
+        convLayer->Quantize( inputMin, inputMax );
+    }
+    else if ( fcLayer )
+    {
+        fcLayer->Quantize( inputMin, inputMax );
+    }
+}
+
+// Saves parameters of a layer for quantized model - quantized weights if the layer is quantized, or its learned
+// parameters otherwise, prefixed with a flag telling which is the case
+static bool SaveLayerQuantizedParams( const shared_ptr<ILayer>& layer, FILE* file )
+{
+    shared_ptr<XConvolutionLayer>    convLayer = dynamic_pointer_cast<XConvolutionLayer>( layer );
+    shared_ptr<XFullyConnectedLayer> fcLayer   = dynamic_pointer_cast<XFullyConnectedLayer>( layer );
+    uint8_t                          quantized = ( ( ( convLayer ) && ( convLayer->IsQuantized( ) ) ) ||
+                                                   ( ( fcLayer   ) && ( fcLayer->IsQuantized( ) ) ) ) ? 1 : 0;
+    bool                             ret       = ( fwrite( &quantized, sizeof( quantized ), 1, file ) == 1 );
+
+    if ( ret )
+    {
+        if ( quantized == 0 )
+        {
+            ret = layer->SaveLearnedParams( file );
+        }
+        else if ( convLayer )
+        {
+            ret = convLayer->SaveQuantizedParams( file );
+        }
+        else
+        {
+            ret = fcLayer->SaveQuantizedParams( file );
+        }
+    }
+
+    return ret;
+}
+
+// Loads parameters of a layer saved by SaveLayerQuantizedParams( )
+static bool LoadLayerQuantizedParams( const shared_ptr<ILayer>& layer, FILE* file )
+{
+    shared_ptr<XConvolutionLayer>    convLayer = dynamic_pointer_cast<XConvolutionLayer>( layer );
+    shared_ptr<XFullyConnectedLayer> fcLayer   = dynamic_pointer_cast<XFullyConnectedLayer>( layer );
+    uint8_t                          quantized = 0;
+    bool                             ret       = ( fread( &quantized, sizeof( quantized ), 1, file ) == 1 );
+
+    if ( ret )
+    {
+        if ( quantized == 0 )
+        {
+            ret = layer->LoadLearnedParams( file );
+        }
+        else if ( convLayer )
+        {
+            ret = convLayer->LoadQuantizedParams( file );
+        }
+        else if ( fcLayer )
+        {
+            ret = fcLayer->LoadQuantizedParams( file );
+        }
+        else
+        {
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
+// Layout of learned parameters' file header:
+//   "ANNT", zero byte, version of the format as uint8_t, sizeof( float_t ) as uint8_t.
+// Files of the first version have sizeof( float_t ) right after "ANNT" (it is never zero, which tells the versions apart).
+// Those were saved by convolution layers adding bias once for every connected input map, so biases of convolution
+// layers are scaled when loading them.
+static const uint8_t LEARNED_PARAMS_VERSION        = 2;
+static const uint8_t LEARNED_PARAMS_LEGACY_VERSION = 1;
+
+// Writes header of learned parameters' file
+static bool WriteLearnedParamsHeader( FILE* file )
+{
+    // float_t can be defined to other than "float", so need to save its size and stop loading
+    // saves produced by incompatible builds
+    uint8_t header[3] = { 0, LEARNED_PARAMS_VERSION, static_cast<uint8_t>( sizeof( float_t ) ) };
+
+    return ( fwrite( "ANNT", sizeof( char ), 4, file ) == 4 ) &&
+           ( fwrite( header, sizeof( uint8_t ), 3, file ) == 3 );
+}
+
+// Reads header of learned parameters' file and provides version of its format
+static bool ReadLearnedParamsHeader( FILE* file, uint8_t* version )
+{
+    char    magic[4];
+    uint8_t header[3];
+    bool    ret = ( fread( magic, sizeof( char ), 4, file ) == 4 ) &&
+                  ( fread( header, sizeof( uint8_t ), 1, file ) == 1 ) &&
+                  ( memcmp( magic, "ANNT", 4 ) == 0 );
+
+    if ( ( ret ) && ( header[0] == 0 ) )
+    {
+        ret = ( fread( &header[1], sizeof( uint8_t ), 2, file ) == 2 ) &&
+              ( header[1] == LEARNED_PARAMS_VERSION ) &&
+              ( header[2] == static_cast<uint8_t>( sizeof( float_t ) ) );
+
+        *version = header[1];
+    }
+    else
+    {
+        ret = ( ret ) && ( header[0] == static_cast<uint8_t>( sizeof( float_t ) ) );
+
+        *version = LEARNED_PARAMS_LEGACY_VERSION;
+    }
+
+    return ret;
+}
+
+// Returns trainable layer supporting weights in half precision, or null for other layers
+static shared_ptr<ITrainableLayer> HalfPrecisionLayer( const shared_ptr<ILayer>& layer )
+{
+    shared_ptr<ITrainableLayer> trainableLayer = dynamic_pointer_cast<ITrainableLayer>( layer );
+
+    return ( ( trainableLayer ) && ( trainableLayer->HalfPrecisionSupported( ) ) ) ? trainableLayer : shared_ptr<ITrainableLayer>( );
+}
+
+// Layout of half precision parameters' file:
+//   "ANNH", sizeof( float_t ) as uint8_t, precision of weights as uint8_t;
+//   parameters of layers - weights of layers supporting half precision (see ITrainableLayer::SaveHalfWeightsHelper( )),
+//   or learned parameters for the rest (as in the files saved by XNeuralNetwork::SaveLearnedParams( )).
+static const uint8_t HALF_PARAMS_PRECISION_HALF     = 1;
+static const uint8_t HALF_PARAMS_PRECISION_BFLOAT16 = 2;
+
+// Converts learned parameters of a layer read from the source file into the format of half precision parameters' file.
+// Layer's ID is already read, while the rest is read according to what the layer saves.
+static bool ConvertLayerLearnedParams( FILE* srcFile, FILE* dstFile, uint32_t layerID, WeightsPrecision precision )
+{
+    // layers which keep weights in half precision have single vector of parameters, while batch normalization
+    // keeps two of them; the rest don't save anything
+    bool     halfPrecision = false;
+    uint32_t vectorsCount  = 0;
+
+    switch ( static_cast<LayerID>( layerID ) )
+    {
+    case LayerID::FullyConnected:
+    case LayerID::Convolution:
+    case LayerID::RecurrentBasic:
+    case LayerID::RecurrentLSTM:
+    case LayerID::RecurrentGRU:
+        halfPrecision = true;
+        vectorsCount  = 1;
+        break;
+
+    case LayerID::DepthwiseSeparableConvolution:
+        vectorsCount  = 1;
+        break;
+
+    case LayerID::BatchNormalization:
+        vectorsCount  = 2;
+        break;
+
+    default:
+        break;
+    }
+
+    uint32_t paramsCounts[2];
+    bool     ret = ( vectorsCount != 0 ) &&
+                   ( fread( paramsCounts, sizeof( uint32_t ), vectorsCount, srcFile ) == vectorsCount ) &&
+                   ( fwrite( &layerID, sizeof( layerID ), 1, dstFile ) == 1 ) &&
+                   ( fwrite( paramsCounts, sizeof( uint32_t ), vectorsCount, dstFile ) == vectorsCount );
+
+    for ( uint32_t i = 0; ( ret ) && ( i < vectorsCount ); i++ )
+    {
+        fvector_t params( paramsCounts[i] );
+
+        ret = ( fread( params.data( ), sizeof( float_t ), params.size( ), srcFile ) == params.size( ) );
+
+        if ( ( ret ) && ( halfPrecision ) )
+        {
+            XHalfWeights weights;
+
+            weights.Convert( params.data( ), params.size( ), precision );
+            ret = weights.Save( dstFile );
+        }
+        else if ( ret )
+        {
+            ret = ( fwrite( params.data( ), sizeof( float_t ), params.size( ), dstFile ) == params.size( ) );
+        }
+    }
+
+    return ret;
+}
+
+} // namespace <anonymous>
+
 // Adds the specified layer to the end of layers' collection
 void XNeuralNetwork::AddLayer( const shared_ptr<ILayer>& layer )
 {
@@ -45,6 +350,7 @@ void XNeuralNetwork::AddLayer( const shared_ptr<ILayer>& layer )
     if ( ( mLayers.empty( ) ) || ( layer->InputsCount( ) == mLayers.back( )->OutputsCount( ) ) )
     {
         mLayers.push_back( layer );
+        mConfigurationVersion++;
     }
     else
     {
@@ -53,6 +359,65 @@ void XNeuralNetwork::AddLayer( const shared_ptr<ILayer>& layer )
     }
 }
 
+// Transforms trained network for inference only
+void XNeuralNetwork::FreezeForInference( )
+{
+    vector<shared_ptr<ILayer>> layers;
+
+    for ( auto layer : mLayers )
+    {
+        shared_ptr<XBatchNormalization> batchNorm = dynamic_pointer_cast<XBatchNormalization>( layer );
+
+        if ( ( batchNorm ) && ( !layers.empty( ) ) && ( FoldBatchNormalization( layers.back( ), *batchNorm ) ) )
+        {
+            // version of the removed layer is kept, so network's version never goes back to any of its previous values
+            mConfigurationVersion += batchNorm->ConfigurationVersion( );
+            continue;
+        }
+
+        layers.push_back( layer );
+    }
+
+    mLayers = layers;
+    mConfigurationVersion++;
+}
+
+// Version of network's configuration - own version plus versions of all layers
+size_t XNeuralNetwork::ConfigurationVersion( ) const
+{
+    size_t version = mConfigurationVersion;
+
+    for ( auto layer : mLayers )
+    {
+        version += layer->ConfigurationVersion( );
+    }
+
+    return version;
+}
+
+// Quantizes weights of convolution and fully connected layers to 8 bit integers
+void XNeuralNetwork::Quantize( const fvector_t& inputsMin, const fvector_t& inputsMax )
+{
+    for ( size_t i = 0; ( i < mLayers.size( ) ) && ( i < inputsMin.size( ) ) && ( i < inputsMax.size( ) ); i++ )
+    {
+        QuantizeLayer( mLayers[i], inputsMin[i], inputsMax[i] );
+    }
+}
+
+// Converts weights of layers supporting it to the specified precision
+void XNeuralNetwork::SetStoragePrecision( WeightsPrecision precision )
+{
+    for ( auto layer : mLayers )
+    {
+        shared_ptr<ITrainableLayer> halfPrecisionLayer = HalfPrecisionLayer( layer );
+
+        if ( halfPrecisionLayer )
+        {
+            halfPrecisionLayer->SetStoragePrecision( precision );
+        }
+    }
+}
+
 // Saves network's learned parameters only.
 // Network structure is not saved and so same network must be constructed before loading parameters
 bool XNeuralNetwork::SaveLearnedParams( const string& fileName ) const
@@ -62,12 +427,7 @@ bool XNeuralNetwork::SaveLearnedParams( const string& fileName ) const
 
     if ( file != nullptr )
     {
-        // float_t can be defined to other than "float", so need to save its size and stop loading
-        // saves produced by incompatible builds
-        uint8_t floatTypeSize = static_cast<uint8_t>( sizeof( float_t ) );
-
-        if ( ( fwrite( "ANNT", sizeof( char ), 4, file ) == 4 ) &&
-            ( fwrite( &floatTypeSize, sizeof( floatTypeSize ), 1, file ) == 1 ) )
+        if ( WriteLearnedParamsHeader( file ) )
         {
             ret = true;
 
@@ -92,19 +452,25 @@ bool XNeuralNetwork::LoadLearnedParams( const string& fileName )
 
     if ( file != nullptr )
     {
-        char    anntMagic[4];
-        uint8_t floatTypeSize;
+        uint8_t version;
 
-        if ( ( fread( anntMagic, sizeof( char ), 4, file ) == 4 ) &&
-            ( fread( &floatTypeSize, sizeof( floatTypeSize ), 1, file ) == 1 ) &&
-            ( anntMagic[0] == 'A' ) && ( anntMagic[1] == 'N' ) && ( anntMagic[2] == 'N' ) && ( anntMagic[3] == 'T' ) &&
-            ( floatTypeSize == static_cast<uint8_t>( sizeof( float_t ) ) ) )
+        if ( ReadLearnedParamsHeader( file, &version ) )
         {
             ret = true;
 
             for ( const_iterator layersIt = mLayers.begin( ); ( ret ) && ( layersIt != mLayers.end( ) ); layersIt++ )
             {
                 ret = ( *layersIt )->LoadLearnedParams( file );
+
+                if ( ( ret ) && ( version == LEARNED_PARAMS_LEGACY_VERSION ) )
+                {
+                    shared_ptr<XConvolutionLayer> convLayer = dynamic_pointer_cast<XConvolutionLayer>( *layersIt );
+
+                    if ( convLayer )
+                    {
+                        convLayer->ScaleLegacyBiases( );
+                    }
+                }
             }
         }
 
@@ -114,4 +480,332 @@ bool XNeuralNetwork::LoadLearnedParams( const string& fileName )
     return ret;
 }
 
+// Saves network's learned parameters in the format, which can be memory mapped
+bool XNeuralNetwork::SaveMappableParams( const string& fileName ) const
+{
+    FILE* file = fopen( fileName.c_str( ), "wb" );
+    bool  ret  = false;
+
+    if ( file != nullptr )
+    {
+        uint8_t                   header[MAPPED_PARAMS_HEADER_SIZE] = { 'A', 'N', 'N', 'M', static_cast<uint8_t>( sizeof( float_t ) ) };
+        uint32_t                  layersCount = static_cast<uint32_t>( mLayers.size( ) );
+        vector<MappedParamsEntry> entries( mLayers.size( ) );
+
+        memcpy( &header[8], &layersCount, sizeof( layersCount ) );
+
+        // entries are written twice - once to reserve the space and then filled with layers' offsets
+        if ( ( fwrite( header, 1, MAPPED_PARAMS_HEADER_SIZE, file ) == MAPPED_PARAMS_HEADER_SIZE ) &&
+             ( fwrite( entries.data( ), sizeof( MappedParamsEntry ), entries.size( ), file ) == entries.size( ) ) )
+        {
+            ret = true;
+
+            for ( size_t i = 0; ( ret ) && ( i < mLayers.size( ) ); i++ )
+            {
+                ret = AlignFilePosition( file, MAPPED_PARAMS_ALIGNMENT );
+
+                if ( ret )
+                {
+                    int64_t start = GetFilePosition( file );
+                    int64_t end;
+
+                    if ( mLayers[i]->Trainable( ) )
+                    {
+                        fvector_t weights = static_pointer_cast<ITrainableLayer>( mLayers[i] )->Weights( );
+
+                        entries[i].Type = MappedParamsType::Weights;
+                        ret = ( fwrite( weights.data( ), sizeof( float_t ), weights.size( ), file ) == weights.size( ) );
+                    }
+                    else
+                    {
+                        entries[i].Type = MappedParamsType::Stream;
+                        ret = mLayers[i]->SaveLearnedParams( file );
+                    }
+
+                    end = GetFilePosition( file );
+                    ret = ( ret ) && ( start >= 0 ) && ( end >= start );
+
+                    entries[i].Offset = static_cast<uint64_t>( start );
+                    entries[i].Size   = static_cast<uint64_t>( end - start );
+                }
+            }
+
+            ret = ( ret ) &&
+                  ( SetFilePosition( file, MAPPED_PARAMS_HEADER_SIZE ) ) &&
+                  ( fwrite( entries.data( ), sizeof( MappedParamsEntry ), entries.size( ), file ) == entries.size( ) );
+        }
+
+        ret = ( fclose( file ) == 0 ) && ( ret );
+    }
+
+    return ret;
+}
+
+// Maps network's learned parameters saved by SaveMappableParams( )
+bool XNeuralNetwork::MapLearnedParams( const string& fileName )
+{
+    shared_ptr<XMappedFile> mapping = make_shared<XMappedFile>( );
+    bool                    ret     = false;
+
+    if ( mapping->Open( fileName ) )
+    {
+        const uint8_t* data        = mapping->Data( );
+        size_t         size        = mapping->Size( );
+        uint32_t       layersCount = 0;
+
+        if ( size >= MAPPED_PARAMS_HEADER_SIZE )
+        {
+            memcpy( &layersCount, &data[8], sizeof( layersCount ) );
+        }
+
+        if ( ( size >= MAPPED_PARAMS_HEADER_SIZE + mLayers.size( ) * sizeof( MappedParamsEntry ) ) &&
+             ( data[0] == 'A' ) && ( data[1] == 'N' ) && ( data[2] == 'N' ) && ( data[3] == 'M' ) &&
+             ( data[4] == static_cast<uint8_t>( sizeof( float_t ) ) ) &&
+             ( layersCount == mLayers.size( ) ) )
+        {
+            vector<MappedParamsEntry> entries( mLayers.size( ) );
+            FILE*                     file = nullptr;
+
+            memcpy( entries.data( ), &data[MAPPED_PARAMS_HEADER_SIZE], entries.size( ) * sizeof( MappedParamsEntry ) );
+
+            ret = true;
+
+            // validate all entries first, so nothing gets mapped from a broken file
+            for ( size_t i = 0; ( ret ) && ( i < mLayers.size( ) ); i++ )
+            {
+                const MappedParamsEntry& entry = entries[i];
+
+                ret = ( entry.Offset <= size ) && ( entry.Size <= size - entry.Offset );
+
+                if ( entry.Type == MappedParamsType::Weights )
+                {
+                    ret = ( ret ) && ( mLayers[i]->Trainable( ) ) && ( entry.Offset % MAPPED_PARAMS_ALIGNMENT == 0 ) &&
+                          ( entry.Size == static_pointer_cast<ITrainableLayer>( mLayers[i] )->WeightsCount( ) * sizeof( float_t ) );
+                }
+                else if ( entry.Type == MappedParamsType::Stream )
+                {
+                    // layers having learned parameters never save empty stream
+                    ret = ( ret ) && ( ( entry.Size != 0 ) || ( !mLayers[i]->HasLearnedParams( ) ) );
+                }
+                else
+                {
+                    // unknown type of parameters
+                    ret = false;
+                }
+            }
+
+            size_t layerIndex = 0;
+
+            for ( ; ( ret ) && ( layerIndex < mLayers.size( ) ); layerIndex++ )
+            {
+                const MappedParamsEntry& entry = entries[layerIndex];
+
+                if ( entry.Type == MappedParamsType::Weights )
+                {
+                    static_pointer_cast<ITrainableLayer>( mLayers[layerIndex] )->MapWeights(
+                        reinterpret_cast<const float_t*>( data + entry.Offset ), mapping );
+                }
+                else if ( entry.Size != 0 )
+                {
+                    // parameters of non-trainable layers are small, so those are simply read
+                    if ( file == nullptr )
+                    {
+                        file = fopen( fileName.c_str( ), "rb" );
+                    }
+
+                    ret = ( file != nullptr ) &&
+                          ( SetFilePosition( file, entry.Offset ) ) &&
+                          ( mLayers[layerIndex]->LoadLearnedParams( file ) );
+                }
+            }
+
+            // don't leave the network partially mapped if loading failed - weights mapped so far are copied into layers' own memory
+            if ( !ret )
+            {
+                for ( size_t i = 0; i < layerIndex; i++ )
+                {
+                    if ( entries[i].Type == MappedParamsType::Weights )
+                    {
+                        static_pointer_cast<ITrainableLayer>( mLayers[i] )->UnmapWeights( );
+                    }
+                }
+            }
+
+            if ( file != nullptr )
+            {
+                fclose( file );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Saves parameters of quantized network
+bool XNeuralNetwork::SaveQuantizedParams( const string& fileName ) const
+{
+    FILE* file = fopen( fileName.c_str( ), "wb" );
+    bool  ret  = false;
+
+    if ( file != nullptr )
+    {
+        uint8_t floatTypeSize = static_cast<uint8_t>( sizeof( float_t ) );
+
+        if ( ( fwrite( "ANNQ", sizeof( char ), 4, file ) == 4 ) &&
+             ( fwrite( &floatTypeSize, sizeof( floatTypeSize ), 1, file ) == 1 ) )
+        {
+            ret = true;
+
+            for ( const_iterator layersIt = mLayers.begin( ); ( ret ) && ( layersIt != mLayers.end( ) ); layersIt++ )
+            {
+                ret = SaveLayerQuantizedParams( *layersIt, file );
+            }
+        }
+
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Loads parameters of quantized network
+bool XNeuralNetwork::LoadQuantizedParams( const string& fileName )
+{
+    FILE* file = fopen( fileName.c_str( ), "rb" );
+    bool  ret  = false;
+
+    if ( file != nullptr )
+    {
+        char    magic[4];
+        uint8_t floatTypeSize;
+
+        if ( ( fread( magic, sizeof( char ), 4, file ) == 4 ) &&
+             ( fread( &floatTypeSize, sizeof( floatTypeSize ), 1, file ) == 1 ) &&
+             ( memcmp( magic, "ANNQ", 4 ) == 0 ) &&
+             ( floatTypeSize == static_cast<uint8_t>( sizeof( float_t ) ) ) )
+        {
+            ret = true;
+
+            for ( const_iterator layersIt = mLayers.begin( ); ( ret ) && ( layersIt != mLayers.end( ) ); layersIt++ )
+            {
+                ret = LoadLayerQuantizedParams( *layersIt, file );
+            }
+        }
+
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Saves network's learned parameters with weights in the specified 16 bit precision
+bool XNeuralNetwork::SaveHalfPrecisionParams( const string& fileName, WeightsPrecision precision ) const
+{
+    FILE* file = ( precision != WeightsPrecision::Float ) ? fopen( fileName.c_str( ), "wb" ) : nullptr;
+    bool  ret  = false;
+
+    if ( file != nullptr )
+    {
+        uint8_t header[2] = { static_cast<uint8_t>( sizeof( float_t ) ),
+                              ( precision == WeightsPrecision::Half ) ? HALF_PARAMS_PRECISION_HALF : HALF_PARAMS_PRECISION_BFLOAT16 };
+
+        if ( ( fwrite( "ANNH", sizeof( char ), 4, file ) == 4 ) &&
+             ( fwrite( header, sizeof( uint8_t ), 2, file ) == 2 ) )
+        {
+            ret = true;
+
+            for ( const_iterator layersIt = mLayers.begin( ); ( ret ) && ( layersIt != mLayers.end( ) ); layersIt++ )
+            {
+                shared_ptr<ITrainableLayer> halfPrecisionLayer = HalfPrecisionLayer( *layersIt );
+
+                ret = ( halfPrecisionLayer ) ? halfPrecisionLayer->SaveHalfPrecisionParams( file, precision ) :
+                                               ( *layersIt )->SaveLearnedParams( file );
+            }
+        }
+
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Loads parameters saved by SaveHalfPrecisionParams( ) - layers supporting it keep weights in half precision
+bool XNeuralNetwork::LoadHalfPrecisionParams( const string& fileName )
+{
+    FILE* file = fopen( fileName.c_str( ), "rb" );
+    bool  ret  = false;
+
+    if ( file != nullptr )
+    {
+        char    magic[4];
+        uint8_t header[2];
+
+        if ( ( fread( magic, sizeof( char ), 4, file ) == 4 ) &&
+             ( fread( header, sizeof( uint8_t ), 2, file ) == 2 ) &&
+             ( memcmp( magic, "ANNH", 4 ) == 0 ) &&
+             ( header[0] == static_cast<uint8_t>( sizeof( float_t ) ) ) &&
+             ( ( header[1] == HALF_PARAMS_PRECISION_HALF ) || ( header[1] == HALF_PARAMS_PRECISION_BFLOAT16 ) ) )
+        {
+            WeightsPrecision precision = ( header[1] == HALF_PARAMS_PRECISION_HALF ) ? WeightsPrecision::Half : WeightsPrecision::BFloat16;
+
+            ret = true;
+
+            for ( const_iterator layersIt = mLayers.begin( ); ( ret ) && ( layersIt != mLayers.end( ) ); layersIt++ )
+            {
+                shared_ptr<ITrainableLayer> halfPrecisionLayer = HalfPrecisionLayer( *layersIt );
+
+                ret = ( halfPrecisionLayer ) ? halfPrecisionLayer->LoadHalfPrecisionParams( file, precision ) :
+                                               ( *layersIt )->LoadLearnedParams( file );
+            }
+        }
+
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Converts file of learned parameters saved by SaveLearnedParams( ) into file of half precision parameters
+bool XNeuralNetwork::ConvertLearnedParams( const string& srcFileName, const string& dstFileName, WeightsPrecision precision )
+{
+    FILE* srcFile = fopen( srcFileName.c_str( ), "rb" );
+    FILE* dstFile = nullptr;
+    bool  ret     = false;
+
+    if ( ( srcFile != nullptr ) && ( precision != WeightsPrecision::Float ) )
+    {
+        uint8_t version;
+
+        if ( ( ReadLearnedParamsHeader( srcFile, &version ) ) &&
+             ( ( dstFile = fopen( dstFileName.c_str( ), "wb" ) ) != nullptr ) )
+        {
+            uint8_t  header[2] = { static_cast<uint8_t>( sizeof( float_t ) ),
+                                   ( precision == WeightsPrecision::Half ) ? HALF_PARAMS_PRECISION_HALF : HALF_PARAMS_PRECISION_BFLOAT16 };
+            uint32_t layerID;
+
+            ret = ( fwrite( "ANNH", sizeof( char ), 4, dstFile ) == 4 ) &&
+                  ( fwrite( header, sizeof( uint8_t ), 2, dstFile ) == 2 );
+
+            // the file does not tell which layers are there, so parameters of layers are converted until its end;
+            // biases of convolution layers in files of the first version can not be scaled with no connections known
+            while ( ( ret ) && ( fread( &layerID, sizeof( layerID ), 1, srcFile ) == 1 ) )
+            {
+                ret = ( ( version != LEARNED_PARAMS_LEGACY_VERSION ) || ( layerID != static_cast<uint32_t>( LayerID::Convolution ) ) ) &&
+                      ( ConvertLayerLearnedParams( srcFile, dstFile, layerID, precision ) );
+            }
+
+            ret = ( ret ) && ( feof( srcFile ) != 0 );
+
+            fclose( dstFile );
+        }
+    }
+
+    if ( srcFile != nullptr )
+    {
+        fclose( srcFile );
+    }
+
+    return ret;
+}
+
 } } // namespace ANNT::Neuro
@@ -23,6 +23,7 @@
 #define ANNT_XNEURAL_NETWORK_HPP
 
 #include <memory>
+#include <string>
 #include <assert.h>
 
 #include "../Layers/ILayer.hpp"
@@ -37,12 +38,14 @@ class XNeuralNetwork
 {
 private:
     std::vector<std::shared_ptr<ILayer>> mLayers;
+    size_t                               mConfigurationVersion;
 
 public:
     typedef std::vector<std::shared_ptr<ILayer>>::iterator       iterator;
     typedef std::vector<std::shared_ptr<ILayer>>::const_iterator const_iterator;
 
-    XNeuralNetwork( )
+    XNeuralNetwork( ) :
+        mConfigurationVersion( 0 )
     {
     }
 
@@ -58,6 +61,10 @@ public:
         return ( mLayers.empty( ) ) ? 0 : mLayers.back( )->OutputsCount( );
     }
 
+    // Version of network's configuration, which changes every time layers are added/removed or any of them is changed
+    // in a way affecting memory needed for its computation (see ILayer::ConfigurationVersion( ))
+    size_t ConfigurationVersion( ) const;
+
     // Reports total number of layers
     size_t LayersCount( ) const
     {
@@ -83,21 +90,75 @@ public:
     }
 
     // Provides layer at the specified index
-    std::shared_ptr<ILayer> LayerAt( size_t index ) const
+    std::shared_ptr<ILayer> LayerAt( size_t index )
     {
         return ( index < mLayers.size( ) ) ? mLayers[index] : std::shared_ptr<ILayer>( nullptr );
     }
+    std::shared_ptr<const ILayer> LayerAt( size_t index ) const
+    {
+        return ( index < mLayers.size( ) ) ? mLayers[index] : std::shared_ptr<const ILayer>( nullptr );
+    }
 
     // Adds the specified layer to the end of layers' collection
     void AddLayer( const std::shared_ptr<ILayer>& layer );
 
+    // Transforms trained network for inference only: batch normalization layers following convolution or fully
+    // connected layers are folded into their weights and biases, and removed from the network.
+    // Inference objects created before re-plan their memory when used next time. The network can not be trained after
+    // that and its learned parameters can only be loaded into a network transformed the same way.
+    void FreezeForInference( );
+
+    // Quantizes weights of convolution and fully connected layers to 8 bit integers, so inference runs on integer
+    // SIMD kernels. Range of inputs of every layer is provided by calibration (see XNetworkInference::CalibrateInputsRange( )).
+    // Inference objects created before (the one used for calibration included) detect the change and re-allocate their
+    // memory when used next time. Changing weights of a layer reverts it to floating point.
+    void Quantize( const fvector_t& inputsMin, const fvector_t& inputsMax );
+
     // Saves network's learned parameters only.
     // Network structure is not saved and so same network must be constructed before loading parameters
     bool SaveLearnedParams( const std::string& fileName ) const;
 
     // Loads network's learned parameters.
     // A network of the same structure as saved must be created first, since this method loads only parameters/weights/biases.
+    // Biases of convolution layers saved by earlier versions (which added bias once for every connected input map) are scaled
+    // to give the same outputs, so saving parameters again upgrades such files.
     bool LoadLearnedParams( const std::string& fileName );
+
+    // Saves network's learned parameters in the format, which can be memory mapped by MapLearnedParams( ) -
+    // weights of every trainable layer are stored as a single 64 bytes aligned block.
+    bool SaveMappableParams( const std::string& fileName ) const;
+
+    // Maps network's learned parameters saved by SaveMappableParams( ). Trainable layers use weights directly from
+    // the read-only mapping, which is shared by all processes mapping the same file, so nothing is read until
+    // weights are accessed. Weights are copied into layers' own memory only if anything is going to change them.
+    // A network of the same structure as saved must be created first.
+    bool MapLearnedParams( const std::string& fileName );
+
+    // Saves parameters of quantized network - 8 bit weights with their scales for quantized layers and
+    // learned parameters for the rest.
+    bool SaveQuantizedParams( const std::string& fileName ) const;
+
+    // Loads parameters saved by SaveQuantizedParams( ), which makes the network quantized.
+    // A network of the same structure as saved must be created first (and frozen, if it was before saving).
+    bool LoadQuantizedParams( const std::string& fileName );
+
+    // Converts weights of fully connected, convolution and recurrent layers to the specified precision, so they take half
+    // of the memory and bandwidth for inference (see ITrainableLayer::SetStoragePrecision( )). Weights of other layers stay
+    // as they are.
+    void SetStoragePrecision( WeightsPrecision precision );
+
+    // Saves network's learned parameters with weights of layers supporting half precision stored in the specified
+    // 16 bit precision (those of other layers are saved as they are).
+    bool SaveHalfPrecisionParams( const std::string& fileName, WeightsPrecision precision ) const;
+
+    // Loads parameters saved by SaveHalfPrecisionParams( ), which makes the layers keep their weights in that precision.
+    // A network of the same structure as saved must be created first.
+    bool LoadHalfPrecisionParams( const std::string& fileName );
+
+    // Converts file of learned parameters saved by SaveLearnedParams( ) into the format of SaveHalfPrecisionParams( ),
+    // so existing parameters can be used with half precision weights without constructing a network. Files saved by earlier
+    // versions, which have convolution layers, must be upgraded first (see LoadLearnedParams( )).
+    static bool ConvertLearnedParams( const std::string& srcFileName, const std::string& dstFileName, WeightsPrecision precision );
 };
 
 } } // namespace ANNT::Neuro
@@ -0,0 +1,200 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+#include <string.h>
+
+#include "XParameterArena.hpp"
+#include "../Layers/ITrainableLayer.hpp"
+#include "../../Tools/XParallel.hpp"
+
+using namespace std;
+
+namespace ANNT { namespace Neuro { namespace Training {
+
+namespace {
+
+// Layers' parameters are padded to multiple of this, so each layer starts 64 bytes aligned
+static const size_t ARENA_ALIGNMENT = 64 / sizeof( float_t );
+
+// Number of parameters processed by a single task, when running parallel pass over the arena
+static const size_t ARENA_CHUNK_SIZE = 16384;
+
+// Runs the specified lambda on chunks of arena's parameters in parallel
+template <typename Func> void ForChunks( size_t size, Func func )
+{
+    size_t chunksCount = ( size + ARENA_CHUNK_SIZE - 1 ) / ARENA_CHUNK_SIZE;
+
+    XParallel::For( chunksCount, chunksCount > 1, [&]( size_t chunk )
+    {
+        size_t start = chunk * ARENA_CHUNK_SIZE;
+
+        func( start, std::min( ARENA_CHUNK_SIZE, size - start ) );
+    } );
+}
+
+} // namespace <anonymous>
+
+// Creates parameters' arena for the specified network and moves weights of its trainable layers there
+XParameterArena::XParameterArena( const shared_ptr<XNeuralNetwork>& network,
+                                  size_t parameterVariablesCount,
+                                  size_t layerVariablesCount ) :
+    mNetwork( network ),
+    mLayersOffsets( network->LayersCount( ) ),
+    mLayersWeightsCount( network->LayersCount( ) ),
+    mParameterVariables( parameterVariablesCount ),
+    mLayerVariables( layerVariablesCount ),
+    mAttached( false )
+{
+    size_t layerIndex = 0;
+    size_t offset     = 0;
+
+    // work out layout of all parameters
+    for ( auto layer : *mNetwork )
+    {
+        size_t weightsCount = 0;
+
+        if ( layer->Trainable( ) )
+        {
+            weightsCount = static_pointer_cast<ITrainableLayer>( layer )->WeightsCount( );
+        }
+
+        mLayersOffsets[layerIndex]      = offset;
+        mLayersWeightsCount[layerIndex] = weightsCount;
+
+        offset += ( weightsCount + ARENA_ALIGNMENT - 1 ) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        layerIndex++;
+    }
+
+    mWeights   = fvector_t( offset );
+    mGradients = fvector_t( offset );
+
+    for ( size_t i = 0; i < parameterVariablesCount; i++ )
+    {
+        mParameterVariables[i] = fvector_t( offset );
+    }
+
+    // move layers' weights into the arena
+    layerIndex = 0;
+
+    for ( auto layer : *mNetwork )
+    {
+        if ( ( mLayersWeightsCount[layerIndex] != 0 ) &&
+             ( !static_pointer_cast<ITrainableLayer>( layer )->AttachWeightsStorage( mWeights.data( ) + mLayersOffsets[layerIndex] ) ) )
+        {
+            break;
+        }
+        layerIndex++;
+    }
+
+    mAttached = ( layerIndex == mNetwork->LayersCount( ) );
+
+    // move weights of already attached layers back, if any layer could not be attached
+    if ( !mAttached )
+    {
+        DetachLayers( layerIndex );
+    }
+}
+
+// Moves weights back into layers' own storage
+XParameterArena::~XParameterArena( )
+{
+    if ( mAttached )
+    {
+        DetachLayers( mNetwork->LayersCount( ) );
+    }
+}
+
+// Moves weights of the specified number of first layers back into their own storage
+void XParameterArena::DetachLayers( size_t layersCount )
+{
+    for ( size_t layerIndex = 0; layerIndex < layersCount; layerIndex++ )
+    {
+        if ( mLayersWeightsCount[layerIndex] != 0 )
+        {
+            static_pointer_cast<ITrainableLayer>( mNetwork->LayerAt( layerIndex ) )->AttachWeightsStorage( nullptr );
+        }
+    }
+}
+
+// Updates all weights from their gradients using the specified optimizer
+void XParameterArena::UpdateWeights( INetworkOptimizer& optimizer, float_t gradScale )
+{
+    float_t* weights   = mWeights.data( );
+    float_t* gradients = mGradients.data( );
+
+    ForChunks( mWeights.size( ), [&]( size_t start, size_t count )
+    {
+        optimizer.UpdateWeightsFromGradients( weights, gradients, mParameterVariables, mLayerVariables, gradScale, start, count );
+    } );
+
+    optimizer.UpdateLayerVariables( mLayerVariables );
+
+    NotifyWeightsChanged( );
+}
+
+// Sets all gradients to zero
+void XParameterArena::ZeroGradients( )
+{
+    float_t* gradients = mGradients.data( );
+
+    ForChunks( mGradients.size( ), [&]( size_t start, size_t count )
+    {
+        memset( gradients + start, 0, count * sizeof( float_t ) );
+    } );
+}
+
+// Copies all weights into the specified snapshot
+void XParameterArena::SaveSnapshot( fvector_t& snapshot ) const
+{
+    snapshot.resize( mWeights.size( ) );
+    memcpy( snapshot.data( ), mWeights.data( ), mWeights.size( ) * sizeof( float_t ) );
+}
+
+// Restores all weights from the specified snapshot
+bool XParameterArena::RestoreSnapshot( const fvector_t& snapshot )
+{
+    bool ret = ( snapshot.size( ) == mWeights.size( ) );
+
+    if ( ret )
+    {
+        memcpy( mWeights.data( ), snapshot.data( ), mWeights.size( ) * sizeof( float_t ) );
+        NotifyWeightsChanged( );
+    }
+
+    return ret;
+}
+
+// Notifies trainable layers their weights were changed
+void XParameterArena::NotifyWeightsChanged( )
+{
+    size_t layerIndex = 0;
+
+    for ( auto layer : *mNetwork )
+    {
+        if ( mLayersWeightsCount[layerIndex] != 0 )
+        {
+            static_pointer_cast<ITrainableLayer>( layer )->WeightsChanged( );
+        }
+        layerIndex++;
+    }
+}
+
+} } } // namespace ANNT::Neuro::Training
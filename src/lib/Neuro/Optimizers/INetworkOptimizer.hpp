@@ -22,7 +22,10 @@
 #ifndef ANNT_INETWORK_OPTIMIZER_HPP
 #define ANNT_INETWORK_OPTIMIZER_HPP
 
+#include <string.h>
+
 #include "../../Types/Types.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -66,6 +69,41 @@ public:
 
     // Calculates weights/biases updates from given gradients
     virtual void CalculateUpdatesFromGradients( fvector_t& updates, std::vector<fvector_t>& paramVariables, fvector_t& layerVariables ) = 0;
+
+    // Updates weights from their gradients (multiplied by gradScale) in a single pass and resets the gradients.
+    // Only [offset, offset + count) range of weights, gradients and parameter variables is updated, so the method can be
+    // run in parallel for different ranges. Layer variables are not changed - UpdateLayerVariables( ) is called for
+    // that once all ranges are done. Default implementation goes through CalculateUpdatesFromGradients( ), so
+    // optimizers, which keep state in layer variables, must override both methods.
+    virtual void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& paramVariables,
+                                             const fvector_t& layerVariables, float_t gradScale, size_t offset, size_t count )
+    {
+        fvector_t              updates( count );
+        std::vector<fvector_t> variables( paramVariables.size( ) );
+        fvector_t              layerVariablesCopy( layerVariables );
+
+        XVectorize::Scale( gradients + offset, gradScale, updates.data( ), count );
+
+        for ( size_t i = 0; i < variables.size( ); i++ )
+        {
+            variables[i] = fvector_t( paramVariables[i].begin( ) + offset, paramVariables[i].begin( ) + offset + count );
+        }
+
+        CalculateUpdatesFromGradients( updates, variables, layerVariablesCopy );
+
+        for ( size_t i = 0; i < variables.size( ); i++ )
+        {
+            memcpy( paramVariables[i].data( ) + offset, variables[i].data( ), count * sizeof( float_t ) );
+        }
+
+        XVectorize::Add( updates.data( ), weights + offset, count );
+        memset( gradients + offset, 0, count * sizeof( float_t ) );
+    }
+
+    // Updates layer variables after weights were updated with UpdateWeightsFromGradients( )
+    virtual void UpdateLayerVariables( fvector_t& /* layerVariables */ )
+    {
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
@@ -23,6 +23,7 @@
 #define ANNT_XADAM_OPTIMIZER_HPP
 
 #include "INetworkOptimizer.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 // Implementation of Adam otimizer
 // http://ruder.io/optimizing-gradient-descent/index.html#adam
@@ -88,6 +89,39 @@ public:
         layerVariables[1] = b1t;
         layerVariables[2] = b2t;
     }
+
+    // Updates weights from their gradients in a single pass
+    void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& paramVariables,
+                                     const fvector_t& layerVariables, float_t gradScale, size_t offset, size_t count ) override
+    {
+        bool    firstStep = ( layerVariables[0] < float( 0.5 ) );
+        float_t b1t       = ( firstStep ) ? mB1 : layerVariables[1];
+        float_t b2t       = ( firstStep ) ? mB2 : layerVariables[2];
+
+        XVectorize::AdamStep( weights + offset, gradients + offset, paramVariables[0].data( ) + offset, paramVariables[1].data( ) + offset,
+                              gradScale, mB1, mB2, float_t( 1 ) / ( float_t( 1 ) - b1t ), float_t( 1 ) / ( float_t( 1 ) - b2t ),
+                              mLearningRate, mEpsilon, count );
+    }
+
+    // Updates b1^t and b2^t values after weights were updated
+    void UpdateLayerVariables( fvector_t& layerVariables ) override
+    {
+        float_t b1t = mB1;
+        float_t b2t = mB2;
+
+        if ( layerVariables[0] < float( 0.5 ) )
+        {
+            layerVariables[0] = float( 1.0 );
+        }
+        else
+        {
+            b1t = layerVariables[1];
+            b2t = layerVariables[2];
+        }
+
+        layerVariables[1] = b1t * mB1;
+        layerVariables[2] = b2t * mB2;
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
@@ -23,6 +23,7 @@
 #define ANNT_XGRADIENT_DESCENT_OPTIMIZER_HPP
 
 #include "INetworkOptimizer.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -40,10 +41,14 @@ public:
 
     void CalculateUpdatesFromGradients( fvector_t& updates, std::vector<fvector_t>& /* paramVariables */, fvector_t& /* layerVariables */ ) override
     {
-        for ( auto& update : updates )
-        {
-            update *= -mLearningRate;
-        }
+        XVectorize::Scale( updates.data( ), -mLearningRate, updates.data( ), updates.size( ) );
+    }
+
+    // Updates weights from their gradients in a single pass
+    void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& /* paramVariables */,
+                                     const fvector_t& /* layerVariables */, float_t gradScale, size_t offset, size_t count ) override
+    {
+        XVectorize::SgdStep( weights + offset, gradients + offset, gradScale, mLearningRate, count );
     }
 };
 
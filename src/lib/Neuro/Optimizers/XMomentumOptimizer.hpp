@@ -23,6 +23,7 @@
 #define ANNT_XMOMENTUM_OPTIMIZER_HPP
 
 #include "INetworkOptimizer.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -52,13 +53,18 @@ public:
     {
         fvector_t& vPrev = paramVariables[0];
 
-        for ( size_t i = 0, n = updates.size( ); i < n; i++ )
-        {
-            float_t vt = mMomentum * vPrev[i] + mLearningRate * updates[i];
+        // v(t) = momentum * v(t-1) + learningRate * paramGrad(t)
+        XVectorize::ScaledAdd( updates.data( ), mLearningRate, mMomentum, vPrev.data( ), updates.size( ) );
+        // paramUpdate(t) = -v(t)
+        XVectorize::Scale( vPrev.data( ), float_t( -1 ), updates.data( ), updates.size( ) );
+    }
 
-            updates[i] = -vt;
-            vPrev[i]   = vt;
-        }
+    // Updates weights from their gradients in a single pass
+    void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& paramVariables,
+                                     const fvector_t& /* layerVariables */, float_t gradScale, size_t offset, size_t count ) override
+    {
+        XVectorize::MomentumStep( weights + offset, gradients + offset, paramVariables[0].data( ) + offset,
+                                  gradScale, mMomentum, mLearningRate, float_t( -1 ), float_t( 0 ), count );
     }
 };
 
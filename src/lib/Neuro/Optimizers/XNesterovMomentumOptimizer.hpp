@@ -23,6 +23,7 @@
 #define ANNT_XNESTEROV_MOMENTUM_OPTIMIZER_HPP
 
 #include "INetworkOptimizer.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -49,13 +50,19 @@ public:
     {
         fvector_t& vPrev = paramVariables[0];
 
-        for ( size_t i = 0, n = updates.size( ); i < n; i++ )
-        {
-            float_t vt = mMomentum * vPrev[i] - mLearningRate * updates[i];
+        // v(t) = momentum * v(t-1) - learningRate * paramGrad(t)
+        XVectorize::ScaledAdd( updates.data( ), -mLearningRate, mMomentum, vPrev.data( ), updates.size( ) );
+        // paramUpdate(t) = -momentum * v(t-1) + ( 1 + momentum ) * v(t), which is the same as
+        //                  momentum * v(t) - learningRate * paramGrad(t)
+        XVectorize::ScaledAdd( vPrev.data( ), mMomentum, -mLearningRate, updates.data( ), updates.size( ) );
+    }
 
-            updates[i] = -mMomentum * vPrev[i] + ( float_t( 1.0 ) + mMomentum ) * vt;
-            vPrev[i]   = vt;
-        }
+    // Updates weights from their gradients in a single pass
+    void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& paramVariables,
+                                     const fvector_t& /* layerVariables */, float_t gradScale, size_t offset, size_t count ) override
+    {
+        XVectorize::MomentumStep( weights + offset, gradients + offset, paramVariables[0].data( ) + offset,
+                                  gradScale, mMomentum, -mLearningRate, mMomentum, -mLearningRate, count );
     }
 };
 
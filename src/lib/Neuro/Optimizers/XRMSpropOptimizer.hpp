@@ -23,6 +23,7 @@
 #define ANNT_XRMSPROP_OPTIMIZER_HPP
 
 #include "INetworkOptimizer.hpp"
+#include "../../Tools/XVectorize.hpp"
 
 namespace ANNT { namespace Neuro { namespace Training {
 
@@ -57,6 +58,14 @@ public:
             updates[i] *= -mLearningRate / std::sqrt( eg[i] + mEpsilon );
         }
     }
+
+    // Updates weights from their gradients in a single pass
+    void UpdateWeightsFromGradients( float_t* weights, float_t* gradients, std::vector<fvector_t>& paramVariables,
+                                     const fvector_t& /* layerVariables */, float_t gradScale, size_t offset, size_t count ) override
+    {
+        XVectorize::AdaptiveStep( weights + offset, gradients + offset, paramVariables[0].data( ) + offset,
+                                  gradScale, mMu, float_t( 1 ) - mMu, mLearningRate, mEpsilon, count );
+    }
 };
 
 } } } // namespace ANNT::Neuro::Training
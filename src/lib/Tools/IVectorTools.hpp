@@ -50,6 +50,85 @@ public:
     // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
     virtual void Max( const float*  src, float  alpha, float*  dst, size_t size ) const = 0;
     virtual void Max( const double* src, double alpha, double* dst, size_t size ) const = 0;
+
+    // Scales vector and adds it to another one: dst[i] += alpha * src[i]
+    virtual void Axpy( const float*  src, float  alpha, float*  dst, size_t size ) const = 0;
+    virtual void Axpy( const double* src, double alpha, double* dst, size_t size ) const = 0;
+
+    // Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+    virtual void Scale( const float*  src, float  alpha, float  beta, float*  dst, size_t size ) const = 0;
+    virtual void Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const = 0;
+
+    // Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+    virtual void ScaledAdd( const float*  src, float  alpha, float  beta, float*  dst, size_t size ) const = 0;
+    virtual void ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const = 0;
+
+    // Element wise multiply-add: dst[i] += src1[i] * src2[i]
+    virtual void MulAdd( const float*  src1, const float*  src2, float*  dst, size_t size ) const = 0;
+    virtual void MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const = 0;
+
+    // Sum of vector's elements: sum( src[i] )
+    virtual float  Sum( const float*  src, size_t size ) const = 0;
+    virtual double Sum( const double* src, size_t size ) const = 0;
+
+    // Sum of squared vector's elements: sum( src[i] * src[i] )
+    virtual float  SumOfSquares( const float*  src, size_t size ) const = 0;
+    virtual double SumOfSquares( const double* src, size_t size ) const = 0;
+
+    // Minimum of vector's elements (0 for empty vector)
+    virtual float  MinValue( const float*  src, size_t size ) const = 0;
+    virtual double MinValue( const double* src, size_t size ) const = 0;
+
+    // Maximum of vector's elements (0 for empty vector)
+    virtual float  MaxValue( const float*  src, size_t size ) const = 0;
+    virtual double MaxValue( const double* src, size_t size ) const = 0;
+
+    // Index of the first maximum element of the vector (0 for empty vector)
+    virtual size_t ArgMax( const float*  src, size_t size ) const = 0;
+    virtual size_t ArgMax( const double* src, size_t size ) const = 0;
+
+    // Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+    virtual void Gather( const float*  src, const size_t* indexes, float*  dst, size_t size ) const = 0;
+    virtual void Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const = 0;
+
+    // Exponent of vector's elements: dst[i] = exp( src[i] )
+    virtual void Exp( const float*  src, float*  dst, size_t size ) const = 0;
+    virtual void Exp( const double* src, double* dst, size_t size ) const = 0;
+
+    // Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+    virtual void Sigmoid( const float*  src, float*  dst, size_t size ) const = 0;
+    virtual void Sigmoid( const double* src, double* dst, size_t size ) const = 0;
+
+    // Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+    virtual void Tanh( const float*  src, float*  dst, size_t size ) const = 0;
+    virtual void Tanh( const double* src, double* dst, size_t size ) const = 0;
+
+    // Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+    virtual void SigmoidDerivative( const float*  y, const float*  delta, float*  dst, size_t size ) const = 0;
+    virtual void SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const = 0;
+
+    // Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+    virtual void TanhDerivative( const float*  y, const float*  delta, float*  dst, size_t size ) const = 0;
+    virtual void TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const = 0;
+
+    // Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+    virtual void SgdStep( float*  weights, float*  gradients, float  gradScale, float  learningRate, size_t size ) const = 0;
+    virtual void SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const = 0;
+
+    // Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+    //   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+    virtual void MomentumStep( float*  weights, float*  gradients, float*  velocity, float  gradScale, float  momentum, float  alpha, float  beta, float  gamma, size_t size ) const = 0;
+    virtual void MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const = 0;
+
+    // Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+    //   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+    virtual void AdaptiveStep( float*  weights, float*  gradients, float*  sqSum, float  gradScale, float  decay, float  sqFactor, float  learningRate, float  epsilon, size_t size ) const = 0;
+    virtual void AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const = 0;
+
+    // Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+    //   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+    virtual void AdamStep( float*  weights, float*  gradients, float*  mt, float*  vt, float  gradScale, float  b1, float  b2, float  mtScale, float  vtScale, float  learningRate, float  epsilon, size_t size ) const = 0;
+    virtual void AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const = 0;
 };
 
 } // namespace ANNT
@@ -0,0 +1,386 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XSimdVectorTools.hpp"
+#include "XAvx2FmaVectorTools.hpp"
+#include "XCpu.hpp"
+
+#include "../Config.hpp"
+
+namespace ANNT {
+
+namespace {
+
+// Wrappers of AVX2/FMA intrinsics for single/double precision numbers
+template <typename T> struct Avx2FmaOps;
+
+template <> struct Avx2FmaOps<float>
+{
+    typedef __m256 Vector;
+
+    static const size_t Width     = 8;
+    static const size_t Alignment = 32;
+
+    static inline Vector Load( const float* src )                { return _mm256_load_ps( src ); }
+    static inline Vector LoadU( const float* src )               { return _mm256_loadu_ps( src ); }
+    static inline void   Store( float* dst, Vector value )       { _mm256_store_ps( dst, value ); }
+    static inline void   StoreU( float* dst, Vector value )      { _mm256_storeu_ps( dst, value ); }
+    static inline Vector Set1( float value )                     { return _mm256_set1_ps( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm256_add_ps( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm256_mul_ps( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm256_sub_ps( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm256_div_ps( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm256_sqrt_ps( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm256_max_ps( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm256_min_ps( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm256_fmadd_ps( v1, v2, v3 ); }
+    static inline Vector Round( Vector value )                   { return _mm256_round_ps( value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+
+    // ( a < b ) ? v1 : v2
+    static inline Vector Select( Vector a, Vector b, Vector v1, Vector v2 )
+    {
+        return _mm256_blendv_ps( v2, v1, _mm256_cmp_ps( a, b, _CMP_LT_OQ ) );
+    }
+
+    // 2^n is built directly from exponent bits: ( n + 127 ) << 23
+    static inline Vector Pow2( Vector n )
+    {
+        return _mm256_castsi256_ps( _mm256_cvtps_epi32( _mm256_mul_ps( _mm256_add_ps( n, _mm256_set1_ps( 127.0f ) ), _mm256_set1_ps( 8388608.0f ) ) ) );
+    }
+
+    static inline Vector Gather( const float* src, const size_t* idx )
+    {
+        if ( sizeof( size_t ) == 8 )
+        {
+            __m128 lo = _mm256_i64gather_ps( src, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) ), 4 );
+            __m128 hi = _mm256_i64gather_ps( src, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx + 4 ) ), 4 );
+
+            return _mm256_insertf128_ps( _mm256_castps128_ps256( lo ), hi, 1 );
+        }
+        else
+        {
+            return _mm256_i32gather_ps( src, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) ), 4 );
+        }
+    }
+
+    static inline float  Sum( Vector value )
+    {
+        float mem[8];
+
+        _mm256_storeu_ps( mem, value );
+
+        return mem[0] + mem[1] + mem[2] + mem[3] + mem[4] + mem[5] + mem[6] + mem[7];
+    }
+};
+
+template <> struct Avx2FmaOps<double>
+{
+    typedef __m256d Vector;
+
+    static const size_t Width     = 4;
+    static const size_t Alignment = 32;
+
+    static inline Vector Load( const double* src )               { return _mm256_load_pd( src ); }
+    static inline Vector LoadU( const double* src )              { return _mm256_loadu_pd( src ); }
+    static inline void   Store( double* dst, Vector value )      { _mm256_store_pd( dst, value ); }
+    static inline void   StoreU( double* dst, Vector value )     { _mm256_storeu_pd( dst, value ); }
+    static inline Vector Set1( double value )                    { return _mm256_set1_pd( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm256_add_pd( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm256_mul_pd( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm256_sub_pd( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm256_div_pd( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm256_sqrt_pd( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm256_max_pd( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm256_min_pd( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm256_fmadd_pd( v1, v2, v3 ); }
+
+    static inline Vector Gather( const double* src, const size_t* idx )
+    {
+        if ( sizeof( size_t ) == 8 )
+        {
+            return _mm256_i64gather_pd( src, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) ), 8 );
+        }
+        else
+        {
+            return _mm256_i32gather_pd( src, _mm_loadu_si128( reinterpret_cast<const __m128i*>( idx ) ), 8 );
+        }
+    }
+
+    static inline double  Sum( Vector value )
+    {
+        double mem[4];
+
+        _mm256_storeu_pd( mem, value );
+
+        return mem[0] + mem[1] + mem[2] + mem[3];
+    }
+};
+
+// Vector routines built on top of AVX2/FMA intrinsics
+typedef SimdTools<Avx2FmaOps> Avx2FmaTools;
+
+} // namespace <anonymous>
+
+/* ============================================================================= */
+
+// Check if the implementation of vector tools is available on the current system
+bool XAvx2FmaVectorTools::IsAvailable( ) const
+{
+#if defined(ANNT_USE_AVX2)
+    return XCpu::IsAvx2FmaSupported( );
+#else
+    return false;
+#endif
+}
+
+// Add two vectors: dst[i] += src[i]
+void XAvx2FmaVectorTools::Add( const float* src, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Add( src, dst, size );
+}
+void XAvx2FmaVectorTools::Add( const double* src, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Add( src, dst, size );
+}
+
+// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+void XAvx2FmaVectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+{
+    Avx2FmaTools::Mul( src, dst, size );
+}
+void XAvx2FmaVectorTools::Mul( const double* src, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Mul( src, dst, size );
+}
+
+// Dot product of two vectors: sum( vec1[i] * vec2[i] )
+float XAvx2FmaVectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+{
+    return Avx2FmaTools::Dot( vec1, vec2, size );
+}
+double XAvx2FmaVectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+{
+    return Avx2FmaTools::Dot( vec1, vec2, size );
+}
+
+// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+void XAvx2FmaVectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Max( src, alpha, dst, size );
+}
+void XAvx2FmaVectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Max( src, alpha, dst, size );
+}
+
+// Scales vector and adds it to another one: dst[i] += alpha * src[i]
+void XAvx2FmaVectorTools::Axpy( const float* src, float alpha, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Axpy( src, alpha, dst, size );
+}
+void XAvx2FmaVectorTools::Axpy( const double* src, double alpha, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Axpy( src, alpha, dst, size );
+}
+
+// Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+void XAvx2FmaVectorTools::Scale( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Scale( src, alpha, beta, dst, size );
+}
+void XAvx2FmaVectorTools::Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Scale( src, alpha, beta, dst, size );
+}
+
+// Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+void XAvx2FmaVectorTools::ScaledAdd( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    Avx2FmaTools::ScaledAdd( src, alpha, beta, dst, size );
+}
+void XAvx2FmaVectorTools::ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    Avx2FmaTools::ScaledAdd( src, alpha, beta, dst, size );
+}
+
+// Element wise multiply-add: dst[i] += src1[i] * src2[i]
+void XAvx2FmaVectorTools::MulAdd( const float* src1, const float* src2, float* dst, size_t size ) const
+{
+    Avx2FmaTools::MulAdd( src1, src2, dst, size );
+}
+void XAvx2FmaVectorTools::MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const
+{
+    Avx2FmaTools::MulAdd( src1, src2, dst, size );
+}
+
+// Sum of vector's elements: sum( src[i] )
+float XAvx2FmaVectorTools::Sum( const float* src, size_t size ) const
+{
+    return Avx2FmaTools::Sum( src, size );
+}
+double XAvx2FmaVectorTools::Sum( const double* src, size_t size ) const
+{
+    return Avx2FmaTools::Sum( src, size );
+}
+
+// Sum of squared vector's elements: sum( src[i] * src[i] )
+float XAvx2FmaVectorTools::SumOfSquares( const float* src, size_t size ) const
+{
+    return Avx2FmaTools::SumOfSquares( src, size );
+}
+double XAvx2FmaVectorTools::SumOfSquares( const double* src, size_t size ) const
+{
+    return Avx2FmaTools::SumOfSquares( src, size );
+}
+
+// Minimum of vector's elements (0 for empty vector)
+float XAvx2FmaVectorTools::MinValue( const float* src, size_t size ) const
+{
+    return Avx2FmaTools::MinValue( src, size );
+}
+double XAvx2FmaVectorTools::MinValue( const double* src, size_t size ) const
+{
+    return Avx2FmaTools::MinValue( src, size );
+}
+
+// Maximum of vector's elements (0 for empty vector)
+float XAvx2FmaVectorTools::MaxValue( const float* src, size_t size ) const
+{
+    return Avx2FmaTools::MaxValue( src, size );
+}
+double XAvx2FmaVectorTools::MaxValue( const double* src, size_t size ) const
+{
+    return Avx2FmaTools::MaxValue( src, size );
+}
+
+// Index of the first maximum element of the vector (0 for empty vector)
+size_t XAvx2FmaVectorTools::ArgMax( const float* src, size_t size ) const
+{
+    return Avx2FmaTools::ArgMax( src, size );
+}
+size_t XAvx2FmaVectorTools::ArgMax( const double* src, size_t size ) const
+{
+    return Avx2FmaTools::ArgMax( src, size );
+}
+
+// Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+void XAvx2FmaVectorTools::Gather( const float* src, const size_t* indexes, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Gather( src, indexes, dst, size );
+}
+void XAvx2FmaVectorTools::Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Gather( src, indexes, dst, size );
+}
+
+// Exponent of vector's elements: dst[i] = exp( src[i] )
+void XAvx2FmaVectorTools::Exp( const float* src, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Exp( src, dst, size );
+}
+void XAvx2FmaVectorTools::Exp( const double* src, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Exp( src, dst, size );
+}
+
+// Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+void XAvx2FmaVectorTools::Sigmoid( const float* src, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Sigmoid( src, dst, size );
+}
+void XAvx2FmaVectorTools::Sigmoid( const double* src, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Sigmoid( src, dst, size );
+}
+
+// Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+void XAvx2FmaVectorTools::Tanh( const float* src, float* dst, size_t size ) const
+{
+    Avx2FmaTools::Tanh( src, dst, size );
+}
+void XAvx2FmaVectorTools::Tanh( const double* src, double* dst, size_t size ) const
+{
+    Avx2FmaTools::Tanh( src, dst, size );
+}
+
+// Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+void XAvx2FmaVectorTools::SigmoidDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    Avx2FmaTools::SigmoidDerivative( y, delta, dst, size );
+}
+void XAvx2FmaVectorTools::SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    Avx2FmaTools::SigmoidDerivative( y, delta, dst, size );
+}
+
+// Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+void XAvx2FmaVectorTools::TanhDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    Avx2FmaTools::TanhDerivative( y, delta, dst, size );
+}
+void XAvx2FmaVectorTools::TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    Avx2FmaTools::TanhDerivative( y, delta, dst, size );
+}
+
+// Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+void XAvx2FmaVectorTools::SgdStep( float* weights, float* gradients, float gradScale, float learningRate, size_t size ) const
+{
+    Avx2FmaTools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+void XAvx2FmaVectorTools::SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const
+{
+    Avx2FmaTools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+
+// Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+//   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+void XAvx2FmaVectorTools::MomentumStep( float* weights, float* gradients, float* velocity, float gradScale, float momentum, float alpha, float beta, float gamma, size_t size ) const
+{
+    Avx2FmaTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+void XAvx2FmaVectorTools::MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const
+{
+    Avx2FmaTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+
+// Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+//   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+void XAvx2FmaVectorTools::AdaptiveStep( float* weights, float* gradients, float* sqSum, float gradScale, float decay, float sqFactor, float learningRate, float epsilon, size_t size ) const
+{
+    Avx2FmaTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+void XAvx2FmaVectorTools::AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const
+{
+    Avx2FmaTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+
+// Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+//   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+void XAvx2FmaVectorTools::AdamStep( float* weights, float* gradients, float* mt, float* vt, float gradScale, float b1, float b2, float mtScale, float vtScale, float learningRate, float epsilon, size_t size ) const
+{
+    Avx2FmaTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+void XAvx2FmaVectorTools::AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const
+{
+    Avx2FmaTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+
+} // namespace ANNT
@@ -0,0 +1,177 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <cstring>
+#include <immintrin.h>
+
+#include "XHalfKernels.hpp"
+
+namespace ANNT {
+
+// Number of values widened by one instruction
+static const size_t HALF_KERNELS_STEP = 8;
+
+// Half precision values are widened by F16C conversion
+static inline __m256 WidenHalf( const uint16_t* values )
+{
+    return _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<const __m128i*>( values ) ) );
+}
+
+// bfloat16 values are upper halves of floats, so only need to be shifted into place
+static inline __m256 WidenBFloat16( const uint16_t* values )
+{
+    __m256i widened = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( values ) ) );
+
+    return _mm256_castsi256_ps( _mm256_slli_epi32( widened, 16 ) );
+}
+
+// Float values are narrowed to half precision by F16C conversion, rounding to nearest even
+static inline __m128i NarrowHalf( __m256 values )
+{
+    return _mm256_cvtps_ph( values, _MM_FROUND_TO_NEAREST_INT );
+}
+
+// Float values are narrowed to bfloat16 by rounding away lower halves (ties to even), keeping NaN values quiet
+static inline __m128i NarrowBFloat16( __m256 values )
+{
+    __m256i bits    = _mm256_castps_si256( values );
+    __m256i lsb     = _mm256_and_si256( _mm256_srli_epi32( bits, 16 ), _mm256_set1_epi32( 1 ) );
+    __m256i rounded = _mm256_srli_epi32( _mm256_add_epi32( bits, _mm256_add_epi32( lsb, _mm256_set1_epi32( 0x7FFF ) ) ), 16 );
+    __m256i nan     = _mm256_or_si256( _mm256_srli_epi32( bits, 16 ), _mm256_set1_epi32( 0x0040 ) );
+    __m256i isNan   = _mm256_cmpgt_epi32( _mm256_and_si256( bits, _mm256_set1_epi32( 0x7FFFFFFF ) ), _mm256_set1_epi32( 0x7F800000 ) );
+    __m256i packed  = _mm256_packus_epi32( _mm256_blendv_epi8( rounded, nan, isNan ), _mm256_setzero_si256( ) );
+
+    return _mm256_castsi256_si128( _mm256_permute4x64_epi64( packed, 0x08 ) );
+}
+
+// Sums 8 float values of the register
+static inline float HorizontalSum( __m256 sum )
+{
+    __m128 sum4 = _mm_add_ps( _mm256_castps256_ps128( sum ), _mm256_extractf128_ps( sum, 1 ) );
+    __m128 sum2 = _mm_add_ps( sum4, _mm_movehl_ps( sum4, sum4 ) );
+
+    return _mm_cvtss_f32( _mm_add_ss( sum2, _mm_shuffle_ps( sum2, sum2, 1 ) ) );
+}
+
+// Widens values using the specified conversion - the tail shorter than conversion step goes through temporary buffers
+template <__m256 ( *Widen )( const uint16_t* )> static void ToFloat( const uint16_t* values, float* widened, size_t count )
+{
+    size_t i = 0;
+
+    for ( ; i + HALF_KERNELS_STEP <= count; i += HALF_KERNELS_STEP )
+    {
+        _mm256_storeu_ps( widened + i, Widen( values + i ) );
+    }
+
+    if ( i != count )
+    {
+        uint16_t tail[HALF_KERNELS_STEP] = { 0 };
+        float    tailWidened[HALF_KERNELS_STEP];
+
+        memcpy( tail, values + i, ( count - i ) * sizeof( uint16_t ) );
+        _mm256_storeu_ps( tailWidened, Widen( tail ) );
+        memcpy( widened + i, tailWidened, ( count - i ) * sizeof( float ) );
+    }
+}
+
+// Narrows values using the specified conversion - the tail shorter than conversion step goes through temporary buffers
+template <__m128i ( *Narrow )( __m256 )> static void FromFloat( const float* values, uint16_t* narrowed, size_t count )
+{
+    size_t i = 0;
+
+    for ( ; i + HALF_KERNELS_STEP <= count; i += HALF_KERNELS_STEP )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( narrowed + i ), Narrow( _mm256_loadu_ps( values + i ) ) );
+    }
+
+    if ( i != count )
+    {
+        float    tail[HALF_KERNELS_STEP] = { 0 };
+        uint16_t tailNarrowed[HALF_KERNELS_STEP];
+
+        memcpy( tail, values + i, ( count - i ) * sizeof( float ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( tailNarrowed ), Narrow( _mm256_loadu_ps( tail ) ) );
+        memcpy( narrowed + i, tailNarrowed, ( count - i ) * sizeof( uint16_t ) );
+    }
+}
+
+// Calculates dot product of widened values and the vector - 4 independent sums are kept to hide latency of FMA
+template <__m256 ( *Widen )( const uint16_t* )> static float Dot( const uint16_t* values, const float* vector, size_t count )
+{
+    __m256 sum0 = _mm256_setzero_ps( );
+    __m256 sum1 = _mm256_setzero_ps( );
+    __m256 sum2 = _mm256_setzero_ps( );
+    __m256 sum3 = _mm256_setzero_ps( );
+    size_t i    = 0;
+
+    for ( ; i + HALF_KERNELS_STEP * 4 <= count; i += HALF_KERNELS_STEP * 4 )
+    {
+        sum0 = _mm256_fmadd_ps( Widen( values + i      ), _mm256_loadu_ps( vector + i      ), sum0 );
+        sum1 = _mm256_fmadd_ps( Widen( values + i +  8 ), _mm256_loadu_ps( vector + i +  8 ), sum1 );
+        sum2 = _mm256_fmadd_ps( Widen( values + i + 16 ), _mm256_loadu_ps( vector + i + 16 ), sum2 );
+        sum3 = _mm256_fmadd_ps( Widen( values + i + 24 ), _mm256_loadu_ps( vector + i + 24 ), sum3 );
+    }
+    for ( ; i + HALF_KERNELS_STEP <= count; i += HALF_KERNELS_STEP )
+    {
+        sum0 = _mm256_fmadd_ps( Widen( values + i ), _mm256_loadu_ps( vector + i ), sum0 );
+    }
+
+    if ( i != count )
+    {
+        uint16_t tail[HALF_KERNELS_STEP]       = { 0 };
+        float    tailVector[HALF_KERNELS_STEP] = { 0 };
+
+        memcpy( tail, values + i, ( count - i ) * sizeof( uint16_t ) );
+        memcpy( tailVector, vector + i, ( count - i ) * sizeof( float ) );
+        sum1 = _mm256_fmadd_ps( Widen( tail ), _mm256_loadu_ps( tailVector ), sum1 );
+    }
+
+    return HorizontalSum( _mm256_add_ps( _mm256_add_ps( sum0, sum1 ), _mm256_add_ps( sum2, sum3 ) ) );
+}
+
+// F16C/FMA implementations for half precision weights
+void F16cFloatToHalf( const float* values, uint16_t* narrowed, size_t count )
+{
+    FromFloat<NarrowHalf>( values, narrowed, count );
+}
+void F16cHalfToFloat( const uint16_t* values, float* widened, size_t count )
+{
+    ToFloat<WidenHalf>( values, widened, count );
+}
+float F16cHalfDot( const uint16_t* values, const float* vector, size_t count )
+{
+    return Dot<WidenHalf>( values, vector, count );
+}
+
+// AVX2/FMA implementations for bfloat16 weights
+void Avx2FloatToBFloat16( const float* values, uint16_t* narrowed, size_t count )
+{
+    FromFloat<NarrowBFloat16>( values, narrowed, count );
+}
+void Avx2BFloat16ToFloat( const uint16_t* values, float* widened, size_t count )
+{
+    ToFloat<WidenBFloat16>( values, widened, count );
+}
+float Avx2BFloat16Dot( const uint16_t* values, const float* vector, size_t count )
+{
+    return Dot<WidenBFloat16>( values, vector, count );
+}
+
+} // namespace ANNT
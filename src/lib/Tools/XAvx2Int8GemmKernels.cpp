@@ -0,0 +1,91 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <cstring>
+#include <immintrin.h>
+
+#include "XInt8GemmKernels.hpp"
+
+namespace ANNT {
+
+// Loads group of 4 values as a single 32 bit integer
+static inline int32_t LoadQuad( const uint8_t* ptr )
+{
+    int32_t quad;
+
+    memcpy( &quad, ptr, sizeof( quad ) );
+
+    return quad;
+}
+
+// u8 * s8 products summed in pairs into s16, then in pairs into s32 and added to the accumulator
+static inline __m256i MultiplyAdd( __m256i sum, __m256i a, __m256i b, __m256i ones )
+{
+    return _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_maddubs_epi16( a, b ), ones ) );
+}
+
+// AVX2 implementation of INT8 GEMM micro kernel
+void Avx2Int8GemmKernel( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c )
+{
+    const __m256i  ones = _mm256_set1_epi16( 1 );
+    const uint8_t* a0   = a[0];
+    const uint8_t* a1   = a[1];
+    const uint8_t* a2   = a[2];
+    const uint8_t* a3   = a[3];
+    __m256i        c00  = _mm256_setzero_si256( ), c01 = _mm256_setzero_si256( );
+    __m256i        c10  = _mm256_setzero_si256( ), c11 = _mm256_setzero_si256( );
+    __m256i        c20  = _mm256_setzero_si256( ), c21 = _mm256_setzero_si256( );
+    __m256i        c30  = _mm256_setzero_si256( ), c31 = _mm256_setzero_si256( );
+
+    for ( size_t p = 0; p < k; p += 4, b += 64 )
+    {
+        // groups of 4 values of 8 panel rows in each register
+        __m256i b0 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b ) );
+        __m256i b1 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + 32 ) );
+        __m256i va;
+
+        va  = _mm256_set1_epi32( LoadQuad( a0 + p ) );
+        c00 = MultiplyAdd( c00, va, b0, ones );
+        c01 = MultiplyAdd( c01, va, b1, ones );
+
+        va  = _mm256_set1_epi32( LoadQuad( a1 + p ) );
+        c10 = MultiplyAdd( c10, va, b0, ones );
+        c11 = MultiplyAdd( c11, va, b1, ones );
+
+        va  = _mm256_set1_epi32( LoadQuad( a2 + p ) );
+        c20 = MultiplyAdd( c20, va, b0, ones );
+        c21 = MultiplyAdd( c21, va, b1, ones );
+
+        va  = _mm256_set1_epi32( LoadQuad( a3 + p ) );
+        c30 = MultiplyAdd( c30, va, b0, ones );
+        c31 = MultiplyAdd( c31, va, b1, ones );
+    }
+
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[0] ), c00 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[0] + 8 ), c01 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[1] ), c10 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[1] + 8 ), c11 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[2] ), c20 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[2] + 8 ), c21 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[3] ), c30 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( c[3] + 8 ), c31 );
+}
+
+} // namespace ANNT
@@ -0,0 +1,390 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XSimdVectorTools.hpp"
+#include "XAvx512VectorTools.hpp"
+#include "XCpu.hpp"
+
+#include "../Config.hpp"
+
+namespace ANNT {
+
+namespace {
+
+// Wrappers of AVX-512 intrinsics for single/double precision numbers
+// (masked versions of some intrinsics are used, since the plain ones are implemented with undefined pass-through register in some compilers)
+template <typename T> struct Avx512Ops;
+
+template <> struct Avx512Ops<float>
+{
+    typedef __m512 Vector;
+
+    static const size_t Width     = 16;
+    static const size_t Alignment = 64;
+
+    static inline Vector Load( const float* src )                { return _mm512_load_ps( src ); }
+    static inline Vector LoadU( const float* src )               { return _mm512_loadu_ps( src ); }
+    static inline void   Store( float* dst, Vector value )       { _mm512_store_ps( dst, value ); }
+    static inline void   StoreU( float* dst, Vector value )      { _mm512_storeu_ps( dst, value ); }
+    static inline Vector Set1( float value )                     { return _mm512_set1_ps( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm512_add_ps( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm512_mul_ps( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm512_sub_ps( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm512_div_ps( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm512_mask_sqrt_ps( value, 0xFFFF, value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm512_mask_max_ps( v1, 0xFFFF, v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm512_mask_min_ps( v1, 0xFFFF, v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm512_fmadd_ps( v1, v2, v3 ); }
+    static inline Vector Round( Vector value )                   { return _mm512_mask_roundscale_ps( value, 0xFFFF, value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+
+    // ( a < b ) ? v1 : v2
+    static inline Vector Select( Vector a, Vector b, Vector v1, Vector v2 )
+    {
+        return _mm512_mask_blend_ps( _mm512_cmp_ps_mask( a, b, _CMP_LT_OQ ), v2, v1 );
+    }
+
+    // 2^n is built directly from exponent bits: ( n + 127 ) << 23
+    static inline Vector Pow2( Vector n )
+    {
+        return _mm512_castsi512_ps( _mm512_mask_cvtps_epi32( _mm512_setzero_si512( ), 0xFFFF, _mm512_mul_ps( _mm512_add_ps( n, _mm512_set1_ps( 127.0f ) ), _mm512_set1_ps( 8388608.0f ) ) ) );
+    }
+
+    static inline Vector Gather( const float* src, const size_t* idx )
+    {
+        if ( sizeof( size_t ) == 8 )
+        {
+            __m256 lo = _mm512_mask_i64gather_ps( _mm256_setzero_ps( ), 0xFF, _mm512_loadu_si512( idx ), src, 4 );
+            __m256 hi = _mm512_mask_i64gather_ps( _mm256_setzero_ps( ), 0xFF, _mm512_loadu_si512( idx + 8 ), src, 4 );
+
+            __m512d lo512 = _mm512_castpd256_pd512( _mm256_castps_pd( lo ) );
+
+            return _mm512_castpd_ps( _mm512_mask_insertf64x4( lo512, 0xFF, lo512, _mm256_castps_pd( hi ), 1 ) );
+        }
+        else
+        {
+            return _mm512_mask_i32gather_ps( _mm512_setzero_ps( ), 0xFFFF, _mm512_loadu_si512( idx ), src, 4 );
+        }
+    }
+
+    static inline float  Sum( Vector value )
+    {
+        float mem[16];
+
+        _mm512_storeu_ps( mem, value );
+
+        return ( ( mem[0] + mem[1] ) + ( mem[2]  + mem[3]  ) ) + ( ( mem[4]  + mem[5]  ) + ( mem[6]  + mem[7]  ) ) +
+               ( ( mem[8] + mem[9] ) + ( mem[10] + mem[11] ) ) + ( ( mem[12] + mem[13] ) + ( mem[14] + mem[15] ) );
+    }
+};
+
+template <> struct Avx512Ops<double>
+{
+    typedef __m512d Vector;
+
+    static const size_t Width     = 8;
+    static const size_t Alignment = 64;
+
+    static inline Vector Load( const double* src )               { return _mm512_load_pd( src ); }
+    static inline Vector LoadU( const double* src )              { return _mm512_loadu_pd( src ); }
+    static inline void   Store( double* dst, Vector value )      { _mm512_store_pd( dst, value ); }
+    static inline void   StoreU( double* dst, Vector value )     { _mm512_storeu_pd( dst, value ); }
+    static inline Vector Set1( double value )                    { return _mm512_set1_pd( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm512_add_pd( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm512_mul_pd( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm512_sub_pd( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm512_div_pd( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm512_mask_sqrt_pd( value, 0xFF, value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm512_mask_max_pd( v1, 0xFF, v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm512_mask_min_pd( v1, 0xFF, v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm512_fmadd_pd( v1, v2, v3 ); }
+
+    static inline Vector Gather( const double* src, const size_t* idx )
+    {
+        if ( sizeof( size_t ) == 8 )
+        {
+            return _mm512_mask_i64gather_pd( _mm512_setzero_pd( ), 0xFF, _mm512_loadu_si512( idx ), src, 8 );
+        }
+        else
+        {
+            return _mm512_mask_i32gather_pd( _mm512_setzero_pd( ), 0xFF, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) ), src, 8 );
+        }
+    }
+
+    static inline double Sum( Vector value )
+    {
+        double mem[8];
+
+        _mm512_storeu_pd( mem, value );
+
+        return ( ( mem[0] + mem[1] ) + ( mem[2] + mem[3] ) ) + ( ( mem[4] + mem[5] ) + ( mem[6] + mem[7] ) );
+    }
+};
+
+// Vector routines built on top of AVX-512 intrinsics
+typedef SimdTools<Avx512Ops> Avx512Tools;
+
+} // namespace <anonymous>
+
+/* ============================================================================= */
+
+// Check if the implementation of vector tools is available on the current system
+bool XAvx512VectorTools::IsAvailable( ) const
+{
+#if defined(ANNT_USE_AVX512)
+    return XCpu::IsAvx512Supported( );
+#else
+    return false;
+#endif
+}
+
+// Add two vectors: dst[i] += src[i]
+void XAvx512VectorTools::Add( const float* src, float* dst, size_t size ) const
+{
+    Avx512Tools::Add( src, dst, size );
+}
+void XAvx512VectorTools::Add( const double* src, double* dst, size_t size ) const
+{
+    Avx512Tools::Add( src, dst, size );
+}
+
+// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+void XAvx512VectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+{
+    Avx512Tools::Mul( src, dst, size );
+}
+void XAvx512VectorTools::Mul( const double* src, double* dst, size_t size ) const
+{
+    Avx512Tools::Mul( src, dst, size );
+}
+
+// Dot product of two vectors: sum( vec1[i] * vec2[i] )
+float XAvx512VectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+{
+    return Avx512Tools::Dot( vec1, vec2, size );
+}
+double XAvx512VectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+{
+    return Avx512Tools::Dot( vec1, vec2, size );
+}
+
+// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+void XAvx512VectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
+{
+    Avx512Tools::Max( src, alpha, dst, size );
+}
+void XAvx512VectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
+{
+    Avx512Tools::Max( src, alpha, dst, size );
+}
+
+// Scales vector and adds it to another one: dst[i] += alpha * src[i]
+void XAvx512VectorTools::Axpy( const float* src, float alpha, float* dst, size_t size ) const
+{
+    Avx512Tools::Axpy( src, alpha, dst, size );
+}
+void XAvx512VectorTools::Axpy( const double* src, double alpha, double* dst, size_t size ) const
+{
+    Avx512Tools::Axpy( src, alpha, dst, size );
+}
+
+// Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+void XAvx512VectorTools::Scale( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    Avx512Tools::Scale( src, alpha, beta, dst, size );
+}
+void XAvx512VectorTools::Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    Avx512Tools::Scale( src, alpha, beta, dst, size );
+}
+
+// Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+void XAvx512VectorTools::ScaledAdd( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    Avx512Tools::ScaledAdd( src, alpha, beta, dst, size );
+}
+void XAvx512VectorTools::ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    Avx512Tools::ScaledAdd( src, alpha, beta, dst, size );
+}
+
+// Element wise multiply-add: dst[i] += src1[i] * src2[i]
+void XAvx512VectorTools::MulAdd( const float* src1, const float* src2, float* dst, size_t size ) const
+{
+    Avx512Tools::MulAdd( src1, src2, dst, size );
+}
+void XAvx512VectorTools::MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const
+{
+    Avx512Tools::MulAdd( src1, src2, dst, size );
+}
+
+// Sum of vector's elements: sum( src[i] )
+float XAvx512VectorTools::Sum( const float* src, size_t size ) const
+{
+    return Avx512Tools::Sum( src, size );
+}
+double XAvx512VectorTools::Sum( const double* src, size_t size ) const
+{
+    return Avx512Tools::Sum( src, size );
+}
+
+// Sum of squared vector's elements: sum( src[i] * src[i] )
+float XAvx512VectorTools::SumOfSquares( const float* src, size_t size ) const
+{
+    return Avx512Tools::SumOfSquares( src, size );
+}
+double XAvx512VectorTools::SumOfSquares( const double* src, size_t size ) const
+{
+    return Avx512Tools::SumOfSquares( src, size );
+}
+
+// Minimum of vector's elements (0 for empty vector)
+float XAvx512VectorTools::MinValue( const float* src, size_t size ) const
+{
+    return Avx512Tools::MinValue( src, size );
+}
+double XAvx512VectorTools::MinValue( const double* src, size_t size ) const
+{
+    return Avx512Tools::MinValue( src, size );
+}
+
+// Maximum of vector's elements (0 for empty vector)
+float XAvx512VectorTools::MaxValue( const float* src, size_t size ) const
+{
+    return Avx512Tools::MaxValue( src, size );
+}
+double XAvx512VectorTools::MaxValue( const double* src, size_t size ) const
+{
+    return Avx512Tools::MaxValue( src, size );
+}
+
+// Index of the first maximum element of the vector (0 for empty vector)
+size_t XAvx512VectorTools::ArgMax( const float* src, size_t size ) const
+{
+    return Avx512Tools::ArgMax( src, size );
+}
+size_t XAvx512VectorTools::ArgMax( const double* src, size_t size ) const
+{
+    return Avx512Tools::ArgMax( src, size );
+}
+
+// Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+void XAvx512VectorTools::Gather( const float* src, const size_t* indexes, float* dst, size_t size ) const
+{
+    Avx512Tools::Gather( src, indexes, dst, size );
+}
+void XAvx512VectorTools::Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const
+{
+    Avx512Tools::Gather( src, indexes, dst, size );
+}
+
+// Exponent of vector's elements: dst[i] = exp( src[i] )
+void XAvx512VectorTools::Exp( const float* src, float* dst, size_t size ) const
+{
+    Avx512Tools::Exp( src, dst, size );
+}
+void XAvx512VectorTools::Exp( const double* src, double* dst, size_t size ) const
+{
+    Avx512Tools::Exp( src, dst, size );
+}
+
+// Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+void XAvx512VectorTools::Sigmoid( const float* src, float* dst, size_t size ) const
+{
+    Avx512Tools::Sigmoid( src, dst, size );
+}
+void XAvx512VectorTools::Sigmoid( const double* src, double* dst, size_t size ) const
+{
+    Avx512Tools::Sigmoid( src, dst, size );
+}
+
+// Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+void XAvx512VectorTools::Tanh( const float* src, float* dst, size_t size ) const
+{
+    Avx512Tools::Tanh( src, dst, size );
+}
+void XAvx512VectorTools::Tanh( const double* src, double* dst, size_t size ) const
+{
+    Avx512Tools::Tanh( src, dst, size );
+}
+
+// Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+void XAvx512VectorTools::SigmoidDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    Avx512Tools::SigmoidDerivative( y, delta, dst, size );
+}
+void XAvx512VectorTools::SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    Avx512Tools::SigmoidDerivative( y, delta, dst, size );
+}
+
+// Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+void XAvx512VectorTools::TanhDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    Avx512Tools::TanhDerivative( y, delta, dst, size );
+}
+void XAvx512VectorTools::TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    Avx512Tools::TanhDerivative( y, delta, dst, size );
+}
+
+// Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+void XAvx512VectorTools::SgdStep( float* weights, float* gradients, float gradScale, float learningRate, size_t size ) const
+{
+    Avx512Tools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+void XAvx512VectorTools::SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const
+{
+    Avx512Tools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+
+// Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+//   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+void XAvx512VectorTools::MomentumStep( float* weights, float* gradients, float* velocity, float gradScale, float momentum, float alpha, float beta, float gamma, size_t size ) const
+{
+    Avx512Tools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+void XAvx512VectorTools::MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const
+{
+    Avx512Tools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+
+// Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+//   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+void XAvx512VectorTools::AdaptiveStep( float* weights, float* gradients, float* sqSum, float gradScale, float decay, float sqFactor, float learningRate, float epsilon, size_t size ) const
+{
+    Avx512Tools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+void XAvx512VectorTools::AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const
+{
+    Avx512Tools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+
+// Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+//   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+void XAvx512VectorTools::AdamStep( float* weights, float* gradients, float* mt, float* vt, float gradScale, float b1, float b2, float mtScale, float vtScale, float learningRate, float epsilon, size_t size ) const
+{
+    Avx512Tools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+void XAvx512VectorTools::AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const
+{
+    Avx512Tools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+
+} // namespace ANNT
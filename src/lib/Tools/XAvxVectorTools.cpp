@@ -18,14 +18,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
-#include <type_traits>
-
-#ifdef _MSC_VER
-    #include <intrin.h>
-#elif __GNUC__
-    #include <x86intrin.h>
-#endif
-
+#include "XSimdVectorTools.hpp"
 #include "XAvxVectorTools.hpp"
 #include "XCpu.hpp"
 
@@ -33,577 +26,344 @@
 
 namespace ANNT {
 
-// Helper class wrapping some AVX intrinsics
-class AvxTools
+namespace {
+
+// Wrappers of AVX intrinsics for single/double precision numbers
+template <typename T> struct AvxOps;
+
+template <> struct AvxOps<float>
 {
-public:
-    // Add two vectors: dst[i] += src[i]
-    template <typename T> static inline void Add( const T* src, T* dst, size_t size )
+    typedef __m256 Vector;
+
+    static const size_t Width     = 8;
+    static const size_t Alignment = 32;
+
+    static inline Vector Load( const float* src )                { return _mm256_load_ps( src ); }
+    static inline Vector LoadU( const float* src )               { return _mm256_loadu_ps( src ); }
+    static inline void   Store( float* dst, Vector value )       { _mm256_store_ps( dst, value ); }
+    static inline void   StoreU( float* dst, Vector value )      { _mm256_storeu_ps( dst, value ); }
+    static inline Vector Set1( float value )                     { return _mm256_set1_ps( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm256_add_ps( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm256_mul_ps( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm256_sub_ps( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm256_div_ps( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm256_sqrt_ps( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm256_max_ps( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm256_min_ps( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm256_add_ps( _mm256_mul_ps( v1, v2 ), v3 ); }
+    static inline Vector Round( Vector value )                   { return _mm256_round_ps( value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+
+    // ( a < b ) ? v1 : v2
+    static inline Vector Select( Vector a, Vector b, Vector v1, Vector v2 )
     {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Add<T, std::true_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Add<T, std::true_type, std::false_type>( src, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Add<T, std::false_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Add<T, std::false_type, std::false_type>( src, dst, size );
-            }
-        }
+        return _mm256_blendv_ps( v2, v1, _mm256_cmp_ps( a, b, _CMP_LT_OQ ) );
     }
 
-    // Multiply two vectors: dst[i] *= src[i]
-    template <typename T> static inline void Mul( const T* src, T* dst, size_t size )
+    // 2^n is built directly from exponent bits: ( n + 127 ) << 23
+    static inline Vector Pow2( Vector n )
     {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Mul<T, std::true_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Mul<T, std::true_type, std::false_type>( src, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Mul<T, std::false_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Mul<T, std::false_type, std::false_type>( src, dst, size );
-            }
-        }
+        return _mm256_castsi256_ps( _mm256_cvtps_epi32( _mm256_mul_ps( _mm256_add_ps( n, _mm256_set1_ps( 127.0f ) ), _mm256_set1_ps( 8388608.0f ) ) ) );
     }
 
-    // Dot product: sum( vec1[i] * vec2[i] )
-    template <typename T> static inline T Dot( const T* vec1, const T* vec2, size_t size )
+    static inline Vector Gather( const float* src, const size_t* idx )
     {
-        T dotProduct;
-
-        if ( IsAligned( vec1 ) )
-        {
-            if ( IsAligned( vec2 ) )
-            {
-                dotProduct = Dot<T, std::true_type, std::true_type>( vec1, vec2, size );
-            }
-            else
-            {
-                dotProduct = Dot<T, std::true_type, std::false_type>( vec1, vec2, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( vec2 ) )
-            {
-                dotProduct = Dot<T, std::false_type, std::true_type>( vec1, vec2, size );
-            }
-            else
-            {
-                dotProduct = Dot<T, std::false_type, std::false_type>( vec1, vec2, size );
-            }
-        }
-
-        return dotProduct;
+        return _mm256_set_ps( src[idx[7]], src[idx[6]], src[idx[5]], src[idx[4]], src[idx[3]], src[idx[2]], src[idx[1]], src[idx[0]] );
     }
 
-    // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
-    template <typename T> static inline void Max( const T* src, T alpha, T* dst, size_t size )
+    static inline float  Sum( Vector value )
     {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Max<T, std::true_type, std::true_type>( src, alpha, dst, size );
-            }
-            else
-            {
-                Max<T, std::true_type, std::false_type>( src, alpha, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Max<T, std::false_type, std::true_type>( src, alpha, dst, size );
-            }
-            else
-            {
-                Max<T, std::false_type, std::false_type>( src, alpha, dst, size );
-            }
-        }
-    }
-
-private:
-    // Unroll size for single/double precision numbers - number of those in AVX register
-    template <typename T> static inline size_t UnrollSize( );
-
-    // Load 8 single / 4 double precision numbers into AVX register
-    template <typename isAligned> static inline __m256  Load( const float*  src );
-    template <typename isAligned> static inline __m256d Load( const double* src );
+        float mem[8];
 
-    // Store 8 single / 4 double precision numbers from AVX register into memory
-    template <typename isAligned> static inline void Store( const __m256&  value, float*  dst );
-    template <typename isAligned> static inline void Store( const __m256d& value, double* dst );
+        _mm256_storeu_ps( mem, value );
 
-    // Check if the pointer is AVX-aligned (32 byte aligned)
-    template <typename T> static inline bool IsAligned( const T* ptr )
-    {
-        return ( ( reinterpret_cast<uintptr_t>( ptr ) % 32 ) == 0 );
+        return mem[0] + mem[1] + mem[2] + mem[3] + mem[4] + mem[5] + mem[6] + mem[7];
     }
+};
 
-    // Initialize 8 single / 4 double precision numbers of AVX register with the specified value 
-    static inline __m256 Set1( float value )
+template <> struct AvxOps<double>
+{
+    typedef __m256d Vector;
+
+    static const size_t Width     = 4;
+    static const size_t Alignment = 32;
+
+    static inline Vector Load( const double* src )               { return _mm256_load_pd( src ); }
+    static inline Vector LoadU( const double* src )              { return _mm256_loadu_pd( src ); }
+    static inline void   Store( double* dst, Vector value )      { _mm256_store_pd( dst, value ); }
+    static inline void   StoreU( double* dst, Vector value )     { _mm256_storeu_pd( dst, value ); }
+    static inline Vector Set1( double value )                    { return _mm256_set1_pd( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm256_add_pd( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm256_mul_pd( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm256_sub_pd( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm256_div_pd( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm256_sqrt_pd( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm256_max_pd( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm256_min_pd( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm256_add_pd( _mm256_mul_pd( v1, v2 ), v3 ); }
+
+    static inline Vector Gather( const double* src, const size_t* idx )
     {
-        return _mm256_set1_ps( value );
+        return _mm256_set_pd( src[idx[3]], src[idx[2]], src[idx[1]], src[idx[0]] );
     }
-    static inline __m256d Set1( double value )
+
+    static inline double  Sum( Vector value )
     {
-        return _mm256_set1_pd( value );
-    }
+        double mem[4];
 
-    // Sum 8 single / 4 double precision numbers of AVX register
-    static inline float  Sum( __m256 value );
-    static inline double Sum( __m256d value );
+        _mm256_storeu_pd( mem, value );
 
-    // Add 8 single / 4 double precision numbers
-    static inline __m256 Add( const __m256& value1, const __m256& value2 )
-    {
-        return _mm256_add_ps( value1, value2 );
-    }
-    static inline __m256d Add( const __m256d& value1, const __m256d& value2 )
-    {
-        return _mm256_add_pd( value1, value2 );
+        return mem[0] + mem[1] + mem[2] + mem[3];
     }
+};
 
-    // Multiple 8 single / 4 double precision numbers
-    static inline __m256 Mul( const __m256& value1, const __m256& value2 )
-    {
-        return _mm256_mul_ps( value1, value2 );
-    }
-    static inline __m256d Mul( const __m256d& value1, const __m256d& value2 )
-    {
-        return _mm256_mul_pd( value1, value2 );
-    }
+// Vector routines built on top of AVX intrinsics
+typedef SimdTools<AvxOps> AvxTools;
 
-    // Multiple and Add 8 single / 4 double precision numbers: value1 * value2 + value3
-    static inline __m256 MAdd( const __m256& value1, const __m256& value2, const __m256& value3 )
-    {
-#ifdef USE_AVX2
-        return _mm256_fmadd_ps( value1, value2, value3 );
-#else
-        return _mm256_add_ps( _mm256_mul_ps( value1, value2 ), value3 );
-#endif
-    }
-    static inline __m256d MAdd( const __m256d& value1, const __m256d& value2, const __m256d& value3 )
-    {
-#ifdef USE_AVX2
-        return _mm256_fmadd_pd( value1, value2, value3 );
-#else
-        return _mm256_add_pd( _mm256_mul_pd( value1, value2 ), value3 );
-#endif
-    }
+} // namespace <anonymous>
 
-    // Maximum of 8 single / 4 double precision numbers
-    static inline __m256 Max( const __m256& value1, const __m256& value2 )
-    {
-        return _mm256_max_ps( value1, value2 );
-    }
-    static inline __m256d Max( const __m256d& value1, const __m256d& value2 )
-    {
-        return _mm256_max_pd( value1, value2 );
-    }
+/* ============================================================================= */
 
-    // Add two vectors
-    template <typename T, typename srcAligned, typename dstAligned> static void Add( const T* src, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-            auto d0 = Load<dstAligned>(  dst );
-            auto d1 = Load<dstAligned>( &dst[blockSize ] );
-            auto d2 = Load<dstAligned>( &dst[blockSize2] );
-            auto d3 = Load<dstAligned>( &dst[blockSize3] );
-
-            d0 = Add( s0, d0 );
-            d1 = Add( s1, d1 );
-            d2 = Add( s2, d2 );
-            d3 = Add( s3, d3 );
-
-            Store<dstAligned>( d0,  dst );
-            Store<dstAligned>( d1, &dst[blockSize ] );
-            Store<dstAligned>( d2, &dst[blockSize2] );
-            Store<dstAligned>( d3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-            auto d = Load<dstAligned>( dst );
-
-            d = Add( s, d );
-
-            Store<dstAligned>( d, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst += *src;
-
-            src++;
-            dst++;
-        }
-    }
+// Check if the implementation of vector tools is available on the current system
+bool XAvxVectorTools::IsAvailable( ) const
+{
+#if defined(ANNT_USE_AVX)
+    return XCpu::IsAvxSupported( );
+#else
+    return false;
+#endif
+}
 
-    // Multiply two vectors
-    template <typename T, typename srcAligned, typename dstAligned> static void Mul( const T* src, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-            auto d0 = Load<dstAligned>(  dst );
-            auto d1 = Load<dstAligned>( &dst[blockSize ] );
-            auto d2 = Load<dstAligned>( &dst[blockSize2] );
-            auto d3 = Load<dstAligned>( &dst[blockSize3] );
-
-            d0 = Mul( s0, d0 );
-            d1 = Mul( s1, d1 );
-            d2 = Mul( s2, d2 );
-            d3 = Mul( s3, d3 );
-
-            Store<dstAligned>( d0,  dst );
-            Store<dstAligned>( d1, &dst[blockSize ] );
-            Store<dstAligned>( d2, &dst[blockSize2] );
-            Store<dstAligned>( d3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-            auto d = Load<dstAligned>( dst );
-
-            d = Mul( s, d );
-
-            Store<dstAligned>( d, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst *= *src;
-
-            src++;
-            dst++;
-        }
-    }
+// Add two vectors: dst[i] += src[i]
+void XAvxVectorTools::Add( const float* src, float* dst, size_t size ) const
+{
+    AvxTools::Add( src, dst, size );
+}
+void XAvxVectorTools::Add( const double* src, double* dst, size_t size ) const
+{
+    AvxTools::Add( src, dst, size );
+}
 
-    // Dot product of two vectors
-    template <typename T, typename vec1Aligned, typename vec2Aligned> static T Dot( const T* vec1, const T* vec2, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-        
-        auto   sum0 = Set1( T( 0 ) );
-        auto   sum1 = Set1( T( 0 ) );
-        auto   sum2 = Set1( T( 0 ) );
-        auto   sum3 = Set1( T( 0 ) );
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto v10 = Load<vec1Aligned>(  vec1 );
-            auto v11 = Load<vec1Aligned>( &vec1[blockSize ] );
-            auto v12 = Load<vec1Aligned>( &vec1[blockSize2] );
-            auto v13 = Load<vec1Aligned>( &vec1[blockSize3] );
-            auto v20 = Load<vec2Aligned>(  vec2 );
-            auto v21 = Load<vec2Aligned>( &vec2[blockSize ] );
-            auto v22 = Load<vec2Aligned>( &vec2[blockSize2] );
-            auto v23 = Load<vec2Aligned>( &vec2[blockSize3] );
-
-            sum0 = MAdd( v10, v20, sum0 );
-            sum1 = MAdd( v11, v21, sum1 );
-            sum2 = MAdd( v12, v22, sum2 );
-            sum3 = MAdd( v13, v23, sum3 );
-
-            vec1 += blockSize4;
-            vec2 += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto v1 = Load<vec1Aligned>( vec1 );
-            auto v2 = Load<vec2Aligned>( vec2 );
-
-            sum0 = MAdd( v1, v2, sum0 );
-
-            vec1 += blockSize;
-            vec2 += blockSize;
-        }
-
-        sum0  = Add( sum0, sum1 );
-        sum0  = Add( sum0, sum2 );
-        sum0  = Add( sum0, sum3 );
-
-        T sum = Sum( sum0 );
-
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            sum += *vec1 * *vec2;
-
-            vec1++;
-            vec2++;
-        }
-
-        return sum;
-    }
+// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+void XAvxVectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+{
+    AvxTools::Mul( src, dst, size );
+}
+void XAvxVectorTools::Mul( const double* src, double* dst, size_t size ) const
+{
+    AvxTools::Mul( src, dst, size );
+}
 
-    // Maximum value of vector's elements and the specified alpha value
-    template <typename T, typename srcAligned, typename dstAligned> static void Max( const T* src, T alpha, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        auto   alphaVec = Set1( alpha );
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-
-            s0 = Max( s0, alphaVec );
-            s1 = Max( s1, alphaVec );
-            s2 = Max( s2, alphaVec );
-            s3 = Max( s3, alphaVec );
-
-            Store<dstAligned>( s0,  dst );
-            Store<dstAligned>( s1, &dst[blockSize ] );
-            Store<dstAligned>( s2, &dst[blockSize2] );
-            Store<dstAligned>( s3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-
-            s = Max( s, alphaVec );
-
-            Store<dstAligned>( s, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst = ( *src > alpha ) ? *src : alpha;
-
-            src++;
-            dst++;
-        }
-    }
-};
+// Dot product of two vectors: sum( vec1[i] * vec2[i] )
+float XAvxVectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+{
+    return AvxTools::Dot( vec1, vec2, size );
+}
+double XAvxVectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+{
+    return AvxTools::Dot( vec1, vec2, size );
+}
 
-// Unroll size for single/double precision numbers - number of those in AVX register
-template <> inline size_t AvxTools::UnrollSize<float>( )
+// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+void XAvxVectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
 {
-    return 8;
+    AvxTools::Max( src, alpha, dst, size );
 }
-template <> inline size_t AvxTools::UnrollSize<double>( )
+void XAvxVectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
 {
-    return 4;
+    AvxTools::Max( src, alpha, dst, size );
 }
 
-// Load 8 aligned single precision numbers
-template <> inline __m256 AvxTools::Load<std::true_type>( const float* src )
+// Scales vector and adds it to another one: dst[i] += alpha * src[i]
+void XAvxVectorTools::Axpy( const float* src, float alpha, float* dst, size_t size ) const
+{
+    AvxTools::Axpy( src, alpha, dst, size );
+}
+void XAvxVectorTools::Axpy( const double* src, double alpha, double* dst, size_t size ) const
 {
-    return _mm256_load_ps( src );
+    AvxTools::Axpy( src, alpha, dst, size );
 }
 
-// Load 8 unaligned single precision numbers
-template <> inline __m256 AvxTools::Load<std::false_type>( const float* src )
+// Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+void XAvxVectorTools::Scale( const float* src, float alpha, float beta, float* dst, size_t size ) const
 {
-    return _mm256_loadu_ps( src );
+    AvxTools::Scale( src, alpha, beta, dst, size );
+}
+void XAvxVectorTools::Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    AvxTools::Scale( src, alpha, beta, dst, size );
 }
 
-// Load 4 aligned double precision numbers
-template <> inline __m256d AvxTools::Load<std::true_type>( const double* src )
+// Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+void XAvxVectorTools::ScaledAdd( const float* src, float alpha, float beta, float* dst, size_t size ) const
 {
-    return _mm256_load_pd( src );
+    AvxTools::ScaledAdd( src, alpha, beta, dst, size );
+}
+void XAvxVectorTools::ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    AvxTools::ScaledAdd( src, alpha, beta, dst, size );
 }
 
-// Load 4 unaligned double precision numbers
-template <> inline __m256d AvxTools::Load<std::false_type>( const double* src )
+// Element wise multiply-add: dst[i] += src1[i] * src2[i]
+void XAvxVectorTools::MulAdd( const float* src1, const float* src2, float* dst, size_t size ) const
 {
-    return _mm256_loadu_pd( src );
+    AvxTools::MulAdd( src1, src2, dst, size );
+}
+void XAvxVectorTools::MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const
+{
+    AvxTools::MulAdd( src1, src2, dst, size );
 }
 
-// Store 8 signle precision numbers into aligned memory
-template <> inline void AvxTools::Store<std::true_type>( const __m256& value, float* dst )
+// Sum of vector's elements: sum( src[i] )
+float XAvxVectorTools::Sum( const float* src, size_t size ) const
+{
+    return AvxTools::Sum( src, size );
+}
+double XAvxVectorTools::Sum( const double* src, size_t size ) const
 {
-    _mm256_store_ps( dst, value );
+    return AvxTools::Sum( src, size );
 }
 
-// Store 8 signle precision numbers into unaligned memory
-template <> inline void AvxTools::Store<std::false_type>( const __m256& value, float* dst )
+// Sum of squared vector's elements: sum( src[i] * src[i] )
+float XAvxVectorTools::SumOfSquares( const float* src, size_t size ) const
 {
-    _mm256_storeu_ps( dst, value );
+    return AvxTools::SumOfSquares( src, size );
+}
+double XAvxVectorTools::SumOfSquares( const double* src, size_t size ) const
+{
+    return AvxTools::SumOfSquares( src, size );
 }
 
-// Store 4 double precision numbers into aligned memory
-template <> inline void AvxTools::Store<std::true_type>( const __m256d& value, double* dst )
+// Minimum of vector's elements (0 for empty vector)
+float XAvxVectorTools::MinValue( const float* src, size_t size ) const
+{
+    return AvxTools::MinValue( src, size );
+}
+double XAvxVectorTools::MinValue( const double* src, size_t size ) const
 {
-    _mm256_store_pd( dst, value );
+    return AvxTools::MinValue( src, size );
 }
 
-// Store 4 double precision numbers into unaligned memory
-template <> inline void AvxTools::Store<std::false_type>( const __m256d& value, double* dst )
+// Maximum of vector's elements (0 for empty vector)
+float XAvxVectorTools::MaxValue( const float* src, size_t size ) const
+{
+    return AvxTools::MaxValue( src, size );
+}
+double XAvxVectorTools::MaxValue( const double* src, size_t size ) const
 {
-    _mm256_storeu_pd( dst, value );
+    return AvxTools::MaxValue( src, size );
 }
 
-// Sum 8 single / 4 double precision numbers of AVX register
-inline float AvxTools::Sum( __m256 value )
+// Index of the first maximum element of the vector (0 for empty vector)
+size_t XAvxVectorTools::ArgMax( const float* src, size_t size ) const
 {
-    float mem[8];
+    return AvxTools::ArgMax( src, size );
+}
+size_t XAvxVectorTools::ArgMax( const double* src, size_t size ) const
+{
+    return AvxTools::ArgMax( src, size );
+}
 
-    Store<std::false_type>( value, mem );
+// Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+void XAvxVectorTools::Gather( const float* src, const size_t* indexes, float* dst, size_t size ) const
+{
+    AvxTools::Gather( src, indexes, dst, size );
+}
+void XAvxVectorTools::Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const
+{
+    AvxTools::Gather( src, indexes, dst, size );
+}
 
-    return mem[0] + mem[1] + mem[2] + mem[3] + mem[4] + mem[5] + mem[6] + mem[7];
+// Exponent of vector's elements: dst[i] = exp( src[i] )
+void XAvxVectorTools::Exp( const float* src, float* dst, size_t size ) const
+{
+    AvxTools::Exp( src, dst, size );
 }
-inline double AvxTools::Sum( __m256d value )
+void XAvxVectorTools::Exp( const double* src, double* dst, size_t size ) const
 {
-    double mem[4];
+    AvxTools::Exp( src, dst, size );
+}
 
-    Store<std::false_type>( value, mem );
+// Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+void XAvxVectorTools::Sigmoid( const float* src, float* dst, size_t size ) const
+{
+    AvxTools::Sigmoid( src, dst, size );
+}
+void XAvxVectorTools::Sigmoid( const double* src, double* dst, size_t size ) const
+{
+    AvxTools::Sigmoid( src, dst, size );
+}
 
-    return mem[0] + mem[1] + mem[2] + mem[3];
+// Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+void XAvxVectorTools::Tanh( const float* src, float* dst, size_t size ) const
+{
+    AvxTools::Tanh( src, dst, size );
+}
+void XAvxVectorTools::Tanh( const double* src, double* dst, size_t size ) const
+{
+    AvxTools::Tanh( src, dst, size );
 }
 
-/* ============================================================================= */
+// Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+void XAvxVectorTools::SigmoidDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    AvxTools::SigmoidDerivative( y, delta, dst, size );
+}
+void XAvxVectorTools::SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    AvxTools::SigmoidDerivative( y, delta, dst, size );
+}
 
-// Check if the implementation of vector tools is available on the current system
-bool XAvxVectorTools::IsAvailable( ) const
+// Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+void XAvxVectorTools::TanhDerivative( const float* y, const float* delta, float* dst, size_t size ) const
 {
-#if defined(ANNT_USE_AVX2)
-    return XCpu::IsFeatureSupported( XCpu::Reg_EBX, XCpu::Flag_AVX2 );
-#elif defined(ANNT_USE_AVX)
-    return XCpu::IsFeatureSupported( XCpu::Reg_ECX, XCpu::Flag_AVX );
-#else
-    return false;
-#endif
+    AvxTools::TanhDerivative( y, delta, dst, size );
+}
+void XAvxVectorTools::TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    AvxTools::TanhDerivative( y, delta, dst, size );
 }
 
-// Add two vectors: dst[i] += src[i]
-void XAvxVectorTools::Add( const float* src, float* dst, size_t size ) const
+// Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+void XAvxVectorTools::SgdStep( float* weights, float* gradients, float gradScale, float learningRate, size_t size ) const
 {
-    AvxTools::Add( src, dst, size );
+    AvxTools::SgdStep( weights, gradients, gradScale, learningRate, size );
 }
-void XAvxVectorTools::Add( const double* src, double* dst, size_t size ) const
+void XAvxVectorTools::SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const
 {
-    AvxTools::Add( src, dst, size );
-};
+    AvxTools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
 
-// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
-void XAvxVectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+// Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+//   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+void XAvxVectorTools::MomentumStep( float* weights, float* gradients, float* velocity, float gradScale, float momentum, float alpha, float beta, float gamma, size_t size ) const
 {
-    AvxTools::Mul( src, dst, size );
+    AvxTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
 }
-void XAvxVectorTools::Mul( const double* src, double* dst, size_t size ) const
+void XAvxVectorTools::MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const
 {
-    AvxTools::Mul( src, dst, size );
+    AvxTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
 }
 
-// Dot product of two vectors: sum( vec1[i] * vec2[i] )
-float XAvxVectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+// Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+//   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+void XAvxVectorTools::AdaptiveStep( float* weights, float* gradients, float* sqSum, float gradScale, float decay, float sqFactor, float learningRate, float epsilon, size_t size ) const
 {
-    return AvxTools::Dot( vec1, vec2, size );
+    AvxTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
 }
-double XAvxVectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+void XAvxVectorTools::AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const
 {
-    return AvxTools::Dot( vec1, vec2, size );
+    AvxTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
 }
 
-// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
-void XAvxVectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
+// Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+//   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+void XAvxVectorTools::AdamStep( float* weights, float* gradients, float* mt, float* vt, float gradScale, float b1, float b2, float mtScale, float vtScale, float learningRate, float epsilon, size_t size ) const
 {
-    AvxTools::Max( src, alpha, dst, size );
+    AvxTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
 }
-void XAvxVectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
+void XAvxVectorTools::AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const
 {
-    AvxTools::Max( src, alpha, dst, size );
+    AvxTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
 }
 
 } // namespace ANNT
@@ -47,13 +47,48 @@ void XCpu::CpuId( uint32_t& eax, uint32_t& ebx, uint32_t& ecx, uint32_t& edx )
 #endif
 }
 
+// Provide the specified leaf/sub-leaf of CPU ID (zeros if the leaf is not supported)
+void XCpu::CpuId( uint32_t leaf, uint32_t subLeaf, uint32_t& eax, uint32_t& ebx, uint32_t& ecx, uint32_t& edx )
+{
+    eax = ebx = ecx = edx = 0;
+
+#ifdef _MSC_VER
+    int cpuInfo[4];
+
+    __cpuid( cpuInfo, 0 );
+
+    if ( static_cast<uint32_t>( cpuInfo[0] ) >= leaf )
+    {
+        __cpuidex( cpuInfo, static_cast<int>( leaf ), static_cast<int>( subLeaf ) );
+
+        eax = static_cast<uint32_t>( cpuInfo[0] );
+        ebx = static_cast<uint32_t>( cpuInfo[1] );
+        ecx = static_cast<uint32_t>( cpuInfo[2] );
+        edx = static_cast<uint32_t>( cpuInfo[3] );
+    }
+#elif __GNUC__
+    if ( __get_cpuid_max( 0, nullptr ) >= leaf )
+    {
+        __cpuid_count( leaf, subLeaf, eax, ebx, ecx, edx );
+    }
+#endif
+}
+
 // Check if the particular feature is support by the CPU
 bool XCpu::IsFeatureSupported( uint32_t reg, uint32_t flag )
 {
     uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
     bool     ret = false;
 
-    CpuId( eax, ebx, ecx, edx );
+    if ( reg == Reg_EBX )
+    {
+        // extended features
+        CpuId( 7, 0, eax, ebx, ecx, edx );
+    }
+    else
+    {
+        CpuId( eax, ebx, ecx, edx );
+    }
 
     switch ( reg )
     {
@@ -74,6 +109,50 @@ bool XCpu::IsFeatureSupported( uint32_t reg, uint32_t flag )
     return ret;
 }
 
+// Check if OS saves/restores the specified state components of extended control register (XCR0)
+bool XCpu::IsOsStateEnabled( uint64_t stateMask )
+{
+    uint64_t xcr0 = 0;
+
+    // XGETBV instruction is available only if OS has enabled XSAVE
+    if ( IsFeatureSupported( Reg_ECX, Flag_OSXSAVE ) )
+    {
+#ifdef _MSC_VER
+        xcr0 = _xgetbv( 0 );
+#elif __GNUC__
+        uint32_t eax, edx;
+
+        __asm__ __volatile__ ( "xgetbv" : "=a" ( eax ), "=d" ( edx ) : "c" ( 0 ) );
+
+        xcr0 = ( static_cast<uint64_t>( edx ) << 32 ) | eax;
+#endif
+    }
+
+    return ( ( xcr0 & stateMask ) == stateMask );
+}
+
+// Check if AVX instructions can be used (supported by both CPU and OS)
+bool XCpu::IsAvxSupported( )
+{
+    return ( ( IsFeatureSupported( Reg_ECX, Flag_AVX ) ) && ( IsOsStateEnabled( 0x06 ) ) );
+}
+
+// Check if AVX2 and FMA instructions can be used
+bool XCpu::IsAvx2FmaSupported( )
+{
+    return ( ( IsAvxSupported( ) ) &&
+             ( IsFeatureSupported( Reg_EBX, Flag_AVX2 ) ) &&
+             ( IsFeatureSupported( Reg_ECX, Flag_FMA ) ) );
+}
+
+// Check if AVX-512 foundation instructions can be used
+bool XCpu::IsAvx512Supported( )
+{
+    return ( ( IsAvx2FmaSupported( ) ) &&
+             ( IsFeatureSupported( Reg_EBX, Flag_AVX512F ) ) &&
+             ( IsOsStateEnabled( 0xE6 ) ) );
+}
+
 // Get number of CPU cores provided by the system
 uint32_t XCpu::CoresCount( )
 {
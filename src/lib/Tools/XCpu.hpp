@@ -41,19 +41,24 @@ public:
         Reg_EDX = 3
     };
 
-    // Some of the CPUID flags to check for for available instruction sets
+    // Some of the CPUID flags to check for for available instruction sets. EBX flags are
+    // reported by the extended features leaf (7), while the rest by the leaf 1.
     enum EbxFlags
     {
-        Flag_AVX2   = 1 << 5,
+        Flag_AVX2    = 1 << 5,
+        Flag_AVX512F = 1 << 16,
     };
 
     enum EcxFlags
     {
-        Flag_SSE3   = 1,
-        Flag_SSSE3  = 1 << 9,
-        Flag_SSE4_1 = 1 << 19,
-        Flag_SSE4_2 = 1 << 20,
-        Flag_AVX    = 1 << 28,
+        Flag_SSE3    = 1,
+        Flag_SSSE3   = 1 << 9,
+        Flag_FMA     = 1 << 12,
+        Flag_SSE4_1  = 1 << 19,
+        Flag_SSE4_2  = 1 << 20,
+        Flag_OSXSAVE = 1 << 27,
+        Flag_AVX     = 1 << 28,
+        Flag_F16C    = 1 << 29,
     };
 
     enum EdxFlags
@@ -67,9 +72,25 @@ public:
     // Provide CPU ID - 4 32-bit registers describing CPU features
     static void CpuId( uint32_t& eax, uint32_t& ebx, uint32_t& ecx, uint32_t& edx );
 
+    // Provide the specified leaf/sub-leaf of CPU ID
+    static void CpuId( uint32_t leaf, uint32_t subLeaf, uint32_t& eax, uint32_t& ebx, uint32_t& ecx, uint32_t& edx );
+
     // Check if the particular feature is support by the CPU
     static bool IsFeatureSupported( uint32_t reg, uint32_t flag );
 
+    // Check if OS saves/restores the specified state components of extended control register (XCR0),
+    // which is needed before using AVX (0x06 - SSE and YMM) or AVX-512 (0xE6 - also opmask and ZMM) registers
+    static bool IsOsStateEnabled( uint64_t stateMask );
+
+    // Check if AVX instructions can be used (supported by both CPU and OS)
+    static bool IsAvxSupported( );
+
+    // Check if AVX2 and FMA instructions can be used
+    static bool IsAvx2FmaSupported( );
+
+    // Check if AVX-512 foundation instructions can be used
+    static bool IsAvx512Supported( );
+
     // Get number of CPU cores provided by the system
     static uint32_t CoresCount( );
 };
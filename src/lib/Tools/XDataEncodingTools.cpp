@@ -19,6 +19,8 @@
 */
 
 #include "XDataEncodingTools.hpp"
+#include "XVectorize.hpp"
+#include <algorithm>
 
 using namespace std;
 
@@ -52,19 +54,7 @@ vector<fvector_t> XDataEncodingTools::OneHotEncoding( const uvector_t& labels, s
 // Returns index of the maximum element in the specified vector
 size_t XDataEncodingTools::MaxIndex( const fvector_t& vec )
 {
-    size_t maxIndex = 0;
-    auto   maxValue = vec[0];
-
-    for ( size_t i = 1, n = vec.size( ); i < n; i++ )
-    {
-        if ( vec[i] > maxValue )
-        {
-            maxValue = vec[i];
-            maxIndex = i;
-        }
-    }
-
-    return maxIndex;
+    return XVectorize::ArgMax( vec.data( ), vec.size( ) );
 }
 
 // Pads the specified 2D input (although it can be of certain depth) with the specified value
@@ -204,6 +194,113 @@ void XDataEncodingTools::RemovePadding2d( const float_t* src, float_t* dst,
     }
 }
 
+// Finds range of output positions [start, end), which map into input when the specified kernel offset is applied:
+//   inputPos = outputPos * step + kernelOffset - pad
+void XDataEncodingTools::ValidOutputRange( size_t inputSize, size_t outputSize, size_t kernelOffset, size_t pad, size_t step,
+                                           size_t& start, size_t& end )
+{
+    start = ( pad > kernelOffset ) ? ( pad - kernelOffset + step - 1 ) / step : 0;
+    end   = ( inputSize + pad > kernelOffset ) ? ( inputSize + pad - kernelOffset - 1 ) / step + 1 : 0;
+    end   = std::min( end, outputSize );
+    start = std::min( start, end );
+}
+
+// Lowers 2D input into a matrix, where each column contains input values covered by convolution kernel (im2col)
+void XDataEncodingTools::Im2Col( const float_t* src, float_t* dst,
+                                 size_t width, size_t height, size_t depth,
+                                 size_t kernelWidth, size_t kernelHeight,
+                                 size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                                 size_t outputWidth, size_t outputHeight )
+{
+    for ( size_t d = 0; d < depth; d++ )
+    {
+        const float_t* srcBase = src + d * width * height;
+
+        for ( size_t ky = 0; ky < kernelHeight; ky++ )
+        {
+            size_t yStart, yEnd;
+
+            ValidOutputRange( height, outputHeight, ky, padTop, verticalStep, yStart, yEnd );
+
+            for ( size_t kx = 0; kx < kernelWidth; kx++ )
+            {
+                size_t xStart, xEnd;
+
+                ValidOutputRange( width, outputWidth, kx, padLeft, horizontalStep, xStart, xEnd );
+
+                for ( size_t oy = 0; oy < outputHeight; oy++, dst += outputWidth )
+                {
+                    if ( ( oy < yStart ) || ( oy >= yEnd ) )
+                    {
+                        std::fill( dst, dst + outputWidth, float_t( 0 ) );
+                        continue;
+                    }
+
+                    const float_t* srcPtr = srcBase + ( oy * verticalStep + ky - padTop ) * width +
+                                                      ( xStart * horizontalStep + kx - padLeft );
+
+                    std::fill( dst, dst + xStart, float_t( 0 ) );
+
+                    if ( horizontalStep == 1 )
+                    {
+                        std::copy( srcPtr, srcPtr + ( xEnd - xStart ), dst + xStart );
+                    }
+                    else
+                    {
+                        for ( size_t ox = xStart; ox < xEnd; ox++, srcPtr += horizontalStep )
+                        {
+                            dst[ox] = *srcPtr;
+                        }
+                    }
+
+                    std::fill( dst + xEnd, dst + outputWidth, float_t( 0 ) );
+                }
+            }
+        }
+    }
+}
+
+// Accumulates matrix columns back into the 2D input (col2im)
+void XDataEncodingTools::Col2Im( const float_t* src, float_t* dst,
+                                 size_t width, size_t height, size_t depth,
+                                 size_t kernelWidth, size_t kernelHeight,
+                                 size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                                 size_t outputWidth, size_t outputHeight )
+{
+    for ( size_t d = 0; d < depth; d++ )
+    {
+        float_t* dstBase = dst + d * width * height;
+
+        for ( size_t ky = 0; ky < kernelHeight; ky++ )
+        {
+            size_t yStart, yEnd;
+
+            ValidOutputRange( height, outputHeight, ky, padTop, verticalStep, yStart, yEnd );
+
+            for ( size_t kx = 0; kx < kernelWidth; kx++ )
+            {
+                size_t xStart, xEnd;
+
+                ValidOutputRange( width, outputWidth, kx, padLeft, horizontalStep, xStart, xEnd );
+
+                for ( size_t oy = yStart; oy < yEnd; oy++ )
+                {
+                    const float_t* srcPtr = src + oy * outputWidth;
+                    float_t*       dstPtr = dstBase + ( oy * verticalStep + ky - padTop ) * width +
+                                                      ( xStart * horizontalStep + kx - padLeft );
+
+                    for ( size_t ox = xStart; ox < xEnd; ox++, dstPtr += horizontalStep )
+                    {
+                        *dstPtr += srcPtr[ox];
+                    }
+                }
+
+                src += outputWidth * outputHeight;
+            }
+        }
+    }
+}
+
 // Builds input to output index mapping for pooling operator - one to one mapping
 uvector_t XDataEncodingTools::BuildPoolingInToOutMap( size_t inputWidth, size_t inputHeight, size_t inputDepth,
                                                       size_t poolSizeX, size_t poolSizeY,
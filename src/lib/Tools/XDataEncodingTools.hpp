@@ -59,6 +59,28 @@ public:
                                  size_t srcWidth, size_t srcHeight, size_t dstWidth, size_t dstHeight,
                                  size_t depth );
 
+    // Finds range of output positions [start, end), which map into input when the specified kernel offset is applied:
+    //   inputPos = outputPos * step + kernelOffset - pad
+    static void ValidOutputRange( size_t inputSize, size_t outputSize, size_t kernelOffset, size_t pad, size_t step,
+                                  size_t& start, size_t& end );
+
+    // Lowers 2D input (of certain depth) into a matrix, where each column contains input values covered by convolution
+    // kernel at the corresponding output position (im2col). The matrix has depth * kernelHeight * kernelWidth rows
+    // and outputHeight * outputWidth columns. Positions falling into padding area are set to zero.
+    static void Im2Col( const float_t* src, float_t* dst,
+                        size_t width, size_t height, size_t depth,
+                        size_t kernelWidth, size_t kernelHeight,
+                        size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                        size_t outputWidth, size_t outputHeight );
+
+    // Reverse of Im2Col - accumulates matrix columns back into the 2D input (col2im). Destination is not cleared,
+    // but values are added to it. Values corresponding to padding area are dropped.
+    static void Col2Im( const float_t* src, float_t* dst,
+                        size_t width, size_t height, size_t depth,
+                        size_t kernelWidth, size_t kernelHeight,
+                        size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                        size_t outputWidth, size_t outputHeight );
+
     // Builds input to output index mapping for pooling operator - one to one mapping
     static uvector_t BuildPoolingInToOutMap( size_t inputWidth, size_t inputHeight, size_t inputDepth,
                                              size_t poolSizeX, size_t poolSizeY,
@@ -0,0 +1,212 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XDepthwiseConvolution.hpp"
+#include "XDataEncodingTools.hpp"
+#include "XParallel.hpp"
+#include "XVectorize.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace ANNT {
+
+XDepthwiseConvolution::XDepthwiseConvolution( ) :
+    XDepthwiseConvolution( 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0 )
+{
+}
+
+XDepthwiseConvolution::XDepthwiseConvolution( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                                              size_t kernelWidth, size_t kernelHeight, size_t multiplier,
+                                              size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                                              size_t outputWidth, size_t outputHeight ) :
+    mInputWidth( inputWidth ), mInputHeight( inputHeight ), mInputDepth( inputDepth ),
+    mKernelWidth( kernelWidth ), mKernelHeight( kernelHeight ), mMultiplier( multiplier ),
+    mPadLeft( padLeft ), mPadTop( padTop ), mHorizontalStep( horizontalStep ), mVerticalStep( verticalStep ),
+    mOutputWidth( outputWidth ), mOutputHeight( outputHeight ),
+    mColumnStart( kernelWidth ), mColumnEnd( kernelWidth ), mRowStart( kernelHeight ), mRowEnd( kernelHeight )
+{
+    for ( size_t kx = 0; kx < mKernelWidth; kx++ )
+    {
+        XDataEncodingTools::ValidOutputRange( mInputWidth, mOutputWidth, kx, mPadLeft, mHorizontalStep,
+                                              mColumnStart[kx], mColumnEnd[kx] );
+    }
+    for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+    {
+        XDataEncodingTools::ValidOutputRange( mInputHeight, mOutputHeight, ky, mPadTop, mVerticalStep,
+                                              mRowStart[ky], mRowEnd[ky] );
+    }
+}
+
+// Calculates outputs for the given input
+void XDepthwiseConvolution::Forward( const float_t* input, const float_t* kernels, const float_t* biases,
+                                     float_t* output, bool parallel ) const
+{
+    size_t inputSize  = mInputWidth  * mInputHeight;
+    size_t outputSize = mOutputWidth * mOutputHeight;
+    size_t kernelSize = mKernelWidth * mKernelHeight;
+
+    XParallel::For( mInputDepth * mMultiplier, parallel, [&]( size_t kernelIndex )
+    {
+        const float_t* inputBase  = input   + ( kernelIndex / mMultiplier ) * inputSize;
+        const float_t* kernel     = kernels + kernelIndex * kernelSize;
+        float_t*       outputBase = output  + kernelIndex * outputSize;
+
+        fill( outputBase, outputBase + outputSize, ( biases != nullptr ) ? biases[kernelIndex] : float_t( 0 ) );
+
+        for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+        {
+            for ( size_t oy = mRowStart[ky]; oy < mRowEnd[ky]; oy++ )
+            {
+                const float_t* inputRow  = inputBase + ( oy * mVerticalStep + ky - mPadTop ) * mInputWidth;
+                float_t*       outputRow = outputBase + oy * mOutputWidth;
+
+                for ( size_t kx = 0; kx < mKernelWidth; kx++ )
+                {
+                    size_t         start    = mColumnStart[kx];
+                    size_t         count    = mColumnEnd[kx] - start;
+                    float_t        weight   = kernel[ky * mKernelWidth + kx];
+                    const float_t* inputPtr = inputRow + start * mHorizontalStep + kx - mPadLeft;
+                    float_t*       outPtr   = outputRow + start;
+
+                    if ( mHorizontalStep == 1 )
+                    {
+                        for ( size_t i = 0; i < count; i++ )
+                        {
+                            outPtr[i] += weight * inputPtr[i];
+                        }
+                    }
+                    else
+                    {
+                        for ( size_t i = 0; i < count; i++ )
+                        {
+                            outPtr[i] += weight * inputPtr[i * mHorizontalStep];
+                        }
+                    }
+                }
+            }
+        }
+    } );
+}
+
+// Propagates error from outputs to inputs - every input map collects error from the outputs it produced
+void XDepthwiseConvolution::Backward( const float_t* deltas, const float_t* kernels,
+                                      float_t* prevDeltas, bool parallel ) const
+{
+    size_t inputSize  = mInputWidth  * mInputHeight;
+    size_t outputSize = mOutputWidth * mOutputHeight;
+    size_t kernelSize = mKernelWidth * mKernelHeight;
+
+    XParallel::For( mInputDepth, parallel, [&]( size_t inputDepthIndex )
+    {
+        float_t* prevDeltaBase = prevDeltas + inputDepthIndex * inputSize;
+
+        fill( prevDeltaBase, prevDeltaBase + inputSize, float_t( 0 ) );
+
+        for ( size_t kernelIndex = inputDepthIndex * mMultiplier; kernelIndex < ( inputDepthIndex + 1 ) * mMultiplier; kernelIndex++ )
+        {
+            const float_t* deltaBase = deltas  + kernelIndex * outputSize;
+            const float_t* kernel    = kernels + kernelIndex * kernelSize;
+
+            for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+            {
+                for ( size_t oy = mRowStart[ky]; oy < mRowEnd[ky]; oy++ )
+                {
+                    const float_t* deltaRow     = deltaBase + oy * mOutputWidth;
+                    float_t*       prevDeltaRow = prevDeltaBase + ( oy * mVerticalStep + ky - mPadTop ) * mInputWidth;
+
+                    for ( size_t kx = 0; kx < mKernelWidth; kx++ )
+                    {
+                        size_t         start        = mColumnStart[kx];
+                        size_t         count        = mColumnEnd[kx] - start;
+                        float_t        weight       = kernel[ky * mKernelWidth + kx];
+                        const float_t* deltaPtr     = deltaRow + start;
+                        float_t*       prevDeltaPtr = prevDeltaRow + start * mHorizontalStep + kx - mPadLeft;
+
+                        if ( mHorizontalStep == 1 )
+                        {
+                            for ( size_t i = 0; i < count; i++ )
+                            {
+                                prevDeltaPtr[i] += weight * deltaPtr[i];
+                            }
+                        }
+                        else
+                        {
+                            for ( size_t i = 0; i < count; i++ )
+                            {
+                                prevDeltaPtr[i * mHorizontalStep] += weight * deltaPtr[i];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    } );
+}
+
+// Accumulates kernels' gradients - sum of output deltas multiplied by inputs they were calculated from
+void XDepthwiseConvolution::CalculateGradients( const float_t* input, const float_t* deltas,
+                                                float_t* gradKernels, bool parallel ) const
+{
+    size_t inputSize  = mInputWidth  * mInputHeight;
+    size_t outputSize = mOutputWidth * mOutputHeight;
+    size_t kernelSize = mKernelWidth * mKernelHeight;
+
+    XParallel::For( mInputDepth * mMultiplier, parallel, [&]( size_t kernelIndex )
+    {
+        const float_t* inputBase = input  + ( kernelIndex / mMultiplier ) * inputSize;
+        const float_t* deltaBase = deltas + kernelIndex * outputSize;
+        float_t*       gradPtr   = gradKernels + kernelIndex * kernelSize;
+
+        for ( size_t ky = 0; ky < mKernelHeight; ky++ )
+        {
+            for ( size_t kx = 0; kx < mKernelWidth; kx++ )
+            {
+                size_t  start = mColumnStart[kx];
+                size_t  count = mColumnEnd[kx] - start;
+                float_t sum   = float_t( 0 );
+
+                for ( size_t oy = mRowStart[ky]; oy < mRowEnd[ky]; oy++ )
+                {
+                    const float_t* deltaPtr = deltaBase + oy * mOutputWidth + start;
+                    const float_t* inputPtr = inputBase + ( oy * mVerticalStep + ky - mPadTop ) * mInputWidth +
+                                              start * mHorizontalStep + kx - mPadLeft;
+
+                    if ( mHorizontalStep == 1 )
+                    {
+                        sum += XVectorize::Dot( deltaPtr, inputPtr, count );
+                    }
+                    else
+                    {
+                        for ( size_t i = 0; i < count; i++ )
+                        {
+                            sum += deltaPtr[i] * inputPtr[i * mHorizontalStep];
+                        }
+                    }
+                }
+
+                gradPtr[ky * mKernelWidth + kx] += sum;
+            }
+        }
+    } );
+}
+
+} // namespace ANNT
@@ -0,0 +1,79 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XDEPTHWISE_CONVOLUTION_HPP
+#define ANNT_XDEPTHWISE_CONVOLUTION_HPP
+
+#include "../Types/Types.hpp"
+
+namespace ANNT {
+
+// Implementation of depthwise convolution - each input map is convolved with its own set of "multiplier" kernels
+// (never mixing input maps), so that output map "k" is produced from input map "k / multiplier".
+//
+// Kernels are packed as ( inputDepth * multiplier ) x kernelHeight x kernelWidth array. Loops run along output
+// rows with the range of valid positions precomputed for every kernel offset, so there is no branching on borders
+// and the innermost loops are plain (vectorizable) multiply-add/dot-product over contiguous memory for unit steps.
+class XDepthwiseConvolution
+{
+private:
+    size_t    mInputWidth;
+    size_t    mInputHeight;
+    size_t    mInputDepth;
+    size_t    mKernelWidth;
+    size_t    mKernelHeight;
+    size_t    mMultiplier;
+    size_t    mPadLeft;
+    size_t    mPadTop;
+    size_t    mHorizontalStep;
+    size_t    mVerticalStep;
+    size_t    mOutputWidth;
+    size_t    mOutputHeight;
+
+    // ranges of output positions [start, end) valid for each kernel column/row
+    uvector_t mColumnStart;
+    uvector_t mColumnEnd;
+    uvector_t mRowStart;
+    uvector_t mRowEnd;
+
+public:
+    XDepthwiseConvolution( );
+    XDepthwiseConvolution( size_t inputWidth, size_t inputHeight, size_t inputDepth,
+                           size_t kernelWidth, size_t kernelHeight, size_t multiplier,
+                           size_t padLeft, size_t padTop, size_t horizontalStep, size_t verticalStep,
+                           size_t outputWidth, size_t outputHeight );
+
+    // Calculates outputs for the given input. Biases are optional (may be null).
+    void Forward( const float_t* input, const float_t* kernels, const float_t* biases,
+                  float_t* output, bool parallel ) const;
+
+    // Propagates error from outputs to inputs (previous deltas are overwritten)
+    void Backward( const float_t* deltas, const float_t* kernels,
+                   float_t* prevDeltas, bool parallel ) const;
+
+    // Accumulates kernels' gradients for the given input and output deltas
+    void CalculateGradients( const float_t* input, const float_t* deltas,
+                             float_t* gradKernels, bool parallel ) const;
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XDEPTHWISE_CONVOLUTION_HPP
@@ -0,0 +1,356 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XFft.hpp"
+#include <assert.h>
+
+using namespace std;
+
+namespace ANNT {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Multiplication of complex numbers without the special NaN/infinity handling std::complex does
+inline fcomplex_t Mul( const fcomplex_t& a, const fcomplex_t& b )
+{
+    return fcomplex_t( a.real( ) * b.real( ) - a.imag( ) * b.imag( ),
+                       a.real( ) * b.imag( ) + a.imag( ) * b.real( ) );
+}
+
+// Multiplies by imaginary unit
+inline fcomplex_t MulI( const fcomplex_t& a )
+{
+    return fcomplex_t( -a.imag( ), a.real( ) );
+}
+
+// Checks if the number has no prime factors other than 2, 3 and 5
+bool IsGoodSize( size_t size )
+{
+    static const size_t factors[] = { 2, 3, 5 };
+
+    for ( size_t factor : factors )
+    {
+        while ( ( size % factor ) == 0 )
+        {
+            size /= factor;
+        }
+    }
+
+    return ( size == 1 );
+}
+
+} // anonymous namespace
+
+XFft::XFft( size_t size ) :
+    mSize( size ), mTwiddles( size )
+{
+    assert( IsGoodSize( size ) );
+
+    // factorize the size - prefer radix 4 passes, since they are cheaper than two radix 2 passes
+    static const size_t factors[] = { 4, 2, 3, 5 };
+
+    for ( size_t factor : factors )
+    {
+        while ( ( size % factor ) == 0 )
+        {
+            mFactors.push_back( factor );
+            size /= factor;
+        }
+    }
+
+    for ( size_t i = 0; i < mSize; i++ )
+    {
+        double angle = -2.0 * PI * static_cast<double>( i ) / static_cast<double>( mSize );
+
+        mTwiddles[i] = fcomplex_t( static_cast<float_t>( cos( angle ) ), static_cast<float_t>( sin( angle ) ) );
+    }
+}
+
+// Finds the smallest size not less than the specified one, which can be transformed
+size_t XFft::GoodSize( size_t size )
+{
+    size = max( size, size_t( 1 ) );
+
+    while ( !IsGoodSize( size ) )
+    {
+        size++;
+    }
+
+    return size;
+}
+
+// Does forward or inverse transform - the sequence is split into "factor" interleaved subsequences on each pass,
+// which are transformed by radix-"factor" butterfly and multiplied by twiddle factors. The Stockham algorithm
+// ping-pongs data between the two buffers, so no bit reversal is needed.
+void XFft::Transform( fcomplex_t* data, fcomplex_t* scratch, bool inverse ) const
+{
+    fcomplex_t* src    = data;
+    fcomplex_t* dst    = scratch;
+    size_t      n      = mSize;
+    size_t      stride = 1;
+    // sine of 60 degrees for radix 3 butterfly, sign depends on direction
+    float_t     sin60  = static_cast<float_t>( ( inverse ) ? sin( PI / 3 ) : -sin( PI / 3 ) );
+
+    for ( size_t factor : mFactors )
+    {
+        size_t     m       = n / factor;
+        size_t     twStep  = mSize / n;
+        fcomplex_t twiddles[5];
+
+        for ( size_t q = 0; q < m; q++ )
+        {
+            for ( size_t k = 1; k < factor; k++ )
+            {
+                twiddles[k] = mTwiddles[q * k * twStep];
+
+                if ( inverse )
+                {
+                    twiddles[k] = conj( twiddles[k] );
+                }
+            }
+
+            for ( size_t r = 0; r < stride; r++ )
+            {
+                // inputs of the butterfly are "m * stride" apart, outputs are "stride" apart
+                const fcomplex_t* a     = src + r + stride * q;
+                fcomplex_t*       y     = dst + r + stride * factor * q;
+                size_t            aStep = stride * m;
+
+                if ( factor == 4 )
+                {
+                    fcomplex_t t0 = a[0] + a[2 * aStep];
+                    fcomplex_t t1 = a[0] - a[2 * aStep];
+                    fcomplex_t t2 = a[aStep] + a[3 * aStep];
+                    fcomplex_t t3 = MulI( a[aStep] - a[3 * aStep] );
+
+                    if ( !inverse )
+                    {
+                        t3 = -t3;
+                    }
+
+                    y[0]          = t0 + t2;
+                    y[stride]     = Mul( t1 + t3, twiddles[1] );
+                    y[2 * stride] = Mul( t0 - t2, twiddles[2] );
+                    y[3 * stride] = Mul( t1 - t3, twiddles[3] );
+                }
+                else if ( factor == 2 )
+                {
+                    fcomplex_t a0 = a[0];
+                    fcomplex_t a1 = a[aStep];
+
+                    y[0]      = a0 + a1;
+                    y[stride] = Mul( a0 - a1, twiddles[1] );
+                }
+                else if ( factor == 3 )
+                {
+                    fcomplex_t sum  = a[aStep] + a[2 * aStep];
+                    fcomplex_t t    = a[0] - float_t( 0.5 ) * sum;
+                    fcomplex_t u    = MulI( a[aStep] - a[2 * aStep] ) * sin60;
+
+                    y[0]          = a[0] + sum;
+                    y[stride]     = Mul( t + u, twiddles[1] );
+                    y[2 * stride] = Mul( t - u, twiddles[2] );
+                }
+                else
+                {
+                    // generic DFT for the rest (radix 5)
+                    size_t rootStep = mSize / factor;
+
+                    for ( size_t k = 0; k < factor; k++ )
+                    {
+                        fcomplex_t sum = a[0];
+
+                        for ( size_t j = 1; j < factor; j++ )
+                        {
+                            fcomplex_t root = mTwiddles[( ( j * k ) % factor ) * rootStep];
+
+                            sum += Mul( a[j * aStep], ( inverse ) ? conj( root ) : root );
+                        }
+
+                        y[k * stride] = ( k == 0 ) ? sum : Mul( sum, twiddles[k] );
+                    }
+                }
+            }
+        }
+
+        n       = m;
+        stride *= factor;
+        swap( src, dst );
+    }
+
+    if ( src != data )
+    {
+        copy( src, src + mSize, data );
+    }
+}
+
+XRealFft2d::XRealFft2d( size_t height, size_t width ) :
+    mHeight( height ), mWidth( width ),
+    mRowFft( width / 2 ), mColumnFft( height ),
+    mRowTwiddles( width / 2 + 1 )
+{
+    assert( ( width & 1 ) == 0 );
+
+    for ( size_t i = 0; i <= width / 2; i++ )
+    {
+        double angle = -2.0 * PI * static_cast<double>( i ) / static_cast<double>( width );
+
+        mRowTwiddles[i] = fcomplex_t( static_cast<float_t>( cos( angle ) ), static_cast<float_t>( sin( angle ) ) );
+    }
+}
+
+// Finds the smallest width not less than the specified one, which can be transformed
+size_t XRealFft2d::GoodWidth( size_t width )
+{
+    width = XFft::GoodSize( width );
+
+    while ( ( width & 1 ) != 0 )
+    {
+        width = XFft::GoodSize( width + 1 );
+    }
+
+    return width;
+}
+
+// Calculates half spectrum of the real data - rows are transformed first (packing pairs of real values
+// into complex numbers and then separating spectra of even/odd elements), then columns
+void XRealFft2d::Forward( const float_t* src, fcomplex_t* dst, fcomplex_t* scratch ) const
+{
+    size_t halfWidth     = mWidth / 2;
+    size_t spectrumWidth = halfWidth + 1;
+
+    for ( size_t y = 0; y < mHeight; y++ )
+    {
+        const float_t* srcRow = src + y * mWidth;
+        fcomplex_t*    row    = dst + y * spectrumWidth;
+
+        for ( size_t x = 0; x < halfWidth; x++ )
+        {
+            row[x] = fcomplex_t( srcRow[2 * x], srcRow[2 * x + 1] );
+        }
+
+        mRowFft.Forward( row, scratch );
+
+        fcomplex_t z0 = row[0];
+
+        row[0]         = fcomplex_t( z0.real( ) + z0.imag( ), 0 );
+        row[halfWidth] = fcomplex_t( z0.real( ) - z0.imag( ), 0 );
+
+        for ( size_t k = 1, n = halfWidth / 2; k <= n; k++ )
+        {
+            // spectra of even (fe) and odd (fo) elements
+            fcomplex_t zk = row[k];
+            fcomplex_t zn = conj( row[halfWidth - k] );
+            fcomplex_t fe = ( zk + zn ) * float_t( 0.5 );
+            fcomplex_t fo = MulI( zn - zk ) * float_t( 0.5 );
+
+            row[k] = fe + Mul( fo, mRowTwiddles[k] );
+
+            if ( k != halfWidth - k )
+            {
+                row[halfWidth - k] = conj( fe ) + Mul( conj( fo ), mRowTwiddles[halfWidth - k] );
+            }
+        }
+    }
+
+    fcomplex_t* column        = scratch;
+    fcomplex_t* columnScratch = scratch + mHeight;
+
+    for ( size_t x = 0; x < spectrumWidth; x++ )
+    {
+        for ( size_t y = 0; y < mHeight; y++ )
+        {
+            column[y] = dst[y * spectrumWidth + x];
+        }
+
+        mColumnFft.Forward( column, columnScratch );
+
+        for ( size_t y = 0; y < mHeight; y++ )
+        {
+            dst[y * spectrumWidth + x] = column[y];
+        }
+    }
+}
+
+// Restores real data from its half spectrum - reverse of the forward transform
+void XRealFft2d::Inverse( fcomplex_t* src, float_t* dst, fcomplex_t* scratch ) const
+{
+    size_t      halfWidth     = mWidth / 2;
+    size_t      spectrumWidth = halfWidth + 1;
+    float_t     scale         = float_t( 1 ) / static_cast<float_t>( mWidth * mHeight );
+    fcomplex_t* column        = scratch;
+    fcomplex_t* columnScratch = scratch + mHeight;
+
+    for ( size_t x = 0; x < spectrumWidth; x++ )
+    {
+        for ( size_t y = 0; y < mHeight; y++ )
+        {
+            column[y] = src[y * spectrumWidth + x];
+        }
+
+        mColumnFft.Inverse( column, columnScratch );
+
+        for ( size_t y = 0; y < mHeight; y++ )
+        {
+            src[y * spectrumWidth + x] = column[y];
+        }
+    }
+
+    for ( size_t y = 0; y < mHeight; y++ )
+    {
+        fcomplex_t* row    = src + y * spectrumWidth;
+        float_t*    dstRow = dst + y * mWidth;
+
+        // combine spectra of even/odd elements back into spectrum of the packed complex sequence
+        fcomplex_t x0 = row[0];
+        fcomplex_t xh = conj( row[halfWidth] );
+
+        row[0] = ( x0 + xh ) + MulI( x0 - xh );
+
+        for ( size_t k = 1, n = halfWidth / 2; k <= n; k++ )
+        {
+            fcomplex_t xk = row[k];
+            fcomplex_t xn = conj( row[halfWidth - k] );
+            fcomplex_t fe = xk + xn;
+            fcomplex_t fo = Mul( xk - xn, conj( mRowTwiddles[k] ) );
+
+            row[k] = fe + MulI( fo );
+
+            if ( k != halfWidth - k )
+            {
+                fo = Mul( conj( xn - xk ), conj( mRowTwiddles[halfWidth - k] ) );
+
+                row[halfWidth - k] = conj( fe ) + MulI( fo );
+            }
+        }
+
+        mRowFft.Inverse( row, scratch );
+
+        for ( size_t x = 0; x < halfWidth; x++ )
+        {
+            dstRow[2 * x]     = row[x].real( ) * scale;
+            dstRow[2 * x + 1] = row[x].imag( ) * scale;
+        }
+    }
+}
+
+} // namespace ANNT
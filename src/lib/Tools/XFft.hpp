@@ -0,0 +1,115 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XFFT_HPP
+#define ANNT_XFFT_HPP
+
+#include <algorithm>
+#include <complex>
+#include "../Types/Types.hpp"
+
+namespace ANNT {
+
+// Complex number type and vector of those used for frequency domain computations
+typedef std::complex<float_t> fcomplex_t;
+typedef std::vector<fcomplex_t, XAlignedAllocator<fcomplex_t, 32>> cvector_t;
+
+// Mixed radix complex Fast Fourier Transform. Size of the transform must have only 2, 3 and 5 as its prime
+// factors (use GoodSize() to find the nearest suitable size). Transform is done in place by the self-sorting
+// Stockham algorithm using radix 4, 2, 3 and 5 passes.
+class XFft
+{
+private:
+    size_t    mSize;
+    uvector_t mFactors;
+    cvector_t mTwiddles;    // exp( -2 * pi * i * k / size )
+
+public:
+    XFft( ) : mSize( 0 ) { }
+    XFft( size_t size );
+
+    // Size of the transform
+    size_t Size( ) const { return mSize; }
+
+    // Finds the smallest size not less than the specified one, which can be transformed
+    static size_t GoodSize( size_t size );
+
+    // Forward transform. Scratch buffer must have room for Size() elements.
+    void Forward( fcomplex_t* data, fcomplex_t* scratch ) const
+    {
+        Transform( data, scratch, false );
+    }
+
+    // Inverse transform - the result is not normalized (scaled by Size() compared to the original)
+    void Inverse( fcomplex_t* data, fcomplex_t* scratch ) const
+    {
+        Transform( data, scratch, true );
+    }
+
+private:
+    void Transform( fcomplex_t* data, fcomplex_t* scratch, bool inverse ) const;
+};
+
+// 2D Fast Fourier Transform of real data. Real input of height x width size is transformed into its half spectrum
+// of height x ( width / 2 + 1 ) complex values (the rest is redundant due to conjugate symmetry). Width must be even.
+class XRealFft2d
+{
+private:
+    size_t    mHeight;
+    size_t    mWidth;
+    XFft      mRowFft;      // half size complex FFT for rows - two real values are packed into one complex
+    XFft      mColumnFft;
+    cvector_t mRowTwiddles; // exp( -2 * pi * i * k / width )
+
+public:
+    XRealFft2d( ) : mHeight( 0 ), mWidth( 0 ) { }
+    XRealFft2d( size_t height, size_t width );
+
+    // Size of the transformed real data
+    size_t Height( ) const { return mHeight; }
+    size_t Width( )  const { return mWidth; }
+
+    // Finds the smallest width not less than the specified one, which can be transformed (must be even)
+    static size_t GoodWidth( size_t width );
+
+    // Number of complex values in spectrum
+    size_t SpectrumSize( ) const
+    {
+        return mHeight * ( mWidth / 2 + 1 );
+    }
+
+    // Number of complex values required for scratch buffer
+    size_t ScratchSize( ) const
+    {
+        return 2 * std::max( mHeight, mWidth / 2 + 1 );
+    }
+
+    // Calculates half spectrum of the real data
+    void Forward( const float_t* src, fcomplex_t* dst, fcomplex_t* scratch ) const;
+
+    // Restores real data from its half spectrum (normalized, so Inverse(Forward(x)) == x). Spectrum is used
+    // as working memory, so its content is destroyed.
+    void Inverse( fcomplex_t* src, float_t* dst, fcomplex_t* scratch ) const;
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XFFT_HPP
@@ -0,0 +1,52 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XAvxGemmKernel.hpp"
+
+namespace ANNT {
+
+namespace {
+
+// Fused multiply-add
+struct FmaMAdd
+{
+    static inline __m256 Do( __m256 a, __m256 b, __m256 c )
+    {
+        return _mm256_fmadd_ps( a, b, c );
+    }
+    static inline __m256d Do( __m256d a, __m256d b, __m256d c )
+    {
+        return _mm256_fmadd_pd( a, b, c );
+    }
+};
+
+} // namespace <anonymous>
+
+// AVX + FMA implementation of GEMM micro kernels
+void FmaGemmKernel( size_t kc, const float* a, const float* b, float* const* c )
+{
+    AvxGemmMicroKernel<float, FmaMAdd>( kc, a, b, c );
+}
+void FmaGemmKernel( size_t kc, const double* a, const double* b, double* const* c )
+{
+    AvxGemmMicroKernel<double, FmaMAdd>( kc, a, b, c );
+}
+
+} // namespace ANNT
@@ -0,0 +1,497 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "XGemm.hpp"
+#include "XGemmKernels.hpp"
+#include "XCpu.hpp"
+#include "XParallel.hpp"
+#include "XVectorize.hpp"
+#include "../Types/XAlignedAllocator.hpp"
+#include "../Config.hpp"
+
+using namespace std;
+
+namespace ANNT {
+
+namespace {
+
+// Blocking parameters: KC is the depth of packed panels (panel of B should stay in L1 cache),
+// MC is the number of A rows processed by single task (block of A should stay in L2 cache),
+// NC is the number of B columns packed at once and NG is the number of those processed by single task.
+static const size_t GEMM_KC = 256;
+static const size_t GEMM_MC = 120;
+static const size_t GEMM_NC = 2048;
+static const size_t GEMM_NG = 128;
+
+// Don't bother spreading work between cores for matrices smaller than this (M * N * K)
+static const size_t GEMM_PARALLEL_THRESHOLD = 32 * 32 * 32;
+
+// Generic implementation of micro kernel for CPUs without supported SIMD extensions
+template <typename T> void DefaultGemmKernel( size_t kc, const T* a, const T* b, T* const* c )
+{
+    const size_t rows = XGemmTile<T>::Rows;
+    const size_t cols = XGemmTile<T>::Cols;
+
+    T acc[rows][cols] = { };
+
+    for ( size_t p = 0; p < kc; p++, a += rows, b += cols )
+    {
+        for ( size_t i = 0; i < rows; i++ )
+        {
+            for ( size_t j = 0; j < cols; j++ )
+            {
+                acc[i][j] += a[i] * b[j];
+            }
+        }
+    }
+
+    for ( size_t i = 0; i < rows; i++ )
+    {
+        for ( size_t j = 0; j < cols; j++ )
+        {
+            c[i][j] += acc[i][j];
+        }
+    }
+}
+
+// Blocked matrix multiplication running micro kernel on packed panels
+template <typename T> class GemmEngine
+{
+    typedef vector<T, XAlignedAllocator<T, 32>> buffer_t;
+    typedef void ( *Kernel )( size_t kc, const T* a, const T* b, T* const* c );
+    typedef function<void( T*, size_t )> Epilogue;
+
+    static const size_t MR = XGemmTile<T>::Rows;
+    static const size_t NR = XGemmTile<T>::Cols;
+
+public:
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          T alpha, const T* const* a, const T* const* b,
+                          T beta, T* const* c, const Epilogue& epilogue, bool parallel )
+    {
+        if ( ( m == 0 ) || ( n == 0 ) )
+        {
+            return;
+        }
+
+        // C = beta * C
+        if ( beta != T( 1 ) )
+        {
+            for ( size_t i = 0; i < m; i++ )
+            {
+                T* row = c[i];
+
+                if ( beta == T( 0 ) )
+                {
+                    std::fill( row, row + n, T( 0 ) );
+                }
+                else
+                {
+                    for ( size_t j = 0; j < n; j++ )
+                    {
+                        row[j] *= beta;
+                    }
+                }
+            }
+        }
+
+        if ( ( k == 0 ) || ( alpha == T( 0 ) ) )
+        {
+            if ( epilogue )
+            {
+                for ( size_t i = 0; i < m; i++ )
+                {
+                    epilogue( c[i], n );
+                }
+            }
+            return;
+        }
+
+        parallel = ( parallel ) && ( m * n * k >= GEMM_PARALLEL_THRESHOLD );
+
+        if ( m == 1 )
+        {
+            MultiplyRow( transA, transB, n, k, alpha, a, b, c[0], parallel );
+
+            if ( epilogue )
+            {
+                epilogue( c[0], n );
+            }
+        }
+        else
+        {
+            MultiplyBlocked( transA, transB, m, n, k, alpha, a, b, c, epilogue, parallel );
+        }
+    }
+
+    // Kernel to use for the current CPU
+    static Kernel mKernel;
+
+private:
+    // Packing/blocking does not pay off when A is a single row - do it as a series of dot products or AXPYs
+    static void MultiplyRow( bool transA, bool transB, size_t n, size_t k,
+                             T alpha, const T* const* a, const T* const* b, T* c, bool parallel )
+    {
+        buffer_t aRow( k );
+
+        for ( size_t p = 0; p < k; p++ )
+        {
+            aRow[p] = alpha * ( ( transA ) ? a[p][0] : a[0][p] );
+        }
+
+        if ( transB )
+        {
+            // B rows are columns of op( B ), so each output is a dot product
+            XParallel::For( n, parallel, [&]( size_t j )
+            {
+                c[j] += XVectorize::Dot( aRow.data( ), b[j], k );
+            } );
+        }
+        else
+        {
+            // accumulate rows of B scaled by corresponding A value, splitting columns between tasks
+            size_t tasks = ( n + GEMM_NG - 1 ) / GEMM_NG;
+
+            XParallel::For( tasks, parallel, [&]( size_t task )
+            {
+                size_t start = task * GEMM_NG;
+                size_t end   = std::min( start + GEMM_NG, n );
+
+                for ( size_t p = 0; p < k; p++ )
+                {
+                    const T* bRow   = b[p];
+                    T        aValue = aRow[p];
+
+                    for ( size_t j = start; j < end; j++ )
+                    {
+                        c[j] += aValue * bRow[j];
+                    }
+                }
+            } );
+        }
+    }
+
+    // Packs MR rows of op( A ) starting from the given row/column - value of each column are put next to each other
+    static void PackA( bool transA, const T* const* a, size_t row, size_t rows, size_t col, size_t kc, T alpha, T* dst )
+    {
+        if ( rows != MR )
+        {
+            std::fill( dst, dst + MR * kc, T( 0 ) );
+        }
+
+        if ( transA )
+        {
+            for ( size_t p = 0; p < kc; p++, dst += MR )
+            {
+                const T* src = a[col + p] + row;
+
+                for ( size_t i = 0; i < rows; i++ )
+                {
+                    dst[i] = alpha * src[i];
+                }
+            }
+        }
+        else
+        {
+            for ( size_t i = 0; i < rows; i++ )
+            {
+                const T* src = a[row + i] + col;
+
+                for ( size_t p = 0; p < kc; p++ )
+                {
+                    dst[p * MR + i] = alpha * src[p];
+                }
+            }
+        }
+    }
+
+    // Packs NR columns of op( B ) starting from the given row/column - values of each row are put next to each other
+    static void PackB( bool transB, const T* const* b, size_t row, size_t kc, size_t col, size_t cols, T* dst )
+    {
+        if ( cols != NR )
+        {
+            std::fill( dst, dst + NR * kc, T( 0 ) );
+        }
+
+        if ( transB )
+        {
+            for ( size_t j = 0; j < cols; j++ )
+            {
+                const T* src = b[col + j] + row;
+
+                for ( size_t p = 0; p < kc; p++ )
+                {
+                    dst[p * NR + j] = src[p];
+                }
+            }
+        }
+        else
+        {
+            for ( size_t p = 0; p < kc; p++, dst += NR )
+            {
+                const T* src = b[row + p] + col;
+
+                for ( size_t j = 0; j < cols; j++ )
+                {
+                    dst[j] = src[j];
+                }
+            }
+        }
+    }
+
+    // Runs micro kernel for the specified block of packed A and range of packed B panels
+    static void MacroKernel( size_t kc, const T* packedA, size_t panelsA, size_t rowsA,
+                             const T* packedB, size_t panelsB, size_t colsB,
+                             T* const* c, size_t col )
+    {
+        T*  tileRows[MR];
+        T*  cRows[MR];
+        T   tile[MR * NR];
+
+        for ( size_t i = 0; i < MR; i++ )
+        {
+            tileRows[i] = tile + i * NR;
+        }
+
+        for ( size_t jp = 0; jp < panelsB; jp++ )
+        {
+            const T* panelB = packedB + jp * NR * kc;
+            size_t   cols   = std::min( NR, colsB - jp * NR );
+
+            for ( size_t ip = 0; ip < panelsA; ip++ )
+            {
+                const T* panelA = packedA + ip * MR * kc;
+                size_t   rows   = std::min( MR, rowsA - ip * MR );
+
+                if ( ( rows == MR ) && ( cols == NR ) )
+                {
+                    for ( size_t i = 0; i < MR; i++ )
+                    {
+                        cRows[i] = c[ip * MR + i] + col + jp * NR;
+                    }
+
+                    mKernel( kc, panelA, panelB, cRows );
+                }
+                else
+                {
+                    // edge tiles are computed into temporary buffer first
+                    std::fill( tile, tile + MR * NR, T( 0 ) );
+
+                    mKernel( kc, panelA, panelB, tileRows );
+
+                    for ( size_t i = 0; i < rows; i++ )
+                    {
+                        T* cRow = c[ip * MR + i] + col + jp * NR;
+
+                        for ( size_t j = 0; j < cols; j++ )
+                        {
+                            cRow[j] += tile[i * NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Multiplies matrices block by block, packing panels of A and B first. Epilogue is applied to blocks of C
+    // once the last panel is multiplied, while the block is still in cache.
+    static void MultiplyBlocked( bool transA, bool transB, size_t m, size_t n, size_t k,
+                                 T alpha, const T* const* a, const T* const* b, T* const* c,
+                                 const Epilogue& epilogue, bool parallel )
+    {
+        // number of A rows to pack at once - give a block to each core if running in parallel
+        size_t   mChunk  = ( parallel ) ? GEMM_MC * std::max<size_t>( 1, XCpu::CoresCount( ) ) : GEMM_MC;
+        size_t   kcMax   = std::min( k, GEMM_KC );
+        size_t   mcMax   = std::min( m, mChunk );
+        size_t   ncMax   = std::min( n, GEMM_NC );
+        buffer_t packedA( ( mcMax + MR - 1 ) / MR * MR * kcMax );
+        buffer_t packedB( ( ncMax + NR - 1 ) / NR * NR * kcMax );
+
+        for ( size_t jc = 0; jc < n; jc += GEMM_NC )
+        {
+            size_t nc      = std::min( GEMM_NC, n - jc );
+            size_t panelsB = ( nc + NR - 1 ) / NR;
+
+            for ( size_t pc = 0; pc < k; pc += GEMM_KC )
+            {
+                size_t kc = std::min( GEMM_KC, k - pc );
+
+                XParallel::For( panelsB, parallel, [&]( size_t panel )
+                {
+                    PackB( transB, b, pc, kc, jc + panel * NR, std::min( NR, nc - panel * NR ), &packedB[panel * NR * kc] );
+                } );
+
+                for ( size_t ic = 0; ic < m; ic += mChunk )
+                {
+                    size_t mc      = std::min( mChunk, m - ic );
+                    size_t panelsA = ( mc + MR - 1 ) / MR;
+
+                    XParallel::For( panelsA, parallel, [&]( size_t panel )
+                    {
+                        PackA( transA, a, ic + panel * MR, std::min( MR, mc - panel * MR ), pc, kc, alpha, &packedA[panel * MR * kc] );
+                    } );
+
+                    // split the work into tasks - each processing a block of A rows and a group of B columns
+                    size_t blocksA = ( mc + GEMM_MC - 1 ) / GEMM_MC;
+                    size_t groupsB = ( nc + GEMM_NG - 1 ) / GEMM_NG;
+
+                    XParallel::For( blocksA * groupsB, parallel, [&]( size_t task )
+                    {
+                        size_t blockA = task % blocksA;
+                        size_t groupB = task / blocksA;
+                        size_t rowsA  = std::min( GEMM_MC, mc - blockA * GEMM_MC );
+                        size_t colsB  = std::min( GEMM_NG, nc - groupB * GEMM_NG );
+
+                        MacroKernel( kc, &packedA[blockA * GEMM_MC * kc], ( rowsA + MR - 1 ) / MR, rowsA,
+                                     &packedB[groupB * GEMM_NG * kc], ( colsB + NR - 1 ) / NR, colsB,
+                                     c + ic + blockA * GEMM_MC, jc + groupB * GEMM_NG );
+
+                        if ( ( epilogue ) && ( pc + kc == k ) )
+                        {
+                            for ( size_t i = 0; i < rowsA; i++ )
+                            {
+                                epilogue( c[ic + blockA * GEMM_MC + i] + jc + groupB * GEMM_NG, colsB );
+                            }
+                        }
+                    } );
+                }
+            }
+        }
+    }
+};
+
+// Tile sizes are passed by reference to std::min(), so need definitions when not inlined
+template <typename T> const size_t GemmEngine<T>::MR;
+template <typename T> const size_t GemmEngine<T>::NR;
+
+// Selects the best micro kernel available on the current CPU
+template <typename T> void ( *GetAvailableGemmKernel( ) )( size_t, const T*, const T*, T* const* )
+{
+    void ( *kernel )( size_t, const T*, const T*, T* const* ) = DefaultGemmKernel<T>;
+
+#ifdef ANNT_USE_AVX
+    if ( XCpu::IsAvxSupported( ) )
+    {
+        kernel = AvxGemmKernel;
+
+        if ( XCpu::IsFeatureSupported( XCpu::Reg_ECX, XCpu::Flag_FMA ) )
+        {
+            kernel = FmaGemmKernel;
+        }
+    }
+#endif
+
+    return kernel;
+}
+
+template <typename T> typename GemmEngine<T>::Kernel GemmEngine<T>::mKernel = GetAvailableGemmKernel<T>( );
+
+// Builds array of row pointers for a matrix kept in contiguous memory
+template <typename T> vector<T*> MakeRows( T* data, size_t rows, size_t stride )
+{
+    vector<T*> ptrs( rows );
+
+    for ( size_t i = 0; i < rows; i++ )
+    {
+        ptrs[i] = data + i * stride;
+    }
+
+    return ptrs;
+}
+
+} // namespace <anonymous>
+
+// Multiplies matrices provided as contiguous memory blocks with the specified row strides
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                      float beta, float* c, size_t ldc, bool parallel )
+{
+    vector<const float*> aRows = MakeRows( a, ( transA ) ? k : m, lda );
+    vector<const float*> bRows = MakeRows( b, ( transB ) ? n : k, ldb );
+    vector<float*>       cRows = MakeRows( c, m, ldc );
+
+    GemmEngine<float>::Multiply( transA, transB, m, n, k, alpha, aRows.data( ), bRows.data( ), beta, cRows.data( ), nullptr, parallel );
+}
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                      double beta, double* c, size_t ldc, bool parallel )
+{
+    vector<const double*> aRows = MakeRows( a, ( transA ) ? k : m, lda );
+    vector<const double*> bRows = MakeRows( b, ( transB ) ? n : k, ldb );
+    vector<double*>       cRows = MakeRows( c, m, ldc );
+
+    GemmEngine<double>::Multiply( transA, transB, m, n, k, alpha, aRows.data( ), bRows.data( ), beta, cRows.data( ), nullptr, parallel );
+}
+
+// Multiplies matrices provided as contiguous memory blocks and applies epilogue to the results
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                      float beta, float* c, size_t ldc, const function<void( float*, size_t )>& epilogue, bool parallel )
+{
+    vector<const float*> aRows = MakeRows( a, ( transA ) ? k : m, lda );
+    vector<const float*> bRows = MakeRows( b, ( transB ) ? n : k, ldb );
+    vector<float*>       cRows = MakeRows( c, m, ldc );
+
+    GemmEngine<float>::Multiply( transA, transB, m, n, k, alpha, aRows.data( ), bRows.data( ), beta, cRows.data( ), epilogue, parallel );
+}
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                      double beta, double* c, size_t ldc, const function<void( double*, size_t )>& epilogue, bool parallel )
+{
+    vector<const double*> aRows = MakeRows( a, ( transA ) ? k : m, lda );
+    vector<const double*> bRows = MakeRows( b, ( transB ) ? n : k, ldb );
+    vector<double*>       cRows = MakeRows( c, m, ldc );
+
+    GemmEngine<double>::Multiply( transA, transB, m, n, k, alpha, aRows.data( ), bRows.data( ), beta, cRows.data( ), epilogue, parallel );
+}
+
+// Multiplies matrices provided as arrays of row pointers
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      float alpha, const float* const* a, const float* const* b,
+                      float beta, float* const* c, bool parallel )
+{
+    GemmEngine<float>::Multiply( transA, transB, m, n, k, alpha, a, b, beta, c, nullptr, parallel );
+}
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      double alpha, const double* const* a, const double* const* b,
+                      double beta, double* const* c, bool parallel )
+{
+    GemmEngine<double>::Multiply( transA, transB, m, n, k, alpha, a, b, beta, c, nullptr, parallel );
+}
+
+// Multiplies matrices provided as arrays of row pointers and applies epilogue to the results
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      float alpha, const float* const* a, const float* const* b,
+                      float beta, float* const* c, const function<void( float*, size_t )>& epilogue, bool parallel )
+{
+    GemmEngine<float>::Multiply( transA, transB, m, n, k, alpha, a, b, beta, c, epilogue, parallel );
+}
+void XGemm::Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                      double alpha, const double* const* a, const double* const* b,
+                      double beta, double* const* c, const function<void( double*, size_t )>& epilogue, bool parallel )
+{
+    GemmEngine<double>::Multiply( transA, transB, m, n, k, alpha, a, b, beta, c, epilogue, parallel );
+}
+
+} // namespace ANNT
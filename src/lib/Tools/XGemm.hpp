@@ -0,0 +1,87 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XGEMM_HPP
+#define ANNT_XGEMM_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace ANNT {
+
+// General matrix multiplication: C = alpha * op( A ) * op( B ) + beta * C, where op( X ) is X or its transpose.
+//
+// All matrices are row-major. op( A ) is M x K, op( B ) is K x N and C is M x N. The implementation packs
+// panels of A and B into cache friendly blocks and runs register tiled SIMD micro kernels on them (the best
+// available on the current CPU), splitting the work between cores when the matrices are big enough.
+//
+// Matrices can be provided either as contiguous memory with leading dimension (row stride) or as arrays of
+// row pointers. The latter allows running single multiplication over a batch of separately allocated vectors.
+class XGemm
+{
+private:
+    XGemm( );
+
+public:
+    // Multiplies matrices provided as contiguous memory blocks with the specified row strides
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                          float beta, float* c, size_t ldc, bool parallel = true );
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                          double beta, double* c, size_t ldc, bool parallel = true );
+
+    // Multiplies matrices provided as contiguous memory blocks and calls epilogue for every block of C row's values
+    // once they are final (see below)
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                          float beta, float* c, size_t ldc, const std::function<void( float*, size_t )>& epilogue,
+                          bool parallel = true );
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                          double beta, double* c, size_t ldc, const std::function<void( double*, size_t )>& epilogue,
+                          bool parallel = true );
+
+    // Multiplies matrices provided as arrays of row pointers. Note: rows are as stored in memory, i.e.
+    // A has K rows when transA is set (M rows otherwise) and B has N rows when transB is set (K rows otherwise).
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          float alpha, const float* const* a, const float* const* b,
+                          float beta, float* const* c, bool parallel = true );
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          double alpha, const double* const* a, const double* const* b,
+                          double beta, double* const* c, bool parallel = true );
+
+    // Multiplies matrices provided as arrays of row pointers and calls epilogue for every block of C row's
+    // values once they are final, while still in cache - lets element wise functions be fused with multiplication.
+    // Note: epilogue may be called from different threads for different blocks.
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          float alpha, const float* const* a, const float* const* b,
+                          float beta, float* const* c, const std::function<void( float*, size_t )>& epilogue,
+                          bool parallel = true );
+    static void Multiply( bool transA, bool transB, size_t m, size_t n, size_t k,
+                          double alpha, const double* const* a, const double* const* b,
+                          double beta, double* const* c, const std::function<void( double*, size_t )>& epilogue,
+                          bool parallel = true );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XGEMM_HPP
@@ -0,0 +1,290 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <cstring>
+
+#include "XHalfWeights.hpp"
+#include "XHalfKernels.hpp"
+#include "XCpu.hpp"
+#include "../Config.hpp"
+
+using namespace std;
+
+namespace ANNT {
+
+namespace {
+
+typedef void    ( *NarrowKernel )( const float_t* values, uint16_t* narrowed, size_t count );
+typedef void    ( *WidenKernel  )( const uint16_t* values, float_t* widened, size_t count );
+typedef float_t ( *DotKernel    )( const uint16_t* values, const float_t* vector, size_t count );
+
+// Kernels used for weights of certain precision
+struct HalfKernels
+{
+    NarrowKernel Narrow;
+    WidenKernel  Widen;
+    DotKernel    Dot;
+};
+
+// Default implementations, which convert values one by one
+template <uint16_t ( *Narrow )( float )> static void DefaultFromFloat( const float_t* values, uint16_t* narrowed, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        narrowed[i] = Narrow( static_cast<float>( values[i] ) );
+    }
+}
+template <float ( *Widen )( uint16_t )> static void DefaultToFloat( const uint16_t* values, float_t* widened, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        widened[i] = static_cast<float_t>( Widen( values[i] ) );
+    }
+}
+template <float ( *Widen )( uint16_t )> static float_t DefaultDot( const uint16_t* values, const float_t* vector, size_t count )
+{
+    float_t sum = float_t( 0 );
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        sum += static_cast<float_t>( Widen( values[i] ) ) * vector[i];
+    }
+
+    return sum;
+}
+
+// Selects the best kernels available on the current CPU for weights of the specified precision
+static HalfKernels GetAvailableHalfKernels( WeightsPrecision precision )
+{
+    HalfKernels kernels;
+
+    if ( precision == WeightsPrecision::Half )
+    {
+        kernels.Narrow = DefaultFromFloat<XHalfWeights::FloatToHalf>;
+        kernels.Widen  = DefaultToFloat<XHalfWeights::HalfToFloat>;
+        kernels.Dot    = DefaultDot<XHalfWeights::HalfToFloat>;
+    }
+    else
+    {
+        kernels.Narrow = DefaultFromFloat<XHalfWeights::FloatToBFloat16>;
+        kernels.Widen  = DefaultToFloat<XHalfWeights::BFloat16ToFloat>;
+        kernels.Dot    = DefaultDot<XHalfWeights::BFloat16ToFloat>;
+    }
+
+    // SIMD kernels work with single precision only
+#if defined( ANNT_USE_AVX2 ) && !defined( ANNT_USE_DOUBLE )
+    if ( XCpu::IsAvx2FmaSupported( ) )
+    {
+        if ( precision == WeightsPrecision::BFloat16 )
+        {
+            kernels.Narrow = Avx2FloatToBFloat16;
+            kernels.Widen  = Avx2BFloat16ToFloat;
+            kernels.Dot    = Avx2BFloat16Dot;
+        }
+        else if ( XCpu::IsFeatureSupported( XCpu::Reg_ECX, XCpu::Flag_F16C ) )
+        {
+            kernels.Narrow = F16cFloatToHalf;
+            kernels.Widen  = F16cHalfToFloat;
+            kernels.Dot    = F16cHalfDot;
+        }
+    }
+#endif
+
+    return kernels;
+}
+
+static const HalfKernels HALF_KERNELS     = GetAvailableHalfKernels( WeightsPrecision::Half );
+static const HalfKernels BFLOAT16_KERNELS = GetAvailableHalfKernels( WeightsPrecision::BFloat16 );
+
+// Bits of float value
+static inline uint32_t FloatBits( float value )
+{
+    uint32_t bits;
+
+    memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+// Float value of the bits
+static inline float BitsFloat( uint32_t bits )
+{
+    float value;
+
+    memcpy( &value, &bits, sizeof( value ) );
+
+    return value;
+}
+
+} // namespace <anonymous>
+
+XHalfWeights::XHalfWeights( ) :
+    mPrecision( WeightsPrecision::Float )
+{
+}
+
+// Releases weights
+void XHalfWeights::Clear( )
+{
+    mPrecision = WeightsPrecision::Float;
+    mValues.clear( );
+    mValues.shrink_to_fit( );
+}
+
+// Converts the specified weights to half precision or bfloat16 (memory is reused when converting again)
+void XHalfWeights::Convert( const float_t* weights, size_t count, WeightsPrecision precision )
+{
+    if ( precision == WeightsPrecision::Float )
+    {
+        Clear( );
+    }
+    else
+    {
+        const HalfKernels& kernels = ( precision == WeightsPrecision::Half ) ? HALF_KERNELS : BFLOAT16_KERNELS;
+
+        mPrecision = precision;
+        mValues.resize( count );
+
+        kernels.Narrow( weights, mValues.data( ), count );
+    }
+}
+
+// Widens the specified number of weights starting from the given offset
+void XHalfWeights::ToFloat( size_t offset, size_t count, float_t* weights ) const
+{
+    const HalfKernels& kernels = ( mPrecision == WeightsPrecision::Half ) ? HALF_KERNELS : BFLOAT16_KERNELS;
+
+    kernels.Widen( mValues.data( ) + offset, weights, count );
+}
+
+// Calculates dot product of the vector and the specified number of weights starting from the given offset
+float_t XHalfWeights::Dot( size_t offset, const float_t* vector, size_t count ) const
+{
+    const HalfKernels& kernels = ( mPrecision == WeightsPrecision::Half ) ? HALF_KERNELS : BFLOAT16_KERNELS;
+
+    return kernels.Dot( mValues.data( ) + offset, vector, count );
+}
+
+// Saves weights as raw 16 bit values
+bool XHalfWeights::Save( FILE* file ) const
+{
+    return ( fwrite( mValues.data( ), sizeof( uint16_t ), mValues.size( ), file ) == mValues.size( ) );
+}
+
+// Loads the specified number of weights of the given precision
+bool XHalfWeights::Load( FILE* file, size_t count, WeightsPrecision precision )
+{
+    bool ret = ( precision != WeightsPrecision::Float );
+
+    Clear( );
+
+    if ( ret )
+    {
+        mValues.resize( count );
+
+        ret = ( fread( mValues.data( ), sizeof( uint16_t ), count, file ) == count );
+
+        if ( ret )
+        {
+            mPrecision = precision;
+        }
+        else
+        {
+            Clear( );
+        }
+    }
+
+    return ret;
+}
+
+// Converts float to half precision number, rounding to nearest even (values out of range become infinity)
+uint16_t XHalfWeights::FloatToHalf( float value )
+{
+    uint32_t bits    = FloatBits( value );
+    uint16_t sign    = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+    uint32_t absBits = bits & 0x7FFFFFFF;
+    uint16_t half;
+
+    if ( absBits >= 0x7F800000 )
+    {
+        // infinity or NaN (which is kept quiet)
+        half = ( absBits == 0x7F800000 ) ? 0x7C00 : 0x7E00;
+    }
+    else if ( absBits >= 0x477FF000 )
+    {
+        // rounds to above the largest half value (65504)
+        half = 0x7C00;
+    }
+    else if ( absBits < 0x38800000 )
+    {
+        // below the smallest normal half value (2^-14), so it is a multiple of the smallest subnormal one (2^-24)
+        half = static_cast<uint16_t>( nearbyint( BitsFloat( absBits ) * 16777216.0f ) );
+    }
+    else
+    {
+        // re-bias exponent and round away 13 bits of mantissa (ties to even)
+        half = static_cast<uint16_t>( ( absBits - 0x38000000 + 0x0FFF + ( ( absBits >> 13 ) & 1 ) ) >> 13 );
+    }
+
+    return static_cast<uint16_t>( sign | half );
+}
+
+// Converts half precision number to float
+float XHalfWeights::HalfToFloat( uint16_t value )
+{
+    uint32_t sign     = static_cast<uint32_t>( value & 0x8000 ) << 16;
+    uint32_t exponent = ( value >> 10 ) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+    uint32_t bits;
+
+    if ( exponent == 0 )
+    {
+        // zero or subnormal value
+        bits = FloatBits( static_cast<float>( mantissa ) / 16777216.0f );
+    }
+    else if ( exponent == 0x1F )
+    {
+        bits = 0x7F800000 | ( mantissa << 13 );
+    }
+    else
+    {
+        bits = ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+    }
+
+    return BitsFloat( sign | bits );
+}
+
+// Converts float to bfloat16 number, rounding to nearest even
+uint16_t XHalfWeights::FloatToBFloat16( float value )
+{
+    uint32_t bits = FloatBits( value );
+
+    // NaN must not be rounded into infinity
+    return ( ( bits & 0x7FFFFFFF ) > 0x7F800000 ) ? static_cast<uint16_t>( ( bits >> 16 ) | 0x0040 ) :
+                                                    static_cast<uint16_t>( ( bits + 0x7FFF + ( ( bits >> 16 ) & 1 ) ) >> 16 );
+}
+
+// Converts bfloat16 number to float
+float XHalfWeights::BFloat16ToFloat( uint16_t value )
+{
+    return BitsFloat( static_cast<uint32_t>( value ) << 16 );
+}
+
+} // namespace ANNT
@@ -0,0 +1,88 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XHALF_WEIGHTS_HPP
+#define ANNT_XHALF_WEIGHTS_HPP
+
+#include <stdio.h>
+#include <cstdint>
+
+#include "../Types/Types.hpp"
+
+namespace ANNT {
+
+// Weights stored as 16 bit floating point numbers (half precision or bfloat16), which take half of the memory
+// and bandwidth of float weights. Values are widened to float when used, while computations are done in float.
+class XHalfWeights
+{
+private:
+    WeightsPrecision                                       mPrecision;
+    std::vector<uint16_t, XAlignedAllocator<uint16_t, 32>> mValues;
+
+public:
+    XHalfWeights( );
+
+    // Checks if there are no weights
+    bool IsEmpty( ) const
+    {
+        return mValues.empty( );
+    }
+
+    // Releases weights
+    void Clear( );
+
+    // Precision of the stored weights (Float if there are none)
+    WeightsPrecision Precision( ) const
+    {
+        return mPrecision;
+    }
+
+    // Number of stored weights
+    size_t Count( ) const
+    {
+        return mValues.size( );
+    }
+
+    // Converts the specified weights to half precision or bfloat16 (rounding to nearest), reusing memory of
+    // the previously converted weights
+    void Convert( const float_t* weights, size_t count, WeightsPrecision precision );
+
+    // Widens the specified number of weights starting from the given offset into float_t values
+    void ToFloat( size_t offset, size_t count, float_t* weights ) const;
+
+    // Calculates dot product of the vector and the specified number of weights starting from the given offset
+    float_t Dot( size_t offset, const float_t* vector, size_t count ) const;
+
+    // Saves weights as raw 16 bit values
+    bool Save( FILE* file ) const;
+    // Loads the specified number of weights of the given precision saved by Save( )
+    bool Load( FILE* file, size_t count, WeightsPrecision precision );
+
+    // Conversion of single values between float and half precision/bfloat16 numbers
+    static uint16_t FloatToHalf( float value );
+    static float HalfToFloat( uint16_t value );
+    static uint16_t FloatToBFloat16( float value );
+    static float BFloat16ToFloat( uint16_t value );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XHALF_WEIGHTS_HPP
@@ -0,0 +1,197 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "XInt8Gemm.hpp"
+#include "XInt8GemmKernels.hpp"
+#include "XCpu.hpp"
+#include "XParallel.hpp"
+#include "../Config.hpp"
+
+using namespace std;
+
+namespace ANNT {
+
+namespace {
+
+// Number of A rows computed by micro kernels at once
+static const size_t INT8_GEMM_MR = 4;
+
+// Number of B rows computed by micro kernels at once (panel width)
+static const size_t INT8_GEMM_NR = XInt8Gemm::PanelWidth;
+
+// Size of A block (bytes), which should stay in L2 cache while going through panels of B
+static const size_t INT8_GEMM_BLOCK_SIZE = 64 * 1024;
+
+// Minimum amount of work to split it between cores
+static const size_t INT8_GEMM_PARALLEL_THRESHOLD = 64 * 64 * 64;
+
+typedef void ( *Int8GemmKernel )( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c );
+
+// Default implementation of INT8 GEMM micro kernel
+static void DefaultInt8GemmKernel( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c )
+{
+    for ( size_t i = 0; i < INT8_GEMM_MR; i++ )
+    {
+        std::fill( c[i], c[i] + INT8_GEMM_NR, 0 );
+    }
+
+    for ( size_t p = 0; p < k; p += 4, b += INT8_GEMM_NR * 4 )
+    {
+        for ( size_t i = 0; i < INT8_GEMM_MR; i++ )
+        {
+            const uint8_t* aQuad = a[i] + p;
+
+            for ( size_t j = 0; j < INT8_GEMM_NR; j++ )
+            {
+                const int8_t* bQuad = b + j * 4;
+
+                c[i][j] += aQuad[0] * bQuad[0] + aQuad[1] * bQuad[1] + aQuad[2] * bQuad[2] + aQuad[3] * bQuad[3];
+            }
+        }
+    }
+}
+
+// Selects the best micro kernel available on the current CPU
+static Int8GemmKernel GetAvailableInt8GemmKernel( )
+{
+    Int8GemmKernel kernel = DefaultInt8GemmKernel;
+
+#ifdef ANNT_USE_SSE
+    if ( ( XCpu::IsFeatureSupported( XCpu::Reg_ECX, XCpu::Flag_SSSE3 ) ) &&
+         ( XCpu::IsFeatureSupported( XCpu::Reg_ECX, XCpu::Flag_SSE4_1 ) ) )
+    {
+        kernel = Sse41Int8GemmKernel;
+    }
+#endif
+
+#ifdef ANNT_USE_AVX2
+    if ( XCpu::IsAvx2FmaSupported( ) )
+    {
+        kernel = Avx2Int8GemmKernel;
+    }
+#endif
+
+    return kernel;
+}
+
+static const Int8GemmKernel INT8_GEMM_KERNEL = GetAvailableInt8GemmKernel( );
+
+} // namespace <anonymous>
+
+// Packs B matrix into panels
+void XInt8Gemm::Pack( size_t n, size_t k, const int8_t* b, size_t ldb, int8_t* packedB )
+{
+    size_t rowSize = RowSize( k );
+
+    std::fill( packedB, packedB + PackedSize( n, k ), int8_t( 0 ) );
+
+    for ( size_t j = 0; j < n; j++ )
+    {
+        const int8_t* bRow  = b + j * ldb;
+        int8_t*       panel = packedB + j / PanelWidth * PanelWidth * rowSize + j % PanelWidth * 4;
+
+        // groups of 4 values of panel's rows are interleaved
+        for ( size_t p = 0; p < k; p++ )
+        {
+            panel[p / 4 * PanelWidth * 4 + p % 4] = bRow[p];
+        }
+    }
+}
+
+// Multiplies matrices provided as contiguous memory blocks with the specified row strides
+void XInt8Gemm::Multiply( size_t m, size_t n, size_t k,
+                          const uint8_t* a, size_t lda, const int8_t* packedB,
+                          int32_t* c, size_t ldc, bool parallel )
+{
+    vector<const uint8_t*> aRows( m );
+    vector<int32_t*>       cRows( m );
+
+    for ( size_t i = 0; i < m; i++ )
+    {
+        aRows[i] = a + i * lda;
+        cRows[i] = c + i * ldc;
+    }
+
+    Multiply( m, n, k, aRows.data( ), packedB, cRows.data( ), parallel );
+}
+
+// Multiplies matrices with rows of A and C provided as arrays of row pointers
+void XInt8Gemm::Multiply( size_t m, size_t n, size_t k,
+                          const uint8_t* const* a, const int8_t* packedB,
+                          int32_t* const* c, bool parallel )
+{
+    size_t rowSize     = RowSize( k );
+    size_t blockRows   = std::max( INT8_GEMM_BLOCK_SIZE / std::max( rowSize, size_t( 1 ) ) / INT8_GEMM_MR, size_t( 1 ) ) * INT8_GEMM_MR;
+    size_t blocksCount = ( m + blockRows - 1 ) / blockRows;
+    size_t panelsCount = ( n + INT8_GEMM_NR - 1 ) / INT8_GEMM_NR;
+    size_t tasksCount  = blocksCount * panelsCount;
+
+    parallel = ( parallel ) && ( tasksCount > 1 ) && ( m * n * k >= INT8_GEMM_PARALLEL_THRESHOLD );
+
+    // every task multiplies a block of A rows by a panel of B; consecutive tasks share the block of A
+    XParallel::For( tasksCount, parallel, [&]( size_t task )
+    {
+        size_t         blockStart = task / panelsCount * blockRows;
+        size_t         blockEnd   = std::min( blockStart + blockRows, m );
+        size_t         col        = task % panelsCount * INT8_GEMM_NR;
+        size_t         cols       = std::min( INT8_GEMM_NR, n - col );
+        const int8_t*  panel      = packedB + col * rowSize;
+        const uint8_t* aRows[INT8_GEMM_MR];
+        int32_t*       cRows[INT8_GEMM_MR];
+        int32_t        tile[INT8_GEMM_MR * INT8_GEMM_NR];
+
+        for ( size_t i = blockStart; i < blockEnd; i += INT8_GEMM_MR )
+        {
+            size_t rows = std::min( INT8_GEMM_MR, blockEnd - i );
+
+            if ( ( rows == INT8_GEMM_MR ) && ( cols == INT8_GEMM_NR ) )
+            {
+                for ( size_t r = 0; r < INT8_GEMM_MR; r++ )
+                {
+                    aRows[r] = a[i + r];
+                    cRows[r] = c[i + r] + col;
+                }
+
+                INT8_GEMM_KERNEL( rowSize, aRows, panel, cRows );
+            }
+            else
+            {
+                // partial tile is computed into temporary buffer (missing rows of A repeat the last one)
+                for ( size_t r = 0; r < INT8_GEMM_MR; r++ )
+                {
+                    aRows[r] = a[i + std::min( r, rows - 1 )];
+                    cRows[r] = tile + r * INT8_GEMM_NR;
+                }
+
+                INT8_GEMM_KERNEL( rowSize, aRows, panel, cRows );
+
+                for ( size_t r = 0; r < rows; r++ )
+                {
+                    std::copy( tile + r * INT8_GEMM_NR, tile + r * INT8_GEMM_NR + cols, c[i + r] + col );
+                }
+            }
+        }
+    } );
+}
+
+} // namespace ANNT
@@ -0,0 +1,77 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XINT8_GEMM_HPP
+#define ANNT_XINT8_GEMM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ANNT {
+
+// Matrix multiplication of quantized values: C = A * B^T, where A is M x K matrix of unsigned 7 bit values
+// (0-127), B is N x K matrix of signed 8 bit values and C is M x N matrix of 32 bit products.
+//
+// B is packed in advance into panels of PanelWidth rows, where every group of 4 consecutive values of those
+// rows is stored next to each other. This way SIMD kernels (the best available on the current CPU) compute tiles
+// of C by multiplying broadcasted groups of A values with whole panel vectors, without any horizontal sums.
+// Rows of A must be readable up to RowSize( K ) values - padded values don't matter, since B is padded with zeros.
+class XInt8Gemm
+{
+private:
+    XInt8Gemm( );
+
+public:
+    // Rows of A and B are padded to multiple of this number of values
+    static const size_t RowAlignment = 4;
+
+    // Number of B rows packed into a single panel
+    static const size_t PanelWidth = 16;
+
+    // Padded size of rows with the specified number of values
+    static size_t RowSize( size_t k )
+    {
+        return ( k + RowAlignment - 1 ) / RowAlignment * RowAlignment;
+    }
+
+    // Size of packed B matrix (number of values)
+    static size_t PackedSize( size_t n, size_t k )
+    {
+        return ( n + PanelWidth - 1 ) / PanelWidth * PanelWidth * RowSize( k );
+    }
+
+    // Packs B matrix (rows are ldb values apart) into panels - PackedSize( n, k ) values
+    static void Pack( size_t n, size_t k, const int8_t* b, size_t ldb, int8_t* packedB );
+
+    // Multiplies matrices provided as contiguous memory blocks with the specified row strides
+    static void Multiply( size_t m, size_t n, size_t k,
+                          const uint8_t* a, size_t lda, const int8_t* packedB,
+                          int32_t* c, size_t ldc, bool parallel = true );
+
+    // Multiplies matrices with rows of A and C provided as arrays of row pointers
+    static void Multiply( size_t m, size_t n, size_t k,
+                          const uint8_t* const* a, const int8_t* packedB,
+                          int32_t* const* c, bool parallel = true );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XINT8_GEMM_HPP
@@ -0,0 +1,132 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XMappedFile.hpp"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else  // posix assumed
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace ANNT {
+
+XMappedFile::XMappedFile( ) :
+    mData( nullptr ), mSize( 0 )
+    #ifdef _WIN32
+    , mFileHandle( nullptr ), mMappingHandle( nullptr )
+    #endif
+{
+}
+
+XMappedFile::~XMappedFile( )
+{
+    Close( );
+}
+
+// Maps the specified file into memory (closes previous mapping, if any)
+bool XMappedFile::Open( const std::string& fileName )
+{
+    Close( );
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA( fileName.c_str( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+    if ( file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER fileSize;
+
+        if ( ( GetFileSizeEx( file, &fileSize ) ) && ( fileSize.QuadPart != 0 ) )
+        {
+            HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+            if ( mapping != nullptr )
+            {
+                mData = static_cast<const uint8_t*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+
+                if ( mData != nullptr )
+                {
+                    mSize          = static_cast<size_t>( fileSize.QuadPart );
+                    mMappingHandle = mapping;
+                    mFileHandle    = file;
+                }
+                else
+                {
+                    CloseHandle( mapping );
+                }
+            }
+        }
+
+        if ( mData == nullptr )
+        {
+            CloseHandle( file );
+        }
+    }
+#else
+    int file = open( fileName.c_str( ), O_RDONLY );
+
+    if ( file != -1 )
+    {
+        struct stat fileInfo;
+
+        if ( ( fstat( file, &fileInfo ) == 0 ) && ( fileInfo.st_size != 0 ) )
+        {
+            void* data = mmap( nullptr, static_cast<size_t>( fileInfo.st_size ), PROT_READ, MAP_SHARED, file, 0 );
+
+            if ( data != MAP_FAILED )
+            {
+                mData = static_cast<const uint8_t*>( data );
+                mSize = static_cast<size_t>( fileInfo.st_size );
+            }
+        }
+
+        // mapping stays valid after closing the file descriptor
+        close( file );
+    }
+#endif
+
+    return ( mData != nullptr );
+}
+
+// Unmaps the file
+void XMappedFile::Close( )
+{
+    if ( mData != nullptr )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile( mData );
+        CloseHandle( mMappingHandle );
+        CloseHandle( mFileHandle );
+
+        mMappingHandle = nullptr;
+        mFileHandle    = nullptr;
+#else
+        munmap( const_cast<uint8_t*>( mData ), mSize );
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+    }
+}
+
+} // namespace ANNT
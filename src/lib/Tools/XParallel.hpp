@@ -24,6 +24,10 @@
 
 #include "../Config.hpp"
 
+#ifdef ANNT_USE_OMP
+#include <omp.h>
+#endif
+
 namespace ANNT {
 
 // Provides functions to use for paralleling for-loops
@@ -33,6 +37,26 @@ private:
     XParallel( );
 
 public:
+    // Maximum number of threads parallel loops may run on
+    static inline size_t ThreadsCount( )
+    {
+        #ifdef ANNT_USE_OMP
+        return static_cast<size_t>( omp_get_max_threads( ) );
+        #else
+        return 1;
+        #endif
+    }
+
+    // Index of the thread running current iteration of a parallel loop (0 outside of parallel loops)
+    static inline size_t ThreadIndex( )
+    {
+        #ifdef ANNT_USE_OMP
+        return static_cast<size_t>( omp_get_thread_num( ) );
+        #else
+        return 0;
+        #endif
+    }
+
     // Runs the specified lambda in a parallel for loop
     template <typename Func> static inline void For( size_t size, Func func )
     {
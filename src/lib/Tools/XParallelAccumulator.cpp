@@ -0,0 +1,72 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XParallelAccumulator.hpp"
+#include "XVectorize.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace ANNT {
+
+// Makes sure there are zeroed private buffers for the specified number of threads
+float_t* XParallelAccumulator::PrepareBuffers( size_t threadsCount, size_t size )
+{
+    if ( mBuffers.size( ) < threadsCount * size )
+    {
+        mBuffers.resize( threadsCount * size );
+    }
+
+    float_t* buffers = mBuffers.data( );
+
+    XParallel::For( threadsCount, true, [&]( size_t threadIndex )
+    {
+        fill( buffers + threadIndex * size, buffers + ( threadIndex + 1 ) * size, float_t( 0 ) );
+    } );
+
+    return buffers;
+}
+
+// Sums private buffers with tree reduction and adds the result to the destination
+void XParallelAccumulator::Reduce( size_t threadsCount, size_t size, float_t* dst )
+{
+    float_t* buffers = mBuffers.data( );
+
+    // on each step buffer "2 * k * stride" gets sum with the buffer "stride" positions further
+    for ( size_t stride = 1; stride < threadsCount; stride *= 2 )
+    {
+        size_t pairsCount = ( threadsCount + 2 * stride - 1 ) / ( 2 * stride );
+
+        XParallel::For( pairsCount, true, [&]( size_t pairIndex )
+        {
+            size_t dstIndex = pairIndex * 2 * stride;
+            size_t srcIndex = dstIndex + stride;
+
+            if ( srcIndex < threadsCount )
+            {
+                XVectorize::Add( buffers + srcIndex * size, buffers + dstIndex * size, size );
+            }
+        } );
+    }
+
+    XVectorize::Add( buffers, dst, size );
+}
+
+} // namespace ANNT
@@ -0,0 +1,76 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XPARALLEL_ACCUMULATOR_HPP
+#define ANNT_XPARALLEL_ACCUMULATOR_HPP
+
+#include "../Types/Types.hpp"
+#include "XParallel.hpp"
+
+namespace ANNT {
+
+// Runs parallel loops which accumulate into the same destination (like weights' gradients summed over samples).
+// Every thread accumulates into its own private buffer, so loop iterations don't need to be split by the
+// destination's parts. Private buffers are then summed pairwise in log2( threads ) steps and added to the
+// destination. The buffers are kept between calls, so there is no allocation once they grew large enough.
+class XParallelAccumulator
+{
+private:
+    fvector_t mBuffers;
+
+public:
+    // Runs func( index, accumulator ) for all indexes in [0, count) range, where accumulator is the
+    // destination of the given size or thread's private copy of it
+    template <typename Func> void For( size_t count, bool parallel, float_t* dst, size_t size, Func func )
+    {
+        size_t threadsCount = ( ( parallel ) && ( count > 1 ) ) ? XParallel::ThreadsCount( ) : 1;
+
+        if ( threadsCount <= 1 )
+        {
+            for ( size_t i = 0; i < count; i++ )
+            {
+                func( i, dst );
+            }
+        }
+        else
+        {
+            float_t* buffers = PrepareBuffers( threadsCount, size );
+
+            XParallel::For( count, true, [&]( size_t i )
+            {
+                func( i, buffers + XParallel::ThreadIndex( ) * size );
+            } );
+
+            Reduce( threadsCount, size, dst );
+        }
+    }
+
+private:
+    // Makes sure there are zeroed private buffers for the specified number of threads
+    float_t* PrepareBuffers( size_t threadsCount, size_t size );
+
+    // Sums private buffers with tree reduction and adds the result to the destination
+    void Reduce( size_t threadsCount, size_t size, float_t* dst );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XPARALLEL_ACCUMULATOR_HPP
@@ -0,0 +1,239 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+
+#include "XQuantizedWeights.hpp"
+#include "XInt8Gemm.hpp"
+
+using namespace std;
+
+namespace ANNT {
+
+namespace {
+
+// Maximum of quantized inputs - 7 bits, so pairs of products with weights don't overflow 16 bit integers
+static const int32_t MAX_QUANTIZED_INPUT = 127;
+
+// Maximum (absolute) of quantized weights - symmetric range, so weights' zero is exact
+static const int32_t MAX_QUANTIZED_WEIGHT = 127;
+
+// Rounds the value and clamps it to the specified range
+static inline int32_t RoundToRange( float_t value, int32_t minValue, int32_t maxValue )
+{
+    int32_t rounded = static_cast<int32_t>( std::floor( value + float_t( 0.5 ) ) );
+
+    return std::min( std::max( rounded, minValue ), maxValue );
+}
+
+} // namespace <anonymous>
+
+XQuantizedWeights::XQuantizedWeights( ) :
+    mRowsCount( 0 ), mRowSize( 0 ), mPaddedRowSize( 0 ), mInputScale( 1 ), mInputZeroPoint( 0 )
+{
+}
+
+// Releases quantized weights
+void XQuantizedWeights::Clear( )
+{
+    mRowsCount     = 0;
+    mRowSize       = 0;
+    mPaddedRowSize = 0;
+
+    mWeights.clear( );
+    mPackedWeights.clear( );
+    mZeroPointOffsets.clear( );
+    mWeightScales.clear( );
+    mOutputScales.clear( );
+    mBiases.clear( );
+}
+
+// Quantizes rows of weights and biases for inputs in the specified range
+void XQuantizedWeights::Quantize( const float_t* weights, const float_t* biases, size_t rowsCount, size_t rowSize,
+                                  float_t inputMin, float_t inputMax )
+{
+    // range of inputs must include zero, so it is quantized exactly (zero padding, ReLU outputs, etc.)
+    inputMin = std::min( inputMin, float_t( 0 ) );
+    inputMax = std::max( inputMax, float_t( 0 ) );
+
+    mInputScale     = ( inputMax > inputMin ) ? ( inputMax - inputMin ) / MAX_QUANTIZED_INPUT : float_t( 1 );
+    mInputZeroPoint = static_cast<uint8_t>( RoundToRange( -inputMin / mInputScale, 0, MAX_QUANTIZED_INPUT ) );
+
+    mRowsCount = rowsCount;
+    mRowSize   = rowSize;
+    mWeights.resize( rowsCount * rowSize );
+    mWeightScales.resize( rowsCount );
+    mBiases.assign( biases, biases + rowsCount );
+
+    for ( size_t j = 0; j < rowsCount; j++ )
+    {
+        const float_t* row    = weights + j * rowSize;
+        int8_t*        qrow   = mWeights.data( ) + j * rowSize;
+        float_t        maxAbs = float_t( 0 );
+
+        for ( size_t i = 0; i < rowSize; i++ )
+        {
+            maxAbs = std::max( maxAbs, std::abs( row[i] ) );
+        }
+
+        mWeightScales[j] = ( maxAbs > float_t( 0 ) ) ? maxAbs / MAX_QUANTIZED_WEIGHT : float_t( 1 );
+
+        for ( size_t i = 0; i < rowSize; i++ )
+        {
+            qrow[i] = static_cast<int8_t>( RoundToRange( row[i] / mWeightScales[j], -MAX_QUANTIZED_WEIGHT, MAX_QUANTIZED_WEIGHT ) );
+        }
+    }
+
+    PrepareWeights( );
+}
+
+// Calculates padded row size, zero point offsets and output scales for the current weights, packs them for multiplication
+void XQuantizedWeights::PrepareWeights( )
+{
+    mPaddedRowSize = XInt8Gemm::RowSize( mRowSize );
+    mZeroPointOffsets.resize( mRowsCount );
+    mOutputScales.resize( mRowsCount );
+    mPackedWeights.resize( XInt8Gemm::PackedSize( mRowsCount, mRowSize ) );
+
+    XInt8Gemm::Pack( mRowsCount, mRowSize, mWeights.data( ), mRowSize, mPackedWeights.data( ) );
+
+    for ( size_t j = 0; j < mRowsCount; j++ )
+    {
+        const int8_t* row    = mWeights.data( ) + j * mRowSize;
+        int32_t       rowSum = 0;
+
+        for ( size_t i = 0; i < mRowSize; i++ )
+        {
+            rowSum += row[i];
+        }
+
+        mZeroPointOffsets[j] = rowSum * mInputZeroPoint;
+        mOutputScales[j]     = mInputScale * mWeightScales[j];
+    }
+}
+
+// Quantizes input values into unsigned 7 bit values
+void XQuantizedWeights::QuantizeInputs( const float_t* inputs, uint8_t* quantized, size_t count ) const
+{
+    float_t invScale  = float_t( 1 ) / mInputScale;
+    float_t zeroPoint = static_cast<float_t>( mInputZeroPoint );
+
+    float_t maxValue  = static_cast<float_t>( MAX_QUANTIZED_INPUT );
+
+    // values are clamped before rounding, so adding 0.5 and truncating rounds them (loop is vectorized this way)
+    for ( size_t i = 0; i < count; i++ )
+    {
+        float_t value = std::min( std::max( inputs[i] * invScale + zeroPoint, float_t( 0 ) ), maxValue );
+
+        quantized[i] = static_cast<uint8_t>( static_cast<int32_t>( value + float_t( 0.5 ) ) );
+    }
+}
+
+// Multiplies rows of quantized inputs by rows of quantized weights
+void XQuantizedWeights::Multiply( size_t inputRows, const uint8_t* const* inputs, int32_t* const* products, bool parallel ) const
+{
+    XInt8Gemm::Multiply( inputRows, mRowsCount, mRowSize, inputs, mPackedWeights.data( ), products, parallel );
+}
+void XQuantizedWeights::Multiply( size_t inputRows, const uint8_t* inputs, int32_t* products, bool parallel ) const
+{
+    XInt8Gemm::Multiply( inputRows, mRowsCount, mRowSize, inputs, mPaddedRowSize,
+                         mPackedWeights.data( ), products, mRowsCount, parallel );
+}
+
+// Converts products of quantized inputs and weights into outputs
+void XQuantizedWeights::Dequantize( const int32_t* products, float_t* outputs, size_t outputsStride ) const
+{
+    for ( size_t j = 0; j < mRowsCount; j++ )
+    {
+        outputs[j * outputsStride] = static_cast<float_t>( products[j] - mZeroPointOffsets[j] ) * mOutputScales[j] + mBiases[j];
+    }
+}
+
+// Converts products of input rows into outputs stored by rows of weights
+void XQuantizedWeights::DequantizeTransposed( const int32_t* products, size_t inputRows, float_t* outputs ) const
+{
+    // going through outputs sequentially, since their rows may be far apart in memory
+    for ( size_t j = 0; j < mRowsCount; j++ )
+    {
+        const int32_t* productsPtr = products + j;
+        float_t*       outputsRow  = outputs + j * inputRows;
+        int32_t        offset      = mZeroPointOffsets[j];
+        float_t        scale       = mOutputScales[j];
+        float_t        bias        = mBiases[j];
+
+        for ( size_t i = 0; i < inputRows; i++, productsPtr += mRowsCount )
+        {
+            outputsRow[i] = static_cast<float_t>( *productsPtr - offset ) * scale + bias;
+        }
+    }
+}
+
+// Saves quantized weights
+bool XQuantizedWeights::Save( FILE* file ) const
+{
+    uint32_t sizes[2] = { static_cast<uint32_t>( mRowsCount ), static_cast<uint32_t>( mRowSize ) };
+
+    return ( fwrite( sizes, sizeof( uint32_t ), 2, file ) == 2 ) &&
+           ( fwrite( &mInputScale, sizeof( mInputScale ), 1, file ) == 1 ) &&
+           ( fwrite( &mInputZeroPoint, sizeof( mInputZeroPoint ), 1, file ) == 1 ) &&
+           ( fwrite( mWeightScales.data( ), sizeof( float_t ), mRowsCount, file ) == mRowsCount ) &&
+           ( fwrite( mBiases.data( ), sizeof( float_t ), mRowsCount, file ) == mRowsCount ) &&
+           ( fwrite( mWeights.data( ), sizeof( int8_t ), mWeights.size( ), file ) == mWeights.size( ) );
+}
+
+// Loads quantized weights, which must be of the specified size
+bool XQuantizedWeights::Load( FILE* file, size_t rowsCount, size_t rowSize )
+{
+    uint32_t sizes[2];
+    bool     ret = ( fread( sizes, sizeof( uint32_t ), 2, file ) == 2 ) &&
+                   ( sizes[0] == static_cast<uint32_t>( rowsCount ) ) &&
+                   ( sizes[1] == static_cast<uint32_t>( rowSize ) );
+
+    Clear( );
+
+    if ( ret )
+    {
+        mRowsCount = rowsCount;
+        mRowSize   = rowSize;
+        mWeights.resize( rowsCount * rowSize );
+        mWeightScales.resize( rowsCount );
+        mBiases.resize( rowsCount );
+
+        ret = ( fread( &mInputScale, sizeof( mInputScale ), 1, file ) == 1 ) &&
+              ( fread( &mInputZeroPoint, sizeof( mInputZeroPoint ), 1, file ) == 1 ) &&
+              ( mInputZeroPoint <= MAX_QUANTIZED_INPUT ) &&
+              ( fread( mWeightScales.data( ), sizeof( float_t ), rowsCount, file ) == rowsCount ) &&
+              ( fread( mBiases.data( ), sizeof( float_t ), rowsCount, file ) == rowsCount ) &&
+              ( fread( mWeights.data( ), sizeof( int8_t ), mWeights.size( ), file ) == mWeights.size( ) );
+
+        if ( ret )
+        {
+            PrepareWeights( );
+        }
+        else
+        {
+            Clear( );
+        }
+    }
+
+    return ret;
+}
+
+} // namespace ANNT
@@ -0,0 +1,1129 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XSIMD_VECTOR_TOOLS_HPP
+#define ANNT_XSIMD_VECTOR_TOOLS_HPP
+
+#include <stdint.h>
+#include <cmath>
+#include <type_traits>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#elif __GNUC__
+    #include <x86intrin.h>
+#endif
+
+// Body of vector routines shared by SSE/AVX/AVX2/AVX-512 implementations of IVectorTools, which are compiled
+// with different instruction sets enabled. Everything is kept in anonymous namespace, so each translation unit
+// gets own copy of it.
+//
+// The including translation unit provides Ops<float> and Ops<double> wrappers of its intrinsics:
+//   Vector               - register type;
+//   Width, Alignment     - number of values in register and alignment of aligned loads/stores (bytes);
+//   Load/LoadU           - aligned/unaligned load;
+//   Store/StoreU         - aligned/unaligned store;
+//   Set1                 - broadcast of a value;
+//   Add/Sub/Mul/Div      - element-wise arithmetic;
+//   Sqrt                 - element-wise square root;
+//   Min/Max              - element-wise minimum/maximum;
+//   MAdd( a, b, c )      - a * b + c (fused, if instruction set has it);
+//   Sum                  - horizontal sum of register's values;
+//   Gather( src, idx )   - register loaded from src[idx[0]], src[idx[1]], ...
+// Ops<float> also provides:
+//   Round                - rounding to the nearest integer;
+//   Pow2( n )            - 2^n for integer n in [-126, 127] range;
+//   Select( a, b, x, y ) - element-wise ( a < b ) ? x : y.
+
+namespace ANNT { namespace {
+
+template <template <typename> class Ops> class SimdTools
+{
+public:
+    // Add two vectors: dst[i] += src[i]
+    template <typename T> static inline void Add( const T* src, T* dst, size_t size )
+    {
+        Call<AddImpl>( src, dst, src, dst, size );
+    }
+
+    // Multiply two vectors: dst[i] *= src[i]
+    template <typename T> static inline void Mul( const T* src, T* dst, size_t size )
+    {
+        Call<MulImpl>( src, dst, src, dst, size );
+    }
+
+    // Dot product: sum( vec1[i] * vec2[i] )
+    template <typename T> static inline T Dot( const T* vec1, const T* vec2, size_t size )
+    {
+        return Call<DotImpl>( vec1, vec2, vec1, vec2, size );
+    }
+
+    // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+    template <typename T> static inline void Max( const T* src, T alpha, T* dst, size_t size )
+    {
+        Call<MaxImpl>( src, dst, src, alpha, dst, size );
+    }
+
+    // Scales vector and adds it to another one: dst[i] += alpha * src[i]
+    template <typename T> static inline void Axpy( const T* src, T alpha, T* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, AxpyOp<T>( alpha ) );
+    }
+
+    // Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+    template <typename T> static inline void Scale( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, ScaleOp<T>( alpha, beta ) );
+    }
+
+    // Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+    template <typename T> static inline void ScaledAdd( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, ScaledAddOp<T>( alpha, beta ) );
+    }
+
+    // Element wise multiply-add: dst[i] += src1[i] * src2[i]
+    template <typename T> static inline void MulAdd( const T* src1, const T* src2, T* dst, size_t size )
+    {
+        Call<MulAddImpl>( src1, dst, src1, src2, dst, size );
+    }
+
+    // Sum of vector's elements
+    template <typename T> static inline T Sum( const T* src, size_t size )
+    {
+        return Call<ReduceImpl>( src, src, src, size, SumOp<T>( ) );
+    }
+
+    // Sum of squared vector's elements
+    template <typename T> static inline T SumOfSquares( const T* src, size_t size )
+    {
+        return Call<ReduceImpl>( src, src, src, size, SumOfSquaresOp<T>( ) );
+    }
+
+    // Minimum/maximum of vector's elements (0 for empty vector)
+    template <typename T> static inline T MinValue( const T* src, size_t size )
+    {
+        return ( size == 0 ) ? T( 0 ) : Call<ReduceImpl>( src, src, src, size, MinOp<T>( src[0] ) );
+    }
+    template <typename T> static inline T MaxValue( const T* src, size_t size )
+    {
+        return ( size == 0 ) ? T( 0 ) : Call<ReduceImpl>( src, src, src, size, MaxOp<T>( src[0] ) );
+    }
+
+    // Index of the first maximum element of the vector (0 for empty vector)
+    template <typename T> static inline size_t ArgMax( const T* src, size_t size )
+    {
+        T maxValue = MaxValue( src, size );
+
+        for ( size_t i = 0; i < size; i++ )
+        {
+            if ( src[i] == maxValue )
+            {
+                return i;
+            }
+        }
+
+        return 0;
+    }
+
+    // Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+    template <typename T> static inline void Gather( const T* src, const size_t* indexes, T* dst, size_t size )
+    {
+        Call<GatherImpl>( dst, dst, src, indexes, dst, size );
+    }
+
+    // Exponent of vector's elements: dst[i] = exp( src[i] )
+    static inline void Exp( const float* src, float* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, ExpOp( ) );
+    }
+    static inline void Exp( const double* src, double* dst, size_t size )
+    {
+        // no vectorized version for double precision, which needs 64 bit integer arithmetic for scaling by 2^n
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = std::exp( src[i] );
+        }
+    }
+
+    // Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+    static inline void Sigmoid( const float* src, float* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, SigmoidOp( ) );
+    }
+    static inline void Sigmoid( const double* src, double* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = double( 1 ) / ( double( 1 ) + std::exp( -src[i] ) );
+        }
+    }
+
+    // Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+    static inline void Tanh( const float* src, float* dst, size_t size )
+    {
+        Call<TransformImpl>( src, dst, src, dst, size, TanhOp( ) );
+    }
+    static inline void Tanh( const double* src, double* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = std::tanh( src[i] );
+        }
+    }
+
+    // Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+    template <typename T> static inline void SigmoidDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        Call<BinaryTransformImpl>( y, dst, y, delta, dst, size, SigmoidDerivativeOp<T>( ) );
+    }
+
+    // Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+    template <typename T> static inline void TanhDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        Call<BinaryTransformImpl>( y, dst, y, delta, dst, size, TanhDerivativeOp<T>( ) );
+    }
+
+    // Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+    template <typename T> static inline void SgdStep( T* weights, T* gradients, T gradScale, T learningRate, size_t size )
+    {
+        Call<OptimizerStepImpl>( weights, gradients, weights, gradients, static_cast<T*>( nullptr ), static_cast<T*>( nullptr ),
+                                 size, SgdStepOp<T>( gradScale, learningRate ) );
+    }
+
+    // Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+    //   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+    template <typename T> static inline void MomentumStep( T* weights, T* gradients, T* velocity, T gradScale, T momentum, T alpha, T beta, T gamma, size_t size )
+    {
+        Call<OptimizerStepImpl>( weights, gradients, weights, gradients, velocity, static_cast<T*>( nullptr ),
+                                 size, MomentumStepOp<T>( gradScale, momentum, alpha, beta, gamma ) );
+    }
+
+    // Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+    //   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+    template <typename T> static inline void AdaptiveStep( T* weights, T* gradients, T* sqSum, T gradScale, T decay, T sqFactor, T learningRate, T epsilon, size_t size )
+    {
+        Call<OptimizerStepImpl>( weights, gradients, weights, gradients, sqSum, static_cast<T*>( nullptr ),
+                                 size, AdaptiveStepOp<T>( gradScale, decay, sqFactor, learningRate, epsilon ) );
+    }
+
+    // Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+    //   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+    template <typename T> static inline void AdamStep( T* weights, T* gradients, T* mt, T* vt, T gradScale, T b1, T b2, T mtScale, T vtScale, T learningRate, T epsilon, size_t size )
+    {
+        Call<OptimizerStepImpl>( weights, gradients, weights, gradients, mt, vt,
+                                 size, AdamStepOp<T>( gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon ) );
+    }
+
+private:
+    // Check if the pointer is aligned as needed for aligned loads/stores
+    template <typename T> static inline bool IsAligned( const T* ptr )
+    {
+        return ( ( reinterpret_cast<uintptr_t>( ptr ) % Ops<T>::Alignment ) == 0 );
+    }
+
+    // Runs the implementation with alignment of the two pointers resolved to compile time types
+    template <typename Impl, typename T1, typename T2, typename ... Args>
+    static inline auto Call( const T1* ptr1, const T2* ptr2, Args ... args ) ->
+        decltype( Impl::template Run<std::true_type, std::true_type>( args ... ) )
+    {
+        if ( IsAligned( ptr1 ) )
+        {
+            if ( IsAligned( ptr2 ) )
+            {
+                return Impl::template Run<std::true_type, std::true_type>( args ... );
+            }
+            else
+            {
+                return Impl::template Run<std::true_type, std::false_type>( args ... );
+            }
+        }
+        else
+        {
+            if ( IsAligned( ptr2 ) )
+            {
+                return Impl::template Run<std::false_type, std::true_type>( args ... );
+            }
+            else
+            {
+                return Impl::template Run<std::false_type, std::false_type>( args ... );
+            }
+        }
+    }
+
+    // Load/store of the register, which is aligned or not
+    template <typename isAligned, typename T> static inline typename Ops<T>::Vector Load( const T* src )
+    {
+        return ( isAligned::value ) ? Ops<T>::Load( src ) : Ops<T>::LoadU( src );
+    }
+    template <typename isAligned, typename T> static inline void Store( const typename Ops<T>::Vector& value, T* dst )
+    {
+        if ( isAligned::value )
+        {
+            Ops<T>::Store( dst, value );
+        }
+        else
+        {
+            Ops<T>::StoreU( dst, value );
+        }
+    }
+
+    // Add two vectors
+    struct AddImpl
+    {
+        template <typename srcAligned, typename dstAligned, typename T> static void Run( const T* src, T* dst, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto d0 = Op::Add( Load<srcAligned>(  src ),                  Load<dstAligned>(  dst ) );
+                auto d1 = Op::Add( Load<srcAligned>( &src[blockSize    ] ),   Load<dstAligned>( &dst[blockSize    ] ) );
+                auto d2 = Op::Add( Load<srcAligned>( &src[blockSize * 2] ),   Load<dstAligned>( &dst[blockSize * 2] ) );
+                auto d3 = Op::Add( Load<srcAligned>( &src[blockSize * 3] ),   Load<dstAligned>( &dst[blockSize * 3] ) );
+
+                Store<dstAligned>( d0,  dst );
+                Store<dstAligned>( d1, &dst[blockSize    ] );
+                Store<dstAligned>( d2, &dst[blockSize * 2] );
+                Store<dstAligned>( d3, &dst[blockSize * 3] );
+
+                src += blockSize4;
+                dst += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( Op::Add( Load<srcAligned>( src ), Load<dstAligned>( dst ) ), dst );
+
+                src += blockSize;
+                dst += blockSize;
+            }
+
+            // remainder for compiler to decide
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst += *src;
+
+                src++;
+                dst++;
+            }
+        }
+    };
+
+    // Multiply two vectors
+    struct MulImpl
+    {
+        template <typename srcAligned, typename dstAligned, typename T> static void Run( const T* src, T* dst, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto d0 = Op::Mul( Load<srcAligned>(  src ),                  Load<dstAligned>(  dst ) );
+                auto d1 = Op::Mul( Load<srcAligned>( &src[blockSize    ] ),   Load<dstAligned>( &dst[blockSize    ] ) );
+                auto d2 = Op::Mul( Load<srcAligned>( &src[blockSize * 2] ),   Load<dstAligned>( &dst[blockSize * 2] ) );
+                auto d3 = Op::Mul( Load<srcAligned>( &src[blockSize * 3] ),   Load<dstAligned>( &dst[blockSize * 3] ) );
+
+                Store<dstAligned>( d0,  dst );
+                Store<dstAligned>( d1, &dst[blockSize    ] );
+                Store<dstAligned>( d2, &dst[blockSize * 2] );
+                Store<dstAligned>( d3, &dst[blockSize * 3] );
+
+                src += blockSize4;
+                dst += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( Op::Mul( Load<srcAligned>( src ), Load<dstAligned>( dst ) ), dst );
+
+                src += blockSize;
+                dst += blockSize;
+            }
+
+            // remainder for compiler to decide
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst *= *src;
+
+                src++;
+                dst++;
+            }
+        }
+    };
+
+    // Dot product of two vectors. Uses 8 independent accumulators, so that latency of multiply-add
+    // instructions is hidden (with FMA there may be 8-10 of them in flight).
+    struct DotImpl
+    {
+        template <typename vec1Aligned, typename vec2Aligned, typename T> static T Run( const T* vec1, const T* vec2, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize8       = blockSize * 8;
+            size_t       blockIterations8 = size / blockSize8;
+            size_t       blockIterations  = ( size - blockIterations8 * blockSize8 ) / blockSize;
+            size_t       remainIterations = size - blockIterations8 * blockSize8 - blockIterations * blockSize;
+
+            auto sum0 = Op::Set1( T( 0 ) ), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+            auto sum4 = sum0, sum5 = sum0, sum6 = sum0, sum7 = sum0;
+
+            // large blocks of 8
+            for ( size_t i = 0; i < blockIterations8; i++ )
+            {
+                sum0 = Op::MAdd( Load<vec1Aligned>(  vec1 ),                Load<vec2Aligned>(  vec2 ),                sum0 );
+                sum1 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize    ] ), Load<vec2Aligned>( &vec2[blockSize    ] ), sum1 );
+                sum2 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 2] ), Load<vec2Aligned>( &vec2[blockSize * 2] ), sum2 );
+                sum3 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 3] ), Load<vec2Aligned>( &vec2[blockSize * 3] ), sum3 );
+                sum4 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 4] ), Load<vec2Aligned>( &vec2[blockSize * 4] ), sum4 );
+                sum5 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 5] ), Load<vec2Aligned>( &vec2[blockSize * 5] ), sum5 );
+                sum6 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 6] ), Load<vec2Aligned>( &vec2[blockSize * 6] ), sum6 );
+                sum7 = Op::MAdd( Load<vec1Aligned>( &vec1[blockSize * 7] ), Load<vec2Aligned>( &vec2[blockSize * 7] ), sum7 );
+
+                vec1 += blockSize8;
+                vec2 += blockSize8;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                sum0 = Op::MAdd( Load<vec1Aligned>( vec1 ), Load<vec2Aligned>( vec2 ), sum0 );
+
+                vec1 += blockSize;
+                vec2 += blockSize;
+            }
+
+            sum0 = Op::Add( Op::Add( sum0, sum1 ), Op::Add( sum2, sum3 ) );
+            sum4 = Op::Add( Op::Add( sum4, sum5 ), Op::Add( sum6, sum7 ) );
+
+            T sum = Op::Sum( Op::Add( sum0, sum4 ) );
+
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                sum += *vec1 * *vec2;
+
+                vec1++;
+                vec2++;
+            }
+
+            return sum;
+        }
+    };
+
+    // Maximum value of vector's elements and the specified alpha value
+    struct MaxImpl
+    {
+        template <typename srcAligned, typename dstAligned, typename T> static void Run( const T* src, T alpha, T* dst, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            auto alphaVec = Op::Set1( alpha );
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto s0 = Op::Max( Load<srcAligned>(  src ),                alphaVec );
+                auto s1 = Op::Max( Load<srcAligned>( &src[blockSize    ] ), alphaVec );
+                auto s2 = Op::Max( Load<srcAligned>( &src[blockSize * 2] ), alphaVec );
+                auto s3 = Op::Max( Load<srcAligned>( &src[blockSize * 3] ), alphaVec );
+
+                Store<dstAligned>( s0,  dst );
+                Store<dstAligned>( s1, &dst[blockSize    ] );
+                Store<dstAligned>( s2, &dst[blockSize * 2] );
+                Store<dstAligned>( s3, &dst[blockSize * 3] );
+
+                src += blockSize4;
+                dst += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( Op::Max( Load<srcAligned>( src ), alphaVec ), dst );
+
+                src += blockSize;
+                dst += blockSize;
+            }
+
+            // remainder for compiler to decide
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst = ( *src > alpha ) ? *src : alpha;
+
+                src++;
+                dst++;
+            }
+        }
+    };
+
+    // Applies element-wise operation to vectors, dst[i] = op( src[i], dst[i] ). The operation object also
+    // tells if destination's values are needed as its input.
+    struct TransformImpl
+    {
+        template <typename srcAligned, typename dstAligned, typename T, typename Operation>
+        static void Run( const T* src, T* dst, size_t size, const Operation& op )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto d0 = op( Load<srcAligned>(  src ),                LoadDst<dstAligned, Operation>(  dst ) );
+                auto d1 = op( Load<srcAligned>( &src[blockSize    ] ), LoadDst<dstAligned, Operation>( &dst[blockSize    ] ) );
+                auto d2 = op( Load<srcAligned>( &src[blockSize * 2] ), LoadDst<dstAligned, Operation>( &dst[blockSize * 2] ) );
+                auto d3 = op( Load<srcAligned>( &src[blockSize * 3] ), LoadDst<dstAligned, Operation>( &dst[blockSize * 3] ) );
+
+                Store<dstAligned>( d0,  dst );
+                Store<dstAligned>( d1, &dst[blockSize    ] );
+                Store<dstAligned>( d2, &dst[blockSize * 2] );
+                Store<dstAligned>( d3, &dst[blockSize * 3] );
+
+                src += blockSize4;
+                dst += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( op( Load<srcAligned>( src ), LoadDst<dstAligned, Operation>( dst ) ), dst );
+
+                src += blockSize;
+                dst += blockSize;
+            }
+
+            // remainder goes through zero padded register as well, so all values are calculated the same way
+            if ( remainIterations != 0 )
+            {
+                T srcMem[Op::Width] = { };
+                T dstMem[Op::Width] = { };
+
+                for ( size_t i = 0; i < remainIterations; i++ )
+                {
+                    srcMem[i] = src[i];
+                    dstMem[i] = ( Operation::ReadsDestination ) ? dst[i] : T( 0 );
+                }
+
+                Op::StoreU( dstMem, op( Op::LoadU( srcMem ), Op::LoadU( dstMem ) ) );
+
+                for ( size_t i = 0; i < remainIterations; i++ )
+                {
+                    dst[i] = dstMem[i];
+                }
+            }
+        }
+
+        // Loads destination register only if the operation needs it
+        template <typename dstAligned, typename Operation, typename T> static inline typename Ops<T>::Vector LoadDst( const T* dst )
+        {
+            return ( Operation::ReadsDestination ) ? Load<dstAligned>( dst ) : Ops<T>::Set1( T( 0 ) );
+        }
+    };
+
+    // Element wise multiply-add of vectors. Alignment is resolved for the first source and destination,
+    // while the second source is loaded with unaligned loads (which are not slower on aligned data).
+    struct MulAddImpl
+    {
+        template <typename src1Aligned, typename dstAligned, typename T> static void Run( const T* src1, const T* src2, T* dst, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto d0 = Op::MAdd( Load<src1Aligned>(  src1 ),                Op::LoadU(  src2 ),                Load<dstAligned>(  dst ) );
+                auto d1 = Op::MAdd( Load<src1Aligned>( &src1[blockSize    ] ), Op::LoadU( &src2[blockSize    ] ), Load<dstAligned>( &dst[blockSize    ] ) );
+                auto d2 = Op::MAdd( Load<src1Aligned>( &src1[blockSize * 2] ), Op::LoadU( &src2[blockSize * 2] ), Load<dstAligned>( &dst[blockSize * 2] ) );
+                auto d3 = Op::MAdd( Load<src1Aligned>( &src1[blockSize * 3] ), Op::LoadU( &src2[blockSize * 3] ), Load<dstAligned>( &dst[blockSize * 3] ) );
+
+                Store<dstAligned>( d0,  dst );
+                Store<dstAligned>( d1, &dst[blockSize    ] );
+                Store<dstAligned>( d2, &dst[blockSize * 2] );
+                Store<dstAligned>( d3, &dst[blockSize * 3] );
+
+                src1 += blockSize4;
+                src2 += blockSize4;
+                dst  += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( Op::MAdd( Load<src1Aligned>( src1 ), Op::LoadU( src2 ), Load<dstAligned>( dst ) ), dst );
+
+                src1 += blockSize;
+                src2 += blockSize;
+                dst  += blockSize;
+            }
+
+            // remainder for compiler to decide
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst += *src1 * *src2;
+
+                src1++;
+                src2++;
+                dst++;
+            }
+        }
+    };
+
+    // Element-wise operation on two vectors: dst[i] = op( src1[i], src2[i] )
+    struct BinaryTransformImpl
+    {
+        template <typename src1Aligned, typename dstAligned, typename T, typename Operation>
+        static void Run( const T* src1, const T* src2, T* dst, size_t size, const Operation& op )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                auto d0 = op( Load<src1Aligned>(  src1 ),                Op::LoadU(  src2 ) );
+                auto d1 = op( Load<src1Aligned>( &src1[blockSize    ] ), Op::LoadU( &src2[blockSize    ] ) );
+                auto d2 = op( Load<src1Aligned>( &src1[blockSize * 2] ), Op::LoadU( &src2[blockSize * 2] ) );
+                auto d3 = op( Load<src1Aligned>( &src1[blockSize * 3] ), Op::LoadU( &src2[blockSize * 3] ) );
+
+                Store<dstAligned>( d0,  dst );
+                Store<dstAligned>( d1, &dst[blockSize    ] );
+                Store<dstAligned>( d2, &dst[blockSize * 2] );
+                Store<dstAligned>( d3, &dst[blockSize * 3] );
+
+                src1 += blockSize4;
+                src2 += blockSize4;
+                dst  += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( op( Load<src1Aligned>( src1 ), Op::LoadU( src2 ) ), dst );
+
+                src1 += blockSize;
+                src2 += blockSize;
+                dst  += blockSize;
+            }
+
+            // remainder for compiler to decide
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst = op( *src1, *src2 );
+
+                src1++;
+                src2++;
+                dst++;
+            }
+        }
+    };
+
+    // Reduces vector to a single value. Uses 4 independent accumulators, which are then combined together.
+    struct ReduceImpl
+    {
+        template <typename srcAligned, typename unused, typename T, typename Operation> static T Run( const T* src, size_t size, const Operation& op )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            const size_t blockSize4       = blockSize * 4;
+            size_t       blockIterations4 = size / blockSize4;
+            size_t       blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
+            size_t       remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
+
+            auto acc0 = Op::Set1( op.Initial ), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+            // large blocks of 4
+            for ( size_t i = 0; i < blockIterations4; i++ )
+            {
+                acc0 = op.Accumulate( acc0, Load<srcAligned>(  src ) );
+                acc1 = op.Accumulate( acc1, Load<srcAligned>( &src[blockSize    ] ) );
+                acc2 = op.Accumulate( acc2, Load<srcAligned>( &src[blockSize * 2] ) );
+                acc3 = op.Accumulate( acc3, Load<srcAligned>( &src[blockSize * 3] ) );
+
+                src += blockSize4;
+            }
+
+            // small blocks of 1
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                acc0 = op.Accumulate( acc0, Load<srcAligned>( src ) );
+
+                src += blockSize;
+            }
+
+            // combine accumulators and then values of the final register
+            T mem[Op::Width];
+            T result = op.Initial;
+
+            Op::StoreU( mem, op.Combine( op.Combine( acc0, acc1 ), op.Combine( acc2, acc3 ) ) );
+
+            for ( size_t i = 0; i < blockSize; i++ )
+            {
+                result = op.Combine( result, mem[i] );
+            }
+
+            // remainder
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                result = op.Accumulate( result, *src );
+
+                src++;
+            }
+
+            return result;
+        }
+    };
+
+    // Gathers values by their indexes
+    struct GatherImpl
+    {
+        template <typename dstAligned, typename unused, typename T> static void Run( const T* src, const size_t* indexes, T* dst, size_t size )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            size_t       blockIterations  = size / blockSize;
+            size_t       remainIterations = size - blockIterations * blockSize;
+
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                Store<dstAligned>( Op::Gather( src, indexes ), dst );
+
+                indexes += blockSize;
+                dst     += blockSize;
+            }
+
+            for ( size_t i = 0; i < remainIterations; i++ )
+            {
+                *dst = src[*indexes];
+
+                indexes++;
+                dst++;
+            }
+        }
+    };
+
+    // Fused optimizer step - updates weights and up to 2 optimizer's variables per weight from gradients, which are
+    // then set to zero. Alignment is resolved for weights and gradients, while variables are accessed with unaligned
+    // loads/stores (variables, which are not used by the operation, are not accessed at all).
+    struct OptimizerStepImpl
+    {
+        template <typename weightsAligned, typename gradientsAligned, typename T, typename Operation>
+        static void Run( T* weights, T* gradients, T* var1, T* var2, size_t size, const Operation& op )
+        {
+            typedef Ops<T> Op;
+
+            const size_t blockSize        = Op::Width;
+            size_t       blockIterations  = size / blockSize;
+            size_t       remainIterations = size - blockIterations * blockSize;
+            auto         zero             = Op::Set1( T( 0 ) );
+
+            for ( size_t i = 0; i < blockIterations; i++ )
+            {
+                auto w  = Load<weightsAligned>( weights );
+                auto v1 = ( Operation::VariablesCount > 0 ) ? Op::LoadU( var1 ) : zero;
+                auto v2 = ( Operation::VariablesCount > 1 ) ? Op::LoadU( var2 ) : zero;
+
+                op( Load<gradientsAligned>( gradients ), w, v1, v2 );
+
+                Store<weightsAligned>( w, weights );
+                Store<gradientsAligned>( zero, gradients );
+
+                if ( Operation::VariablesCount > 0 )
+                {
+                    Op::StoreU( var1, v1 );
+                    var1 += blockSize;
+                }
+                if ( Operation::VariablesCount > 1 )
+                {
+                    Op::StoreU( var2, v2 );
+                    var2 += blockSize;
+                }
+
+                weights   += blockSize;
+                gradients += blockSize;
+            }
+
+            // remainder goes through zero padded registers as well, so all values are calculated the same way
+            if ( remainIterations != 0 )
+            {
+                T wMem[Op::Width]  = { };
+                T gMem[Op::Width]  = { };
+                T v1Mem[Op::Width] = { };
+                T v2Mem[Op::Width] = { };
+
+                for ( size_t i = 0; i < remainIterations; i++ )
+                {
+                    wMem[i] = weights[i];
+                    gMem[i] = gradients[i];
+
+                    if ( Operation::VariablesCount > 0 ) v1Mem[i] = var1[i];
+                    if ( Operation::VariablesCount > 1 ) v2Mem[i] = var2[i];
+                }
+
+                auto w  = Op::LoadU( wMem );
+                auto v1 = Op::LoadU( v1Mem );
+                auto v2 = Op::LoadU( v2Mem );
+
+                op( Op::LoadU( gMem ), w, v1, v2 );
+
+                Op::StoreU( wMem, w );
+                Op::StoreU( v1Mem, v1 );
+                Op::StoreU( v2Mem, v2 );
+
+                for ( size_t i = 0; i < remainIterations; i++ )
+                {
+                    weights[i]   = wMem[i];
+                    gradients[i] = T( 0 );
+
+                    if ( Operation::VariablesCount > 0 ) var1[i] = v1Mem[i];
+                    if ( Operation::VariablesCount > 1 ) var2[i] = v2Mem[i];
+                }
+            }
+        }
+    };
+
+    // Element-wise operations to use with TransformImpl
+    template <typename T> struct AxpyOp
+    {
+        static const bool ReadsDestination = true;
+
+        typename Ops<T>::Vector Alpha;
+
+        AxpyOp( T alpha ) : Alpha( Ops<T>::Set1( alpha ) ) { }
+
+        inline typename Ops<T>::Vector operator()( typename Ops<T>::Vector src, typename Ops<T>::Vector dst ) const
+        {
+            return Ops<T>::MAdd( Alpha, src, dst );
+        }
+    };
+
+    template <typename T> struct ScaleOp
+    {
+        static const bool ReadsDestination = false;
+
+        typename Ops<T>::Vector Alpha, Beta;
+
+        ScaleOp( T alpha, T beta ) : Alpha( Ops<T>::Set1( alpha ) ), Beta( Ops<T>::Set1( beta ) ) { }
+
+        inline typename Ops<T>::Vector operator()( typename Ops<T>::Vector src, typename Ops<T>::Vector ) const
+        {
+            return Ops<T>::MAdd( Alpha, src, Beta );
+        }
+    };
+
+    template <typename T> struct ScaledAddOp
+    {
+        static const bool ReadsDestination = true;
+
+        typename Ops<T>::Vector Alpha, Beta;
+
+        ScaledAddOp( T alpha, T beta ) : Alpha( Ops<T>::Set1( alpha ) ), Beta( Ops<T>::Set1( beta ) ) { }
+
+        inline typename Ops<T>::Vector operator()( typename Ops<T>::Vector src, typename Ops<T>::Vector dst ) const
+        {
+            return Ops<T>::MAdd( Alpha, src, Ops<T>::Mul( Beta, dst ) );
+        }
+    };
+
+    // Exponent of single precision values: x = n * ln(2) + r, exp(x) = 2^n * exp(r), where |r| <= ln(2)/2
+    // and exp(r) is approximated with polynomial (Cephes' expf). Inputs are clamped to the range, which
+    // keeps 2^n a normal number, so results saturate at ~1.2e-38 and ~2.4e38. Max error is ~1.3 ULP.
+    static inline typename Ops<float>::Vector ExpVector( typename Ops<float>::Vector x )
+    {
+        typedef Ops<float> Op;
+
+        x = Op::Min( Op::Max( x, Op::Set1( -87.3365402f ) ), Op::Set1( 88.3762589f ) );
+
+        auto n = Op::Round( Op::Mul( x, Op::Set1( 1.44269504088896341f ) ) );
+
+        // r = x - n * ln(2), with ln(2) split into two parts for better precision
+        auto r = Op::MAdd( n, Op::Set1( -0.693359375f ), x );
+        r = Op::MAdd( n, Op::Set1( 2.12194440e-4f ), r );
+
+        auto p = Op::Set1( 1.9875691500e-4f );
+        p = Op::MAdd( p, r, Op::Set1( 1.3981999507e-3f ) );
+        p = Op::MAdd( p, r, Op::Set1( 8.3334519073e-3f ) );
+        p = Op::MAdd( p, r, Op::Set1( 4.1665795894e-2f ) );
+        p = Op::MAdd( p, r, Op::Set1( 1.6666665459e-1f ) );
+        p = Op::MAdd( p, r, Op::Set1( 5.0000001201e-1f ) );
+        p = Op::MAdd( p, Op::Mul( r, r ), Op::Add( r, Op::Set1( 1.0f ) ) );
+
+        return Op::Mul( p, Op::Pow2( n ) );
+    }
+
+    struct ExpOp
+    {
+        static const bool ReadsDestination = false;
+
+        inline typename Ops<float>::Vector operator()( typename Ops<float>::Vector x, typename Ops<float>::Vector ) const
+        {
+            return ExpVector( x );
+        }
+    };
+
+    // Sigmoid of single precision values: 1 / ( 1 + exp(-x) ), max error is 3 ULP (for results above 1e-37)
+    struct SigmoidOp
+    {
+        static const bool ReadsDestination = false;
+
+        inline typename Ops<float>::Vector operator()( typename Ops<float>::Vector x, typename Ops<float>::Vector ) const
+        {
+            typedef Ops<float> Op;
+
+            auto one = Op::Set1( 1.0f );
+
+            return Op::Div( one, Op::Add( one, ExpVector( Op::Sub( Op::Set1( 0.0f ), x ) ) ) );
+        }
+    };
+
+    // Hyperbolic tangent of single precision values (Cephes' tanhf), max error is 1 ULP:
+    //   |x| <  0.625 : x + x^3 * P(x^2), where the odd polynomial avoids cancellation near zero;
+    //   |x| >= 0.625 : sign(x) * ( 1 - 2 / ( exp(2|x|) + 1 ) ).
+    struct TanhOp
+    {
+        static const bool ReadsDestination = false;
+
+        inline typename Ops<float>::Vector operator()( typename Ops<float>::Vector x, typename Ops<float>::Vector ) const
+        {
+            typedef Ops<float> Op;
+
+            auto zero = Op::Set1( 0.0f );
+            auto one  = Op::Set1( 1.0f );
+            auto absX = Op::Max( x, Op::Sub( zero, x ) );
+
+            // large values
+            auto e     = ExpVector( Op::Add( absX, absX ) );
+            auto large = Op::Sub( one, Op::Div( Op::Set1( 2.0f ), Op::Add( e, one ) ) );
+
+            large = Op::Select( x, zero, Op::Sub( zero, large ), large );
+
+            // small values
+            auto z = Op::Mul( x, x );
+            auto p = Op::Set1( -5.70498872745e-3f );
+            p = Op::MAdd( p, z, Op::Set1( 2.06390887954e-2f ) );
+            p = Op::MAdd( p, z, Op::Set1( -5.37397155531e-2f ) );
+            p = Op::MAdd( p, z, Op::Set1( 1.33314422036e-1f ) );
+            p = Op::MAdd( p, z, Op::Set1( -3.33332819422e-1f ) );
+
+            auto small = Op::MAdd( Op::Mul( p, z ), x, x );
+
+            return Op::Select( absX, Op::Set1( 0.625f ), small, large );
+        }
+    };
+
+    // Element-wise operations to use with BinaryTransformImpl
+    template <typename T> struct SigmoidDerivativeOp
+    {
+        inline typename Ops<T>::Vector operator()( typename Ops<T>::Vector y, typename Ops<T>::Vector delta ) const
+        {
+            return Ops<T>::Mul( Ops<T>::Mul( delta, y ), Ops<T>::Sub( Ops<T>::Set1( T( 1 ) ), y ) );
+        }
+
+        inline T operator()( T y, T delta ) const
+        {
+            return delta * y * ( T( 1 ) - y );
+        }
+    };
+
+    template <typename T> struct TanhDerivativeOp
+    {
+        inline typename Ops<T>::Vector operator()( typename Ops<T>::Vector y, typename Ops<T>::Vector delta ) const
+        {
+            return Ops<T>::Mul( delta, Ops<T>::Sub( Ops<T>::Set1( T( 1 ) ), Ops<T>::Mul( y, y ) ) );
+        }
+
+        inline T operator()( T y, T delta ) const
+        {
+            return delta * ( T( 1 ) - y * y );
+        }
+    };
+
+    // Operations to use with OptimizerStepImpl, which update weights and optimizer's variables from gradients
+    template <typename T> struct SgdStepOp
+    {
+        static const size_t VariablesCount = 0;
+
+        typename Ops<T>::Vector GradScale, Rate;
+
+        SgdStepOp( T gradScale, T learningRate ) :
+            GradScale( Ops<T>::Set1( gradScale ) ), Rate( Ops<T>::Set1( -learningRate ) ) { }
+
+        inline void operator()( typename Ops<T>::Vector g, typename Ops<T>::Vector& w,
+                                typename Ops<T>::Vector&, typename Ops<T>::Vector& ) const
+        {
+            w = Ops<T>::MAdd( Rate, Ops<T>::Mul( GradScale, g ), w );
+        }
+    };
+
+    template <typename T> struct MomentumStepOp
+    {
+        static const size_t VariablesCount = 1;
+
+        typename Ops<T>::Vector GradScale, Momentum, Alpha, Beta, Gamma;
+
+        MomentumStepOp( T gradScale, T momentum, T alpha, T beta, T gamma ) :
+            GradScale( Ops<T>::Set1( gradScale ) ), Momentum( Ops<T>::Set1( momentum ) ),
+            Alpha( Ops<T>::Set1( alpha ) ), Beta( Ops<T>::Set1( beta ) ), Gamma( Ops<T>::Set1( gamma ) ) { }
+
+        inline void operator()( typename Ops<T>::Vector g, typename Ops<T>::Vector& w,
+                                typename Ops<T>::Vector& velocity, typename Ops<T>::Vector& ) const
+        {
+            g        = Ops<T>::Mul( GradScale, g );
+            velocity = Ops<T>::MAdd( Alpha, g, Ops<T>::Mul( Momentum, velocity ) );
+            w        = Ops<T>::Add( w, Ops<T>::MAdd( Beta, velocity, Ops<T>::Mul( Gamma, g ) ) );
+        }
+    };
+
+    template <typename T> struct AdaptiveStepOp
+    {
+        static const size_t VariablesCount = 1;
+
+        typename Ops<T>::Vector GradScale, Decay, SqFactor, Rate, Epsilon;
+
+        AdaptiveStepOp( T gradScale, T decay, T sqFactor, T learningRate, T epsilon ) :
+            GradScale( Ops<T>::Set1( gradScale ) ), Decay( Ops<T>::Set1( decay ) ), SqFactor( Ops<T>::Set1( sqFactor ) ),
+            Rate( Ops<T>::Set1( -learningRate ) ), Epsilon( Ops<T>::Set1( epsilon ) ) { }
+
+        inline void operator()( typename Ops<T>::Vector g, typename Ops<T>::Vector& w,
+                                typename Ops<T>::Vector& sqSum, typename Ops<T>::Vector& ) const
+        {
+            g     = Ops<T>::Mul( GradScale, g );
+            sqSum = Ops<T>::MAdd( Ops<T>::Mul( SqFactor, g ), g, Ops<T>::Mul( Decay, sqSum ) );
+            w     = Ops<T>::MAdd( g, Ops<T>::Div( Rate, Ops<T>::Sqrt( Ops<T>::Add( sqSum, Epsilon ) ) ), w );
+        }
+    };
+
+    template <typename T> struct AdamStepOp
+    {
+        static const size_t VariablesCount = 2;
+
+        typename Ops<T>::Vector GradScale, B1, B2, B1c, B2c, MtScale, VtScale, Rate, Epsilon;
+
+        AdamStepOp( T gradScale, T b1, T b2, T mtScale, T vtScale, T learningRate, T epsilon ) :
+            GradScale( Ops<T>::Set1( gradScale ) ), B1( Ops<T>::Set1( b1 ) ), B2( Ops<T>::Set1( b2 ) ),
+            B1c( Ops<T>::Set1( T( 1 ) - b1 ) ), B2c( Ops<T>::Set1( T( 1 ) - b2 ) ),
+            MtScale( Ops<T>::Set1( mtScale ) ), VtScale( Ops<T>::Set1( vtScale ) ),
+            Rate( Ops<T>::Set1( -learningRate ) ), Epsilon( Ops<T>::Set1( epsilon ) ) { }
+
+        inline void operator()( typename Ops<T>::Vector g, typename Ops<T>::Vector& w,
+                                typename Ops<T>::Vector& mt, typename Ops<T>::Vector& vt ) const
+        {
+            g  = Ops<T>::Mul( GradScale, g );
+            mt = Ops<T>::MAdd( B1, mt, Ops<T>::Mul( B1c, g ) );
+            vt = Ops<T>::MAdd( B2, vt, Ops<T>::Mul( Ops<T>::Mul( B2c, g ), g ) );
+            w  = Ops<T>::Add( w, Ops<T>::Div( Ops<T>::Mul( Rate, Ops<T>::Mul( mt, MtScale ) ),
+                                              Ops<T>::Sqrt( Ops<T>::MAdd( vt, VtScale, Epsilon ) ) ) );
+        }
+    };
+
+    // Reduction operations to use with ReduceImpl
+    template <typename T> struct SumOp
+    {
+        T Initial;
+
+        SumOp( ) : Initial( T( 0 ) ) { }
+
+        inline typename Ops<T>::Vector Accumulate( typename Ops<T>::Vector acc, typename Ops<T>::Vector v ) const { return Ops<T>::Add( acc, v ); }
+        inline typename Ops<T>::Vector Combine( typename Ops<T>::Vector v1, typename Ops<T>::Vector v2 ) const    { return Ops<T>::Add( v1, v2 ); }
+        inline T Accumulate( T acc, T v ) const { return acc + v; }
+        inline T Combine( T v1, T v2 ) const    { return v1 + v2; }
+    };
+
+    template <typename T> struct SumOfSquaresOp
+    {
+        T Initial;
+
+        SumOfSquaresOp( ) : Initial( T( 0 ) ) { }
+
+        inline typename Ops<T>::Vector Accumulate( typename Ops<T>::Vector acc, typename Ops<T>::Vector v ) const { return Ops<T>::MAdd( v, v, acc ); }
+        inline typename Ops<T>::Vector Combine( typename Ops<T>::Vector v1, typename Ops<T>::Vector v2 ) const    { return Ops<T>::Add( v1, v2 ); }
+        inline T Accumulate( T acc, T v ) const { return acc + v * v; }
+        inline T Combine( T v1, T v2 ) const    { return v1 + v2; }
+    };
+
+    template <typename T> struct MinOp
+    {
+        T Initial;
+
+        MinOp( T initial ) : Initial( initial ) { }
+
+        inline typename Ops<T>::Vector Accumulate( typename Ops<T>::Vector acc, typename Ops<T>::Vector v ) const { return Ops<T>::Min( acc, v ); }
+        inline typename Ops<T>::Vector Combine( typename Ops<T>::Vector v1, typename Ops<T>::Vector v2 ) const    { return Ops<T>::Min( v1, v2 ); }
+        inline T Accumulate( T acc, T v ) const { return ( v < acc ) ? v : acc; }
+        inline T Combine( T v1, T v2 ) const    { return ( v2 < v1 ) ? v2 : v1; }
+    };
+
+    template <typename T> struct MaxOp
+    {
+        T Initial;
+
+        MaxOp( T initial ) : Initial( initial ) { }
+
+        inline typename Ops<T>::Vector Accumulate( typename Ops<T>::Vector acc, typename Ops<T>::Vector v ) const { return Ops<T>::Max( acc, v ); }
+        inline typename Ops<T>::Vector Combine( typename Ops<T>::Vector v1, typename Ops<T>::Vector v2 ) const    { return Ops<T>::Max( v1, v2 ); }
+        inline T Accumulate( T acc, T v ) const { return ( v > acc ) ? v : acc; }
+        inline T Combine( T v1, T v2 ) const    { return ( v2 > v1 ) ? v2 : v1; }
+    };
+};
+
+} } // namespace ANNT::<anonymous>
+
+#endif // ANNT_XSIMD_VECTOR_TOOLS_HPP
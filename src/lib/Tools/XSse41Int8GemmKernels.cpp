@@ -0,0 +1,90 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <cstring>
+#include <smmintrin.h>
+
+#include "XInt8GemmKernels.hpp"
+
+namespace ANNT {
+
+// Loads group of 4 values as a single 32 bit integer
+static inline int32_t LoadQuad( const uint8_t* ptr )
+{
+    int32_t quad;
+
+    memcpy( &quad, ptr, sizeof( quad ) );
+
+    return quad;
+}
+
+// u8 * s8 products summed in pairs into s16, then in pairs into s32 and added to the accumulator
+static inline __m128i MultiplyAdd( __m128i sum, __m128i a, __m128i b, __m128i ones )
+{
+    return _mm_add_epi32( sum, _mm_madd_epi16( _mm_maddubs_epi16( a, b ), ones ) );
+}
+
+// Computes 2 rows of C tile - there are not enough registers for all 4 rows
+static inline void Sse41Int8GemmKernel2x16( size_t k, const uint8_t* a0, const uint8_t* a1, const int8_t* b, int32_t* c0, int32_t* c1 )
+{
+    const __m128i ones = _mm_set1_epi16( 1 );
+    __m128i       c00  = _mm_setzero_si128( ), c01 = _mm_setzero_si128( ), c02 = _mm_setzero_si128( ), c03 = _mm_setzero_si128( );
+    __m128i       c10  = _mm_setzero_si128( ), c11 = _mm_setzero_si128( ), c12 = _mm_setzero_si128( ), c13 = _mm_setzero_si128( );
+
+    for ( size_t p = 0; p < k; p += 4, b += 64 )
+    {
+        // groups of 4 values of 4 panel rows in each register
+        __m128i b0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b ) );
+        __m128i b1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + 16 ) );
+        __m128i b2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + 32 ) );
+        __m128i b3 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + 48 ) );
+        __m128i va;
+
+        va  = _mm_set1_epi32( LoadQuad( a0 + p ) );
+        c00 = MultiplyAdd( c00, va, b0, ones );
+        c01 = MultiplyAdd( c01, va, b1, ones );
+        c02 = MultiplyAdd( c02, va, b2, ones );
+        c03 = MultiplyAdd( c03, va, b3, ones );
+
+        va  = _mm_set1_epi32( LoadQuad( a1 + p ) );
+        c10 = MultiplyAdd( c10, va, b0, ones );
+        c11 = MultiplyAdd( c11, va, b1, ones );
+        c12 = MultiplyAdd( c12, va, b2, ones );
+        c13 = MultiplyAdd( c13, va, b3, ones );
+    }
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c0 ), c00 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c0 + 4 ), c01 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c0 + 8 ), c02 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c0 + 12 ), c03 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c1 ), c10 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c1 + 4 ), c11 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c1 + 8 ), c12 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( c1 + 12 ), c13 );
+}
+
+// SSE4.1 implementation of INT8 GEMM micro kernel
+void Sse41Int8GemmKernel( size_t k, const uint8_t* const* a, const int8_t* b, int32_t* const* c )
+{
+    Sse41Int8GemmKernel2x16( k, a[0], a[1], b, c[0], c[1] );
+    Sse41Int8GemmKernel2x16( k, a[2], a[3], b, c[2], c[3] );
+}
+
+} // namespace ANNT
@@ -18,14 +18,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
-#include <type_traits>
-
-#ifdef _MSC_VER
-    #include <intrin.h>
-#elif __GNUC__
-    #include <x86intrin.h>
-#endif
-
+#include "XSimdVectorTools.hpp"
 #include "XSseVectorTools.hpp"
 #include "XCpu.hpp"
 
@@ -33,568 +26,347 @@
 
 namespace ANNT {
 
-// Helper class wrapping some SSE intrinsics
-class SseTools
+namespace {
+
+// Wrappers of SSE intrinsics for single/double precision numbers
+template <typename T> struct SseOps;
+
+template <> struct SseOps<float>
 {
-public:
-    // Add two vectors: dst[i] += src[i]
-    template <typename T> static inline void Add( const T* src, T* dst, size_t size )
+    typedef __m128 Vector;
+
+    static const size_t Width     = 4;
+    static const size_t Alignment = 16;
+
+    static inline Vector Load( const float* src )                { return _mm_load_ps( src ); }
+    static inline Vector LoadU( const float* src )               { return _mm_loadu_ps( src ); }
+    static inline void   Store( float* dst, Vector value )       { _mm_store_ps( dst, value ); }
+    static inline void   StoreU( float* dst, Vector value )      { _mm_storeu_ps( dst, value ); }
+    static inline Vector Set1( float value )                     { return _mm_set1_ps( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm_add_ps( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm_mul_ps( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm_sub_ps( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm_div_ps( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm_sqrt_ps( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm_max_ps( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm_min_ps( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm_add_ps( _mm_mul_ps( v1, v2 ), v3 ); }
+    static inline Vector Round( Vector value )                   { return _mm_cvtepi32_ps( _mm_cvtps_epi32( value ) ); }
+
+    // ( a < b ) ? v1 : v2
+    static inline Vector Select( Vector a, Vector b, Vector v1, Vector v2 )
     {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Add<T, std::true_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Add<T, std::true_type, std::false_type>( src, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Add<T, std::false_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Add<T, std::false_type, std::false_type>( src, dst, size );
-            }
-        }
-    }
+        Vector mask = _mm_cmplt_ps( a, b );
 
-    // Multiply two vectors: dst[i] *= src[i]
-    template <typename T> static inline void Mul( const T* src, T* dst, size_t size )
-    {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Mul<T, std::true_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Mul<T, std::true_type, std::false_type>( src, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Mul<T, std::false_type, std::true_type>( src, dst, size );
-            }
-            else
-            {
-                Mul<T, std::false_type, std::false_type>( src, dst, size );
-            }
-        }
+        return _mm_or_ps( _mm_and_ps( mask, v1 ), _mm_andnot_ps( mask, v2 ) );
     }
 
-    // Dot product: sum( vec1[i] * vec2[i] )
-    template <typename T> static inline T Dot( const T* vec1, const T* vec2, size_t size )
+    // 2^n is built directly from exponent bits: ( n + 127 ) << 23
+    static inline Vector Pow2( Vector n )
     {
-        T dotProduct;
-
-        if ( IsAligned( vec1 ) )
-        {
-            if ( IsAligned( vec2 ) )
-            {
-                dotProduct = Dot<T, std::true_type, std::true_type>( vec1, vec2, size );
-            }
-            else
-            {
-                dotProduct = Dot<T, std::true_type, std::false_type>( vec1, vec2, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( vec2 ) )
-            {
-                dotProduct = Dot<T, std::false_type, std::true_type>( vec1, vec2, size );
-            }
-            else
-            {
-                dotProduct = Dot<T, std::false_type, std::false_type>( vec1, vec2, size );
-            }
-        }
-
-        return dotProduct;
+        return _mm_castsi128_ps( _mm_cvtps_epi32( _mm_mul_ps( _mm_add_ps( n, _mm_set1_ps( 127.0f ) ), _mm_set1_ps( 8388608.0f ) ) ) );
     }
 
-    // Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
-    template <typename T> static inline void Max( const T* src, T alpha, T* dst, size_t size )
+    static inline Vector Gather( const float* src, const size_t* idx )
     {
-        if ( IsAligned( src ) )
-        {
-            if ( IsAligned( dst ) )
-            {
-                Max<T, std::true_type, std::true_type>( src, alpha, dst, size );
-            }
-            else
-            {
-                Max<T, std::true_type, std::false_type>( src, alpha, dst, size );
-            }
-        }
-        else
-        {
-            if ( IsAligned( dst ) )
-            {
-                Max<T, std::false_type, std::true_type>( src, alpha, dst, size );
-            }
-            else
-            {
-                Max<T, std::false_type, std::false_type>( src, alpha, dst, size );
-            }
-        }
+        return _mm_set_ps( src[idx[3]], src[idx[2]], src[idx[1]], src[idx[0]] );
     }
 
-private:
-
-    // Unroll size for single/double precision numbers - number of those in SSE register
-    template <typename T> static inline size_t UnrollSize( );
-
-    // Load 4 single / 2 double precision numbers into SSE register
-    template <typename isAligned> static inline __m128  Load( const float*  src );
-    template <typename isAligned> static inline __m128d Load( const double* src );
+    static inline float  Sum( Vector value )
+    {
+        float mem[4];
 
-    // Store 4 single / 2 double precision numbers from SSE register into memory
-    template <typename isAligned> static inline void Store( const __m128&  value, float*  dst );
-    template <typename isAligned> static inline void Store( const __m128d& value, double* dst );
+        _mm_storeu_ps( mem, value );
 
-    // Check if the pointer is SSE-aligned (16 byte aligned)
-    template <typename T> static inline bool IsAligned( const T* ptr )
-    {
-        return ( ( reinterpret_cast<uintptr_t>( ptr ) % 16 ) == 0 );
+        return mem[0] + mem[1] + mem[2] + mem[3];
     }
+};
 
-    // Initialize 4 single / 2 double precision numbers of SSE register with the specified value
-    static inline __m128 Set1( float value )
+template <> struct SseOps<double>
+{
+    typedef __m128d Vector;
+
+    static const size_t Width     = 2;
+    static const size_t Alignment = 16;
+
+    static inline Vector Load( const double* src )               { return _mm_load_pd( src ); }
+    static inline Vector LoadU( const double* src )              { return _mm_loadu_pd( src ); }
+    static inline void   Store( double* dst, Vector value )      { _mm_store_pd( dst, value ); }
+    static inline void   StoreU( double* dst, Vector value )     { _mm_storeu_pd( dst, value ); }
+    static inline Vector Set1( double value )                    { return _mm_set1_pd( value ); }
+    static inline Vector Add( Vector v1, Vector v2 )             { return _mm_add_pd( v1, v2 ); }
+    static inline Vector Mul( Vector v1, Vector v2 )             { return _mm_mul_pd( v1, v2 ); }
+    static inline Vector Sub( Vector v1, Vector v2 )             { return _mm_sub_pd( v1, v2 ); }
+    static inline Vector Div( Vector v1, Vector v2 )             { return _mm_div_pd( v1, v2 ); }
+    static inline Vector Sqrt( Vector value )                    { return _mm_sqrt_pd( value ); }
+    static inline Vector Max( Vector v1, Vector v2 )             { return _mm_max_pd( v1, v2 ); }
+    static inline Vector Min( Vector v1, Vector v2 )             { return _mm_min_pd( v1, v2 ); }
+    static inline Vector MAdd( Vector v1, Vector v2, Vector v3 ) { return _mm_add_pd( _mm_mul_pd( v1, v2 ), v3 ); }
+
+    static inline Vector Gather( const double* src, const size_t* idx )
     {
-        return _mm_set1_ps( value );
+        return _mm_set_pd( src[idx[1]], src[idx[0]] );
     }
-    static inline __m128d Set1( double value )
+
+    static inline double  Sum( Vector value )
     {
-        return _mm_set1_pd( value );
-    }
+        double mem[2];
 
-    // Sum 4 single / 2 double precision numbers of SSE register
-    static inline float Sum( __m128 value );
-    static inline double Sum( __m128d value );
+        _mm_storeu_pd( mem, value );
 
-    // Add 4 single / 2 double precision numbers
-    static inline __m128 Add( const __m128& value1, const __m128& value2 )
-    {
-        return _mm_add_ps( value1, value2 );
-    }
-    static inline __m128d Add( const __m128d& value1, const __m128d& value2 )
-    {
-        return _mm_add_pd( value1, value2 );
+        return mem[0] + mem[1];
     }
+};
 
-    // Multiple 4 single / 2 double precision numbers
-    static inline __m128 Mul( const __m128& value1, const __m128& value2 )
-    {
-        return _mm_mul_ps( value1, value2 );
-    }
-    static inline __m128d Mul( const __m128d& value1, const __m128d& value2 )
-    {
-        return _mm_mul_pd( value1, value2 );
-    }
+// Vector routines built on top of SSE intrinsics
+typedef SimdTools<SseOps> SseTools;
 
-    // Multiple and Add 4 single / 2 double precision numbers: value1 * value2 + value3
-    static inline __m128 MAdd( const __m128& value1, const __m128& value2, const __m128& value3 )
-    {
-        return _mm_add_ps( _mm_mul_ps( value1, value2 ), value3 );
-    }
-    static inline __m128d MAdd( const __m128d& value1, const __m128d& value2, const __m128d& value3 )
-    {
-        return _mm_add_pd( _mm_mul_pd( value1, value2 ), value3 );
-    }
+} // namespace <anonymous>
 
-    // Maximum of 8 single / 4 double precision numbers
-    static inline __m128 Max( const __m128& value1, const __m128& value2 )
-    {
-        return _mm_max_ps( value1, value2 );
-    }
-    static inline __m128d Max( const __m128d& value1, const __m128d& value2 )
-    {
-        return _mm_max_pd( value1, value2 );
-    }
+/* ============================================================================= */
 
-    // Add two vectors
-    template <typename T, typename srcAligned, typename dstAligned> static void Add( const T* src, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-            auto d0 = Load<dstAligned>(  dst );
-            auto d1 = Load<dstAligned>( &dst[blockSize ] );
-            auto d2 = Load<dstAligned>( &dst[blockSize2] );
-            auto d3 = Load<dstAligned>( &dst[blockSize3] );
-
-            d0 = Add( s0, d0 );
-            d1 = Add( s1, d1 );
-            d2 = Add( s2, d2 );
-            d3 = Add( s3, d3 );
-
-            Store<dstAligned>( d0,  dst );
-            Store<dstAligned>( d1, &dst[blockSize ] );
-            Store<dstAligned>( d2, &dst[blockSize2] );
-            Store<dstAligned>( d3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-            auto d = Load<dstAligned>( dst );
-
-            d = Add( s, d );
-
-            Store<dstAligned>( d, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst += *src;
-
-            src++;
-            dst++;
-        }
-    }
+// Check if the implementation of vector tools is available on the current system
+bool XSseVectorTools::IsAvailable( ) const
+{
+    // the double precision part requires SSE2
+#if defined(ANNT_USE_SSE)
+    return XCpu::IsFeatureSupported( XCpu::Reg_EDX, XCpu::Flag_SSE2 );
+#else
+    return false;
+#endif
+}
 
-    // Multiply two vectors
-    template <typename T, typename srcAligned, typename dstAligned> static void Mul( const T* src, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-            auto d0 = Load<dstAligned>(  dst );
-            auto d1 = Load<dstAligned>( &dst[blockSize ] );
-            auto d2 = Load<dstAligned>( &dst[blockSize2] );
-            auto d3 = Load<dstAligned>( &dst[blockSize3] );
-
-            d0 = Mul( s0, d0 );
-            d1 = Mul( s1, d1 );
-            d2 = Mul( s2, d2 );
-            d3 = Mul( s3, d3 );
-
-            Store<dstAligned>( d0, dst );
-            Store<dstAligned>( d1, &dst[blockSize ] );
-            Store<dstAligned>( d2, &dst[blockSize2] );
-            Store<dstAligned>( d3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-            auto d = Load<dstAligned>( dst );
-
-            d = Mul( s, d );
-
-            Store<dstAligned>( d, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst *= *src;
-
-            src++;
-            dst++;
-        }
-    }
+// Add two vectors: dst[i] += src[i]
+void XSseVectorTools::Add( const float* src, float* dst, size_t size ) const
+{
+    SseTools::Add( src, dst, size );
+}
+void XSseVectorTools::Add( const double* src, double* dst, size_t size ) const
+{
+    SseTools::Add( src, dst, size );
+}
 
-    // Dot product of two vectors
-    template <typename T, typename vec1Aligned, typename vec2Aligned> static T Dot( const T* vec1, const T* vec2, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-
-        auto   sum0 = Set1( T( 0 ) );
-        auto   sum1 = Set1( T( 0 ) );
-        auto   sum2 = Set1( T( 0 ) );
-        auto   sum3 = Set1( T( 0 ) );
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto v10 = Load<vec1Aligned>(  vec1 );
-            auto v11 = Load<vec1Aligned>( &vec1[blockSize ] );
-            auto v12 = Load<vec1Aligned>( &vec1[blockSize2] );
-            auto v13 = Load<vec1Aligned>( &vec1[blockSize3] );
-            auto v20 = Load<vec2Aligned>(  vec2 );
-            auto v21 = Load<vec2Aligned>( &vec2[blockSize ] );
-            auto v22 = Load<vec2Aligned>( &vec2[blockSize2] );
-            auto v23 = Load<vec2Aligned>( &vec2[blockSize3] );
-
-            sum0 = MAdd( v10, v20, sum0 );
-            sum1 = MAdd( v11, v21, sum1 );
-            sum2 = MAdd( v12, v22, sum2 );
-            sum3 = MAdd( v13, v23, sum3 );
-
-            vec1 += blockSize4;
-            vec2 += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto v1 = Load<vec1Aligned>( vec1 );
-            auto v2 = Load<vec2Aligned>( vec2 );
-
-            sum0 = MAdd( v1, v2, sum0 );
-
-            vec1 += blockSize;
-            vec2 += blockSize;
-        }
-
-        sum0  = Add( sum0, sum1 );
-        sum0  = Add( sum0, sum2 );
-        sum0  = Add( sum0, sum3 );
-
-        T sum = Sum( sum0 );
-
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            sum += *vec1 * *vec2;
-
-            vec1++;
-            vec2++;
-        }
-
-        return sum;
-    }
+// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
+void XSseVectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+{
+    SseTools::Mul( src, dst, size );
+}
+void XSseVectorTools::Mul( const double* src, double* dst, size_t size ) const
+{
+    SseTools::Mul( src, dst, size );
+}
 
-    // Maximum value of vector's elements and the specified alpha value
-    template <typename T, typename srcAligned, typename dstAligned> static void Max( const T* src, T alpha, T* dst, size_t size )
-    {
-        size_t blockSize        = UnrollSize<T>( );
-        size_t blockSize2       = blockSize * 2;
-        size_t blockSize3       = blockSize * 3;
-        size_t blockSize4       = blockSize * 4;
-        size_t blockIterations4 = size / blockSize4;
-        size_t blockIterations  = ( size - blockIterations4 * blockSize4 ) / blockSize;
-        size_t remainIterations = size - blockIterations4 * blockSize4 - blockIterations * blockSize;
-        auto   alphaVec         = Set1( alpha );
-
-        // large blocks of 4
-        for ( size_t i = 0; i < blockIterations4; i++ )
-        {
-            auto s0 = Load<srcAligned>(  src );
-            auto s1 = Load<srcAligned>( &src[blockSize ] );
-            auto s2 = Load<srcAligned>( &src[blockSize2] );
-            auto s3 = Load<srcAligned>( &src[blockSize3] );
-
-            s0 = Max( s0, alphaVec );
-            s1 = Max( s1, alphaVec );
-            s2 = Max( s2, alphaVec );
-            s3 = Max( s3, alphaVec );
-
-            Store<dstAligned>( s0,  dst );
-            Store<dstAligned>( s1, &dst[blockSize ] );
-            Store<dstAligned>( s2, &dst[blockSize2] );
-            Store<dstAligned>( s3, &dst[blockSize3] );
-
-            src += blockSize4;
-            dst += blockSize4;
-        }
-
-        // small blocks of 1
-        for ( size_t i = 0; i < blockIterations; i++ )
-        {
-            auto s = Load<srcAligned>( src );
-
-            s = Max( s, alphaVec );
-
-            Store<dstAligned>( s, dst );
-
-            src += blockSize;
-            dst += blockSize;
-        }
-
-        // remainder for compiler to decide
-        for ( size_t i = 0; i < remainIterations; i++ )
-        {
-            *dst = ( *src > alpha ) ? *src : alpha;
-
-            src++;
-            dst++;
-        }
-    }
-};
+// Dot product of two vectors: sum( vec1[i] * vec2[i] )
+float XSseVectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+{
+    return SseTools::Dot( vec1, vec2, size );
+}
+double XSseVectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+{
+    return SseTools::Dot( vec1, vec2, size );
+}
 
-// Unroll size for single/double precision numbers - number of those in SSE register
-template <> inline size_t SseTools::UnrollSize<float>( )
+// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
+void XSseVectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
 {
-    return 4;
+    SseTools::Max( src, alpha, dst, size );
 }
-template <> inline size_t SseTools::UnrollSize<double>( )
+void XSseVectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
 {
-    return 2;
+    SseTools::Max( src, alpha, dst, size );
 }
 
-// Load 4 aligned single precision numbers
-template <> inline __m128 SseTools::Load<std::true_type>( const float* src )
+// Scales vector and adds it to another one: dst[i] += alpha * src[i]
+void XSseVectorTools::Axpy( const float* src, float alpha, float* dst, size_t size ) const
 {
-    return _mm_load_ps( src );
+    SseTools::Axpy( src, alpha, dst, size );
+}
+void XSseVectorTools::Axpy( const double* src, double alpha, double* dst, size_t size ) const
+{
+    SseTools::Axpy( src, alpha, dst, size );
 }
 
-// Load 8 unaligned single precision numbers
-template <> inline __m128 SseTools::Load<std::false_type>( const float* src )
+// Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+void XSseVectorTools::Scale( const float* src, float alpha, float beta, float* dst, size_t size ) const
 {
-    return _mm_loadu_ps( src );
+    SseTools::Scale( src, alpha, beta, dst, size );
+}
+void XSseVectorTools::Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    SseTools::Scale( src, alpha, beta, dst, size );
 }
 
-// Load 4 aligned double precision numbers
-template <> inline __m128d SseTools::Load<std::true_type>( const double* src )
+// Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+void XSseVectorTools::ScaledAdd( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    SseTools::ScaledAdd( src, alpha, beta, dst, size );
+}
+void XSseVectorTools::ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const
 {
-    return _mm_load_pd( src );
+    SseTools::ScaledAdd( src, alpha, beta, dst, size );
 }
 
-// Load 4 unaligned double precision numbers
-template <> inline __m128d SseTools::Load<std::false_type>( const double* src )
+// Element wise multiply-add: dst[i] += src1[i] * src2[i]
+void XSseVectorTools::MulAdd( const float* src1, const float* src2, float* dst, size_t size ) const
+{
+    SseTools::MulAdd( src1, src2, dst, size );
+}
+void XSseVectorTools::MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const
 {
-    return _mm_loadu_pd( src );
+    SseTools::MulAdd( src1, src2, dst, size );
 }
 
-// Store 4 signle precision numbers into aligned memory
-template <> inline void SseTools::Store<std::true_type>( const __m128& value, float* dst )
+// Sum of vector's elements: sum( src[i] )
+float XSseVectorTools::Sum( const float* src, size_t size ) const
 {
-    _mm_store_ps( dst, value );
+    return SseTools::Sum( src, size );
+}
+double XSseVectorTools::Sum( const double* src, size_t size ) const
+{
+    return SseTools::Sum( src, size );
 }
 
-// Store 4 signle precision numbers into unaligned memory
-template <> inline void SseTools::Store<std::false_type>( const __m128& value, float* dst )
+// Sum of squared vector's elements: sum( src[i] * src[i] )
+float XSseVectorTools::SumOfSquares( const float* src, size_t size ) const
+{
+    return SseTools::SumOfSquares( src, size );
+}
+double XSseVectorTools::SumOfSquares( const double* src, size_t size ) const
 {
-    _mm_storeu_ps( dst, value );
+    return SseTools::SumOfSquares( src, size );
 }
 
-// Store 2 double precision numbers into aligned memory
-template <> inline void SseTools::Store<std::true_type>( const __m128d& value, double* dst )
+// Minimum of vector's elements (0 for empty vector)
+float XSseVectorTools::MinValue( const float* src, size_t size ) const
 {
-    _mm_store_pd( dst, value );
+    return SseTools::MinValue( src, size );
+}
+double XSseVectorTools::MinValue( const double* src, size_t size ) const
+{
+    return SseTools::MinValue( src, size );
 }
 
-// Store 2 double precision numbers into unaligned memory
-template <> inline void SseTools::Store<std::false_type>( const __m128d& value, double* dst )
+// Maximum of vector's elements (0 for empty vector)
+float XSseVectorTools::MaxValue( const float* src, size_t size ) const
 {
-    _mm_storeu_pd( dst, value );
+    return SseTools::MaxValue( src, size );
+}
+double XSseVectorTools::MaxValue( const double* src, size_t size ) const
+{
+    return SseTools::MaxValue( src, size );
 }
 
-// Sum 4 single / 2 double precision numbers of SSE register
-inline float SseTools::Sum( __m128 value )
+// Index of the first maximum element of the vector (0 for empty vector)
+size_t XSseVectorTools::ArgMax( const float* src, size_t size ) const
+{
+    return SseTools::ArgMax( src, size );
+}
+size_t XSseVectorTools::ArgMax( const double* src, size_t size ) const
 {
-    float mem[4];
+    return SseTools::ArgMax( src, size );
+}
 
-    Store<std::false_type>( value, mem );
+// Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+void XSseVectorTools::Gather( const float* src, const size_t* indexes, float* dst, size_t size ) const
+{
+    SseTools::Gather( src, indexes, dst, size );
+}
+void XSseVectorTools::Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const
+{
+    SseTools::Gather( src, indexes, dst, size );
+}
 
-    return mem[0] + mem[1] + mem[2] + mem[3];
+// Exponent of vector's elements: dst[i] = exp( src[i] )
+void XSseVectorTools::Exp( const float* src, float* dst, size_t size ) const
+{
+    SseTools::Exp( src, dst, size );
 }
-inline double SseTools::Sum( __m128d value )
+void XSseVectorTools::Exp( const double* src, double* dst, size_t size ) const
 {
-    double mem[2];
+    SseTools::Exp( src, dst, size );
+}
 
-    Store<std::false_type>( value, mem );
+// Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+void XSseVectorTools::Sigmoid( const float* src, float* dst, size_t size ) const
+{
+    SseTools::Sigmoid( src, dst, size );
+}
+void XSseVectorTools::Sigmoid( const double* src, double* dst, size_t size ) const
+{
+    SseTools::Sigmoid( src, dst, size );
+}
 
-    return mem[0] + mem[1];
+// Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+void XSseVectorTools::Tanh( const float* src, float* dst, size_t size ) const
+{
+    SseTools::Tanh( src, dst, size );
+}
+void XSseVectorTools::Tanh( const double* src, double* dst, size_t size ) const
+{
+    SseTools::Tanh( src, dst, size );
 }
 
-/* ============================================================================= */
+// Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+void XSseVectorTools::SigmoidDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    SseTools::SigmoidDerivative( y, delta, dst, size );
+}
+void XSseVectorTools::SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    SseTools::SigmoidDerivative( y, delta, dst, size );
+}
 
-// Check if the implementation of vector tools is available on the current system
-bool XSseVectorTools::IsAvailable( ) const
+// Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+void XSseVectorTools::TanhDerivative( const float* y, const float* delta, float* dst, size_t size ) const
 {
-    // the double precision part requires SSE2
-#if defined(ANNT_USE_SSE)
-    return XCpu::IsFeatureSupported( XCpu::Reg_EDX, XCpu::Flag_SSE2 );
-#else
-    return false;
-#endif
+    SseTools::TanhDerivative( y, delta, dst, size );
+}
+void XSseVectorTools::TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    SseTools::TanhDerivative( y, delta, dst, size );
 }
 
-// Add two vectors: dst[i] += src[i]
-void XSseVectorTools::Add( const float* src, float* dst, size_t size ) const
+// Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+void XSseVectorTools::SgdStep( float* weights, float* gradients, float gradScale, float learningRate, size_t size ) const
 {
-    SseTools::Add( src, dst, size );
+    SseTools::SgdStep( weights, gradients, gradScale, learningRate, size );
 }
-void XSseVectorTools::Add( const double* src, double* dst, size_t size ) const
+void XSseVectorTools::SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const
 {
-    SseTools::Add( src, dst, size );
-};
+    SseTools::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
 
-// Element wise multiplication of two vectors (Hadamard product): dst[i] *= src[i]
-void XSseVectorTools::Mul( const float*  src, float*  dst, size_t size ) const
+// Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+//   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+void XSseVectorTools::MomentumStep( float* weights, float* gradients, float* velocity, float gradScale, float momentum, float alpha, float beta, float gamma, size_t size ) const
 {
-    SseTools::Mul( src, dst, size );
+    SseTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
 }
-void XSseVectorTools::Mul( const double* src, double* dst, size_t size ) const
+void XSseVectorTools::MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const
 {
-    SseTools::Mul( src, dst, size );
+    SseTools::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
 }
 
-// Dot product of two vectors: sum( vec1[i] * vec2[i] )
-float XSseVectorTools::Dot( const float* vec1, const float* vec2, size_t size ) const
+// Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+//   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+void XSseVectorTools::AdaptiveStep( float* weights, float* gradients, float* sqSum, float gradScale, float decay, float sqFactor, float learningRate, float epsilon, size_t size ) const
 {
-    return SseTools::Dot( vec1, vec2, size );
+    SseTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
 }
-double XSseVectorTools::Dot( const double* vec1, const double* vec2, size_t size ) const
+void XSseVectorTools::AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const
 {
-    return SseTools::Dot( vec1, vec2, size );
+    SseTools::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
 }
 
-// Calculates maximum of the vector's elements and the specified value: dst[i] = max( src[i], alpha )
-void XSseVectorTools::Max( const float* src, float alpha, float* dst, size_t size ) const
+// Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+//   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+void XSseVectorTools::AdamStep( float* weights, float* gradients, float* mt, float* vt, float gradScale, float b1, float b2, float mtScale, float vtScale, float learningRate, float epsilon, size_t size ) const
 {
-    SseTools::Max( src, alpha, dst, size );
+    SseTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
 }
-void XSseVectorTools::Max( const double* src, double alpha, double* dst, size_t size ) const
+void XSseVectorTools::AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const
 {
-    SseTools::Max( src, alpha, dst, size );
+    SseTools::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
 }
 
 } // namespace ANNT
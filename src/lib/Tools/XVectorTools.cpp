@@ -19,6 +19,7 @@
 */
 
 #include "XVectorTools.hpp"
+#include <cmath>
 
 namespace ANNT {
 
@@ -65,6 +66,212 @@ public:
             dst[i] = ( src[i] > alpha ) ? src[i] : alpha;
         }
     }
+
+    // Scales vector and adds it to another one: dst[i] += alpha * src[i]
+    template <typename T> static inline void Axpy( const T* src, T alpha, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    // Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+    template <typename T> static inline void Scale( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = alpha * src[i] + beta;
+        }
+    }
+
+    // Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+    template <typename T> static inline void ScaledAdd( const T* src, T alpha, T beta, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = alpha * src[i] + beta * dst[i];
+        }
+    }
+
+    // Element wise multiply-add: dst[i] += src1[i] * src2[i]
+    template <typename T> static inline void MulAdd( const T* src1, const T* src2, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] += src1[i] * src2[i];
+        }
+    }
+
+    // Sum of vector's elements
+    template <typename T> static inline T Sum( const T* src, size_t size )
+    {
+        T sum = T( 0 );
+
+        for ( size_t i = 0; i < size; i++ )
+        {
+            sum += src[i];
+        }
+
+        return sum;
+    }
+
+    // Sum of squared vector's elements
+    template <typename T> static inline T SumOfSquares( const T* src, size_t size )
+    {
+        T sum = T( 0 );
+
+        for ( size_t i = 0; i < size; i++ )
+        {
+            sum += src[i] * src[i];
+        }
+
+        return sum;
+    }
+
+    // Minimum/maximum of vector's elements
+    template <typename T> static inline T MinValue( const T* src, size_t size )
+    {
+        T minValue = ( size == 0 ) ? T( 0 ) : src[0];
+
+        for ( size_t i = 1; i < size; i++ )
+        {
+            if ( src[i] < minValue ) minValue = src[i];
+        }
+
+        return minValue;
+    }
+    template <typename T> static inline T MaxValue( const T* src, size_t size )
+    {
+        T maxValue = ( size == 0 ) ? T( 0 ) : src[0];
+
+        for ( size_t i = 1; i < size; i++ )
+        {
+            if ( src[i] > maxValue ) maxValue = src[i];
+        }
+
+        return maxValue;
+    }
+
+    // Index of the first maximum element of the vector
+    template <typename T> static inline size_t ArgMax( const T* src, size_t size )
+    {
+        size_t maxIndex = 0;
+
+        for ( size_t i = 1; i < size; i++ )
+        {
+            if ( src[i] > src[maxIndex] ) maxIndex = i;
+        }
+
+        return maxIndex;
+    }
+
+    // Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+    template <typename T> static inline void Gather( const T* src, const size_t* indexes, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = src[indexes[i]];
+        }
+    }
+
+    // Exponent of vector's elements: dst[i] = exp( src[i] )
+    template <typename T> static inline void Exp( const T* src, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = std::exp( src[i] );
+        }
+    }
+
+    // Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+    template <typename T> static inline void Sigmoid( const T* src, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = T( 1 ) / ( T( 1 ) + std::exp( -src[i] ) );
+        }
+    }
+
+    // Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+    template <typename T> static inline void Tanh( const T* src, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = std::tanh( src[i] );
+        }
+    }
+
+    // Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+    template <typename T> static inline void SigmoidDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = delta[i] * y[i] * ( T( 1 ) - y[i] );
+        }
+    }
+
+    // Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+    template <typename T> static inline void TanhDerivative( const T* y, const T* delta, T* dst, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            dst[i] = delta[i] * ( T( 1 ) - y[i] * y[i] );
+        }
+    }
+
+    // Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+    template <typename T> static inline void SgdStep( T* weights, T* gradients, T gradScale, T learningRate, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            weights[i]  += -learningRate * ( gradScale * gradients[i] );
+            gradients[i] = T( 0 );
+        }
+    }
+
+    // Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+    //   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+    template <typename T> static inline void MomentumStep( T* weights, T* gradients, T* velocity, T gradScale, T momentum, T alpha, T beta, T gamma, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            T g = gradScale * gradients[i];
+
+            velocity[i]  = alpha * g + momentum * velocity[i];
+            weights[i]  += beta * velocity[i] + gamma * g;
+            gradients[i] = T( 0 );
+        }
+    }
+
+    // Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+    //   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+    template <typename T> static inline void AdaptiveStep( T* weights, T* gradients, T* sqSum, T gradScale, T decay, T sqFactor, T learningRate, T epsilon, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            T g = gradScale * gradients[i];
+
+            sqSum[i]     = sqFactor * g * g + decay * sqSum[i];
+            weights[i]  += g * ( -learningRate / std::sqrt( sqSum[i] + epsilon ) );
+            gradients[i] = T( 0 );
+        }
+    }
+
+    // Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+    //   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+    template <typename T> static inline void AdamStep( T* weights, T* gradients, T* mt, T* vt, T gradScale, T b1, T b2, T mtScale, T vtScale, T learningRate, T epsilon, size_t size )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            T g = gradScale * gradients[i];
+
+            mt[i]        = b1 * mt[i] + ( T( 1 ) - b1 ) * g;
+            vt[i]        = b2 * vt[i] + ( T( 1 ) - b2 ) * g * g;
+            weights[i]  += -learningRate * ( mt[i] * mtScale ) / std::sqrt( vt[i] * vtScale + epsilon );
+            gradients[i] = T( 0 );
+        }
+    }
 };
 
 /* ============================================================================= */
@@ -115,4 +322,197 @@ void XVectorTools::Max( const double* src, double alpha, double* dst, size_t siz
     VectorToolsImpl::Max( src, alpha, dst, size );
 }
 
+// Scales vector and adds it to another one: dst[i] += alpha * src[i]
+void XVectorTools::Axpy( const float* src, float alpha, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Axpy( src, alpha, dst, size );
+}
+void XVectorTools::Axpy( const double* src, double alpha, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Axpy( src, alpha, dst, size );
+}
+
+// Scales and shifts vector's elements: dst[i] = alpha * src[i] + beta
+void XVectorTools::Scale( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Scale( src, alpha, beta, dst, size );
+}
+void XVectorTools::Scale( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Scale( src, alpha, beta, dst, size );
+}
+
+// Weighted sum of two vectors: dst[i] = alpha * src[i] + beta * dst[i]
+void XVectorTools::ScaledAdd( const float* src, float alpha, float beta, float* dst, size_t size ) const
+{
+    VectorToolsImpl::ScaledAdd( src, alpha, beta, dst, size );
+}
+void XVectorTools::ScaledAdd( const double* src, double alpha, double beta, double* dst, size_t size ) const
+{
+    VectorToolsImpl::ScaledAdd( src, alpha, beta, dst, size );
+}
+
+// Element wise multiply-add: dst[i] += src1[i] * src2[i]
+void XVectorTools::MulAdd( const float* src1, const float* src2, float* dst, size_t size ) const
+{
+    VectorToolsImpl::MulAdd( src1, src2, dst, size );
+}
+void XVectorTools::MulAdd( const double* src1, const double* src2, double* dst, size_t size ) const
+{
+    VectorToolsImpl::MulAdd( src1, src2, dst, size );
+}
+
+// Sum of vector's elements: sum( src[i] )
+float XVectorTools::Sum( const float* src, size_t size ) const
+{
+    return VectorToolsImpl::Sum( src, size );
+}
+double XVectorTools::Sum( const double* src, size_t size ) const
+{
+    return VectorToolsImpl::Sum( src, size );
+}
+
+// Sum of squared vector's elements: sum( src[i] * src[i] )
+float XVectorTools::SumOfSquares( const float* src, size_t size ) const
+{
+    return VectorToolsImpl::SumOfSquares( src, size );
+}
+double XVectorTools::SumOfSquares( const double* src, size_t size ) const
+{
+    return VectorToolsImpl::SumOfSquares( src, size );
+}
+
+// Minimum of vector's elements (0 for empty vector)
+float XVectorTools::MinValue( const float* src, size_t size ) const
+{
+    return VectorToolsImpl::MinValue( src, size );
+}
+double XVectorTools::MinValue( const double* src, size_t size ) const
+{
+    return VectorToolsImpl::MinValue( src, size );
+}
+
+// Maximum of vector's elements (0 for empty vector)
+float XVectorTools::MaxValue( const float* src, size_t size ) const
+{
+    return VectorToolsImpl::MaxValue( src, size );
+}
+double XVectorTools::MaxValue( const double* src, size_t size ) const
+{
+    return VectorToolsImpl::MaxValue( src, size );
+}
+
+// Index of the first maximum element of the vector (0 for empty vector)
+size_t XVectorTools::ArgMax( const float* src, size_t size ) const
+{
+    return VectorToolsImpl::ArgMax( src, size );
+}
+size_t XVectorTools::ArgMax( const double* src, size_t size ) const
+{
+    return VectorToolsImpl::ArgMax( src, size );
+}
+
+// Gathers vector's elements by their indexes: dst[i] = src[indexes[i]]
+void XVectorTools::Gather( const float* src, const size_t* indexes, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Gather( src, indexes, dst, size );
+}
+void XVectorTools::Gather( const double* src, const size_t* indexes, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Gather( src, indexes, dst, size );
+}
+
+// Exponent of vector's elements: dst[i] = exp( src[i] )
+void XVectorTools::Exp( const float* src, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Exp( src, dst, size );
+}
+void XVectorTools::Exp( const double* src, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Exp( src, dst, size );
+}
+
+// Sigmoid of vector's elements: dst[i] = 1 / ( 1 + exp( -src[i] ) )
+void XVectorTools::Sigmoid( const float* src, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Sigmoid( src, dst, size );
+}
+void XVectorTools::Sigmoid( const double* src, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Sigmoid( src, dst, size );
+}
+
+// Hyperbolic tangent of vector's elements: dst[i] = tanh( src[i] )
+void XVectorTools::Tanh( const float* src, float* dst, size_t size ) const
+{
+    VectorToolsImpl::Tanh( src, dst, size );
+}
+void XVectorTools::Tanh( const double* src, double* dst, size_t size ) const
+{
+    VectorToolsImpl::Tanh( src, dst, size );
+}
+
+// Multiplies delta by sigmoid's derivative given its output: dst[i] = delta[i] * y[i] * ( 1 - y[i] )
+void XVectorTools::SigmoidDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    VectorToolsImpl::SigmoidDerivative( y, delta, dst, size );
+}
+void XVectorTools::SigmoidDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    VectorToolsImpl::SigmoidDerivative( y, delta, dst, size );
+}
+
+// Multiplies delta by tanh's derivative given its output: dst[i] = delta[i] * ( 1 - y[i] * y[i] )
+void XVectorTools::TanhDerivative( const float* y, const float* delta, float* dst, size_t size ) const
+{
+    VectorToolsImpl::TanhDerivative( y, delta, dst, size );
+}
+void XVectorTools::TanhDerivative( const double* y, const double* delta, double* dst, size_t size ) const
+{
+    VectorToolsImpl::TanhDerivative( y, delta, dst, size );
+}
+
+// Fused SGD step, which also resets gradients: weights[i] -= learningRate * gradScale * gradients[i]
+void XVectorTools::SgdStep( float* weights, float* gradients, float gradScale, float learningRate, size_t size ) const
+{
+    VectorToolsImpl::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+void XVectorTools::SgdStep( double* weights, double* gradients, double gradScale, double learningRate, size_t size ) const
+{
+    VectorToolsImpl::SgdStep( weights, gradients, gradScale, learningRate, size );
+}
+
+// Fused step of SGD with momentum, which also resets gradients (g = gradScale * gradients[i]):
+//   velocity[i] = momentum * velocity[i] + alpha * g, weights[i] += beta * velocity[i] + gamma * g
+void XVectorTools::MomentumStep( float* weights, float* gradients, float* velocity, float gradScale, float momentum, float alpha, float beta, float gamma, size_t size ) const
+{
+    VectorToolsImpl::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+void XVectorTools::MomentumStep( double* weights, double* gradients, double* velocity, double gradScale, double momentum, double alpha, double beta, double gamma, size_t size ) const
+{
+    VectorToolsImpl::MomentumStep( weights, gradients, velocity, gradScale, momentum, alpha, beta, gamma, size );
+}
+
+// Fused Adagrad/RMSprop step, which also resets gradients (g = gradScale * gradients[i]):
+//   sqSum[i] = decay * sqSum[i] + sqFactor * g * g, weights[i] -= learningRate * g / sqrt( sqSum[i] + epsilon )
+void XVectorTools::AdaptiveStep( float* weights, float* gradients, float* sqSum, float gradScale, float decay, float sqFactor, float learningRate, float epsilon, size_t size ) const
+{
+    VectorToolsImpl::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+void XVectorTools::AdaptiveStep( double* weights, double* gradients, double* sqSum, double gradScale, double decay, double sqFactor, double learningRate, double epsilon, size_t size ) const
+{
+    VectorToolsImpl::AdaptiveStep( weights, gradients, sqSum, gradScale, decay, sqFactor, learningRate, epsilon, size );
+}
+
+// Fused Adam step, which also resets gradients (g = gradScale * gradients[i]): mt[i] = b1 * mt[i] + ( 1 - b1 ) * g,
+//   vt[i] = b2 * vt[i] + ( 1 - b2 ) * g * g, weights[i] -= learningRate * mt[i] * mtScale / sqrt( vt[i] * vtScale + epsilon )
+void XVectorTools::AdamStep( float* weights, float* gradients, float* mt, float* vt, float gradScale, float b1, float b2, float mtScale, float vtScale, float learningRate, float epsilon, size_t size ) const
+{
+    VectorToolsImpl::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+void XVectorTools::AdamStep( double* weights, double* gradients, double* mt, double* vt, double gradScale, double b1, double b2, double mtScale, double vtScale, double learningRate, double epsilon, size_t size ) const
+{
+    VectorToolsImpl::AdamStep( weights, gradients, mt, vt, gradScale, b1, b2, mtScale, vtScale, learningRate, epsilon, size );
+}
+
 } // namespace ANNT
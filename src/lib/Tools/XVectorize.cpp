@@ -19,6 +19,8 @@
 */
 
 #include "XVectorize.hpp"
+#include "XAvx512VectorTools.hpp"
+#include "XAvx2FmaVectorTools.hpp"
 #include "XAvxVectorTools.hpp"
 #include "XSseVectorTools.hpp"
 #include "XVectorTools.hpp"
@@ -31,6 +33,32 @@ IVectorTools* GetAvailableVectorTools( )
 {
     IVectorTools* vectorTools = nullptr;
 
+#ifdef ANNT_USE_AVX512
+    if ( vectorTools == nullptr )
+    {
+        vectorTools = new XAvx512VectorTools( );
+
+        if ( !vectorTools->IsAvailable( ) )
+        {
+            delete vectorTools;
+            vectorTools = nullptr;
+        }
+    }
+#endif
+
+#ifdef ANNT_USE_AVX2
+    if ( vectorTools == nullptr )
+    {
+        vectorTools = new XAvx2FmaVectorTools( );
+
+        if ( !vectorTools->IsAvailable( ) )
+        {
+            delete vectorTools;
+            vectorTools = nullptr;
+        }
+    }
+#endif
+
 #ifdef ANNT_USE_AVX
     if ( vectorTools == nullptr )
     {
@@ -0,0 +1,459 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XWinograd.hpp"
+#include "XGemm.hpp"
+#include "XParallel.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace ANNT {
+
+namespace {
+
+// Transformation matrices of F(m x m, 3 x 3) algorithm - input transform (BT), kernel transform (G)
+// and output transform (AT)
+template <size_t m> struct WinogradMatrices;
+
+template <> struct WinogradMatrices<2>
+{
+    static const size_t Alpha = 4;
+
+    static const float_t BT[4][4];
+    static const float_t G[4][3];
+    static const float_t AT[2][4];
+};
+
+const float_t WinogradMatrices<2>::BT[4][4] =
+{
+    { 1,  0, -1,  0 },
+    { 0,  1,  1,  0 },
+    { 0, -1,  1,  0 },
+    { 0,  1,  0, -1 }
+};
+const float_t WinogradMatrices<2>::G[4][3] =
+{
+    { float_t( 1 ),   float_t( 0 ),    float_t( 0 )   },
+    { float_t( 0.5 ), float_t( 0.5 ),  float_t( 0.5 ) },
+    { float_t( 0.5 ), float_t( -0.5 ), float_t( 0.5 ) },
+    { float_t( 0 ),   float_t( 0 ),    float_t( 1 )   }
+};
+const float_t WinogradMatrices<2>::AT[2][4] =
+{
+    { 1, 1,  1,  0 },
+    { 0, 1, -1, -1 }
+};
+
+template <> struct WinogradMatrices<4>
+{
+    static const size_t Alpha = 6;
+
+    static const float_t BT[6][6];
+    static const float_t G[6][3];
+    static const float_t AT[4][6];
+};
+
+const float_t WinogradMatrices<4>::BT[6][6] =
+{
+    { 4,  0, -5,  0, 1, 0 },
+    { 0, -4, -4,  1, 1, 0 },
+    { 0,  4, -4, -1, 1, 0 },
+    { 0, -2, -1,  2, 1, 0 },
+    { 0,  2, -1, -2, 1, 0 },
+    { 0,  4,  0, -5, 0, 1 }
+};
+const float_t WinogradMatrices<4>::G[6][3] =
+{
+    { float_t( 1 ) / 4,   float_t( 0 ),        float_t( 0 )       },
+    { float_t( -1 ) / 6,  float_t( -1 ) / 6,   float_t( -1 ) / 6  },
+    { float_t( -1 ) / 6,  float_t( 1 ) / 6,    float_t( -1 ) / 6  },
+    { float_t( 1 ) / 24,  float_t( 1 ) / 12,   float_t( 1 ) / 6   },
+    { float_t( 1 ) / 24,  float_t( -1 ) / 12,  float_t( 1 ) / 6   },
+    { float_t( 0 ),       float_t( 0 ),        float_t( 1 )       }
+};
+const float_t WinogradMatrices<4>::AT[4][6] =
+{
+    { 1, 1,  1, 1,  1, 0 },
+    { 0, 1, -1, 2, -2, 0 },
+    { 0, 1,  1, 4,  4, 0 },
+    { 0, 1, -1, 8, -8, 1 }
+};
+
+// Kernel transform: u = G * g * GT
+template <size_t m> void TransformKernel( const float_t g[3][3], float_t u[m + 2][m + 2] )
+{
+    typedef WinogradMatrices<m> W;
+    const size_t alpha = W::Alpha;
+    float_t      tmp[alpha][3];
+
+    for ( size_t i = 0; i < alpha; i++ )
+    {
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            tmp[i][j] = W::G[i][0] * g[0][j] + W::G[i][1] * g[1][j] + W::G[i][2] * g[2][j];
+        }
+    }
+
+    for ( size_t i = 0; i < alpha; i++ )
+    {
+        for ( size_t j = 0; j < alpha; j++ )
+        {
+            u[i][j] = tmp[i][0] * W::G[j][0] + tmp[i][1] * W::G[j][1] + tmp[i][2] * W::G[j][2];
+        }
+    }
+}
+
+// Number of tiles transformed together - transforms are done on vectors of tiles, so they can be vectorized by compiler
+static const size_t TilesBlock = 8;
+
+// Input transform of a block of tiles: v = BT * d * B
+template <size_t m> void TransformInput( const float_t d[m + 2][m + 2][TilesBlock], float_t v[m + 2][m + 2][TilesBlock] )
+{
+    typedef WinogradMatrices<m> W;
+    const size_t alpha = W::Alpha;
+    float_t      tmp[alpha][alpha][TilesBlock];
+
+    for ( size_t i = 0; i < alpha; i++ )
+    {
+        for ( size_t j = 0; j < alpha; j++ )
+        {
+            for ( size_t b = 0; b < TilesBlock; b++ )
+            {
+                float_t sum = 0;
+
+                for ( size_t k = 0; k < alpha; k++ )
+                {
+                    sum += W::BT[i][k] * d[k][j][b];
+                }
+                tmp[i][j][b] = sum;
+            }
+        }
+    }
+
+    for ( size_t i = 0; i < alpha; i++ )
+    {
+        for ( size_t j = 0; j < alpha; j++ )
+        {
+            for ( size_t b = 0; b < TilesBlock; b++ )
+            {
+                float_t sum = 0;
+
+                for ( size_t k = 0; k < alpha; k++ )
+                {
+                    sum += tmp[i][k][b] * W::BT[j][k];
+                }
+                v[i][j][b] = sum;
+            }
+        }
+    }
+}
+
+// Output transform of a block of tiles: y = AT * M * A
+template <size_t m> void TransformOutput( const float_t mt[m + 2][m + 2][TilesBlock], float_t y[m][m][TilesBlock] )
+{
+    typedef WinogradMatrices<m> W;
+    const size_t alpha = W::Alpha;
+    float_t      tmp[m][alpha][TilesBlock];
+
+    for ( size_t i = 0; i < m; i++ )
+    {
+        for ( size_t j = 0; j < alpha; j++ )
+        {
+            for ( size_t b = 0; b < TilesBlock; b++ )
+            {
+                float_t sum = 0;
+
+                for ( size_t k = 0; k < alpha; k++ )
+                {
+                    sum += W::AT[i][k] * mt[k][j][b];
+                }
+                tmp[i][j][b] = sum;
+            }
+        }
+    }
+
+    for ( size_t i = 0; i < m; i++ )
+    {
+        for ( size_t j = 0; j < m; j++ )
+        {
+            for ( size_t b = 0; b < TilesBlock; b++ )
+            {
+                float_t sum = 0;
+
+                for ( size_t k = 0; k < alpha; k++ )
+                {
+                    sum += tmp[i][k][b] * W::AT[j][k];
+                }
+                y[i][j][b] = sum;
+            }
+        }
+    }
+}
+
+// Transforms all kernels - result is ( m + 2 )^2 matrices of rowsCount x columnsCount size
+template <size_t m> void TransformKernels( const float_t* kernels, size_t outputsCount, size_t inputsCount,
+                                           bool backward, float_t* transformedKernels )
+{
+    const size_t alpha      = m + 2;
+    const size_t matrixSize = outputsCount * inputsCount;
+
+    for ( size_t o = 0; o < outputsCount; o++ )
+    {
+        for ( size_t i = 0; i < inputsCount; i++ )
+        {
+            const float_t* kernel = kernels + ( o * inputsCount + i ) * 9;
+            float_t        g[3][3];
+            float_t        u[alpha][alpha];
+            size_t         index;
+
+            if ( !backward )
+            {
+                for ( size_t ky = 0; ky < 3; ky++ )
+                {
+                    for ( size_t kx = 0; kx < 3; kx++ )
+                    {
+                        g[ky][kx] = kernel[ky * 3 + kx];
+                    }
+                }
+                index = o * inputsCount + i;
+            }
+            else
+            {
+                // rotate kernel by 180 degrees, swap rows/columns of the resulting matrix
+                for ( size_t ky = 0; ky < 3; ky++ )
+                {
+                    for ( size_t kx = 0; kx < 3; kx++ )
+                    {
+                        g[ky][kx] = kernel[8 - ky * 3 - kx];
+                    }
+                }
+                index = i * outputsCount + o;
+            }
+
+            TransformKernel<m>( g, u );
+
+            for ( size_t xi = 0; xi < alpha; xi++ )
+            {
+                for ( size_t nu = 0; nu < alpha; nu++ )
+                {
+                    transformedKernels[( xi * alpha + nu ) * matrixSize + index] = u[xi][nu];
+                }
+            }
+        }
+    }
+}
+
+// Does convolution using the specified tile size
+template <size_t m> void Convolve( const float_t* input, size_t inputWidth, size_t inputHeight, size_t inputsCount,
+                                   const float_t* transformedKernels, size_t outputsCount,
+                                   size_t padLeft, size_t padTop,
+                                   float_t* output, size_t outputWidth, size_t outputHeight, const float_t* biases,
+                                   float_t* transformedInput, float_t* transformedOutput, bool parallel )
+{
+    const size_t alpha       = m + 2;
+    const size_t tilesX      = ( outputWidth  + m - 1 ) / m;
+    const size_t tilesY      = ( outputHeight + m - 1 ) / m;
+    const size_t tilesCount  = tilesX * tilesY;
+    const size_t inputSize   = inputWidth  * inputHeight;
+    const size_t outputSize  = outputWidth * outputHeight;
+    const size_t inputPlane  = inputsCount  * tilesCount;
+    const size_t outputPlane = outputsCount * tilesCount;
+
+    // 1 - transform input tiles (overlapping by 2 pixels) of every input map
+    XParallel::For( inputsCount, parallel, [&]( size_t c )
+    {
+        const float_t* inputMap = input + c * inputSize;
+        float_t*       dst      = transformedInput + c * tilesCount;
+        float_t        d[alpha][alpha][TilesBlock];
+        float_t        v[alpha][alpha][TilesBlock];
+
+        for ( size_t t0 = 0; t0 < tilesCount; t0 += TilesBlock )
+        {
+            size_t blockSize = std::min( TilesBlock, tilesCount - t0 );
+
+            for ( size_t b = 0; b < TilesBlock; b++ )
+            {
+                if ( b >= blockSize )
+                {
+                    for ( size_t y = 0; y < alpha; y++ )
+                    {
+                        for ( size_t x = 0; x < alpha; x++ )
+                        {
+                            d[y][x][b] = float_t( 0 );
+                        }
+                    }
+                    continue;
+                }
+
+                // top-left corner of the tile in the (unpadded) input
+                size_t t      = t0 + b;
+                int    startY = static_cast<int>( ( t / tilesX ) * m ) - static_cast<int>( padTop );
+                int    startX = static_cast<int>( ( t % tilesX ) * m ) - static_cast<int>( padLeft );
+
+                if ( ( startY >= 0 ) && ( startX >= 0 ) &&
+                     ( startY + alpha <= inputHeight ) && ( startX + alpha <= inputWidth ) )
+                {
+                    const float_t* inputPtr = inputMap + startY * inputWidth + startX;
+
+                    for ( size_t y = 0; y < alpha; y++, inputPtr += inputWidth )
+                    {
+                        for ( size_t x = 0; x < alpha; x++ )
+                        {
+                            d[y][x][b] = inputPtr[x];
+                        }
+                    }
+                }
+                else
+                {
+                    // the tile is on the border - the part outside of input is zero
+                    for ( size_t y = 0; y < alpha; y++ )
+                    {
+                        int iy = startY + static_cast<int>( y );
+
+                        for ( size_t x = 0; x < alpha; x++ )
+                        {
+                            int ix = startX + static_cast<int>( x );
+
+                            d[y][x][b] = ( ( iy < 0 ) || ( iy >= static_cast<int>( inputHeight ) ) ||
+                                           ( ix < 0 ) || ( ix >= static_cast<int>( inputWidth  ) ) ) ?
+                                         float_t( 0 ) : inputMap[iy * inputWidth + ix];
+                        }
+                    }
+                }
+            }
+
+            TransformInput<m>( d, v );
+
+            for ( size_t xi = 0; xi < alpha; xi++ )
+            {
+                for ( size_t nu = 0; nu < alpha; nu++ )
+                {
+                    float_t* dstPtr = dst + ( xi * alpha + nu ) * inputPlane + t0;
+
+                    for ( size_t b = 0; b < blockSize; b++ )
+                    {
+                        dstPtr[b] = v[xi][nu][b];
+                    }
+                }
+            }
+        }
+    } );
+
+    // 2 - multiply transformed kernels and inputs for every element of the transformed tile
+    XParallel::For( alpha * alpha, parallel, [&]( size_t i )
+    {
+        XGemm::Multiply( false, false, outputsCount, tilesCount, inputsCount, float_t( 1 ),
+                         transformedKernels + i * outputsCount * inputsCount, inputsCount,
+                         transformedInput + i * inputPlane, tilesCount,
+                         float_t( 0 ), transformedOutput + i * outputPlane, tilesCount, false );
+    } );
+
+    // 3 - transform the products back into output tiles and copy the valid part of them into output maps
+    XParallel::For( outputsCount, parallel, [&]( size_t k )
+    {
+        const float_t* src       = transformedOutput + k * tilesCount;
+        float_t*       outputMap = output + k * outputSize;
+        float_t        bias      = ( biases != nullptr ) ? biases[k] : float_t( 0 );
+        float_t        mt[alpha][alpha][TilesBlock];
+        float_t        y[m][m][TilesBlock];
+
+        for ( size_t t0 = 0; t0 < tilesCount; t0 += TilesBlock )
+        {
+            size_t blockSize = std::min( TilesBlock, tilesCount - t0 );
+
+            for ( size_t xi = 0; xi < alpha; xi++ )
+            {
+                for ( size_t nu = 0; nu < alpha; nu++ )
+                {
+                    const float_t* srcPtr = src + ( xi * alpha + nu ) * outputPlane + t0;
+
+                    for ( size_t b = 0; b < TilesBlock; b++ )
+                    {
+                        mt[xi][nu][b] = ( b < blockSize ) ? srcPtr[b] : float_t( 0 );
+                    }
+                }
+            }
+
+            TransformOutput<m>( mt, y );
+
+            for ( size_t b = 0; b < blockSize; b++ )
+            {
+                size_t ty   = ( t0 + b ) / tilesX;
+                size_t tx   = ( t0 + b ) % tilesX;
+                size_t rows = std::min( m, outputHeight - ty * m );
+                size_t cols = std::min( m, outputWidth  - tx * m );
+
+                for ( size_t oy = 0; oy < rows; oy++ )
+                {
+                    float_t* outputRow = outputMap + ( ty * m + oy ) * outputWidth + tx * m;
+
+                    for ( size_t ox = 0; ox < cols; ox++ )
+                    {
+                        outputRow[ox] = y[oy][ox][b] + bias;
+                    }
+                }
+            }
+        }
+    } );
+}
+
+} // anonymous namespace
+
+// Transforms 3x3 kernels to be used with the specified tile size
+void XWinograd::TransformKernels( const float_t* kernels, size_t outputsCount, size_t inputsCount,
+                                  size_t tileSize, bool backward, float_t* transformedKernels )
+{
+    assert( IsTileSizeSupported( tileSize ) );
+
+    if ( tileSize == 2 )
+    {
+        ANNT::TransformKernels<2>( kernels, outputsCount, inputsCount, backward, transformedKernels );
+    }
+    else
+    {
+        ANNT::TransformKernels<4>( kernels, outputsCount, inputsCount, backward, transformedKernels );
+    }
+}
+
+// Does convolution of input maps with transformed kernels
+void XWinograd::Convolve( const float_t* input, size_t inputWidth, size_t inputHeight, size_t inputsCount,
+                          const float_t* transformedKernels, size_t outputsCount, size_t tileSize,
+                          size_t padLeft, size_t padTop,
+                          float_t* output, size_t outputWidth, size_t outputHeight, const float_t* biases,
+                          float_t* transformedInput, float_t* transformedOutput, bool parallel )
+{
+    assert( IsTileSizeSupported( tileSize ) );
+
+    if ( tileSize == 2 )
+    {
+        ANNT::Convolve<2>( input, inputWidth, inputHeight, inputsCount, transformedKernels, outputsCount,
+                           padLeft, padTop, output, outputWidth, outputHeight, biases,
+                           transformedInput, transformedOutput, parallel );
+    }
+    else
+    {
+        ANNT::Convolve<4>( input, inputWidth, inputHeight, inputsCount, transformedKernels, outputsCount,
+                           padLeft, padTop, output, outputWidth, outputHeight, biases,
+                           transformedInput, transformedOutput, parallel );
+    }
+}
+
+} // namespace ANNT
@@ -0,0 +1,80 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef ANNT_XWINOGRAD_HPP
+#define ANNT_XWINOGRAD_HPP
+
+#include "../Types/Types.hpp"
+
+namespace ANNT {
+
+// Implementation of Winograd minimal filtering algorithm F(m x m, 3 x 3), which computes convolution with 3x3
+// kernels (unit step) on tiles of m x m outputs using less multiplications than direct convolution. Supported
+// tile sizes are 2 (F(2x2, 3x3), 2.25x less multiplications) and 4 (F(4x4, 3x3), 4x less multiplications,
+// but slightly less accurate).
+//
+// Inputs and kernels are transformed into ( m + 2 ) x ( m + 2 ) tiles, which turns convolution into
+// ( m + 2 )^2 independent matrix multiplications of transformed kernels and transformed inputs.
+class XWinograd
+{
+private:
+    XWinograd( );
+
+public:
+    // Checks if the specified output tile size is supported
+    static bool IsTileSizeSupported( size_t tileSize )
+    {
+        return ( ( tileSize == 2 ) || ( tileSize == 4 ) );
+    }
+
+    // Number of elements in transformed tile for the specified output tile size
+    static size_t TransformedTileSize( size_t tileSize )
+    {
+        return ( tileSize + 2 ) * ( tileSize + 2 );
+    }
+
+    // Number of tiles needed to cover output of the specified size
+    static size_t TilesCount( size_t outputWidth, size_t outputHeight, size_t tileSize )
+    {
+        return ( ( outputWidth + tileSize - 1 ) / tileSize ) * ( ( outputHeight + tileSize - 1 ) / tileSize );
+    }
+
+    // Transforms 3x3 kernels given as outputsCount x inputsCount x 3 x 3 array. Result is TransformedTileSize()
+    // matrices of outputsCount x inputsCount size. If the "backward" flag is set, kernels are rotated by 180 degrees
+    // and transposed instead (resulting in inputsCount x outputsCount matrices), so they can be used to propagate
+    // error gradients from outputs to inputs.
+    static void TransformKernels( const float_t* kernels, size_t outputsCount, size_t inputsCount,
+                                  size_t tileSize, bool backward, float_t* transformedKernels );
+
+    // Does convolution (cross-correlation actually) of input maps with transformed kernels. Padding tells how many
+    // zero rows/columns are assumed above/left of the input; positions outside of input are treated as zeros.
+    // Biases are optional (may be null). The two temporary buffers must have room for TransformedTileSize() *
+    // TilesCount() * inputsCount (outputsCount for the second one) values.
+    static void Convolve( const float_t* input, size_t inputWidth, size_t inputHeight, size_t inputsCount,
+                          const float_t* transformedKernels, size_t outputsCount, size_t tileSize,
+                          size_t padLeft, size_t padTop,
+                          float_t* output, size_t outputWidth, size_t outputHeight, const float_t* biases,
+                          float_t* transformedInput, float_t* transformedOutput, bool parallel );
+};
+
+} // namespace ANNT
+
+#endif // ANNT_XWINOGRAD_HPP
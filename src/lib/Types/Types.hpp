@@ -55,6 +55,18 @@ enum class BorderMode
     Same    // Output is of the same size as input. To get this input is padded.
 };
 
+// Precision weights of trainable layers can be stored in
+enum class WeightsPrecision
+{
+    Float,      // Weights are kept as float_t values.
+
+    Half,       // IEEE 754 half precision (16 bit) floating point numbers - 10 bits of mantissa, but
+                // limited range of +/-65504.
+
+    BFloat16    // Brain floating point (16 bit) numbers - upper half of 32 bit float, so they have
+                // the same range but only 7 bits of mantissa.
+};
+
 // Modes of selecting training samples into batches while running training epch.
 enum class EpochSelectionMode
 {
@@ -12,12 +12,29 @@ SRC = ANNT.cpp \
       XAlignedAllocator.cpp \
       XCpu.cpp \
       XAvxVectorTools.cpp \
+      XAvx2FmaVectorTools.cpp \
+      XAvx512VectorTools.cpp \
       XSseVectorTools.cpp \
       XVectorTools.cpp \
       XVectorize.cpp \
+      XParallelAccumulator.cpp \
+      XGemm.cpp \
+      XAvxGemmKernels.cpp \
+      XFmaGemmKernels.cpp \
+      XInt8Gemm.cpp \
+      XSse41Int8GemmKernels.cpp \
+      XAvx2Int8GemmKernels.cpp \
+      XQuantizedWeights.cpp \
+      XHalfWeights.cpp \
+      XAvx2HalfKernels.cpp \
+      XWinograd.cpp \
+      XFft.cpp \
       XDataEncodingTools.cpp \
+      XDepthwiseConvolution.cpp \
+      XMappedFile.cpp \
       XFullyConnectedLayer.cpp \
       XConvolutionLayer.cpp \
+      XDepthwiseSeparableConvolutionLayer.cpp \
       XRecurrentLayer.cpp \
       XLSTMLayer.cpp \
 	  XGRULayer.cpp \
@@ -25,4 +42,5 @@ SRC = ANNT.cpp \
       XNetworkContext.cpp \
       XNetworkInference.cpp \
       XNetworkTraining.cpp \
+      XParameterArena.cpp \
       XClassificationTrainingHelper.cpp
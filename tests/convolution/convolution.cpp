@@ -0,0 +1,386 @@
+/*
+    ANNT - Artificial Neural Networks C++ library
+
+    AVX/SSE vectorization test
+
+    Copyright (C) 2018, cvsandbox, cvsandbox@gmail.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "ANNT.hpp"
+
+using namespace std;
+using namespace ANNT;
+using namespace ANNT::Neuro;
+using namespace ANNT::Neuro::Training;
+
+// Configuration of convolution layers to test
+struct TestConfig
+{
+    const char* Name;
+    size_t      InputWidth;
+    size_t      InputHeight;
+    size_t      InputDepth;
+    size_t      KernelsCount;
+    size_t      KernelSize;
+    BorderMode  Border;
+    size_t      Step;
+    bool        PartialConnections;
+    size_t      GroupsCount;
+};
+
+// Algorithm to test against direct convolution and the error it is allowed to make
+struct TestAlgorithm
+{
+    const char*          Name;
+    ConvolutionAlgorithm Algorithm;
+    float_t              Tolerance;
+};
+
+static const TestConfig TEST_CONFIGS[] =
+{
+    { "3x3 valid",              12, 11,  3,  4, 3, BorderMode::Valid, 1, false, 1 },
+    { "3x3 same",               12, 11,  3,  4, 3, BorderMode::Same,  1, false, 1 },
+    { "3x3 same, partial",       9,  9,  6,  6, 3, BorderMode::Same,  1, true,  1 },
+    { "3x3 valid, partial",     10,  7,  6,  5, 3, BorderMode::Valid, 1, true,  1 },
+    { "3x3 same, deep",         16, 16, 32, 32, 3, BorderMode::Same,  1, false, 1 },
+    { "5x5 same",               13, 12,  4,  5, 5, BorderMode::Same,  1, false, 1 },
+    { "4x4 same, partial",      11, 10,  6,  4, 4, BorderMode::Same,  1, true,  1 },
+    { "7x7 valid",              20, 17,  3,  4, 7, BorderMode::Valid, 1, false, 1 },
+    { "7x7 same, partial",      18, 21,  6,  6, 7, BorderMode::Same,  1, true,  1 },
+    { "3x3 same, 2 groups",     10,  9,  6,  4, 3, BorderMode::Same,  1, false, 2 },
+    { "1x1, 3 groups",           8,  7,  6,  9, 1, BorderMode::Valid, 1, false, 3 },
+    { "3x3 same, depthwise",    12, 11,  4,  8, 3, BorderMode::Same,  1, false, 4 },
+    { "5x5 valid, depthwise",   13, 12,  6,  6, 5, BorderMode::Valid, 1, false, 6 },
+    { "3x3 step 2, depthwise",  13, 12,  5,  5, 3, BorderMode::Same,  2, false, 5 },
+    { "4x4 step 3, depthwise",  14, 15,  3,  6, 4, BorderMode::Valid, 3, false, 3 },
+};
+
+// Configurations of depthwise separable layers (partial connections and groups are not used)
+static const TestConfig SEPARABLE_TEST_CONFIGS[] =
+{
+    { "3x3 same",           12, 11,  4,  6, 3, BorderMode::Same,  1, false, 0 },
+    { "5x5 valid",          13, 12,  3,  5, 5, BorderMode::Valid, 1, false, 0 },
+    { "3x3 same, step 2",   13, 12,  6,  4, 3, BorderMode::Same,  2, false, 0 },
+};
+
+// Relative tolerances are chosen for single precision. Winograd F(4x4, 3x3) uses transformation matrices
+// with larger coefficients, so it is expected to be less accurate than F(2x2, 3x3).
+static const TestAlgorithm TEST_ALGORITHMS[] =
+{
+    { "GEMM",        ConvolutionAlgorithm::Gemm,        float_t( 1e-4 ) },
+    { "Winograd2x2", ConvolutionAlgorithm::Winograd2x2, float_t( 1e-4 ) },
+    { "Winograd4x4", ConvolutionAlgorithm::Winograd4x4, float_t( 5e-4 ) },
+    { "FFT",         ConvolutionAlgorithm::Fft,         float_t( 1e-4 ) },
+};
+
+// Number of samples in the training batch
+static const size_t BATCH_SIZE = 4;
+
+// Provides connection table with some of the connections missing
+static vector<bool> PartialConnectionTable( size_t inputDepth, size_t kernelsCount )
+{
+    vector<bool> connectionTable( inputDepth * kernelsCount );
+
+    for ( size_t kernelIndex = 0; kernelIndex < kernelsCount; kernelIndex++ )
+    {
+        for ( size_t inputIndex = 0; inputIndex < inputDepth; inputIndex++ )
+        {
+            connectionTable[kernelIndex * inputDepth + inputIndex] = ( ( kernelIndex + inputIndex ) % 3 != 0 );
+        }
+    }
+
+    return connectionTable;
+}
+
+// Creates network of two convolution layers using the specified algorithm - the second layer makes sure
+// error gradients get propagated through the first one. Weights are random, but the same for the same seed.
+static shared_ptr<XNeuralNetwork> CreateNetwork( const TestConfig& config, ConvolutionAlgorithm algorithm )
+{
+    shared_ptr<XNeuralNetwork>    net = make_shared<XNeuralNetwork>( );
+    shared_ptr<XConvolutionLayer> layer1;
+    vector<bool>                  connectionTable;
+
+    if ( config.PartialConnections )
+    {
+        connectionTable = PartialConnectionTable( config.InputDepth, config.KernelsCount );
+    }
+
+    srand( 1 );
+
+    if ( config.GroupsCount > 1 )
+    {
+        layer1 = make_shared<XConvolutionLayer>( config.InputWidth, config.InputHeight, config.InputDepth,
+                                                 config.KernelSize, config.KernelSize, config.KernelsCount,
+                                                 config.GroupsCount, config.Border, config.Step, config.Step );
+    }
+    else
+    {
+        layer1 = make_shared<XConvolutionLayer>( config.InputWidth, config.InputHeight, config.InputDepth,
+                                                 config.KernelSize, config.KernelSize, config.KernelsCount,
+                                                 connectionTable, config.Border, config.Step, config.Step );
+    }
+
+    size_t padSize       = ( config.Border == BorderMode::Same ) ? config.KernelSize - 1 : 0;
+    size_t outputWidth   = ( config.InputWidth  - config.KernelSize + padSize ) / config.Step + 1;
+    size_t outputHeight  = ( config.InputHeight - config.KernelSize + padSize ) / config.Step + 1;
+
+    shared_ptr<XConvolutionLayer> layer2 = make_shared<XConvolutionLayer>(
+        outputWidth, outputHeight, config.KernelsCount, 3, 3, config.KernelsCount, BorderMode::Same );
+
+    layer1->SetAlgorithm( algorithm );
+    layer2->SetAlgorithm( algorithm );
+
+    net->AddLayer( layer1 );
+    net->AddLayer( layer2 );
+
+    return net;
+}
+
+// Finds maximum difference between two vectors relative to the largest absolute value of the reference vector
+static float_t RelativeError( const fvector_t& value, const fvector_t& reference )
+{
+    float_t maxDiff = 0;
+    float_t maxAbs  = 0;
+
+    for ( size_t i = 0, n = reference.size( ); i < n; i++ )
+    {
+        maxDiff = max( maxDiff, static_cast<float_t>( fabs( value[i] - reference[i] ) ) );
+        maxAbs  = max( maxAbs,  static_cast<float_t>( fabs( reference[i] ) ) );
+    }
+
+    return ( maxAbs > 0 ) ? maxDiff / maxAbs : maxDiff;
+}
+
+// Runs the network on the inputs, then does one training step and runs it again. Produces outputs before/after
+// the training step and the updates done to weights of all layers.
+static void RunNetwork( const shared_ptr<XNeuralNetwork>& net, const vector<fvector_t>& inputs, const vector<fvector_t>& targets,
+                        vector<fvector_t>& outputs, vector<fvector_t>& trainedOutputs, vector<fvector_t>& weights )
+{
+    XNetworkTraining netTraining( net,
+                                  make_shared<XGradientDescentOptimizer>( float_t( 0.01 ) ),
+                                  make_shared<XMSECost>( ) );
+    fvector_t        output( net->OutputsCount( ) );
+
+    outputs.clear( );
+    trainedOutputs.clear( );
+    weights.clear( );
+
+    for ( size_t i = 0; i < inputs.size( ); i++ )
+    {
+        netTraining.Compute( inputs[i], output );
+        outputs.push_back( output );
+    }
+
+    for ( auto layer : *net )
+    {
+        weights.push_back( static_pointer_cast<ITrainableLayer>( layer )->Weights( ) );
+    }
+
+    netTraining.TrainBatch( inputs, targets );
+
+    for ( size_t i = 0; i < inputs.size( ); i++ )
+    {
+        netTraining.Compute( inputs[i], output );
+        trainedOutputs.push_back( output );
+    }
+
+    for ( size_t layerIndex = 0; layerIndex < net->LayersCount( ); layerIndex++ )
+    {
+        fvector_t trainedWeights = static_pointer_cast<ITrainableLayer>( net->LayerAt( layerIndex ) )->Weights( );
+
+        for ( size_t i = 0; i < trainedWeights.size( ); i++ )
+        {
+            weights[layerIndex][i] = trainedWeights[i] - weights[layerIndex][i];
+        }
+    }
+}
+
+// Worst relative error over a set of vectors
+static float_t RelativeError( const vector<fvector_t>& values, const vector<fvector_t>& references )
+{
+    float_t error = 0;
+
+    for ( size_t i = 0; i < references.size( ); i++ )
+    {
+        error = max( error, RelativeError( values[i], references[i] ) );
+    }
+
+    return error;
+}
+
+// Generates random inputs and targets for the network
+static void GenerateSamples( const shared_ptr<XNeuralNetwork>& net, vector<fvector_t>& inputs, vector<fvector_t>& targets )
+{
+    srand( 2 );
+
+    for ( size_t i = 0; i < BATCH_SIZE; i++ )
+    {
+        fvector_t input( net->InputsCount( ) );
+        fvector_t target( net->OutputsCount( ) );
+
+        for ( auto& v : input )
+        {
+            v = ( static_cast<float_t>( rand( ) ) / RAND_MAX ) * float_t( 2 ) - float_t( 1 );
+        }
+        for ( auto& v : target )
+        {
+            v = ( static_cast<float_t>( rand( ) ) / RAND_MAX ) * float_t( 2 ) - float_t( 1 );
+        }
+
+        inputs.push_back( input );
+        targets.push_back( target );
+    }
+}
+
+// Tests depthwise separable convolution layer against depthwise convolution layer followed by 1x1 convolution
+// (with the same weights). Both are preceded by 1x1 convolution, which makes sure error gets propagated through.
+static bool TestSeparableLayer( const TestConfig& config )
+{
+    shared_ptr<XNeuralNetwork> refNet = make_shared<XNeuralNetwork>( );
+    shared_ptr<XNeuralNetwork> net    = make_shared<XNeuralNetwork>( );
+    size_t                     depthwiseWeightsCount = config.InputDepth * config.KernelSize * config.KernelSize;
+
+    srand( 1 );
+
+    shared_ptr<XConvolutionLayer> inputLayer = make_shared<XConvolutionLayer>(
+        config.InputWidth, config.InputHeight, config.InputDepth, 1, 1, config.InputDepth );
+    shared_ptr<XConvolutionLayer> depthwiseLayer = make_shared<XConvolutionLayer>(
+        config.InputWidth, config.InputHeight, config.InputDepth,
+        config.KernelSize, config.KernelSize, config.InputDepth, config.InputDepth, config.Border, config.Step, config.Step );
+    shared_ptr<XDepthwiseSeparableConvolutionLayer> separableLayer = make_shared<XDepthwiseSeparableConvolutionLayer>(
+        config.InputWidth, config.InputHeight, config.InputDepth,
+        config.KernelSize, config.KernelSize, config.KernelsCount, config.Border, config.Step, config.Step );
+    shared_ptr<XConvolutionLayer> pointwiseLayer = make_shared<XConvolutionLayer>(
+        depthwiseLayer->OutputsCount( ) / config.InputDepth, 1, config.InputDepth, 1, 1, config.KernelsCount );
+
+    inputLayer->SetAlgorithm( ConvolutionAlgorithm::Direct );
+    depthwiseLayer->SetAlgorithm( ConvolutionAlgorithm::Direct );
+    pointwiseLayer->SetAlgorithm( ConvolutionAlgorithm::Direct );
+
+    // separable layer gets the same weights as the reference pair of layers (depthwise layer's biases are zero)
+    fvector_t depthwiseWeights = depthwiseLayer->Weights( );
+    fvector_t pointwiseWeights = pointwiseLayer->Weights( );
+    fvector_t separableWeights( depthwiseWeights.begin( ), depthwiseWeights.begin( ) + depthwiseWeightsCount );
+
+    separableWeights.insert( separableWeights.end( ), pointwiseWeights.begin( ), pointwiseWeights.end( ) );
+    separableLayer->SetWeights( separableWeights );
+
+    refNet->AddLayer( inputLayer );
+    refNet->AddLayer( depthwiseLayer );
+    refNet->AddLayer( pointwiseLayer );
+
+    shared_ptr<XConvolutionLayer> inputLayerCopy = make_shared<XConvolutionLayer>(
+        config.InputWidth, config.InputHeight, config.InputDepth, 1, 1, config.InputDepth );
+
+    inputLayerCopy->SetAlgorithm( ConvolutionAlgorithm::Direct );
+    inputLayerCopy->SetWeights( inputLayer->Weights( ) );
+
+    net->AddLayer( inputLayerCopy );
+    net->AddLayer( separableLayer );
+
+    vector<fvector_t> inputs, targets;
+    vector<fvector_t> refOutputs, refTrainedOutputs, refWeights;
+    vector<fvector_t> outputs, trainedOutputs, weights;
+
+    GenerateSamples( refNet, inputs, targets );
+
+    RunNetwork( refNet, inputs, targets, refOutputs, refTrainedOutputs, refWeights );
+    RunNetwork( net, inputs, targets, outputs, trainedOutputs, weights );
+
+    // compare updates of the separable layer with those of the depthwise/pointwise layers (ignoring depthwise biases)
+    vector<fvector_t> refUpdates( { refWeights[0], fvector_t( refWeights[1].begin( ), refWeights[1].begin( ) + depthwiseWeightsCount ) } );
+
+    refUpdates[1].insert( refUpdates[1].end( ), refWeights[2].begin( ), refWeights[2].end( ) );
+
+    float_t outputError  = RelativeError( outputs, refOutputs );
+    float_t weightsError = RelativeError( weights, refUpdates );
+    bool    passed       = ( outputError <= float_t( 1e-4 ) ) && ( weightsError <= float_t( 1e-4 ) );
+
+    printf( "  %-21s : %e / %e - %s \n", config.Name,
+            static_cast<double>( outputError ), static_cast<double>( weightsError ), ( passed ) ? "OK" : "FAILED" );
+
+    return passed;
+}
+
+int main( int /* argc */, char** /* argv */ )
+{
+    size_t failedCount = 0;
+    size_t testsCount  = 0;
+
+    printf( "Convolution algorithms test \n" );
+    printf( "=========================== \n\n" );
+    printf( "Relative errors against direct convolution (outputs / outputs after training step / weights' updates): \n\n" );
+
+    for ( const TestConfig& config : TEST_CONFIGS )
+    {
+        vector<fvector_t> inputs;
+        vector<fvector_t> targets;
+        vector<fvector_t> refOutputs, refTrainedOutputs, refWeights;
+
+        shared_ptr<XNeuralNetwork> refNet = CreateNetwork( config, ConvolutionAlgorithm::Direct );
+
+        GenerateSamples( refNet, inputs, targets );
+
+        RunNetwork( refNet, inputs, targets, refOutputs, refTrainedOutputs, refWeights );
+
+        printf( "%s \n", config.Name );
+
+        for ( const TestAlgorithm& algorithm : TEST_ALGORITHMS )
+        {
+            vector<fvector_t> outputs, trainedOutputs, weights;
+
+            RunNetwork( CreateNetwork( config, algorithm.Algorithm ), inputs, targets, outputs, trainedOutputs, weights );
+
+            float_t outputError        = RelativeError( outputs, refOutputs );
+            float_t trainedOutputError = RelativeError( trainedOutputs, refTrainedOutputs );
+            float_t weightsError       = RelativeError( weights, refWeights );
+            bool    passed             = ( outputError        <= algorithm.Tolerance ) &&
+                                         ( trainedOutputError <= algorithm.Tolerance ) &&
+                                         ( weightsError       <= algorithm.Tolerance );
+
+            printf( "  %-12s : %e / %e / %e - %s \n", algorithm.Name,
+                    static_cast<double>( outputError ), static_cast<double>( trainedOutputError ),
+                    static_cast<double>( weightsError ), ( passed ) ? "OK" : "FAILED" );
+
+            testsCount++;
+            if ( !passed )
+            {
+                failedCount++;
+            }
+        }
+    }
+
+    printf( "\nDepthwise separable layer against depthwise + 1x1 convolution layers (outputs / weights' updates): \n\n" );
+
+    for ( const TestConfig& config : SEPARABLE_TEST_CONFIGS )
+    {
+        testsCount++;
+        if ( !TestSeparableLayer( config ) )
+        {
+            failedCount++;
+        }
+    }
+
+    printf( "\n%u of %u tests failed \n", static_cast<uint32_t>( failedCount ), static_cast<uint32_t>( testsCount ) );
+
+    return ( failedCount == 0 ) ? 0 : 1;
+}
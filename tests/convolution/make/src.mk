@@ -0,0 +1,10 @@
+# convolution test source files
+
+# search path for source files
+VPATH = ../../
+
+# source files
+SRC = convolution.cpp
+
+OBJ = $(SRC:.cpp=.o)
+
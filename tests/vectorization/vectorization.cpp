@@ -26,6 +26,8 @@
 #include <chrono>
 
 #include "Types/XAlignedAllocator.hpp"
+#include "Tools/XAvx512VectorTools.hpp"
+#include "Tools/XAvx2FmaVectorTools.hpp"
 #include "Tools/XAvxVectorTools.hpp"
 #include "Tools/XSseVectorTools.hpp"
 #include "Tools/XVectorTools.hpp"
@@ -41,15 +43,30 @@ uint32_t ITERATIONS_COUNT = 15;
 // Vector size used in all tests
 uint32_t VECTOR_SIZE      = 10 * 1000* 1000 + 7;
 
-// 32-byte aligned vector types to make AVX instructions happy
-typedef vector<float,  XAlignedAllocator<float,  32>> float_vec_t;
-typedef vector<double, XAlignedAllocator<double, 32>> double_vec_t;
+// 64-byte aligned vector types to make AVX/AVX-512 instructions happy
+typedef vector<float,  XAlignedAllocator<float,  64>> float_vec_t;
+typedef vector<double, XAlignedAllocator<double, 64>> double_vec_t;
+
+// Set of vector tools to test and their average time taken by each test
+struct TestedTools
+{
+    const char*   Name;
+    IVectorTools* Tools;
+    bool          Supported;
+    float         TimeS[9];
+    float         TimeD[9];
+};
 
 // Forward declaration of tests to run
 template <typename vecType> float AddTest( const IVectorTools* vectorTools );
 template <typename vecType> float MulTest( const IVectorTools* vectorTools );
 template <typename vecType> float DotTest( const IVectorTools* vectorTools );
 template <typename vecType> float MaxTest( const IVectorTools* vectorTools );
+template <typename vecType> float AxpyTest( const IVectorTools* vectorTools );
+template <typename vecType> float SumTest( const IVectorTools* vectorTools );
+template <typename vecType> float ArgMaxTest( const IVectorTools* vectorTools );
+template <typename vecType> float ExpTest( const IVectorTools* vectorTools );
+template <typename vecType> float AdamStepTest( const IVectorTools* vectorTools );
 
 // Parse command line parameters to override defaults
 static void ParseCommandLine( int argc, char** argv )
@@ -108,150 +125,104 @@ static void ParseCommandLine( int argc, char** argv )
     printf( "\n" );
 }
 
+// Runs all tests for the specified tools and vector type
+template <typename vecType> static void RunTests( const TestedTools& tools, float* times )
+{
+    srand( 0 );
+    printf( "\n%s ADD\n", tools.Name );
+    times[0] = AddTest<vecType>( tools.Tools );
+    printf( "\n%s MUL\n", tools.Name );
+    times[1] = MulTest<vecType>( tools.Tools );
+    printf( "\n%s DOT\n", tools.Name );
+    times[2] = DotTest<vecType>( tools.Tools );
+    printf( "\n%s MAX\n", tools.Name );
+    times[3] = MaxTest<vecType>( tools.Tools );
+    printf( "\n%s AXPY\n", tools.Name );
+    times[4] = AxpyTest<vecType>( tools.Tools );
+    printf( "\n%s SUM\n", tools.Name );
+    times[5] = SumTest<vecType>( tools.Tools );
+    printf( "\n%s ARGMAX\n", tools.Name );
+    times[6] = ArgMaxTest<vecType>( tools.Tools );
+    printf( "\n%s EXP\n", tools.Name );
+    times[7] = ExpTest<vecType>( tools.Tools );
+    printf( "\n%s ADAM STEP\n", tools.Name );
+    times[8] = AdamStepTest<vecType>( tools.Tools );
+}
+
 int main( int argc, char** argv )
 {
     printf( "Vectorization test \n" );
     printf( "================== \n" );
 
-    XAvxVectorTools avxVectorTools;
-    XSseVectorTools sseVectorTools;
-    XVectorTools    defVectorTools;
-
-    bool  avxSupported = false;
-    bool  sseSupported = false;
+    XAvx512VectorTools  avx512VectorTools;
+    XAvx2FmaVectorTools avx2VectorTools;
+    XAvxVectorTools     avxVectorTools;
+    XSseVectorTools     sseVectorTools;
+    XVectorTools        defVectorTools;
 
-    float avxAddS = 0, avxMulS = 0, avxDotS = 0, avxMaxS = 0;
-    float sseAddS = 0, sseMulS = 0, sseDotS = 0, sseMaxS = 0;
-    float defAddS = 0, defMulS = 0, defDotS = 0, defMaxS = 0;
-    float avxAddD = 0, avxMulD = 0, avxDotD = 0, avxMaxD = 0;
-    float sseAddD = 0, sseMulD = 0, sseDotD = 0, sseMaxD = 0;
-    float defAddD = 0, defMulD = 0, defDotD = 0, defMaxD = 0;
+    TestedTools testedTools[] =
+    {
+        { "AVX512", &avx512VectorTools, false, { 0 }, { 0 } },
+        { "AVX2",   &avx2VectorTools,   false, { 0 }, { 0 } },
+        { "AVX",    &avxVectorTools,    false, { 0 }, { 0 } },
+        { "SSE",    &sseVectorTools,    false, { 0 }, { 0 } },
+        { "DEF",    &defVectorTools,    false, { 0 }, { 0 } },
+    };
 
     ParseCommandLine( argc, argv );
 
-    if ( avxVectorTools.IsAvailable( ) )
-    {
-        avxSupported = true;
-        printf( "AVX tools are available \n" );
-    }
-    else
+    for ( TestedTools& tools : testedTools )
     {
-        printf( "AVX tools are NOT available \n" );
-    }
+        tools.Supported = tools.Tools->IsAvailable( );
 
-    if ( sseVectorTools.IsAvailable( ) )
-    {
-        sseSupported = true;
-        printf( "SSE tools are available \n" );
-    }
-    else
-    {
-        printf( "SSE tools are NOT available \n" );
+        printf( "%s tools are %savailable \n", tools.Name, ( tools.Supported ) ? "" : "NOT " );
     }
 
     printf( "\n" );
     printf( "Running single precision tests ... \n" );
 
-    if ( avxSupported )
+    for ( TestedTools& tools : testedTools )
     {
-        srand( 0 );
-        printf( "\nAVX ADD\n" );
-        avxAddS = AddTest<float_vec_t>( &avxVectorTools );
-        printf( "\nAVX MUL\n" );
-        avxMulS = MulTest<float_vec_t>( &avxVectorTools );
-        printf( "\nAVX DOT\n" );
-        avxDotS = DotTest<float_vec_t>( &avxVectorTools );
-        printf( "\nAVX MAX\n" );
-        avxMaxS = MaxTest<float_vec_t>( &avxVectorTools );
-    }
-
-    if ( sseSupported )
-    {
-        srand( 0 );
-        printf( "\nSSE ADD\n" );
-        sseAddS = AddTest<float_vec_t>( &sseVectorTools );
-        printf( "\nSSE MUL\n" );
-        sseMulS = MulTest<float_vec_t>( &sseVectorTools );
-        printf( "\nSSE DOT\n" );
-        sseDotS = DotTest<float_vec_t>( &sseVectorTools );
-        printf( "\nSSE MAX\n" );
-        sseMaxS = MaxTest<float_vec_t>( &sseVectorTools );
+        if ( tools.Supported )
+        {
+            RunTests<float_vec_t>( tools, tools.TimeS );
+        }
     }
 
-    srand( 0 );
-    printf( "\nDEF ADD\n" );
-    defAddS = AddTest<float_vec_t>( &defVectorTools );
-    printf( "\nDEF MUL\n" );
-    defMulS = MulTest<float_vec_t>( &defVectorTools );
-    printf( "\nDEF DOT\n" );
-    defDotS = DotTest<float_vec_t>( &defVectorTools );
-    printf( "\nDEF MAX\n" );
-    defMaxS = MaxTest<float_vec_t>( &defVectorTools );
-
     printf( "\n" );
     printf( "Running double precision tests ... \n" );
 
-    if ( avxSupported )
+    for ( TestedTools& tools : testedTools )
     {
-        srand( 0 );
-        printf( "\nAVX ADD\n" );
-        avxAddD = AddTest<double_vec_t>( &avxVectorTools );
-        printf( "\nAVX MUL\n" );
-        avxMulD = MulTest<double_vec_t>( &avxVectorTools );
-        printf( "\nAVX DOT\n" );
-        avxDotD = DotTest<double_vec_t>( &avxVectorTools );
-        printf( "\nAVX MAX\n" );
-        avxMaxD = MaxTest<double_vec_t>( &avxVectorTools );
-    }
-
-    if ( sseSupported )
-    {
-        srand( 0 );
-        printf( "\nSSE ADD\n" );
-        sseAddD = AddTest<double_vec_t>( &sseVectorTools );
-        printf( "\nSSE MUL\n" );
-        sseMulD = MulTest<double_vec_t>( &sseVectorTools );
-        printf( "\nSSE DOT\n" );
-        sseDotD = DotTest<double_vec_t>( &sseVectorTools );
-        printf( "\nSSE MAX\n" );
-        sseMaxD = MaxTest<double_vec_t>( &sseVectorTools );
+        if ( tools.Supported )
+        {
+            RunTests<double_vec_t>( tools, tools.TimeD );
+        }
     }
 
-    srand( 0 );
-    printf( "\nDEF ADD\n" );
-    defAddD = AddTest<double_vec_t>( &defVectorTools );
-    printf( "\nDEF MUL\n" );
-    defMulD = MulTest<double_vec_t>( &defVectorTools );
-    printf( "\nDEF DOT\n" );
-    defDotD = DotTest<double_vec_t>( &defVectorTools );
-    printf( "\nDEF MAX\n" );
-    defMaxD = MaxTest<double_vec_t>( &defVectorTools );
-
     printf( "\n\n" );
     printf( "Single precision:\n\n" );
-    printf( "\t   Add \t | Mul \t | Dot \t | Max \n" );
-    if ( avxSupported )
-    {
-        printf( "AVX \t | %0.2f | %0.2f | %0.2f | %0.2f \n", avxAddS, avxMulS, avxDotS, avxMaxS );
-    }
-    if ( sseSupported )
+    printf( "\t   Add \t | Mul \t | Dot \t | Max \t | Axpy \t | Sum \t | ArgMax | Exp \t | Adam \n" );
+    for ( const TestedTools& tools : testedTools )
     {
-        printf( "SSE \t | %0.2f | %0.2f | %0.2f | %0.2f \n", sseAddS, sseMulS, sseDotS, sseMaxS );
+        if ( tools.Supported )
+        {
+            printf( "%-6s \t | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f \n", tools.Name,
+                    tools.TimeS[0], tools.TimeS[1], tools.TimeS[2], tools.TimeS[3], tools.TimeS[4], tools.TimeS[5], tools.TimeS[6], tools.TimeS[7], tools.TimeS[8] );
+        }
     }
-    printf( "DEF \t | %0.2f | %0.2f | %0.2f | %0.2f \n", defAddS, defMulS, defDotS, defMaxS );
     printf( "\n" );
 
     printf( "Double precision:\n\n" );
-    printf( "\t   Add \t | Mul \t | Dot \t | Max \n" );
-    if ( avxSupported )
-    {
-        printf( "AVX \t | %0.2f | %0.2f | %0.2f | %0.2f \n", avxAddD, avxMulD, avxDotD, avxMaxD );
-    }
-    if ( sseSupported )
+    printf( "\t   Add \t | Mul \t | Dot \t | Max \t | Axpy \t | Sum \t | ArgMax | Exp \t | Adam \n" );
+    for ( const TestedTools& tools : testedTools )
     {
-        printf( "SSE \t | %0.2f | %0.2f | %0.2f | %0.2f \n", sseAddD, sseMulD, sseDotD, sseMaxD );
+        if ( tools.Supported )
+        {
+            printf( "%-6s \t | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f | %0.2f \n", tools.Name,
+                    tools.TimeD[0], tools.TimeD[1], tools.TimeD[2], tools.TimeD[3], tools.TimeD[4], tools.TimeD[5], tools.TimeD[6], tools.TimeD[7], tools.TimeD[8] );
+        }
     }
-    printf( "DEF \t | %0.2f | %0.2f | %0.2f | %0.2f \n", defAddD, defMulD, defDotD, defMaxD );
     printf( "\n" );
 
 	return 0;
@@ -426,3 +397,213 @@ template <typename vecType> float MaxTest( const IVectorTools* vectorTools )
 
     return avgTime;
 }
+
+// Scaled vector added to another one : dst[i] += alpha * src[i]
+template <typename vecType> float AxpyTest( const IVectorTools* vectorTools )
+{
+    vecType src( VECTOR_SIZE );
+    vecType dst( VECTOR_SIZE );
+    float   avgTime = 0.0f;
+
+    typename vecType::value_type alpha = typename vecType::value_type( 0.01 );
+
+    for ( size_t t = 0; t < TESTS_COUNT; t++ )
+    {
+        for ( size_t i = 0; i < VECTOR_SIZE; i++ )
+        {
+            src[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+            dst[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+        }
+
+        steady_clock::time_point start = steady_clock::now( );
+
+        for ( size_t i = 0; i < ITERATIONS_COUNT; i++ )
+        {
+            vectorTools->Axpy( src.data( ), alpha, dst.data( ), src.size( ) );
+        }
+
+        auto timeTaken = duration_cast<std::chrono::milliseconds>( steady_clock::now( ) - start ).count( );
+
+        printf( "time taken: %u \n", static_cast<uint32_t>( timeTaken ) );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( dst[i] ) );
+        }
+        printf( "\n" );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( dst[VECTOR_SIZE - 8 + i] ) );
+        }
+        printf( "\n" );
+
+        avgTime += static_cast<float>( timeTaken );
+    }
+
+    avgTime /= TESTS_COUNT;
+
+    return avgTime;
+}
+
+// Sum of vector's elements : sum( src[i] )
+template <typename vecType> float SumTest( const IVectorTools* vectorTools )
+{
+    vecType src( VECTOR_SIZE );
+    float   avgTime = 0.0f;
+
+    for ( size_t t = 0; t < TESTS_COUNT; t++ )
+    {
+        typename vecType::value_type sum = 0;
+
+        for ( size_t i = 0; i < VECTOR_SIZE; i++ )
+        {
+            src[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+        }
+
+        steady_clock::time_point start = steady_clock::now( );
+
+        for ( size_t i = 0; i < ITERATIONS_COUNT; i++ )
+        {
+            sum = vectorTools->Sum( src.data( ), src.size( ) );
+        }
+
+        auto timeTaken = duration_cast<std::chrono::milliseconds>( steady_clock::now( ) - start ).count( );
+
+        printf( "time taken: %u \n", static_cast<uint32_t>( timeTaken ) );
+        printf( "sum: %f \n", static_cast<float>( sum ) );
+
+        avgTime += static_cast<float>( timeTaken );
+    }
+
+    avgTime /= TESTS_COUNT;
+
+    return avgTime;
+}
+
+// Index of the maximum element of the vector
+template <typename vecType> float ArgMaxTest( const IVectorTools* vectorTools )
+{
+    vecType src( VECTOR_SIZE );
+    float   avgTime = 0.0f;
+
+    for ( size_t t = 0; t < TESTS_COUNT; t++ )
+    {
+        size_t maxIndex = 0;
+
+        for ( size_t i = 0; i < VECTOR_SIZE; i++ )
+        {
+            src[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+        }
+
+        steady_clock::time_point start = steady_clock::now( );
+
+        for ( size_t i = 0; i < ITERATIONS_COUNT; i++ )
+        {
+            maxIndex = vectorTools->ArgMax( src.data( ), src.size( ) );
+        }
+
+        auto timeTaken = duration_cast<std::chrono::milliseconds>( steady_clock::now( ) - start ).count( );
+
+        printf( "time taken: %u \n", static_cast<uint32_t>( timeTaken ) );
+        printf( "max: %f at %u \n", static_cast<float>( src[maxIndex] ), static_cast<uint32_t>( maxIndex ) );
+
+        avgTime += static_cast<float>( timeTaken );
+    }
+
+    avgTime /= TESTS_COUNT;
+
+    return avgTime;
+}
+
+// Exponent of vector's elements : dst[i] = exp( src[i] )
+template <typename vecType> float ExpTest( const IVectorTools* vectorTools )
+{
+    vecType src( VECTOR_SIZE );
+    vecType dst( VECTOR_SIZE );
+    float   avgTime = 0.0f;
+
+    for ( size_t t = 0; t < TESTS_COUNT; t++ )
+    {
+        for ( size_t i = 0; i < VECTOR_SIZE; i++ )
+        {
+            src[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 20 ) - 10.0f;
+        }
+
+        steady_clock::time_point start = steady_clock::now( );
+
+        for ( size_t i = 0; i < ITERATIONS_COUNT; i++ )
+        {
+            vectorTools->Exp( src.data( ), dst.data( ), src.size( ) );
+        }
+
+        auto timeTaken = duration_cast<std::chrono::milliseconds>( steady_clock::now( ) - start ).count( );
+
+        printf( "time taken: %u \n", static_cast<uint32_t>( timeTaken ) );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( dst[i] ) );
+        }
+        printf( "\n" );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( dst[VECTOR_SIZE - 8 + i] ) );
+        }
+        printf( "\n" );
+
+        avgTime += static_cast<float>( timeTaken );
+    }
+
+    avgTime /= TESTS_COUNT;
+
+    return avgTime;
+}
+
+// Fused Adam optimizer step : updates weights, first/second moments and resets gradients
+template <typename vecType> float AdamStepTest( const IVectorTools* vectorTools )
+{
+    typedef typename vecType::value_type T;
+
+    vecType weights( VECTOR_SIZE );
+    vecType gradients( VECTOR_SIZE );
+    vecType mt( VECTOR_SIZE );
+    vecType vt( VECTOR_SIZE );
+    float   avgTime = 0.0f;
+
+    for ( size_t t = 0; t < TESTS_COUNT; t++ )
+    {
+        for ( size_t i = 0; i < VECTOR_SIZE; i++ )
+        {
+            weights[i]   = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+            gradients[i] = ( static_cast<float>( rand( ) ) / RAND_MAX ) * float( 2 ) - 1.0f;
+            mt[i]        = 0;
+            vt[i]        = 0;
+        }
+
+        steady_clock::time_point start = steady_clock::now( );
+
+        for ( size_t i = 0; i < ITERATIONS_COUNT; i++ )
+        {
+            vectorTools->AdamStep( weights.data( ), gradients.data( ), mt.data( ), vt.data( ), T( 0.5 ), T( 0.9 ), T( 0.999 ),
+                                   T( 10 ), T( 1000 ), T( 0.001 ), T( 1e-8 ), weights.size( ) );
+        }
+
+        auto timeTaken = duration_cast<std::chrono::milliseconds>( steady_clock::now( ) - start ).count( );
+
+        printf( "time taken: %u \n", static_cast<uint32_t>( timeTaken ) );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( weights[i] ) );
+        }
+        printf( "\n" );
+        for ( size_t i = 0; i < 8; i++ )
+        {
+            printf( "%f ", static_cast<float>( weights[VECTOR_SIZE - 8 + i] ) );
+        }
+        printf( "\n" );
+
+        avgTime += static_cast<float>( timeTaken );
+    }
+
+    avgTime /= TESTS_COUNT;
+
+    return avgTime;
+}